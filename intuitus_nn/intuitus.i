@@ -25,6 +25,23 @@ from __future__ import absolute_import
 #include "driver_exceptions.hpp"
 #include "framebuffer.hpp"
 #include "v4l_camera.hpp"
+#include "command_codec.hpp"
+#include "result_pool.hpp"
+#include "arena.hpp"
+#include "tensor.hpp"
+#include "dma_copy.hpp"
+#include "transform.hpp"
+#include "dlpack_export.hpp"
+#include "frame_tracker.hpp"
+#include "frame_record.hpp"
+#include "motion_gate.hpp"
+#include "roi.hpp"
+#include "realtime.hpp"
+#include "daemon_client.hpp"
+#include "result_bus.hpp"
+#include "startup.hpp"
+#include "tracker.hpp"
+#include "detection_log.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -82,15 +99,34 @@ import_array();
 %apply (int32_t *IN_ARRAY1, int DIM1) {
     (const int32_t *com_block, int com_block_dim)
 };
+%apply (uint8_t *IN_ARRAY1, int DIM1) {
+    (const uint8_t *com_stream, int com_stream_len),
+    (const uint8_t *data, int size)
+};
 
 %apply (uint32_t *IN_ARRAY2, int DIM1, int DIM2) {
     (const uint32_t *tile_tx_arr, int tile_tx_cnt, int tile_tx_dim),
     (const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim)  
 };
+%apply (int32_t *IN_ARRAY2, int DIM1, int DIM2) {
+    (const int32_t *rois, int roi_cnt, int roi_dim)
+};
+%apply (float *IN_ARRAY2, int DIM1, int DIM2) {
+    (const float *dets, int det_cnt, int det_dim),
+    (const float *values, int rows, int cols)
+};
+
+%apply (uint8_t *IN_ARRAY4, int DIM1, int DIM2, int DIM3, int DIM4) {
+    (const uint8_t *frames, int n, int ci, int h_in, int w_in)
+};
 
 %apply (uint8_t *IN_ARRAY3, int DIM1, int DIM2, int DIM3) {
     (const uint8_t *fmap_in, int ci, int h_in, int w_in), 
-    (const uint8_t *img_ptr, int height, int length, int depth)
+    (const uint8_t *img_ptr, int height, int length, int depth),
+    (const uint8_t *img_in, int h_in, int w_in, int ci)
+};
+%apply (int8_t *IN_ARRAY3, int DIM1, int DIM2, int DIM3) {
+    (const int8_t *data, int c, int h, int w)
 };
 
 
@@ -102,9 +138,6 @@ import_array();
 %apply (int8_t** ARGOUTVIEW_ARRAY3, int *DIM1, int *DIM2, int *DIM3) { 
   (int8_t **fmap_out, int *co, int *h_out, int *w_out)
 };
-%apply (float** ARGOUTVIEW_ARRAY3, int *DIM1, int *DIM2, int *DIM3) { 
-  (float **fmap_out, int *co, int *h_out, int *w_out)
-};
 %apply (uint8_t** ARGOUTVIEW_ARRAY1, int *DIM1) { 
   (uint8_t **fmap_out, int *out_size)
 }
@@ -114,15 +147,468 @@ import_array();
 %apply (int32_t** ARGOUTVIEW_ARRAY1, int *DIM1) { 
   (int32_t **screen_size, int *dim)
 }
+%apply (float** ARGOUTVIEW_ARRAY2, int *DIM1, int *DIM2) { 
+  (float **values, int *rows, int *cols)
+}
+%apply int *OUTPUT { int *slot };
+// Memory managed output: numpy takes ownership and frees the buffer
+%apply (int8_t** ARGOUTVIEWM_ARRAY2, int *DIM1, int *DIM2) { 
+  (int8_t **batch_out, int *batch, int *out_size)
+}
+%apply (uint8_t** ARGOUTVIEWM_ARRAY1, int *DIM1) { 
+  (uint8_t **com_stream_out, int *com_stream_len)
+}
+%apply (float** ARGOUTVIEWM_ARRAY1, int *DIM1) { 
+  (float **latency, int *n)
+}
+%apply (int32_t** ARGOUTVIEWM_ARRAY2, int *DIM1, int *DIM2) { 
+  (int32_t **rois_out, int *roi_cnt, int *roi_dim)
+}
+%apply (float** ARGOUTVIEWM_ARRAY2, int *DIM1, int *DIM2) { 
+  (float **merged_out, int *merged_cnt, int *merged_dim),
+  (float **tracks_out, int *track_cnt, int *track_dim),
+  (float **dets_out, int *det_cnt, int *det_dim)
+}
+%apply (float** ARGOUTVIEWM_ARRAY3, int *DIM1, int *DIM2, int *DIM3) { 
+  (float **hwc_out, int *h_out, int *w_out, int *co)
+}
+%apply (uint8_t** ARGOUTVIEWM_ARRAY3, int *DIM1, int *DIM2, int *DIM3) { 
+  (uint8_t **hwc_out, int *h_out, int *w_out, int *co),
+  (uint8_t **chw_out, int *co, int *h_out, int *w_out)
+}
+// Arena managed output: numpy owns a host arena buffer and gives it back to the arena
+%{
+static void intuitus_arena_capsule_free(PyObject *capsule)
+{
+    Host_arena::instance().release(PyCapsule_GetPointer(capsule, "intuitus_arena"));
+}
+%}
+%typemap(in, numinputs=0) (float **fmap_out, int *co, int *h_out, int *w_out)
+    (float *data_temp = NULL, int dim1_temp = 0, int dim2_temp = 0, int dim3_temp = 0)
+{
+    $1 = &data_temp;
+    $2 = &dim1_temp;
+    $3 = &dim2_temp;
+    $4 = &dim3_temp;
+}
+%typemap(argout) (float **fmap_out, int *co, int *h_out, int *w_out)
+{
+    npy_intp dims[3] = { *$2, *$3, *$4 };
+    PyObject *array, *capsule;
+
+    if (NULL == *$1)
+    {
+        Py_INCREF(Py_None);
+        $result = SWIG_Python_AppendOutput($result, Py_None);
+    }
+    else
+    {
+        capsule = PyCapsule_New((void *)*$1, "intuitus_arena", intuitus_arena_capsule_free);
+        if (capsule == NULL)
+        {
+            Host_arena::instance().release(*$1);
+            SWIG_fail;
+        }
+        array = PyArray_SimpleNewFromData(3, dims, NPY_FLOAT, (void *)*$1);
+        if (array == NULL)
+        {
+            Py_DECREF(capsule);
+            SWIG_fail;
+        }
+        PyArray_SetBaseObject((PyArrayObject *)array, capsule);
+        $result = SWIG_Python_AppendOutput($result, array);
+    }
+}
+
+// ------------------------------- Thread support ---------------------------------------
+//
+// Blocking calls (device ioctl, camera select, framebuffer copy) release the GIL so that
+// python threads can overlap camera waits and inference. Only the wrapped C++ call runs
+// without the GIL, numpy arrays are created afterwards in the argout typemaps.
+// The C++ classes serialize concurrent calls internally.
+%define RELEASE_GIL(function)
+%exception function {
+    Py_BEGIN_ALLOW_THREADS
+    $action
+    Py_END_ALLOW_THREADS
+}
+%enddef
+
+RELEASE_GIL(Intuitus_intf::execute)
+RELEASE_GIL(Intuitus_intf::execute_batch)
+RELEASE_GIL(Intuitus_intf::execute_rois)
+RELEASE_GIL(Intuitus_intf::recover)
+RELEASE_GIL(Intuitus_intf::autotune_dma)
+RELEASE_GIL(Intuitus_intf::set_dma_optimization)
+RELEASE_GIL(Intuitus_intf::load_dma_profile)
+RELEASE_GIL(Intuitus_intf::load_network)
+
+// Device errors in the constructor raise a RuntimeError instead of terminating the process
+%exception Intuitus_intf::Intuitus_intf {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+RELEASE_GIL(Camera::capture)
+RELEASE_GIL(Framebuffer::show)
+RELEASE_GIL(Framebuffer::show_uyvy)
+RELEASE_GIL(Frame_recorder::record)
+RELEASE_GIL(Frame_replay::capture)
+
+%exception Frame_recorder::Frame_recorder {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Tensor::Tensor {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Tensor::at {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_IndexError, e.getMessage());
+    }
+}
+RELEASE_GIL(Daemon_client::submit)
+RELEASE_GIL(Daemon_client::submit_slot)
+RELEASE_GIL(Daemon_client::wait)
+RELEASE_GIL(Daemon_client::execute)
+%exception Daemon_client::Daemon_client {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+RELEASE_GIL(Result_subscriber::next)
+RELEASE_GIL(transform_to_hwc_float)
+RELEASE_GIL(transform_to_hwc_uint8)
+RELEASE_GIL(transform_to_chw)
+RELEASE_GIL(Startup::run)
+RELEASE_GIL(Detection_log::flush)
+%exception Result_publisher::Result_publisher {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Result_subscriber::Result_subscriber {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Frame_replay::Frame_replay {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Detection_log::Detection_log {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+%exception Detection_log_reader::Detection_log_reader {
+    try {
+        $action
+    } catch (DMA_Exception &e) {
+        SWIG_exception(SWIG_RuntimeError, e.getMessage());
+    }
+}
+
+// ------------------------------- Pooled results ---------------------------------------
+//
+// execute_result and execute_dlpack hand out results which are backed by a slot of the 
+// reference counted result pool. The slot is released when the numpy array (and all views 
+// of it) or the DLPack tensor is destroyed. numpy arrays support the buffer protocol, numpy 
+// >= 1.22 additionally exports them through __dlpack__.
+%{
+static void intuitus_result_capsule_free(PyObject *capsule)
+{
+    delete (Result_ref *)PyCapsule_GetPointer(capsule, "intuitus_result");
+}
+
+static void intuitus_dlpack_capsule_free(PyObject *capsule)
+{
+    // Only delete the tensor if it has not been consumed by a framework
+    if (PyCapsule_IsValid(capsule, DLPACK_CAPSULE_NAME))
+    {
+        DLManagedTensor *tensor = (DLManagedTensor *)PyCapsule_GetPointer(capsule, DLPACK_CAPSULE_NAME);
+        tensor->deleter(tensor);
+    }
+}
+%}
+
+%ignore Intuitus_intf::execute_pooled;
+%ignore Intuitus_intf::execute_into;
+%ignore Intuitus_intf::get_result_pool;
+
+%extend Intuitus_intf {
+    /** execute_result -> executes the network. Returns (status, output) where output is a numpy array 
+     *                    owning a pooled result buffer. It is not overwritten by later executions.
+     *                    sequence: camera frame executed (latency tracker)
+     */
+    PyObject *execute_result(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+                             int64_t sequence = TRACKER_CURRENT_FRAME)
+    {
+        int8_t *data = NULL;
+        int slot, size, err;
+        npy_intp dims[1];
+        PyObject *array, *capsule;
+
+        Py_BEGIN_ALLOW_THREADS
+        err = $self->execute_pooled(fmap_in, ci, h_in, w_in, &slot, &data, &size, sequence);
+        Py_END_ALLOW_THREADS
+        if (0 != err)
+        {
+            return Py_BuildValue("(iO)", err, Py_None);
+        }
+
+        Result_ref *ref = new Result_ref($self->get_result_pool(), slot);
+        capsule = PyCapsule_New(ref, "intuitus_result", intuitus_result_capsule_free);
+        if (capsule == NULL)
+        {
+            delete ref;
+            return NULL;
+        }
+        dims[0] = size;
+        array = PyArray_SimpleNewFromData(1, dims, NPY_INT8, (void *)data);
+        if (array == NULL)
+        {
+            Py_DECREF(capsule);
+            return NULL;
+        }
+        PyArray_SetBaseObject((PyArrayObject *)array, capsule);
+        return Py_BuildValue("(iN)", 0, array);
+    }
+
+    /** execute_dlpack -> executes the network. Returns (status, tensor) where tensor is a DLPack 
+     *                    capsule ("dltensor") owning a pooled result buffer. Zero copy import 
+     *                    e.g. by torch.utils.dlpack.from_dlpack.
+     */
+    PyObject *execute_dlpack(const uint8_t *fmap_in, int ci, int h_in, int w_in)
+    {
+        int8_t *data = NULL;
+        int slot, size, err;
+        DLManagedTensor *tensor;
+        PyObject *capsule;
+
+        Py_BEGIN_ALLOW_THREADS
+        err = $self->execute_pooled(fmap_in, ci, h_in, w_in, &slot, &data, &size);
+        Py_END_ALLOW_THREADS
+        if (0 != err)
+        {
+            return Py_BuildValue("(iO)", err, Py_None);
+        }
+
+        tensor = result_to_dlpack(new Result_ref($self->get_result_pool(), slot), data, size);
+        capsule = PyCapsule_New(tensor, DLPACK_CAPSULE_NAME, intuitus_dlpack_capsule_free);
+        if (capsule == NULL)
+        {
+            tensor->deleter(tensor);
+            return NULL;
+        }
+        return Py_BuildValue("(iN)", 0, capsule);
+    }
+}
+
+// ------------------------------- Typed tensors ----------------------------------------
+//
+// execute_tensor returns the network output as Tensor (no copy, backed by a pooled result).
+// Arrays handed out by a tensor reference its storage: the pool slot and the decode cache
+// stay valid until the tensor, its views and all arrays are released.
+%{
+static void intuitus_tensor_capsule_free(PyObject *capsule)
+{
+    delete (std::shared_ptr<struct tensor_storage> *)PyCapsule_GetPointer(capsule, "intuitus_tensor");
+}
+
+static PyObject *intuitus_tensor_array(Tensor *tensor, const void *data, int type, int outer)
+{
+    npy_intp dims[3];
+    PyObject *array, *capsule;
+
+    dims[0] = outer;
+    dims[1] = (TENSOR_CHW == tensor->layout()) ? tensor->height() : tensor->width();
+    dims[2] = (TENSOR_CHW == tensor->layout()) ? tensor->width() : tensor->channels();
+    capsule = PyCapsule_New(new std::shared_ptr<struct tensor_storage>(tensor->get_storage()), "intuitus_tensor",
+                            intuitus_tensor_capsule_free);
+    if (capsule == NULL)
+    {
+        return NULL;
+    }
+    array = PyArray_SimpleNewFromData(3, dims, type, (void *)data);
+    if (array == NULL)
+    {
+        Py_DECREF(capsule);
+        return NULL;
+    }
+    PyArray_SetBaseObject((PyArrayObject *)array, capsule);
+    return array;
+}
+%}
+
+%ignore tensor_storage;
+%ignore float8_decode;
+%ignore Tensor::Tensor(std::shared_ptr<Result_ref>, const int8_t *, int, int, int, int, int);
+%ignore Tensor::Tensor(std::shared_ptr<Result_ref>, const int8_t *, int, int, int, int);
+%ignore Tensor::Tensor(std::shared_ptr<Result_ref>, const int8_t *, int, int, int);
+%ignore Tensor::decode;
+%ignore Tensor::slice;
+%ignore Tensor::raw;
+%ignore Tensor::get_storage;
+%newobject Tensor::view;
+
+%extend Tensor {
+    /** array -> float32 values of entries [begin, end) of the outermost dimension (channels for
+     *           TENSOR_CHW, rows for TENSOR_HWC). Only the tiles covering them are decoded.
+     */
+    PyObject *array(int begin, int end)
+    {
+        const float *values;
+        int n;
+
+        if (0 != $self->slice(begin, end, &values, &n))
+        {
+            PyErr_SetString(PyExc_IndexError, "slice exceeds tensor");
+            return NULL;
+        }
+        return intuitus_tensor_array($self, values, NPY_FLOAT32, end - begin);
+    }
+
+    /** numpy -> all values as float32 array
+     */
+    PyObject *numpy()
+    {
+        const float *values;
+        int n, outer = (TENSOR_CHW == $self->layout()) ? $self->channels() : $self->height();
+
+        if (0 != $self->slice(0, outer, &values, &n))
+        {
+            PyErr_SetString(PyExc_MemoryError, "failed to decode tensor");
+            return NULL;
+        }
+        return intuitus_tensor_array($self, values, NPY_FLOAT32, outer);
+    }
+
+    /** raw_array -> undecoded elements (int8, uint8 for TENSOR_UINT8)
+     */
+    PyObject *raw_array()
+    {
+        const int8_t *data;
+        int n, outer = (TENSOR_CHW == $self->layout()) ? $self->channels() : $self->height();
+
+        $self->raw(&data, &n);
+        return intuitus_tensor_array($self, data, (TENSOR_UINT8 == $self->format()) ? NPY_UINT8 : NPY_INT8, outer);
+    }
+}
+
+%extend Intuitus_intf {
+    /** execute_tensor -> executes the network. Returns (status, tensor) where tensor holds the
+     *                    concatenated outputs with shape (1, 1, output_size) in the given format.
+     *                    Use Tensor.view to address single outputs.
+     */
+    PyObject *execute_tensor(const uint8_t *fmap_in, int ci, int h_in, int w_in, int format = TENSOR_FLOAT8)
+    {
+        int8_t *data = NULL;
+        int slot, size, err;
+        Tensor *tensor;
+
+        Py_BEGIN_ALLOW_THREADS
+        err = $self->execute_pooled(fmap_in, ci, h_in, w_in, &slot, &data, &size);
+        Py_END_ALLOW_THREADS
+        if (0 != err)
+        {
+            return Py_BuildValue("(iO)", err, Py_None);
+        }
+        std::shared_ptr<Result_ref> ref = std::make_shared<Result_ref>($self->get_result_pool(), slot);
+        try
+        {
+            tensor = new Tensor(ref, data, 1, 1, size, format, TENSOR_CHW);
+        }
+        catch (DMA_Exception &e)
+        {
+            PyErr_SetString(PyExc_RuntimeError, e.getMessage());
+            return NULL;
+        }
+        return Py_BuildValue("(iN)", 0, SWIG_NewPointerObj(SWIG_as_voidptr(tensor), SWIGTYPE_p_Tensor, SWIG_POINTER_OWN));
+    }
+}
 
 // ------------------------------------ Wrapping ----------------------------------------
 // Wrap everything declared in this header
+%include "src/trace/frame_tracker.hpp"
+%include "src/mem/tensor.hpp"
+%ignore Intuitus_intf::upload_network;
 %include "src/intuitus.hpp"
 %include "src/fb/framebuffer.hpp"
 %include "src/cam/v4l_camera.hpp"
+%ignore Record_window;
+%include "src/cam/frame_record.hpp"
+%include "src/cam/motion_gate.hpp"
+
+%ignore Command_decoder;
+%include "src/codec/command_codec.hpp"
+
+%ignore Host_arena;
+%include "src/mem/arena.hpp"
 
+%ignore dma_copy_to_device;
+%ignore dma_copy_from_device;
+%ignore dma_copy_from_device_mt;
+%include "src/mem/dma_copy.hpp"
 
+%ignore transform_desc;
+%ignore transform_tensor;
+%include "src/mem/transform.hpp"
 
+%ignore roi_rect;
+%ignore roi_validate;
+%ignore roi_tile_grid;
+%ignore roi_stage;
+%ignore roi_merge;
+%include "src/roi/roi.hpp"
 
+%ignore rt_prefault;
+%ignore rt_register_worker;
+%include "src/rt/realtime.hpp"
 
+%ignore daemon_msg;
+%ignore daemon_send;
+%ignore daemon_recv;
+%include "src/daemon/daemon_protocol.hpp"
+%include "src/daemon/daemon_client.hpp"
+
+%ignore Result_publisher::publish;
+%ignore Result_subscriber::data;
+%include "src/bus/result_bus.hpp"
+
+// network() and camera() return objects owned by the Startup: the proxies keep it alive
+%pythonappend Startup::network() %{
+    if val is not None:
+        val._startup = self
+%}
+%pythonappend Startup::camera() %{
+    if val is not None:
+        val._startup = self
+%}
+%include "src/startup/startup.hpp"
+%include "src/track/tracker.hpp"
 
+%ignore detlog_segment_header;
+%include "src/log/detection_log.hpp"
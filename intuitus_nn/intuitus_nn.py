@@ -101,10 +101,444 @@ except __builtin__.Exception:
         pass
     _newclass = 0
 
+TRACKER_DEFAULT_HISTORY = _intuitus_nn.TRACKER_DEFAULT_HISTORY
+TRACKER_IN_FLIGHT = _intuitus_nn.TRACKER_IN_FLIGHT
+TRACKER_CURRENT_FRAME = _intuitus_nn.TRACKER_CURRENT_FRAME
+STAGE_SUBMIT = _intuitus_nn.STAGE_SUBMIT
+STAGE_COMPLETE = _intuitus_nn.STAGE_COMPLETE
+STAGE_DISPLAY = _intuitus_nn.STAGE_DISPLAY
+class frame_meta(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, frame_meta, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, frame_meta, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["sequence"] = _intuitus_nn.frame_meta_sequence_set
+    __swig_getmethods__["sequence"] = _intuitus_nn.frame_meta_sequence_get
+    if _newclass:
+        sequence = _swig_property(_intuitus_nn.frame_meta_sequence_get, _intuitus_nn.frame_meta_sequence_set)
+    __swig_setmethods__["sensor_us"] = _intuitus_nn.frame_meta_sensor_us_set
+    __swig_getmethods__["sensor_us"] = _intuitus_nn.frame_meta_sensor_us_get
+    if _newclass:
+        sensor_us = _swig_property(_intuitus_nn.frame_meta_sensor_us_get, _intuitus_nn.frame_meta_sensor_us_set)
+    __swig_setmethods__["dequeue_us"] = _intuitus_nn.frame_meta_dequeue_us_set
+    __swig_getmethods__["dequeue_us"] = _intuitus_nn.frame_meta_dequeue_us_get
+    if _newclass:
+        dequeue_us = _swig_property(_intuitus_nn.frame_meta_dequeue_us_get, _intuitus_nn.frame_meta_dequeue_us_set)
+    __swig_setmethods__["submit_us"] = _intuitus_nn.frame_meta_submit_us_set
+    __swig_getmethods__["submit_us"] = _intuitus_nn.frame_meta_submit_us_get
+    if _newclass:
+        submit_us = _swig_property(_intuitus_nn.frame_meta_submit_us_get, _intuitus_nn.frame_meta_submit_us_set)
+    __swig_setmethods__["complete_us"] = _intuitus_nn.frame_meta_complete_us_set
+    __swig_getmethods__["complete_us"] = _intuitus_nn.frame_meta_complete_us_get
+    if _newclass:
+        complete_us = _swig_property(_intuitus_nn.frame_meta_complete_us_get, _intuitus_nn.frame_meta_complete_us_set)
+    __swig_setmethods__["display_us"] = _intuitus_nn.frame_meta_display_us_set
+    __swig_getmethods__["display_us"] = _intuitus_nn.frame_meta_display_us_get
+    if _newclass:
+        display_us = _swig_property(_intuitus_nn.frame_meta_display_us_get, _intuitus_nn.frame_meta_display_us_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_frame_meta()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_frame_meta
+    __del__ = lambda self: None
+frame_meta_swigregister = _intuitus_nn.frame_meta_swigregister
+frame_meta_swigregister(frame_meta)
+class frame_latency_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, frame_latency_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, frame_latency_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["frames"] = _intuitus_nn.frame_latency_stats_frames_set
+    __swig_getmethods__["frames"] = _intuitus_nn.frame_latency_stats_frames_get
+    if _newclass:
+        frames = _swig_property(_intuitus_nn.frame_latency_stats_frames_get, _intuitus_nn.frame_latency_stats_frames_set)
+    __swig_setmethods__["dropped"] = _intuitus_nn.frame_latency_stats_dropped_set
+    __swig_getmethods__["dropped"] = _intuitus_nn.frame_latency_stats_dropped_get
+    if _newclass:
+        dropped = _swig_property(_intuitus_nn.frame_latency_stats_dropped_get, _intuitus_nn.frame_latency_stats_dropped_set)
+    __swig_setmethods__["not_displayed"] = _intuitus_nn.frame_latency_stats_not_displayed_set
+    __swig_getmethods__["not_displayed"] = _intuitus_nn.frame_latency_stats_not_displayed_get
+    if _newclass:
+        not_displayed = _swig_property(_intuitus_nn.frame_latency_stats_not_displayed_get, _intuitus_nn.frame_latency_stats_not_displayed_set)
+    __swig_setmethods__["latency_last_ms"] = _intuitus_nn.frame_latency_stats_latency_last_ms_set
+    __swig_getmethods__["latency_last_ms"] = _intuitus_nn.frame_latency_stats_latency_last_ms_get
+    if _newclass:
+        latency_last_ms = _swig_property(_intuitus_nn.frame_latency_stats_latency_last_ms_get, _intuitus_nn.frame_latency_stats_latency_last_ms_set)
+    __swig_setmethods__["latency_mean_ms"] = _intuitus_nn.frame_latency_stats_latency_mean_ms_set
+    __swig_getmethods__["latency_mean_ms"] = _intuitus_nn.frame_latency_stats_latency_mean_ms_get
+    if _newclass:
+        latency_mean_ms = _swig_property(_intuitus_nn.frame_latency_stats_latency_mean_ms_get, _intuitus_nn.frame_latency_stats_latency_mean_ms_set)
+    __swig_setmethods__["latency_p50_ms"] = _intuitus_nn.frame_latency_stats_latency_p50_ms_set
+    __swig_getmethods__["latency_p50_ms"] = _intuitus_nn.frame_latency_stats_latency_p50_ms_get
+    if _newclass:
+        latency_p50_ms = _swig_property(_intuitus_nn.frame_latency_stats_latency_p50_ms_get, _intuitus_nn.frame_latency_stats_latency_p50_ms_set)
+    __swig_setmethods__["latency_p99_ms"] = _intuitus_nn.frame_latency_stats_latency_p99_ms_set
+    __swig_getmethods__["latency_p99_ms"] = _intuitus_nn.frame_latency_stats_latency_p99_ms_get
+    if _newclass:
+        latency_p99_ms = _swig_property(_intuitus_nn.frame_latency_stats_latency_p99_ms_get, _intuitus_nn.frame_latency_stats_latency_p99_ms_set)
+    __swig_setmethods__["latency_max_ms"] = _intuitus_nn.frame_latency_stats_latency_max_ms_set
+    __swig_getmethods__["latency_max_ms"] = _intuitus_nn.frame_latency_stats_latency_max_ms_get
+    if _newclass:
+        latency_max_ms = _swig_property(_intuitus_nn.frame_latency_stats_latency_max_ms_get, _intuitus_nn.frame_latency_stats_latency_max_ms_set)
+    __swig_setmethods__["capture_mean_ms"] = _intuitus_nn.frame_latency_stats_capture_mean_ms_set
+    __swig_getmethods__["capture_mean_ms"] = _intuitus_nn.frame_latency_stats_capture_mean_ms_get
+    if _newclass:
+        capture_mean_ms = _swig_property(_intuitus_nn.frame_latency_stats_capture_mean_ms_get, _intuitus_nn.frame_latency_stats_capture_mean_ms_set)
+    __swig_setmethods__["inference_mean_ms"] = _intuitus_nn.frame_latency_stats_inference_mean_ms_set
+    __swig_getmethods__["inference_mean_ms"] = _intuitus_nn.frame_latency_stats_inference_mean_ms_get
+    if _newclass:
+        inference_mean_ms = _swig_property(_intuitus_nn.frame_latency_stats_inference_mean_ms_get, _intuitus_nn.frame_latency_stats_inference_mean_ms_set)
+    __swig_setmethods__["display_mean_ms"] = _intuitus_nn.frame_latency_stats_display_mean_ms_set
+    __swig_getmethods__["display_mean_ms"] = _intuitus_nn.frame_latency_stats_display_mean_ms_get
+    if _newclass:
+        display_mean_ms = _swig_property(_intuitus_nn.frame_latency_stats_display_mean_ms_get, _intuitus_nn.frame_latency_stats_display_mean_ms_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_frame_latency_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_frame_latency_stats
+    __del__ = lambda self: None
+frame_latency_stats_swigregister = _intuitus_nn.frame_latency_stats_swigregister
+frame_latency_stats_swigregister(frame_latency_stats)
+def monotonic_us():
+    return _intuitus_nn.monotonic_us()
+monotonic_us = _intuitus_nn.monotonic_us
+class Frame_tracker(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Frame_tracker, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Frame_tracker, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Frame_tracker(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Frame_tracker
+    __del__ = lambda self: None
+
+    def on_capture(self, sequence, sensor_us, dequeue_us):
+        return _intuitus_nn.Frame_tracker_on_capture(self, sequence, sensor_us, dequeue_us)
+
+    def mark(self, stage):
+        return _intuitus_nn.Frame_tracker_mark(self, stage)
+
+    def mark_frame(self, sequence, stage):
+        return _intuitus_nn.Frame_tracker_mark_frame(self, sequence, stage)
+
+    def last_frame(self):
+        return _intuitus_nn.Frame_tracker_last_frame(self)
+
+    def get_stats(self):
+        return _intuitus_nn.Frame_tracker_get_stats(self)
+
+    def get_latencies(self):
+        return _intuitus_nn.Frame_tracker_get_latencies(self)
+
+    def reset(self):
+        return _intuitus_nn.Frame_tracker_reset(self)
+Frame_tracker_swigregister = _intuitus_nn.Frame_tracker_swigregister
+Frame_tracker_swigregister(Frame_tracker)
+
+TENSOR_TILE_SIZE = _intuitus_nn.TENSOR_TILE_SIZE
+TENSOR_INT8 = _intuitus_nn.TENSOR_INT8
+TENSOR_UINT8 = _intuitus_nn.TENSOR_UINT8
+TENSOR_FLOAT8 = _intuitus_nn.TENSOR_FLOAT8
+TENSOR_CHW = _intuitus_nn.TENSOR_CHW
+TENSOR_HWC = _intuitus_nn.TENSOR_HWC
+class Tensor(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Tensor, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Tensor, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Tensor(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Tensor
+    __del__ = lambda self: None
+
+    def channels(self):
+        return _intuitus_nn.Tensor_channels(self)
+
+    def height(self):
+        return _intuitus_nn.Tensor_height(self)
+
+    def width(self):
+        return _intuitus_nn.Tensor_width(self)
+
+    def size(self):
+        return _intuitus_nn.Tensor_size(self)
+
+    def format(self):
+        return _intuitus_nn.Tensor_format(self)
+
+    def layout(self):
+        return _intuitus_nn.Tensor_layout(self)
+
+    def view(self, offset, c, h, w):
+        return _intuitus_nn.Tensor_view(self, offset, c, h, w)
+
+    def at(self, c, h, w):
+        return _intuitus_nn.Tensor_at(self, c, h, w)
+
+    def tile_count(self):
+        return _intuitus_nn.Tensor_tile_count(self)
+
+    def decoded_tiles(self):
+        return _intuitus_nn.Tensor_decoded_tiles(self)
+
+    def array(self, begin, end):
+        return _intuitus_nn.Tensor_array(self, begin, end)
+
+    def numpy(self):
+        return _intuitus_nn.Tensor_numpy(self)
+
+    def raw_array(self):
+        return _intuitus_nn.Tensor_raw_array(self)
+Tensor_swigregister = _intuitus_nn.Tensor_swigregister
+Tensor_swigregister(Tensor)
 DRIVER_KEXT_NAME = _intuitus_nn.DRIVER_KEXT_NAME
+DRIVER_MODULE_NAME = _intuitus_nn.DRIVER_MODULE_NAME
 LINUX_KERNEL_MODULE_PATH = _intuitus_nn.LINUX_KERNEL_MODULE_PATH
-LINUX_ADD_KERNEL_MODULE_COMMAND = _intuitus_nn.LINUX_ADD_KERNEL_MODULE_COMMAND
 LINUX_DEV_PATH = _intuitus_nn.LINUX_DEV_PATH
+RESULT_POOL_DEFAULT_SLOTS = _intuitus_nn.RESULT_POOL_DEFAULT_SLOTS
+BATCH_STAGING_BUFFERS = _intuitus_nn.BATCH_STAGING_BUFFERS
+ERROR_EXECUTION_TIMEOUT = _intuitus_nn.ERROR_EXECUTION_TIMEOUT
+ERROR_DEVICE_BUSY = _intuitus_nn.ERROR_DEVICE_BUSY
+ERROR_DEVICE_RECOVERY = _intuitus_nn.ERROR_DEVICE_RECOVERY
+DMA_OPT_OFF = _intuitus_nn.DMA_OPT_OFF
+DMA_OPT_ALL = _intuitus_nn.DMA_OPT_ALL
+DMA_OPT_PROFILE = _intuitus_nn.DMA_OPT_PROFILE
+DMA_PROFILE_MAGIC = _intuitus_nn.DMA_PROFILE_MAGIC
+DMA_TUNE_MIN_GAIN = _intuitus_nn.DMA_TUNE_MIN_GAIN
+class intuitus_exec_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, intuitus_exec_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, intuitus_exec_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["executions"] = _intuitus_nn.intuitus_exec_stats_executions_set
+    __swig_getmethods__["executions"] = _intuitus_nn.intuitus_exec_stats_executions_get
+    if _newclass:
+        executions = _swig_property(_intuitus_nn.intuitus_exec_stats_executions_get, _intuitus_nn.intuitus_exec_stats_executions_set)
+    __swig_setmethods__["timeouts"] = _intuitus_nn.intuitus_exec_stats_timeouts_set
+    __swig_getmethods__["timeouts"] = _intuitus_nn.intuitus_exec_stats_timeouts_get
+    if _newclass:
+        timeouts = _swig_property(_intuitus_nn.intuitus_exec_stats_timeouts_get, _intuitus_nn.intuitus_exec_stats_timeouts_set)
+    __swig_setmethods__["device_errors"] = _intuitus_nn.intuitus_exec_stats_device_errors_set
+    __swig_getmethods__["device_errors"] = _intuitus_nn.intuitus_exec_stats_device_errors_get
+    if _newclass:
+        device_errors = _swig_property(_intuitus_nn.intuitus_exec_stats_device_errors_get, _intuitus_nn.intuitus_exec_stats_device_errors_set)
+    __swig_setmethods__["missed_frames"] = _intuitus_nn.intuitus_exec_stats_missed_frames_set
+    __swig_getmethods__["missed_frames"] = _intuitus_nn.intuitus_exec_stats_missed_frames_get
+    if _newclass:
+        missed_frames = _swig_property(_intuitus_nn.intuitus_exec_stats_missed_frames_get, _intuitus_nn.intuitus_exec_stats_missed_frames_set)
+    __swig_setmethods__["recoveries"] = _intuitus_nn.intuitus_exec_stats_recoveries_set
+    __swig_getmethods__["recoveries"] = _intuitus_nn.intuitus_exec_stats_recoveries_get
+    if _newclass:
+        recoveries = _swig_property(_intuitus_nn.intuitus_exec_stats_recoveries_get, _intuitus_nn.intuitus_exec_stats_recoveries_set)
+    __swig_setmethods__["failed_recoveries"] = _intuitus_nn.intuitus_exec_stats_failed_recoveries_set
+    __swig_getmethods__["failed_recoveries"] = _intuitus_nn.intuitus_exec_stats_failed_recoveries_get
+    if _newclass:
+        failed_recoveries = _swig_property(_intuitus_nn.intuitus_exec_stats_failed_recoveries_get, _intuitus_nn.intuitus_exec_stats_failed_recoveries_set)
+    __swig_setmethods__["last_recovery_us"] = _intuitus_nn.intuitus_exec_stats_last_recovery_us_set
+    __swig_getmethods__["last_recovery_us"] = _intuitus_nn.intuitus_exec_stats_last_recovery_us_get
+    if _newclass:
+        last_recovery_us = _swig_property(_intuitus_nn.intuitus_exec_stats_last_recovery_us_get, _intuitus_nn.intuitus_exec_stats_last_recovery_us_set)
+    __swig_setmethods__["total_recovery_us"] = _intuitus_nn.intuitus_exec_stats_total_recovery_us_set
+    __swig_getmethods__["total_recovery_us"] = _intuitus_nn.intuitus_exec_stats_total_recovery_us_get
+    if _newclass:
+        total_recovery_us = _swig_property(_intuitus_nn.intuitus_exec_stats_total_recovery_us_get, _intuitus_nn.intuitus_exec_stats_total_recovery_us_set)
+    __swig_setmethods__["upload_us"] = _intuitus_nn.intuitus_exec_stats_upload_us_set
+    __swig_getmethods__["upload_us"] = _intuitus_nn.intuitus_exec_stats_upload_us_get
+    if _newclass:
+        upload_us = _swig_property(_intuitus_nn.intuitus_exec_stats_upload_us_get, _intuitus_nn.intuitus_exec_stats_upload_us_set)
+    __swig_setmethods__["execute_us"] = _intuitus_nn.intuitus_exec_stats_execute_us_set
+    __swig_getmethods__["execute_us"] = _intuitus_nn.intuitus_exec_stats_execute_us_get
+    if _newclass:
+        execute_us = _swig_property(_intuitus_nn.intuitus_exec_stats_execute_us_get, _intuitus_nn.intuitus_exec_stats_execute_us_set)
+    __swig_setmethods__["readout_us"] = _intuitus_nn.intuitus_exec_stats_readout_us_set
+    __swig_getmethods__["readout_us"] = _intuitus_nn.intuitus_exec_stats_readout_us_get
+    if _newclass:
+        readout_us = _swig_property(_intuitus_nn.intuitus_exec_stats_readout_us_get, _intuitus_nn.intuitus_exec_stats_readout_us_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_intuitus_exec_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_intuitus_exec_stats
+    __del__ = lambda self: None
+intuitus_exec_stats_swigregister = _intuitus_nn.intuitus_exec_stats_swigregister
+intuitus_exec_stats_swigregister(intuitus_exec_stats)
+class intuitus_layer_info(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, intuitus_layer_info, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, intuitus_layer_info, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["layer_id"] = _intuitus_nn.intuitus_layer_info_layer_id_set
+    __swig_getmethods__["layer_id"] = _intuitus_nn.intuitus_layer_info_layer_id_get
+    if _newclass:
+        layer_id = _swig_property(_intuitus_nn.intuitus_layer_info_layer_id_get, _intuitus_nn.intuitus_layer_info_layer_id_set)
+    __swig_setmethods__["layer_type"] = _intuitus_nn.intuitus_layer_info_layer_type_set
+    __swig_getmethods__["layer_type"] = _intuitus_nn.intuitus_layer_info_layer_type_get
+    if _newclass:
+        layer_type = _swig_property(_intuitus_nn.intuitus_layer_info_layer_type_get, _intuitus_nn.intuitus_layer_info_layer_type_set)
+    __swig_setmethods__["src_buffer_id"] = _intuitus_nn.intuitus_layer_info_src_buffer_id_set
+    __swig_getmethods__["src_buffer_id"] = _intuitus_nn.intuitus_layer_info_src_buffer_id_get
+    if _newclass:
+        src_buffer_id = _swig_property(_intuitus_nn.intuitus_layer_info_src_buffer_id_get, _intuitus_nn.intuitus_layer_info_src_buffer_id_set)
+    __swig_setmethods__["src2_buffer_id"] = _intuitus_nn.intuitus_layer_info_src2_buffer_id_set
+    __swig_getmethods__["src2_buffer_id"] = _intuitus_nn.intuitus_layer_info_src2_buffer_id_get
+    if _newclass:
+        src2_buffer_id = _swig_property(_intuitus_nn.intuitus_layer_info_src2_buffer_id_get, _intuitus_nn.intuitus_layer_info_src2_buffer_id_set)
+    __swig_setmethods__["in_channels"] = _intuitus_nn.intuitus_layer_info_in_channels_set
+    __swig_getmethods__["in_channels"] = _intuitus_nn.intuitus_layer_info_in_channels_get
+    if _newclass:
+        in_channels = _swig_property(_intuitus_nn.intuitus_layer_info_in_channels_get, _intuitus_nn.intuitus_layer_info_in_channels_set)
+    __swig_setmethods__["out_channels"] = _intuitus_nn.intuitus_layer_info_out_channels_set
+    __swig_getmethods__["out_channels"] = _intuitus_nn.intuitus_layer_info_out_channels_get
+    if _newclass:
+        out_channels = _swig_property(_intuitus_nn.intuitus_layer_info_out_channels_get, _intuitus_nn.intuitus_layer_info_out_channels_set)
+    __swig_setmethods__["out_height"] = _intuitus_nn.intuitus_layer_info_out_height_set
+    __swig_getmethods__["out_height"] = _intuitus_nn.intuitus_layer_info_out_height_get
+    if _newclass:
+        out_height = _swig_property(_intuitus_nn.intuitus_layer_info_out_height_get, _intuitus_nn.intuitus_layer_info_out_height_set)
+    __swig_setmethods__["out_width"] = _intuitus_nn.intuitus_layer_info_out_width_set
+    __swig_getmethods__["out_width"] = _intuitus_nn.intuitus_layer_info_out_width_get
+    if _newclass:
+        out_width = _swig_property(_intuitus_nn.intuitus_layer_info_out_width_get, _intuitus_nn.intuitus_layer_info_out_width_set)
+    __swig_setmethods__["output_bytes"] = _intuitus_nn.intuitus_layer_info_output_bytes_set
+    __swig_getmethods__["output_bytes"] = _intuitus_nn.intuitus_layer_info_output_bytes_get
+    if _newclass:
+        output_bytes = _swig_property(_intuitus_nn.intuitus_layer_info_output_bytes_get, _intuitus_nn.intuitus_layer_info_output_bytes_set)
+    __swig_setmethods__["tx_tiles"] = _intuitus_nn.intuitus_layer_info_tx_tiles_set
+    __swig_getmethods__["tx_tiles"] = _intuitus_nn.intuitus_layer_info_tx_tiles_get
+    if _newclass:
+        tx_tiles = _swig_property(_intuitus_nn.intuitus_layer_info_tx_tiles_get, _intuitus_nn.intuitus_layer_info_tx_tiles_set)
+    __swig_setmethods__["rx_tiles"] = _intuitus_nn.intuitus_layer_info_rx_tiles_set
+    __swig_getmethods__["rx_tiles"] = _intuitus_nn.intuitus_layer_info_rx_tiles_get
+    if _newclass:
+        rx_tiles = _swig_property(_intuitus_nn.intuitus_layer_info_rx_tiles_get, _intuitus_nn.intuitus_layer_info_rx_tiles_set)
+    __swig_setmethods__["command_blocks"] = _intuitus_nn.intuitus_layer_info_command_blocks_set
+    __swig_getmethods__["command_blocks"] = _intuitus_nn.intuitus_layer_info_command_blocks_get
+    if _newclass:
+        command_blocks = _swig_property(_intuitus_nn.intuitus_layer_info_command_blocks_get, _intuitus_nn.intuitus_layer_info_command_blocks_set)
+    __swig_setmethods__["command_bytes"] = _intuitus_nn.intuitus_layer_info_command_bytes_set
+    __swig_getmethods__["command_bytes"] = _intuitus_nn.intuitus_layer_info_command_bytes_get
+    if _newclass:
+        command_bytes = _swig_property(_intuitus_nn.intuitus_layer_info_command_bytes_get, _intuitus_nn.intuitus_layer_info_command_bytes_set)
+    __swig_setmethods__["max_command_bytes"] = _intuitus_nn.intuitus_layer_info_max_command_bytes_set
+    __swig_getmethods__["max_command_bytes"] = _intuitus_nn.intuitus_layer_info_max_command_bytes_get
+    if _newclass:
+        max_command_bytes = _swig_property(_intuitus_nn.intuitus_layer_info_max_command_bytes_get, _intuitus_nn.intuitus_layer_info_max_command_bytes_set)
+    __swig_setmethods__["tx_scatter_list_size"] = _intuitus_nn.intuitus_layer_info_tx_scatter_list_size_set
+    __swig_getmethods__["tx_scatter_list_size"] = _intuitus_nn.intuitus_layer_info_tx_scatter_list_size_get
+    if _newclass:
+        tx_scatter_list_size = _swig_property(_intuitus_nn.intuitus_layer_info_tx_scatter_list_size_get, _intuitus_nn.intuitus_layer_info_tx_scatter_list_size_set)
+    __swig_setmethods__["rx_scatter_list_size"] = _intuitus_nn.intuitus_layer_info_rx_scatter_list_size_set
+    __swig_getmethods__["rx_scatter_list_size"] = _intuitus_nn.intuitus_layer_info_rx_scatter_list_size_get
+    if _newclass:
+        rx_scatter_list_size = _swig_property(_intuitus_nn.intuitus_layer_info_rx_scatter_list_size_get, _intuitus_nn.intuitus_layer_info_rx_scatter_list_size_set)
+    __swig_setmethods__["dma_optimized"] = _intuitus_nn.intuitus_layer_info_dma_optimized_set
+    __swig_getmethods__["dma_optimized"] = _intuitus_nn.intuitus_layer_info_dma_optimized_get
+    if _newclass:
+        dma_optimized = _swig_property(_intuitus_nn.intuitus_layer_info_dma_optimized_get, _intuitus_nn.intuitus_layer_info_dma_optimized_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_intuitus_layer_info()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_intuitus_layer_info
+    __del__ = lambda self: None
+intuitus_layer_info_swigregister = _intuitus_nn.intuitus_layer_info_swigregister
+intuitus_layer_info_swigregister(intuitus_layer_info)
+class intuitus_network_info(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, intuitus_network_info, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, intuitus_network_info, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["layers"] = _intuitus_nn.intuitus_network_info_layers_set
+    __swig_getmethods__["layers"] = _intuitus_nn.intuitus_network_info_layers_get
+    if _newclass:
+        layers = _swig_property(_intuitus_nn.intuitus_network_info_layers_get, _intuitus_nn.intuitus_network_info_layers_set)
+    __swig_setmethods__["command_bytes"] = _intuitus_nn.intuitus_network_info_command_bytes_set
+    __swig_getmethods__["command_bytes"] = _intuitus_nn.intuitus_network_info_command_bytes_get
+    if _newclass:
+        command_bytes = _swig_property(_intuitus_nn.intuitus_network_info_command_bytes_get, _intuitus_nn.intuitus_network_info_command_bytes_set)
+    __swig_setmethods__["buffer_bytes"] = _intuitus_nn.intuitus_network_info_buffer_bytes_set
+    __swig_getmethods__["buffer_bytes"] = _intuitus_nn.intuitus_network_info_buffer_bytes_get
+    if _newclass:
+        buffer_bytes = _swig_property(_intuitus_nn.intuitus_network_info_buffer_bytes_get, _intuitus_nn.intuitus_network_info_buffer_bytes_set)
+    __swig_setmethods__["tx_scatter_list_size"] = _intuitus_nn.intuitus_network_info_tx_scatter_list_size_set
+    __swig_getmethods__["tx_scatter_list_size"] = _intuitus_nn.intuitus_network_info_tx_scatter_list_size_get
+    if _newclass:
+        tx_scatter_list_size = _swig_property(_intuitus_nn.intuitus_network_info_tx_scatter_list_size_get, _intuitus_nn.intuitus_network_info_tx_scatter_list_size_set)
+    __swig_setmethods__["rx_scatter_list_size"] = _intuitus_nn.intuitus_network_info_rx_scatter_list_size_set
+    __swig_getmethods__["rx_scatter_list_size"] = _intuitus_nn.intuitus_network_info_rx_scatter_list_size_get
+    if _newclass:
+        rx_scatter_list_size = _swig_property(_intuitus_nn.intuitus_network_info_rx_scatter_list_size_get, _intuitus_nn.intuitus_network_info_rx_scatter_list_size_set)
+    __swig_setmethods__["input_bytes"] = _intuitus_nn.intuitus_network_info_input_bytes_set
+    __swig_getmethods__["input_bytes"] = _intuitus_nn.intuitus_network_info_input_bytes_get
+    if _newclass:
+        input_bytes = _swig_property(_intuitus_nn.intuitus_network_info_input_bytes_get, _intuitus_nn.intuitus_network_info_input_bytes_set)
+    __swig_setmethods__["output_bytes"] = _intuitus_nn.intuitus_network_info_output_bytes_set
+    __swig_getmethods__["output_bytes"] = _intuitus_nn.intuitus_network_info_output_bytes_get
+    if _newclass:
+        output_bytes = _swig_property(_intuitus_nn.intuitus_network_info_output_bytes_get, _intuitus_nn.intuitus_network_info_output_bytes_set)
+    __swig_setmethods__["max_command_bytes"] = _intuitus_nn.intuitus_network_info_max_command_bytes_set
+    __swig_getmethods__["max_command_bytes"] = _intuitus_nn.intuitus_network_info_max_command_bytes_get
+    if _newclass:
+        max_command_bytes = _swig_property(_intuitus_nn.intuitus_network_info_max_command_bytes_get, _intuitus_nn.intuitus_network_info_max_command_bytes_set)
+    __swig_setmethods__["intf_buffer_size"] = _intuitus_nn.intuitus_network_info_intf_buffer_size_set
+    __swig_getmethods__["intf_buffer_size"] = _intuitus_nn.intuitus_network_info_intf_buffer_size_get
+    if _newclass:
+        intf_buffer_size = _swig_property(_intuitus_nn.intuitus_network_info_intf_buffer_size_get, _intuitus_nn.intuitus_network_info_intf_buffer_size_set)
+    __swig_setmethods__["intf_buffer_peak"] = _intuitus_nn.intuitus_network_info_intf_buffer_peak_set
+    __swig_getmethods__["intf_buffer_peak"] = _intuitus_nn.intuitus_network_info_intf_buffer_peak_get
+    if _newclass:
+        intf_buffer_peak = _swig_property(_intuitus_nn.intuitus_network_info_intf_buffer_peak_get, _intuitus_nn.intuitus_network_info_intf_buffer_peak_set)
+    __swig_setmethods__["network_status"] = _intuitus_nn.intuitus_network_info_network_status_set
+    __swig_getmethods__["network_status"] = _intuitus_nn.intuitus_network_info_network_status_get
+    if _newclass:
+        network_status = _swig_property(_intuitus_nn.intuitus_network_info_network_status_get, _intuitus_nn.intuitus_network_info_network_status_set)
+    __swig_setmethods__["execution_status"] = _intuitus_nn.intuitus_network_info_execution_status_set
+    __swig_getmethods__["execution_status"] = _intuitus_nn.intuitus_network_info_execution_status_get
+    if _newclass:
+        execution_status = _swig_property(_intuitus_nn.intuitus_network_info_execution_status_get, _intuitus_nn.intuitus_network_info_execution_status_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_intuitus_network_info()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_intuitus_network_info
+    __del__ = lambda self: None
+intuitus_network_info_swigregister = _intuitus_nn.intuitus_network_info_swigregister
+intuitus_network_info_swigregister(intuitus_network_info)
+
 class Intuitus_intf(_object):
     __swig_setmethods__ = {}
     __setattr__ = lambda self, name, value: _swig_setattr(self, Intuitus_intf, name, value)
@@ -139,6 +573,9 @@ class Intuitus_intf(_object):
     def conv2d(self, layer_id, layer_type, input_buffer_id, in_channel_cnt, out_height, out_width, out_channel_cnt, scattered_lines, tile_tx_arr, tile_rx_arr, com_block, com_lengths):
         return _intuitus_nn.Intuitus_intf_conv2d(self, layer_id, layer_type, input_buffer_id, in_channel_cnt, out_height, out_width, out_channel_cnt, scattered_lines, tile_tx_arr, tile_rx_arr, com_block, com_lengths)
 
+    def conv2d_compressed(self, layer_id, layer_type, input_buffer_id, in_channel_cnt, out_height, out_width, out_channel_cnt, scattered_lines, tile_tx_arr, tile_rx_arr, com_stream, com_lengths):
+        return _intuitus_nn.Intuitus_intf_conv2d_compressed(self, layer_id, layer_type, input_buffer_id, in_channel_cnt, out_height, out_width, out_channel_cnt, scattered_lines, tile_tx_arr, tile_rx_arr, com_stream, com_lengths)
+
     def concat(self, concat_layer_id, layer_1_id, layer_2_id):
         return _intuitus_nn.Intuitus_intf_concat(self, concat_layer_id, layer_1_id, layer_2_id)
 
@@ -154,11 +591,80 @@ class Intuitus_intf(_object):
     def copy(self, copy_layer_id, in_buffer_id, in_channel_cnt, out_height, out_width):
         return _intuitus_nn.Intuitus_intf_copy(self, copy_layer_id, in_buffer_id, in_channel_cnt, out_height, out_width)
 
-    def execute(self, fmap_in):
-        return _intuitus_nn.Intuitus_intf_execute(self, fmap_in)
+    def execute(self, *args):
+        return _intuitus_nn.Intuitus_intf_execute(self, *args)
+
+    def execute_batch(self, frames):
+        return _intuitus_nn.Intuitus_intf_execute_batch(self, frames)
+
+    def execute_rois(self, img_in, rois):
+        return _intuitus_nn.Intuitus_intf_execute_rois(self, img_in, rois)
+
+    def set_result_pool_size(self, max_slots):
+        return _intuitus_nn.Intuitus_intf_set_result_pool_size(self, max_slots)
+
+    def results_in_use(self):
+        return _intuitus_nn.Intuitus_intf_results_in_use(self)
+
+    def prefault(self):
+        return _intuitus_nn.Intuitus_intf_prefault(self)
+
+    def set_deadline(self, timeout_ms):
+        return _intuitus_nn.Intuitus_intf_set_deadline(self, timeout_ms)
+
+    def enable_recovery(self, enable):
+        return _intuitus_nn.Intuitus_intf_enable_recovery(self, enable)
+
+    def recover(self):
+        return _intuitus_nn.Intuitus_intf_recover(self)
+
+    def get_exec_stats(self):
+        return _intuitus_nn.Intuitus_intf_get_exec_stats(self)
+
+    def attach_tracker(self, tracker):
+        return _intuitus_nn.Intuitus_intf_attach_tracker(self, tracker)
+
+    def layer_count(self):
+        return _intuitus_nn.Intuitus_intf_layer_count(self)
+
+    def get_layer_info(self, index):
+        return _intuitus_nn.Intuitus_intf_get_layer_info(self, index)
+
+    def get_network_info(self):
+        return _intuitus_nn.Intuitus_intf_get_network_info(self)
+
+    def set_dma_optimization(self, mode):
+        return _intuitus_nn.Intuitus_intf_set_dma_optimization(self, mode)
+
+    def set_layer_dma_opt(self, layer_id, enable):
+        return _intuitus_nn.Intuitus_intf_set_layer_dma_opt(self, layer_id, enable)
+
+    def autotune_dma(self, fmap_in, runs):
+        return _intuitus_nn.Intuitus_intf_autotune_dma(self, fmap_in, runs)
+
+    def save_dma_profile(self, path):
+        return _intuitus_nn.Intuitus_intf_save_dma_profile(self, path)
+
+    def load_dma_profile(self, path):
+        return _intuitus_nn.Intuitus_intf_load_dma_profile(self, path)
+
+    def save_network(self, path):
+        return _intuitus_nn.Intuitus_intf_save_network(self, path)
+
+    def load_network(self, path):
+        return _intuitus_nn.Intuitus_intf_load_network(self, path)
 
     def float8_to_float32(self, fmap_in):
         return _intuitus_nn.Intuitus_intf_float8_to_float32(self, fmap_in)
+
+    def execute_result(self, *args):
+        return _intuitus_nn.Intuitus_intf_execute_result(self, *args)
+
+    def execute_dlpack(self, fmap_in):
+        return _intuitus_nn.Intuitus_intf_execute_dlpack(self, fmap_in)
+
+    def execute_tensor(self, *args):
+        return _intuitus_nn.Intuitus_intf_execute_tensor(self, *args)
 Intuitus_intf_swigregister = _intuitus_nn.Intuitus_intf_swigregister
 Intuitus_intf_swigregister(Intuitus_intf)
 
@@ -178,22 +684,30 @@ class Framebuffer(_object):
     __swig_destroy__ = _intuitus_nn.delete_Framebuffer
     __del__ = lambda self: None
 
-    def show(self, img_ptr, offs):
-        return _intuitus_nn.Framebuffer_show(self, img_ptr, offs)
+    def show(self, *args):
+        return _intuitus_nn.Framebuffer_show(self, *args)
+
+    def show_uyvy(self, *args):
+        return _intuitus_nn.Framebuffer_show_uyvy(self, *args)
 
     def close_tty(self):
         return _intuitus_nn.Framebuffer_close_tty(self)
 
     def get_screensize(self):
         return _intuitus_nn.Framebuffer_get_screensize(self)
+
+    def attach_tracker(self, tracker):
+        return _intuitus_nn.Framebuffer_attach_tracker(self, tracker)
+
+    def prefault(self):
+        return _intuitus_nn.Framebuffer_prefault(self)
 Framebuffer_swigregister = _intuitus_nn.Framebuffer_swigregister
 Framebuffer_swigregister(Framebuffer)
 
 FMT_NUM_PLANES = _intuitus_nn.FMT_NUM_PLANES
 WIDTH = _intuitus_nn.WIDTH
 HEIGHT = _intuitus_nn.HEIGHT
-MEDIA_INIT_OV5640 = _intuitus_nn.MEDIA_INIT_OV5640
-MEDIA_INIT_MIPI_CSI_SUBMODULE = _intuitus_nn.MEDIA_INIT_MIPI_CSI_SUBMODULE
+FPS = _intuitus_nn.FPS
 class buffer_addr_struct_t(_object):
     __swig_setmethods__ = {}
     __setattr__ = lambda self, name, value: _swig_setattr(self, buffer_addr_struct_t, name, value)
@@ -231,8 +745,8 @@ class Camera(_object):
     if _newclass:
         camdata = _swig_property(_intuitus_nn.Camera_camdata_get, _intuitus_nn.Camera_camdata_set)
 
-    def __init__(self, dev):
-        this = _intuitus_nn.new_Camera(dev)
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Camera(*args)
         try:
             self.this.append(this)
         except __builtin__.Exception:
@@ -242,8 +756,1010 @@ class Camera(_object):
 
     def capture(self):
         return _intuitus_nn.Camera_capture(self)
+
+    def set_crop(self, left, top, width, height):
+        return _intuitus_nn.Camera_set_crop(self, left, top, width, height)
+
+    def set_frame_rate(self, fps):
+        return _intuitus_nn.Camera_set_frame_rate(self, fps)
+
+    def attach_tracker(self, tracker):
+        return _intuitus_nn.Camera_attach_tracker(self, tracker)
+
+    def prefault(self):
+        return _intuitus_nn.Camera_prefault(self)
+
+    def last_frame_meta(self):
+        return _intuitus_nn.Camera_last_frame_meta(self)
 Camera_swigregister = _intuitus_nn.Camera_swigregister
 Camera_swigregister(Camera)
+FRAME_RECORD_MAGIC = _intuitus_nn.FRAME_RECORD_MAGIC
+FRAME_RECORD_VERSION = _intuitus_nn.FRAME_RECORD_VERSION
+FRAME_RECORD_ALIGN = _intuitus_nn.FRAME_RECORD_ALIGN
+FRAME_RECORD_WINDOW = _intuitus_nn.FRAME_RECORD_WINDOW
+FRAME_RECORD_END = _intuitus_nn.FRAME_RECORD_END
+ERROR_RECORD_FORMAT = _intuitus_nn.ERROR_RECORD_FORMAT
+class frame_record_header(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, frame_record_header, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, frame_record_header, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["magic"] = _intuitus_nn.frame_record_header_magic_set
+    __swig_getmethods__["magic"] = _intuitus_nn.frame_record_header_magic_get
+    if _newclass:
+        magic = _swig_property(_intuitus_nn.frame_record_header_magic_get, _intuitus_nn.frame_record_header_magic_set)
+    __swig_setmethods__["version"] = _intuitus_nn.frame_record_header_version_set
+    __swig_getmethods__["version"] = _intuitus_nn.frame_record_header_version_get
+    if _newclass:
+        version = _swig_property(_intuitus_nn.frame_record_header_version_get, _intuitus_nn.frame_record_header_version_set)
+    __swig_setmethods__["width"] = _intuitus_nn.frame_record_header_width_set
+    __swig_getmethods__["width"] = _intuitus_nn.frame_record_header_width_get
+    if _newclass:
+        width = _swig_property(_intuitus_nn.frame_record_header_width_get, _intuitus_nn.frame_record_header_width_set)
+    __swig_setmethods__["height"] = _intuitus_nn.frame_record_header_height_set
+    __swig_getmethods__["height"] = _intuitus_nn.frame_record_header_height_get
+    if _newclass:
+        height = _swig_property(_intuitus_nn.frame_record_header_height_get, _intuitus_nn.frame_record_header_height_set)
+    __swig_setmethods__["channels"] = _intuitus_nn.frame_record_header_channels_set
+    __swig_getmethods__["channels"] = _intuitus_nn.frame_record_header_channels_get
+    if _newclass:
+        channels = _swig_property(_intuitus_nn.frame_record_header_channels_get, _intuitus_nn.frame_record_header_channels_set)
+    __swig_setmethods__["frame_size"] = _intuitus_nn.frame_record_header_frame_size_set
+    __swig_getmethods__["frame_size"] = _intuitus_nn.frame_record_header_frame_size_get
+    if _newclass:
+        frame_size = _swig_property(_intuitus_nn.frame_record_header_frame_size_get, _intuitus_nn.frame_record_header_frame_size_set)
+    __swig_setmethods__["record_size"] = _intuitus_nn.frame_record_header_record_size_set
+    __swig_getmethods__["record_size"] = _intuitus_nn.frame_record_header_record_size_get
+    if _newclass:
+        record_size = _swig_property(_intuitus_nn.frame_record_header_record_size_get, _intuitus_nn.frame_record_header_record_size_set)
+    __swig_setmethods__["frame_count"] = _intuitus_nn.frame_record_header_frame_count_set
+    __swig_getmethods__["frame_count"] = _intuitus_nn.frame_record_header_frame_count_get
+    if _newclass:
+        frame_count = _swig_property(_intuitus_nn.frame_record_header_frame_count_get, _intuitus_nn.frame_record_header_frame_count_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_frame_record_header()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_frame_record_header
+    __del__ = lambda self: None
+frame_record_header_swigregister = _intuitus_nn.frame_record_header_swigregister
+frame_record_header_swigregister(frame_record_header)
+class frame_record_entry(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, frame_record_entry, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, frame_record_entry, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["sequence"] = _intuitus_nn.frame_record_entry_sequence_set
+    __swig_getmethods__["sequence"] = _intuitus_nn.frame_record_entry_sequence_get
+    if _newclass:
+        sequence = _swig_property(_intuitus_nn.frame_record_entry_sequence_get, _intuitus_nn.frame_record_entry_sequence_set)
+    __swig_setmethods__["frame_size"] = _intuitus_nn.frame_record_entry_frame_size_set
+    __swig_getmethods__["frame_size"] = _intuitus_nn.frame_record_entry_frame_size_get
+    if _newclass:
+        frame_size = _swig_property(_intuitus_nn.frame_record_entry_frame_size_get, _intuitus_nn.frame_record_entry_frame_size_set)
+    __swig_setmethods__["sensor_us"] = _intuitus_nn.frame_record_entry_sensor_us_set
+    __swig_getmethods__["sensor_us"] = _intuitus_nn.frame_record_entry_sensor_us_get
+    if _newclass:
+        sensor_us = _swig_property(_intuitus_nn.frame_record_entry_sensor_us_get, _intuitus_nn.frame_record_entry_sensor_us_set)
+    __swig_setmethods__["dequeue_us"] = _intuitus_nn.frame_record_entry_dequeue_us_set
+    __swig_getmethods__["dequeue_us"] = _intuitus_nn.frame_record_entry_dequeue_us_get
+    if _newclass:
+        dequeue_us = _swig_property(_intuitus_nn.frame_record_entry_dequeue_us_get, _intuitus_nn.frame_record_entry_dequeue_us_set)
+    __swig_setmethods__["reserved"] = _intuitus_nn.frame_record_entry_reserved_set
+    __swig_getmethods__["reserved"] = _intuitus_nn.frame_record_entry_reserved_get
+    if _newclass:
+        reserved = _swig_property(_intuitus_nn.frame_record_entry_reserved_get, _intuitus_nn.frame_record_entry_reserved_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_frame_record_entry()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_frame_record_entry
+    __del__ = lambda self: None
+frame_record_entry_swigregister = _intuitus_nn.frame_record_entry_swigregister
+frame_record_entry_swigregister(frame_record_entry)
+class Frame_recorder(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Frame_recorder, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Frame_recorder, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, path):
+        this = _intuitus_nn.new_Frame_recorder(path)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Frame_recorder
+    __del__ = lambda self: None
+
+    def add_frame(self, img_in, sequence, sensor_us, dequeue_us):
+        return _intuitus_nn.Frame_recorder_add_frame(self, img_in, sequence, sensor_us, dequeue_us)
+
+    def record(self, cam, frame_cnt):
+        return _intuitus_nn.Frame_recorder_record(self, cam, frame_cnt)
+
+    def frames(self):
+        return _intuitus_nn.Frame_recorder_frames(self)
+
+    def close_record(self):
+        return _intuitus_nn.Frame_recorder_close_record(self)
+Frame_recorder_swigregister = _intuitus_nn.Frame_recorder_swigregister
+Frame_recorder_swigregister(Frame_recorder)
+class Frame_replay(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Frame_replay, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Frame_replay, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Frame_replay(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Frame_replay
+    __del__ = lambda self: None
+
+    def capture(self):
+        return _intuitus_nn.Frame_replay_capture(self)
+
+    def attach_tracker(self, tracker):
+        return _intuitus_nn.Frame_replay_attach_tracker(self, tracker)
+
+    def last_frame_meta(self):
+        return _intuitus_nn.Frame_replay_last_frame_meta(self)
+
+    def frames(self):
+        return _intuitus_nn.Frame_replay_frames(self)
+
+    def rewind(self):
+        return _intuitus_nn.Frame_replay_rewind(self)
+Frame_replay_swigregister = _intuitus_nn.Frame_replay_swigregister
+Frame_replay_swigregister(Frame_replay)
+
+MOTION_SAMPLE_ROWS = _intuitus_nn.MOTION_SAMPLE_ROWS
+MOTION_BLOCK_SAMPLES = _intuitus_nn.MOTION_BLOCK_SAMPLES
+MOTION_BLOCK_LINES = _intuitus_nn.MOTION_BLOCK_LINES
+MOTION_DEFAULT_THRESHOLD = _intuitus_nn.MOTION_DEFAULT_THRESHOLD
+MOTION_DEFAULT_MIN_BLOCKS = _intuitus_nn.MOTION_DEFAULT_MIN_BLOCKS
+MOTION_DEFAULT_MAX_INTERVAL_MS = _intuitus_nn.MOTION_DEFAULT_MAX_INTERVAL_MS
+MOTION_SKIP = _intuitus_nn.MOTION_SKIP
+MOTION_INFER = _intuitus_nn.MOTION_INFER
+class motion_gate_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, motion_gate_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, motion_gate_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["frames"] = _intuitus_nn.motion_gate_stats_frames_set
+    __swig_getmethods__["frames"] = _intuitus_nn.motion_gate_stats_frames_get
+    if _newclass:
+        frames = _swig_property(_intuitus_nn.motion_gate_stats_frames_get, _intuitus_nn.motion_gate_stats_frames_set)
+    __swig_setmethods__["inferences"] = _intuitus_nn.motion_gate_stats_inferences_set
+    __swig_getmethods__["inferences"] = _intuitus_nn.motion_gate_stats_inferences_get
+    if _newclass:
+        inferences = _swig_property(_intuitus_nn.motion_gate_stats_inferences_get, _intuitus_nn.motion_gate_stats_inferences_set)
+    __swig_setmethods__["skipped"] = _intuitus_nn.motion_gate_stats_skipped_set
+    __swig_getmethods__["skipped"] = _intuitus_nn.motion_gate_stats_skipped_get
+    if _newclass:
+        skipped = _swig_property(_intuitus_nn.motion_gate_stats_skipped_get, _intuitus_nn.motion_gate_stats_skipped_set)
+    __swig_setmethods__["motion_triggers"] = _intuitus_nn.motion_gate_stats_motion_triggers_set
+    __swig_getmethods__["motion_triggers"] = _intuitus_nn.motion_gate_stats_motion_triggers_get
+    if _newclass:
+        motion_triggers = _swig_property(_intuitus_nn.motion_gate_stats_motion_triggers_get, _intuitus_nn.motion_gate_stats_motion_triggers_set)
+    __swig_setmethods__["interval_triggers"] = _intuitus_nn.motion_gate_stats_interval_triggers_set
+    __swig_getmethods__["interval_triggers"] = _intuitus_nn.motion_gate_stats_interval_triggers_get
+    if _newclass:
+        interval_triggers = _swig_property(_intuitus_nn.motion_gate_stats_interval_triggers_get, _intuitus_nn.motion_gate_stats_interval_triggers_set)
+    __swig_setmethods__["changed_blocks"] = _intuitus_nn.motion_gate_stats_changed_blocks_set
+    __swig_getmethods__["changed_blocks"] = _intuitus_nn.motion_gate_stats_changed_blocks_get
+    if _newclass:
+        changed_blocks = _swig_property(_intuitus_nn.motion_gate_stats_changed_blocks_get, _intuitus_nn.motion_gate_stats_changed_blocks_set)
+    __swig_setmethods__["max_block_diff"] = _intuitus_nn.motion_gate_stats_max_block_diff_set
+    __swig_getmethods__["max_block_diff"] = _intuitus_nn.motion_gate_stats_max_block_diff_get
+    if _newclass:
+        max_block_diff = _swig_property(_intuitus_nn.motion_gate_stats_max_block_diff_get, _intuitus_nn.motion_gate_stats_max_block_diff_set)
+    __swig_setmethods__["check_us"] = _intuitus_nn.motion_gate_stats_check_us_set
+    __swig_getmethods__["check_us"] = _intuitus_nn.motion_gate_stats_check_us_get
+    if _newclass:
+        check_us = _swig_property(_intuitus_nn.motion_gate_stats_check_us_get, _intuitus_nn.motion_gate_stats_check_us_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_motion_gate_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_motion_gate_stats
+    __del__ = lambda self: None
+motion_gate_stats_swigregister = _intuitus_nn.motion_gate_stats_swigregister
+motion_gate_stats_swigregister(motion_gate_stats)
+
+class Motion_gate(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Motion_gate, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Motion_gate, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Motion_gate(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Motion_gate
+    __del__ = lambda self: None
+
+    def check(self, img_in):
+        return _intuitus_nn.Motion_gate_check(self, img_in)
+
+    def set_threshold(self, threshold, min_blocks):
+        return _intuitus_nn.Motion_gate_set_threshold(self, threshold, min_blocks)
+
+    def set_max_interval(self, max_interval_ms):
+        return _intuitus_nn.Motion_gate_set_max_interval(self, max_interval_ms)
+
+    def reset(self):
+        return _intuitus_nn.Motion_gate_reset(self)
+
+    def get_stats(self):
+        return _intuitus_nn.Motion_gate_get_stats(self)
+
+    def reset_stats(self):
+        return _intuitus_nn.Motion_gate_reset_stats(self)
+Motion_gate_swigregister = _intuitus_nn.Motion_gate_swigregister
+Motion_gate_swigregister(Motion_gate)
+
+COM_STREAM_MAGIC = _intuitus_nn.COM_STREAM_MAGIC
+COM_STREAM_HEADER_SIZE = _intuitus_nn.COM_STREAM_HEADER_SIZE
+
+def encode_command_blocks(com_block, com_lengths):
+    return _intuitus_nn.encode_command_blocks(com_block, com_lengths)
+encode_command_blocks = _intuitus_nn.encode_command_blocks
+
+ARENA_CACHE_LINE = _intuitus_nn.ARENA_CACHE_LINE
+ARENA_PAGE_SIZE = _intuitus_nn.ARENA_PAGE_SIZE
+ARENA_HUGE_PAGE_SIZE = _intuitus_nn.ARENA_HUGE_PAGE_SIZE
+ARENA_USE_DEFAULT = _intuitus_nn.ARENA_USE_DEFAULT
+ARENA_PLAIN = _intuitus_nn.ARENA_PLAIN
+ARENA_HUGE_PAGES = _intuitus_nn.ARENA_HUGE_PAGES
+ARENA_LOCKED = _intuitus_nn.ARENA_LOCKED
+class host_arena_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, host_arena_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, host_arena_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["system_allocs"] = _intuitus_nn.host_arena_stats_system_allocs_set
+    __swig_getmethods__["system_allocs"] = _intuitus_nn.host_arena_stats_system_allocs_get
+    if _newclass:
+        system_allocs = _swig_property(_intuitus_nn.host_arena_stats_system_allocs_get, _intuitus_nn.host_arena_stats_system_allocs_set)
+    __swig_setmethods__["system_frees"] = _intuitus_nn.host_arena_stats_system_frees_set
+    __swig_getmethods__["system_frees"] = _intuitus_nn.host_arena_stats_system_frees_get
+    if _newclass:
+        system_frees = _swig_property(_intuitus_nn.host_arena_stats_system_frees_get, _intuitus_nn.host_arena_stats_system_frees_set)
+    __swig_setmethods__["acquires"] = _intuitus_nn.host_arena_stats_acquires_set
+    __swig_getmethods__["acquires"] = _intuitus_nn.host_arena_stats_acquires_get
+    if _newclass:
+        acquires = _swig_property(_intuitus_nn.host_arena_stats_acquires_get, _intuitus_nn.host_arena_stats_acquires_set)
+    __swig_setmethods__["releases"] = _intuitus_nn.host_arena_stats_releases_set
+    __swig_getmethods__["releases"] = _intuitus_nn.host_arena_stats_releases_get
+    if _newclass:
+        releases = _swig_property(_intuitus_nn.host_arena_stats_releases_get, _intuitus_nn.host_arena_stats_releases_set)
+    __swig_setmethods__["bytes_mapped"] = _intuitus_nn.host_arena_stats_bytes_mapped_set
+    __swig_getmethods__["bytes_mapped"] = _intuitus_nn.host_arena_stats_bytes_mapped_get
+    if _newclass:
+        bytes_mapped = _swig_property(_intuitus_nn.host_arena_stats_bytes_mapped_get, _intuitus_nn.host_arena_stats_bytes_mapped_set)
+    __swig_setmethods__["bytes_in_use"] = _intuitus_nn.host_arena_stats_bytes_in_use_set
+    __swig_getmethods__["bytes_in_use"] = _intuitus_nn.host_arena_stats_bytes_in_use_get
+    if _newclass:
+        bytes_in_use = _swig_property(_intuitus_nn.host_arena_stats_bytes_in_use_get, _intuitus_nn.host_arena_stats_bytes_in_use_set)
+    __swig_setmethods__["bytes_locked"] = _intuitus_nn.host_arena_stats_bytes_locked_set
+    __swig_getmethods__["bytes_locked"] = _intuitus_nn.host_arena_stats_bytes_locked_get
+    if _newclass:
+        bytes_locked = _swig_property(_intuitus_nn.host_arena_stats_bytes_locked_get, _intuitus_nn.host_arena_stats_bytes_locked_set)
+    __swig_setmethods__["huge_page_buffers"] = _intuitus_nn.host_arena_stats_huge_page_buffers_set
+    __swig_getmethods__["huge_page_buffers"] = _intuitus_nn.host_arena_stats_huge_page_buffers_get
+    if _newclass:
+        huge_page_buffers = _swig_property(_intuitus_nn.host_arena_stats_huge_page_buffers_get, _intuitus_nn.host_arena_stats_huge_page_buffers_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_host_arena_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_host_arena_stats
+    __del__ = lambda self: None
+host_arena_stats_swigregister = _intuitus_nn.host_arena_stats_swigregister
+host_arena_stats_swigregister(host_arena_stats)
+def get_arena_stats():
+    return _intuitus_nn.get_arena_stats()
+get_arena_stats = _intuitus_nn.get_arena_stats
+
+def set_arena_flags(flags):
+    return _intuitus_nn.set_arena_flags(flags)
+set_arena_flags = _intuitus_nn.set_arena_flags
+DMA_COPY_BURST = _intuitus_nn.DMA_COPY_BURST
+DMA_COPY_PREFETCH = _intuitus_nn.DMA_COPY_PREFETCH
+DMA_COPY_MAX_THREADS = _intuitus_nn.DMA_COPY_MAX_THREADS
+DMA_COPY_MT_THRESHOLD = _intuitus_nn.DMA_COPY_MT_THRESHOLD
+
+def dma_copy_set_threads(threads):
+    return _intuitus_nn.dma_copy_set_threads(threads)
+dma_copy_set_threads = _intuitus_nn.dma_copy_set_threads
+TRANSFORM_FLOAT32 = _intuitus_nn.TRANSFORM_FLOAT32
+TRANSFORM_UINT8 = _intuitus_nn.TRANSFORM_UINT8
+TRANSFORM_BLOCK_ROWS = _intuitus_nn.TRANSFORM_BLOCK_ROWS
+TRANSFORM_BLOCK_COLS = _intuitus_nn.TRANSFORM_BLOCK_COLS
+TRANSFORM_MAX_THREADS = _intuitus_nn.TRANSFORM_MAX_THREADS
+TRANSFORM_MT_THRESHOLD = _intuitus_nn.TRANSFORM_MT_THRESHOLD
+
+def transform_set_threads(threads):
+    return _intuitus_nn.transform_set_threads(threads)
+transform_set_threads = _intuitus_nn.transform_set_threads
+
+def transform_to_hwc_float(fmap_in, format, scale, offset):
+    return _intuitus_nn.transform_to_hwc_float(fmap_in, format, scale, offset)
+transform_to_hwc_float = _intuitus_nn.transform_to_hwc_float
+
+def transform_to_hwc_uint8(fmap_in, format, scale, offset):
+    return _intuitus_nn.transform_to_hwc_uint8(fmap_in, format, scale, offset)
+transform_to_hwc_uint8 = _intuitus_nn.transform_to_hwc_uint8
+
+def transform_to_chw(img_in, scale, offset):
+    return _intuitus_nn.transform_to_chw(img_in, scale, offset)
+transform_to_chw = _intuitus_nn.transform_to_chw
+
+ROI_DIM = _intuitus_nn.ROI_DIM
+ROI_MAX_REGIONS = _intuitus_nn.ROI_MAX_REGIONS
+ROI_DETECTION_DIM = _intuitus_nn.ROI_DETECTION_DIM
+ROI_MERGED_DIM = _intuitus_nn.ROI_MERGED_DIM
+ROI_BORDER_MARGIN = _intuitus_nn.ROI_BORDER_MARGIN
+
+def roi_tiles(frame_h, frame_w, tile_h, tile_w, overlap):
+    return _intuitus_nn.roi_tiles(frame_h, frame_w, tile_h, tile_w, overlap)
+roi_tiles = _intuitus_nn.roi_tiles
+
+def roi_merge_detections(dets, rois, frame_h, frame_w, net_h, net_w, iou_threshold):
+    return _intuitus_nn.roi_merge_detections(dets, rois, frame_h, frame_w, net_h, net_w, iou_threshold)
+roi_merge_detections = _intuitus_nn.roi_merge_detections
+
+RT_ROLE_CAPTURE = _intuitus_nn.RT_ROLE_CAPTURE
+RT_ROLE_INFERENCE = _intuitus_nn.RT_ROLE_INFERENCE
+RT_ROLE_DISPLAY = _intuitus_nn.RT_ROLE_DISPLAY
+RT_ROLE_WORKER = _intuitus_nn.RT_ROLE_WORKER
+RT_ROLES = _intuitus_nn.RT_ROLES
+RT_DEFAULT_CAPTURE_CPU = _intuitus_nn.RT_DEFAULT_CAPTURE_CPU
+RT_DEFAULT_CAPTURE_PRIORITY = _intuitus_nn.RT_DEFAULT_CAPTURE_PRIORITY
+RT_DEFAULT_INFERENCE_CPU = _intuitus_nn.RT_DEFAULT_INFERENCE_CPU
+RT_DEFAULT_INFERENCE_PRIORITY = _intuitus_nn.RT_DEFAULT_INFERENCE_PRIORITY
+RT_DEFAULT_DISPLAY_CPU = _intuitus_nn.RT_DEFAULT_DISPLAY_CPU
+RT_DEFAULT_DISPLAY_PRIORITY = _intuitus_nn.RT_DEFAULT_DISPLAY_PRIORITY
+RT_NO_CPU = _intuitus_nn.RT_NO_CPU
+RT_DEFAULT_WORKER_CPU = _intuitus_nn.RT_DEFAULT_WORKER_CPU
+RT_DEFAULT_WORKER_PRIORITY = _intuitus_nn.RT_DEFAULT_WORKER_PRIORITY
+RT_STACK_PREFAULT = _intuitus_nn.RT_STACK_PREFAULT
+RT_APPLIED_AFFINITY = _intuitus_nn.RT_APPLIED_AFFINITY
+RT_APPLIED_FIFO = _intuitus_nn.RT_APPLIED_FIFO
+RT_APPLIED_MLOCK = _intuitus_nn.RT_APPLIED_MLOCK
+class rt_thread_state(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, rt_thread_state, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, rt_thread_state, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["policy"] = _intuitus_nn.rt_thread_state_policy_set
+    __swig_getmethods__["policy"] = _intuitus_nn.rt_thread_state_policy_get
+    if _newclass:
+        policy = _swig_property(_intuitus_nn.rt_thread_state_policy_get, _intuitus_nn.rt_thread_state_policy_set)
+    __swig_setmethods__["priority"] = _intuitus_nn.rt_thread_state_priority_set
+    __swig_getmethods__["priority"] = _intuitus_nn.rt_thread_state_priority_get
+    if _newclass:
+        priority = _swig_property(_intuitus_nn.rt_thread_state_priority_get, _intuitus_nn.rt_thread_state_priority_set)
+    __swig_setmethods__["cpu_mask"] = _intuitus_nn.rt_thread_state_cpu_mask_set
+    __swig_getmethods__["cpu_mask"] = _intuitus_nn.rt_thread_state_cpu_mask_get
+    if _newclass:
+        cpu_mask = _swig_property(_intuitus_nn.rt_thread_state_cpu_mask_get, _intuitus_nn.rt_thread_state_cpu_mask_set)
+    __swig_setmethods__["memory_locked"] = _intuitus_nn.rt_thread_state_memory_locked_set
+    __swig_getmethods__["memory_locked"] = _intuitus_nn.rt_thread_state_memory_locked_get
+    if _newclass:
+        memory_locked = _swig_property(_intuitus_nn.rt_thread_state_memory_locked_get, _intuitus_nn.rt_thread_state_memory_locked_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_rt_thread_state()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_rt_thread_state
+    __del__ = lambda self: None
+rt_thread_state_swigregister = _intuitus_nn.rt_thread_state_swigregister
+rt_thread_state_swigregister(rt_thread_state)
+
+def rt_set_role(role, cpu, priority):
+    return _intuitus_nn.rt_set_role(role, cpu, priority)
+rt_set_role = _intuitus_nn.rt_set_role
+
+def rt_enter(role):
+    return _intuitus_nn.rt_enter(role)
+rt_enter = _intuitus_nn.rt_enter
+
+def rt_leave():
+    return _intuitus_nn.rt_leave()
+rt_leave = _intuitus_nn.rt_leave
+
+def rt_lock_memory():
+    return _intuitus_nn.rt_lock_memory()
+rt_lock_memory = _intuitus_nn.rt_lock_memory
+
+def rt_unlock_memory():
+    return _intuitus_nn.rt_unlock_memory()
+rt_unlock_memory = _intuitus_nn.rt_unlock_memory
+
+def rt_get_thread_state():
+    return _intuitus_nn.rt_get_thread_state()
+rt_get_thread_state = _intuitus_nn.rt_get_thread_state
+
+DAEMON_SOCKET_PATH = _intuitus_nn.DAEMON_SOCKET_PATH
+DAEMON_PROTOCOL_VERSION = _intuitus_nn.DAEMON_PROTOCOL_VERSION
+DAEMON_DEFAULT_SLOTS = _intuitus_nn.DAEMON_DEFAULT_SLOTS
+DAEMON_MAX_SLOTS = _intuitus_nn.DAEMON_MAX_SLOTS
+DAEMON_NAME_LEN = _intuitus_nn.DAEMON_NAME_LEN
+DAEMON_SLOT_ALIGN = _intuitus_nn.DAEMON_SLOT_ALIGN
+ERROR_DAEMON_DISCONNECTED = _intuitus_nn.ERROR_DAEMON_DISCONNECTED
+DAEMON_OPEN = _intuitus_nn.DAEMON_OPEN
+DAEMON_OPENED = _intuitus_nn.DAEMON_OPENED
+DAEMON_SUBMIT = _intuitus_nn.DAEMON_SUBMIT
+DAEMON_RESULT = _intuitus_nn.DAEMON_RESULT
+DAEMON_ERROR = _intuitus_nn.DAEMON_ERROR
+class Daemon_client(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Daemon_client, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Daemon_client, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Daemon_client(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Daemon_client
+    __del__ = lambda self: None
+
+    def slots(self):
+        return _intuitus_nn.Daemon_client_slots(self)
+
+    def channels(self):
+        return _intuitus_nn.Daemon_client_channels(self)
+
+    def height(self):
+        return _intuitus_nn.Daemon_client_height(self)
+
+    def width(self):
+        return _intuitus_nn.Daemon_client_width(self)
+
+    def output_size(self):
+        return _intuitus_nn.Daemon_client_output_size(self)
+
+    def input_buffer(self, slot):
+        return _intuitus_nn.Daemon_client_input_buffer(self, slot)
+
+    def submit_slot(self, slot):
+        return _intuitus_nn.Daemon_client_submit_slot(self, slot)
+
+    def submit(self, fmap_in):
+        return _intuitus_nn.Daemon_client_submit(self, fmap_in)
+
+    def wait(self):
+        return _intuitus_nn.Daemon_client_wait(self)
+
+    def release(self, slot):
+        return _intuitus_nn.Daemon_client_release(self, slot)
+
+    def execute(self, fmap_in):
+        return _intuitus_nn.Daemon_client_execute(self, fmap_in)
+
+    def last_queue_us(self):
+        return _intuitus_nn.Daemon_client_last_queue_us(self)
+
+    def last_exec_us(self):
+        return _intuitus_nn.Daemon_client_last_exec_us(self)
+Daemon_client_swigregister = _intuitus_nn.Daemon_client_swigregister
+Daemon_client_swigregister(Daemon_client)
+
+RESULT_BUS_MAGIC = _intuitus_nn.RESULT_BUS_MAGIC
+RESULT_BUS_VERSION = _intuitus_nn.RESULT_BUS_VERSION
+RESULT_BUS_PREFIX = _intuitus_nn.RESULT_BUS_PREFIX
+RESULT_BUS_NAME_LEN = _intuitus_nn.RESULT_BUS_NAME_LEN
+RESULT_BUS_DEFAULT_SLOTS = _intuitus_nn.RESULT_BUS_DEFAULT_SLOTS
+RESULT_BUS_DEFAULT_SLOT_SIZE = _intuitus_nn.RESULT_BUS_DEFAULT_SLOT_SIZE
+RESULT_BUS_ALIGN = _intuitus_nn.RESULT_BUS_ALIGN
+RESULT_BUS_INT8 = _intuitus_nn.RESULT_BUS_INT8
+RESULT_BUS_UINT8 = _intuitus_nn.RESULT_BUS_UINT8
+RESULT_BUS_FLOAT32 = _intuitus_nn.RESULT_BUS_FLOAT32
+RESULT_BUS_NO_DATA = _intuitus_nn.RESULT_BUS_NO_DATA
+ERROR_BUS_CLOSED = _intuitus_nn.ERROR_BUS_CLOSED
+
+class result_entry_meta(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, result_entry_meta, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, result_entry_meta, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["sequence"] = _intuitus_nn.result_entry_meta_sequence_set
+    __swig_getmethods__["sequence"] = _intuitus_nn.result_entry_meta_sequence_get
+    if _newclass:
+        sequence = _swig_property(_intuitus_nn.result_entry_meta_sequence_get, _intuitus_nn.result_entry_meta_sequence_set)
+    __swig_setmethods__["frame"] = _intuitus_nn.result_entry_meta_frame_set
+    __swig_getmethods__["frame"] = _intuitus_nn.result_entry_meta_frame_get
+    if _newclass:
+        frame = _swig_property(_intuitus_nn.result_entry_meta_frame_get, _intuitus_nn.result_entry_meta_frame_set)
+    __swig_setmethods__["sensor_us"] = _intuitus_nn.result_entry_meta_sensor_us_set
+    __swig_getmethods__["sensor_us"] = _intuitus_nn.result_entry_meta_sensor_us_get
+    if _newclass:
+        sensor_us = _swig_property(_intuitus_nn.result_entry_meta_sensor_us_get, _intuitus_nn.result_entry_meta_sensor_us_set)
+    __swig_setmethods__["publish_us"] = _intuitus_nn.result_entry_meta_publish_us_set
+    __swig_getmethods__["publish_us"] = _intuitus_nn.result_entry_meta_publish_us_get
+    if _newclass:
+        publish_us = _swig_property(_intuitus_nn.result_entry_meta_publish_us_get, _intuitus_nn.result_entry_meta_publish_us_set)
+    __swig_setmethods__["format"] = _intuitus_nn.result_entry_meta_format_set
+    __swig_getmethods__["format"] = _intuitus_nn.result_entry_meta_format_get
+    if _newclass:
+        format = _swig_property(_intuitus_nn.result_entry_meta_format_get, _intuitus_nn.result_entry_meta_format_set)
+    __swig_setmethods__["rows"] = _intuitus_nn.result_entry_meta_rows_set
+    __swig_getmethods__["rows"] = _intuitus_nn.result_entry_meta_rows_get
+    if _newclass:
+        rows = _swig_property(_intuitus_nn.result_entry_meta_rows_get, _intuitus_nn.result_entry_meta_rows_set)
+    __swig_setmethods__["cols"] = _intuitus_nn.result_entry_meta_cols_set
+    __swig_getmethods__["cols"] = _intuitus_nn.result_entry_meta_cols_get
+    if _newclass:
+        cols = _swig_property(_intuitus_nn.result_entry_meta_cols_get, _intuitus_nn.result_entry_meta_cols_set)
+    __swig_setmethods__["size"] = _intuitus_nn.result_entry_meta_size_set
+    __swig_getmethods__["size"] = _intuitus_nn.result_entry_meta_size_get
+    if _newclass:
+        size = _swig_property(_intuitus_nn.result_entry_meta_size_get, _intuitus_nn.result_entry_meta_size_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_result_entry_meta()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_result_entry_meta
+    __del__ = lambda self: None
+result_entry_meta_swigregister = _intuitus_nn.result_entry_meta_swigregister
+result_entry_meta_swigregister(result_entry_meta)
+
+class Result_publisher(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Result_publisher, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Result_publisher, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Result_publisher(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Result_publisher
+    __del__ = lambda self: None
+
+    def publish_float(self, *args):
+        return _intuitus_nn.Result_publisher_publish_float(self, *args)
+
+    def publish_bytes(self, *args):
+        return _intuitus_nn.Result_publisher_publish_bytes(self, *args)
+
+    def published(self):
+        return _intuitus_nn.Result_publisher_published(self)
+Result_publisher_swigregister = _intuitus_nn.Result_publisher_swigregister
+Result_publisher_swigregister(Result_publisher)
+
+class Result_subscriber(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Result_subscriber, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Result_subscriber, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, name):
+        this = _intuitus_nn.new_Result_subscriber(name)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Result_subscriber
+    __del__ = lambda self: None
+
+    def latest(self):
+        return _intuitus_nn.Result_subscriber_latest(self)
+
+    def next(self, *args):
+        return _intuitus_nn.Result_subscriber_next(self, *args)
+
+    def seek_latest(self):
+        return _intuitus_nn.Result_subscriber_seek_latest(self)
+
+    def last_meta(self):
+        return _intuitus_nn.Result_subscriber_last_meta(self)
+
+    def data_bytes(self):
+        return _intuitus_nn.Result_subscriber_data_bytes(self)
+
+    def data_float(self):
+        return _intuitus_nn.Result_subscriber_data_float(self)
+
+    def overruns(self):
+        return _intuitus_nn.Result_subscriber_overruns(self)
+
+    def slots(self):
+        return _intuitus_nn.Result_subscriber_slots(self)
+
+    def slot_size(self):
+        return _intuitus_nn.Result_subscriber_slot_size(self)
+Result_subscriber_swigregister = _intuitus_nn.Result_subscriber_swigregister
+Result_subscriber_swigregister(Result_subscriber)
+
+STARTUP_PARALLEL = _intuitus_nn.STARTUP_PARALLEL
+STARTUP_SEQUENTIAL = _intuitus_nn.STARTUP_SEQUENTIAL
+class startup_report(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, startup_report, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, startup_report, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["module_us"] = _intuitus_nn.startup_report_module_us_set
+    __swig_getmethods__["module_us"] = _intuitus_nn.startup_report_module_us_get
+    if _newclass:
+        module_us = _swig_property(_intuitus_nn.startup_report_module_us_get, _intuitus_nn.startup_report_module_us_set)
+    __swig_setmethods__["device_us"] = _intuitus_nn.startup_report_device_us_set
+    __swig_getmethods__["device_us"] = _intuitus_nn.startup_report_device_us_get
+    if _newclass:
+        device_us = _swig_property(_intuitus_nn.startup_report_device_us_get, _intuitus_nn.startup_report_device_us_set)
+    __swig_setmethods__["network_read_us"] = _intuitus_nn.startup_report_network_read_us_set
+    __swig_getmethods__["network_read_us"] = _intuitus_nn.startup_report_network_read_us_get
+    if _newclass:
+        network_read_us = _swig_property(_intuitus_nn.startup_report_network_read_us_get, _intuitus_nn.startup_report_network_read_us_set)
+    __swig_setmethods__["upload_us"] = _intuitus_nn.startup_report_upload_us_set
+    __swig_getmethods__["upload_us"] = _intuitus_nn.startup_report_upload_us_get
+    if _newclass:
+        upload_us = _swig_property(_intuitus_nn.startup_report_upload_us_get, _intuitus_nn.startup_report_upload_us_set)
+    __swig_setmethods__["camera_us"] = _intuitus_nn.startup_report_camera_us_set
+    __swig_getmethods__["camera_us"] = _intuitus_nn.startup_report_camera_us_get
+    if _newclass:
+        camera_us = _swig_property(_intuitus_nn.startup_report_camera_us_get, _intuitus_nn.startup_report_camera_us_set)
+    __swig_setmethods__["first_frame_us"] = _intuitus_nn.startup_report_first_frame_us_set
+    __swig_getmethods__["first_frame_us"] = _intuitus_nn.startup_report_first_frame_us_get
+    if _newclass:
+        first_frame_us = _swig_property(_intuitus_nn.startup_report_first_frame_us_get, _intuitus_nn.startup_report_first_frame_us_set)
+    __swig_setmethods__["network_ready_us"] = _intuitus_nn.startup_report_network_ready_us_set
+    __swig_getmethods__["network_ready_us"] = _intuitus_nn.startup_report_network_ready_us_get
+    if _newclass:
+        network_ready_us = _swig_property(_intuitus_nn.startup_report_network_ready_us_get, _intuitus_nn.startup_report_network_ready_us_set)
+    __swig_setmethods__["camera_ready_us"] = _intuitus_nn.startup_report_camera_ready_us_set
+    __swig_getmethods__["camera_ready_us"] = _intuitus_nn.startup_report_camera_ready_us_get
+    if _newclass:
+        camera_ready_us = _swig_property(_intuitus_nn.startup_report_camera_ready_us_get, _intuitus_nn.startup_report_camera_ready_us_set)
+    __swig_setmethods__["total_us"] = _intuitus_nn.startup_report_total_us_set
+    __swig_getmethods__["total_us"] = _intuitus_nn.startup_report_total_us_get
+    if _newclass:
+        total_us = _swig_property(_intuitus_nn.startup_report_total_us_get, _intuitus_nn.startup_report_total_us_set)
+    __swig_setmethods__["stage_sum_us"] = _intuitus_nn.startup_report_stage_sum_us_set
+    __swig_getmethods__["stage_sum_us"] = _intuitus_nn.startup_report_stage_sum_us_get
+    if _newclass:
+        stage_sum_us = _swig_property(_intuitus_nn.startup_report_stage_sum_us_get, _intuitus_nn.startup_report_stage_sum_us_set)
+    __swig_setmethods__["module_inserted"] = _intuitus_nn.startup_report_module_inserted_set
+    __swig_getmethods__["module_inserted"] = _intuitus_nn.startup_report_module_inserted_get
+    if _newclass:
+        module_inserted = _swig_property(_intuitus_nn.startup_report_module_inserted_get, _intuitus_nn.startup_report_module_inserted_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_startup_report()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_startup_report
+    __del__ = lambda self: None
+startup_report_swigregister = _intuitus_nn.startup_report_swigregister
+startup_report_swigregister(startup_report)
+class Startup(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Startup, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Startup, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Startup(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Startup
+    __del__ = lambda self: None
+
+    def run(self, *args):
+        return _intuitus_nn.Startup_run(self, *args)
+
+    def get_report(self):
+        return _intuitus_nn.Startup_get_report(self)
+
+    def print_report(self):
+        return _intuitus_nn.Startup_print_report(self)
+
+    def network(self):
+        val = _intuitus_nn.Startup_network(self)
+        if val is not None:
+            val._startup = self
+        return val
+
+    def camera(self):
+        val = _intuitus_nn.Startup_camera(self)
+        if val is not None:
+            val._startup = self
+        return val
+Startup_swigregister = _intuitus_nn.Startup_swigregister
+Startup_swigregister(Startup)
+
+TRACK_MAX = _intuitus_nn.TRACK_MAX
+TRACK_DETECTION_DIM = _intuitus_nn.TRACK_DETECTION_DIM
+TRACK_DIM = _intuitus_nn.TRACK_DIM
+TRACK_DEFAULT_IOU = _intuitus_nn.TRACK_DEFAULT_IOU
+TRACK_DEFAULT_MAX_INTERVAL = _intuitus_nn.TRACK_DEFAULT_MAX_INTERVAL
+TRACK_DEFAULT_MIN_CONFIDENCE = _intuitus_nn.TRACK_DEFAULT_MIN_CONFIDENCE
+TRACK_DEFAULT_MIN_HITS = _intuitus_nn.TRACK_DEFAULT_MIN_HITS
+TRACK_DEFAULT_MAX_MISSES = _intuitus_nn.TRACK_DEFAULT_MAX_MISSES
+TRACK_CONFIDENCE_DECAY = _intuitus_nn.TRACK_CONFIDENCE_DECAY
+TRACK_MISS_PENALTY = _intuitus_nn.TRACK_MISS_PENALTY
+TRACK_SKIP = _intuitus_nn.TRACK_SKIP
+TRACK_INFER = _intuitus_nn.TRACK_INFER
+class tracker_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, tracker_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, tracker_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["frames"] = _intuitus_nn.tracker_stats_frames_set
+    __swig_getmethods__["frames"] = _intuitus_nn.tracker_stats_frames_get
+    if _newclass:
+        frames = _swig_property(_intuitus_nn.tracker_stats_frames_get, _intuitus_nn.tracker_stats_frames_set)
+    __swig_setmethods__["inferences"] = _intuitus_nn.tracker_stats_inferences_set
+    __swig_getmethods__["inferences"] = _intuitus_nn.tracker_stats_inferences_get
+    if _newclass:
+        inferences = _swig_property(_intuitus_nn.tracker_stats_inferences_get, _intuitus_nn.tracker_stats_inferences_set)
+    __swig_setmethods__["skipped"] = _intuitus_nn.tracker_stats_skipped_set
+    __swig_getmethods__["skipped"] = _intuitus_nn.tracker_stats_skipped_get
+    if _newclass:
+        skipped = _swig_property(_intuitus_nn.tracker_stats_skipped_get, _intuitus_nn.tracker_stats_skipped_set)
+    __swig_setmethods__["confidence_triggers"] = _intuitus_nn.tracker_stats_confidence_triggers_set
+    __swig_getmethods__["confidence_triggers"] = _intuitus_nn.tracker_stats_confidence_triggers_get
+    if _newclass:
+        confidence_triggers = _swig_property(_intuitus_nn.tracker_stats_confidence_triggers_get, _intuitus_nn.tracker_stats_confidence_triggers_set)
+    __swig_setmethods__["interval_triggers"] = _intuitus_nn.tracker_stats_interval_triggers_set
+    __swig_getmethods__["interval_triggers"] = _intuitus_nn.tracker_stats_interval_triggers_get
+    if _newclass:
+        interval_triggers = _swig_property(_intuitus_nn.tracker_stats_interval_triggers_get, _intuitus_nn.tracker_stats_interval_triggers_set)
+    __swig_setmethods__["tracks_created"] = _intuitus_nn.tracker_stats_tracks_created_set
+    __swig_getmethods__["tracks_created"] = _intuitus_nn.tracker_stats_tracks_created_get
+    if _newclass:
+        tracks_created = _swig_property(_intuitus_nn.tracker_stats_tracks_created_get, _intuitus_nn.tracker_stats_tracks_created_set)
+    __swig_setmethods__["tracks_dropped"] = _intuitus_nn.tracker_stats_tracks_dropped_set
+    __swig_getmethods__["tracks_dropped"] = _intuitus_nn.tracker_stats_tracks_dropped_get
+    if _newclass:
+        tracks_dropped = _swig_property(_intuitus_nn.tracker_stats_tracks_dropped_get, _intuitus_nn.tracker_stats_tracks_dropped_set)
+    __swig_setmethods__["active_tracks"] = _intuitus_nn.tracker_stats_active_tracks_set
+    __swig_getmethods__["active_tracks"] = _intuitus_nn.tracker_stats_active_tracks_get
+    if _newclass:
+        active_tracks = _swig_property(_intuitus_nn.tracker_stats_active_tracks_get, _intuitus_nn.tracker_stats_active_tracks_set)
+    __swig_setmethods__["update_us"] = _intuitus_nn.tracker_stats_update_us_set
+    __swig_getmethods__["update_us"] = _intuitus_nn.tracker_stats_update_us_get
+    if _newclass:
+        update_us = _swig_property(_intuitus_nn.tracker_stats_update_us_get, _intuitus_nn.tracker_stats_update_us_set)
+    __swig_setmethods__["predict_us"] = _intuitus_nn.tracker_stats_predict_us_set
+    __swig_getmethods__["predict_us"] = _intuitus_nn.tracker_stats_predict_us_get
+    if _newclass:
+        predict_us = _swig_property(_intuitus_nn.tracker_stats_predict_us_get, _intuitus_nn.tracker_stats_predict_us_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_tracker_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_tracker_stats
+    __del__ = lambda self: None
+tracker_stats_swigregister = _intuitus_nn.tracker_stats_swigregister
+tracker_stats_swigregister(tracker_stats)
+class Tracker(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Tracker, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Tracker, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Tracker(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Tracker
+    __del__ = lambda self: None
+
+    def decide(self):
+        return _intuitus_nn.Tracker_decide(self)
+
+    def update(self, dets):
+        return _intuitus_nn.Tracker_update(self, dets)
+
+    def predict(self):
+        return _intuitus_nn.Tracker_predict(self)
+
+    def set_policy(self, max_interval, min_confidence):
+        return _intuitus_nn.Tracker_set_policy(self, max_interval, min_confidence)
+
+    def set_lifetime(self, min_hits, max_misses):
+        return _intuitus_nn.Tracker_set_lifetime(self, min_hits, max_misses)
+
+    def set_iou_threshold(self, iou_threshold):
+        return _intuitus_nn.Tracker_set_iou_threshold(self, iou_threshold)
+
+    def reset(self):
+        return _intuitus_nn.Tracker_reset(self)
+
+    def get_stats(self):
+        return _intuitus_nn.Tracker_get_stats(self)
+
+    def reset_stats(self):
+        return _intuitus_nn.Tracker_reset_stats(self)
+Tracker_swigregister = _intuitus_nn.Tracker_swigregister
+Tracker_swigregister(Tracker)
+
+DETLOG_MAGIC = _intuitus_nn.DETLOG_MAGIC
+DETLOG_VERSION = _intuitus_nn.DETLOG_VERSION
+DETLOG_EXTENSION = _intuitus_nn.DETLOG_EXTENSION
+DETLOG_DEFAULT_PREFIX = _intuitus_nn.DETLOG_DEFAULT_PREFIX
+DETLOG_DEFAULT_SEGMENT_SIZE = _intuitus_nn.DETLOG_DEFAULT_SEGMENT_SIZE
+DETLOG_DEFAULT_MAX_SEGMENTS = _intuitus_nn.DETLOG_DEFAULT_MAX_SEGMENTS
+DETLOG_DEFAULT_SYNC_INTERVAL_MS = _intuitus_nn.DETLOG_DEFAULT_SYNC_INTERVAL_MS
+DETLOG_MIN_SEGMENT_SIZE = _intuitus_nn.DETLOG_MIN_SEGMENT_SIZE
+DETLOG_BOX_FRAC_BITS = _intuitus_nn.DETLOG_BOX_FRAC_BITS
+DETLOG_MAX_DETECTIONS = _intuitus_nn.DETLOG_MAX_DETECTIONS
+DETLOG_BLOCK_MARK = _intuitus_nn.DETLOG_BLOCK_MARK
+DETLOG_BLOCK_IDS = _intuitus_nn.DETLOG_BLOCK_IDS
+DETLOG_DETECTION_DIM = _intuitus_nn.DETLOG_DETECTION_DIM
+DETLOG_TRACK_DIM = _intuitus_nn.DETLOG_TRACK_DIM
+DETLOG_DIM = _intuitus_nn.DETLOG_DIM
+DETLOG_END = _intuitus_nn.DETLOG_END
+ERROR_LOG_FORMAT = _intuitus_nn.ERROR_LOG_FORMAT
+class detection_log_stats(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, detection_log_stats, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, detection_log_stats, name)
+    __repr__ = _swig_repr
+    __swig_setmethods__["frames"] = _intuitus_nn.detection_log_stats_frames_set
+    __swig_getmethods__["frames"] = _intuitus_nn.detection_log_stats_frames_get
+    if _newclass:
+        frames = _swig_property(_intuitus_nn.detection_log_stats_frames_get, _intuitus_nn.detection_log_stats_frames_set)
+    __swig_setmethods__["detections"] = _intuitus_nn.detection_log_stats_detections_set
+    __swig_getmethods__["detections"] = _intuitus_nn.detection_log_stats_detections_get
+    if _newclass:
+        detections = _swig_property(_intuitus_nn.detection_log_stats_detections_get, _intuitus_nn.detection_log_stats_detections_set)
+    __swig_setmethods__["bytes"] = _intuitus_nn.detection_log_stats_bytes_set
+    __swig_getmethods__["bytes"] = _intuitus_nn.detection_log_stats_bytes_get
+    if _newclass:
+        bytes = _swig_property(_intuitus_nn.detection_log_stats_bytes_get, _intuitus_nn.detection_log_stats_bytes_set)
+    __swig_setmethods__["segments"] = _intuitus_nn.detection_log_stats_segments_set
+    __swig_getmethods__["segments"] = _intuitus_nn.detection_log_stats_segments_get
+    if _newclass:
+        segments = _swig_property(_intuitus_nn.detection_log_stats_segments_get, _intuitus_nn.detection_log_stats_segments_set)
+    __swig_setmethods__["syncs"] = _intuitus_nn.detection_log_stats_syncs_set
+    __swig_getmethods__["syncs"] = _intuitus_nn.detection_log_stats_syncs_get
+    if _newclass:
+        syncs = _swig_property(_intuitus_nn.detection_log_stats_syncs_get, _intuitus_nn.detection_log_stats_syncs_set)
+    __swig_setmethods__["append_us"] = _intuitus_nn.detection_log_stats_append_us_set
+    __swig_getmethods__["append_us"] = _intuitus_nn.detection_log_stats_append_us_get
+    if _newclass:
+        append_us = _swig_property(_intuitus_nn.detection_log_stats_append_us_get, _intuitus_nn.detection_log_stats_append_us_set)
+    __swig_setmethods__["max_append_us"] = _intuitus_nn.detection_log_stats_max_append_us_set
+    __swig_getmethods__["max_append_us"] = _intuitus_nn.detection_log_stats_max_append_us_get
+    if _newclass:
+        max_append_us = _swig_property(_intuitus_nn.detection_log_stats_max_append_us_get, _intuitus_nn.detection_log_stats_max_append_us_set)
+
+    def __init__(self):
+        this = _intuitus_nn.new_detection_log_stats()
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_detection_log_stats
+    __del__ = lambda self: None
+detection_log_stats_swigregister = _intuitus_nn.detection_log_stats_swigregister
+detection_log_stats_swigregister(detection_log_stats)
+
+class Detection_log(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Detection_log, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Detection_log, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, *args):
+        this = _intuitus_nn.new_Detection_log(*args)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Detection_log
+    __del__ = lambda self: None
+
+    def append(self, *args):
+        return _intuitus_nn.Detection_log_append(self, *args)
+
+    def flush(self):
+        return _intuitus_nn.Detection_log_flush(self)
+
+    def set_sync_interval(self, sync_interval_ms):
+        return _intuitus_nn.Detection_log_set_sync_interval(self, sync_interval_ms)
+
+    def segment_path(self):
+        return _intuitus_nn.Detection_log_segment_path(self)
+
+    def get_stats(self):
+        return _intuitus_nn.Detection_log_get_stats(self)
+Detection_log_swigregister = _intuitus_nn.Detection_log_swigregister
+Detection_log_swigregister(Detection_log)
+
+class Detection_log_reader(_object):
+    __swig_setmethods__ = {}
+    __setattr__ = lambda self, name, value: _swig_setattr(self, Detection_log_reader, name, value)
+    __swig_getmethods__ = {}
+    __getattr__ = lambda self, name: _swig_getattr(self, Detection_log_reader, name)
+    __repr__ = _swig_repr
+
+    def __init__(self, path):
+        this = _intuitus_nn.new_Detection_log_reader(path)
+        try:
+            self.this.append(this)
+        except __builtin__.Exception:
+            self.this = this
+    __swig_destroy__ = _intuitus_nn.delete_Detection_log_reader
+    __del__ = lambda self: None
+
+    def next(self):
+        return _intuitus_nn.Detection_log_reader_next(self)
+
+    def frame(self):
+        return _intuitus_nn.Detection_log_reader_frame(self)
+
+    def timestamp_us(self):
+        return _intuitus_nn.Detection_log_reader_timestamp_us(self)
+
+    def segment(self):
+        return _intuitus_nn.Detection_log_reader_segment(self)
+
+    def frames(self):
+        return _intuitus_nn.Detection_log_reader_frames(self)
+Detection_log_reader_swigregister = _intuitus_nn.Detection_log_reader_swigregister
+Detection_log_reader_swigregister(Detection_log_reader)
 
 # This file is compatible with both classic and new-style classes.
 
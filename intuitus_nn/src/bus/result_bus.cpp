@@ -0,0 +1,415 @@
+#include "result_bus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "Result bus requires lock-free atomics in shared memory.");
+
+#define RESULT_BUS_ROUND(X) (((X) + RESULT_BUS_ALIGN - 1) & ~(size_t)(RESULT_BUS_ALIGN - 1))
+
+/**
+ * result_bus_header -> start of the shared memory segment, followed by the slots
+ * @head: number of published entries, entry n lives in slot n % slots
+ * @wake: futex word, incremented after every entry and on close
+ * @closed: the producer has shut down the bus
+ */
+struct result_bus_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slots;
+    uint32_t slot_size;   // data bytes per slot
+    uint32_t slot_stride; // bytes between slots
+    int32_t producer_pid;
+    alignas(RESULT_BUS_ALIGN) std::atomic<uint64_t> head;
+    std::atomic<uint32_t> wake;
+    std::atomic<uint32_t> closed;
+};
+
+/**
+ * result_bus_slot -> one entry of the ring
+ * @seq: 2 * (n + 1) when entry n is complete, 2 * (n + 1) - 1 while it is written
+ */
+struct result_bus_slot
+{
+    std::atomic<uint64_t> seq;
+    struct result_entry_meta meta;
+};
+
+#define RESULT_BUS_OVERWRITTEN 2 // read_entry: the producer reused the slot
+
+#define RESULT_BUS_HEADER_SIZE RESULT_BUS_ROUND(sizeof(struct result_bus_header))
+#define RESULT_BUS_SLOT_HEADER_SIZE RESULT_BUS_ROUND(sizeof(struct result_bus_slot))
+
+static inline uint64_t mono_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline struct result_bus_slot *bus_slot(struct result_bus_header *header, uint64_t sequence)
+{
+	return (struct result_bus_slot *)((uint8_t *)header + RESULT_BUS_HEADER_SIZE +
+									  (size_t)(sequence % header->slots) * header->slot_stride);
+}
+
+static std::string bus_path(const char *name)
+{
+	return std::string(RESULT_BUS_PREFIX) + name;
+}
+
+/** Result_publisher -> creates the bus, a stale bus of the same name is replaced
+ * 			 Consumers keep their mapping of a replaced bus, they attach again on ERROR_BUS_CLOSED.
+ * @name: name of the bus (/dev/shm/intuitus_bus_<name>)
+ * @slots: entries kept in the ring
+ * @slot_size: maximum bytes of an entry
+ */
+Result_publisher::Result_publisher(const char *name, int slots, int slot_size)
+{
+	CHECK_AND_THROW(name != NULL && name[0] != '\0' && strlen(name) < RESULT_BUS_NAME_LEN && strchr(name, '/') == NULL,
+					ERROR_OTHER, "Invalid result bus name.")
+	CHECK_AND_THROW(slots > 1 && slot_size > 0 && slot_size <= INT_MAX - (int)RESULT_BUS_SLOT_HEADER_SIZE - RESULT_BUS_ALIGN,
+					ERROR_OTHER, "Invalid result bus dimensions.")
+	this->path = bus_path(name);
+	size_t stride = RESULT_BUS_SLOT_HEADER_SIZE + RESULT_BUS_ROUND((size_t)slot_size);
+	this->size = RESULT_BUS_HEADER_SIZE + (size_t)slots * stride;
+
+	// a previous producer may have died without unlinking, resizing its segment would fault its readers
+	shm_unlink(this->path.c_str());
+	int fd = shm_open(this->path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+	CHECK_AND_THROW(fd >= 0, ERROR_OTHER, "Failed to create result bus.")
+	if (0 != ftruncate(fd, this->size))
+	{
+		close(fd);
+		shm_unlink(this->path.c_str());
+		CHECK_AND_THROW(0, ERROR_OTHER, "Failed to size result bus.")
+	}
+	void *ptr = mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (ptr == MAP_FAILED)
+	{
+		shm_unlink(this->path.c_str());
+		CHECK_AND_THROW(0, ERROR_OTHER, "Failed to map result bus.")
+	}
+
+	this->header = (struct result_bus_header *)ptr;
+	memset(ptr, 0, this->size);
+	this->header->slots = slots;
+	this->header->slot_size = slot_size;
+	this->header->slot_stride = stride;
+	this->header->producer_pid = getpid();
+	this->header->head.store(0, std::memory_order_relaxed);
+	this->header->wake.store(0, std::memory_order_relaxed);
+	this->header->closed.store(0, std::memory_order_relaxed);
+	this->header->version = RESULT_BUS_VERSION;
+	// readers accept the segment once the magic is set
+	std::atomic_thread_fence(std::memory_order_release);
+	this->header->magic = RESULT_BUS_MAGIC;
+}
+
+Result_publisher::~Result_publisher()
+{
+	if (this->header != NULL)
+	{
+		this->header->closed.store(1, std::memory_order_release);
+		this->header->wake.fetch_add(1, std::memory_order_release);
+		syscall(SYS_futex, &this->header->wake, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+		munmap(this->header, this->size);
+		shm_unlink(this->path.c_str());
+	}
+}
+
+/** publish -> writes an entry into the next slot and wakes the waiting consumers, never blocks on consumers
+ * @data: entry data, size bytes
+ * @format: RESULT_BUS_INT8, RESULT_BUS_UINT8 or RESULT_BUS_FLOAT32
+ * @rows, @cols: shape of the data
+ * @frame: frame sequence number
+ * @sensor_us: capture time of the frame (CLOCK_MONOTONIC)
+ */
+int Result_publisher::publish(const void *data, uint32_t size, int format, int rows, int cols,
+							  uint64_t frame, uint64_t sensor_us)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(size <= this->header->slot_size, ERROR_DIMENSION_MISMATCH, "Entry exceeds the slot size of the result bus.")
+	CHECK(data != NULL || size == 0, ERROR_OTHER, "No entry data.")
+	uint64_t n = this->header->head.load(std::memory_order_relaxed);
+	struct result_bus_slot *slot = bus_slot(this->header, n);
+
+	// odd sequence: readers of the previous entry in this slot detect the overwrite
+	slot->seq.store(2 * (n + 1) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot->meta.sequence = n;
+	slot->meta.frame = frame;
+	slot->meta.sensor_us = sensor_us;
+	slot->meta.publish_us = mono_us();
+	slot->meta.format = format;
+	slot->meta.rows = rows;
+	slot->meta.cols = cols;
+	slot->meta.size = size;
+	if (size > 0)
+	{
+		memcpy((uint8_t *)slot + RESULT_BUS_SLOT_HEADER_SIZE, data, size);
+	}
+	slot->seq.store(2 * (n + 1), std::memory_order_release);
+	this->header->head.store(n + 1, std::memory_order_release);
+
+	this->header->wake.fetch_add(1, std::memory_order_release);
+	syscall(SYS_futex, &this->header->wake, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+	return 0;
+}
+
+/** publish_float -> publishes decoded results
+ * @values: [rows, cols] (e.g. detections x (x, y, w, h, score, class))
+ */
+int Result_publisher::publish_float(const float *values, int rows, int cols, uint64_t frame, uint64_t sensor_us)
+{
+	CHECK(rows >= 0 && cols >= 0, ERROR_DIMENSION_MISMATCH, "Invalid entry shape.")
+	return this->publish(values, (uint32_t)((size_t)rows * cols * sizeof(float)), RESULT_BUS_FLOAT32, rows, cols, frame, sensor_us);
+}
+
+/** publish_bytes -> publishes raw results (e.g. the int8 output of the network)
+ * @format: RESULT_BUS_INT8 or RESULT_BUS_UINT8
+ */
+int Result_publisher::publish_bytes(const uint8_t *data, int size, uint64_t frame, uint64_t sensor_us, int format)
+{
+	CHECK(size >= 0, ERROR_DIMENSION_MISMATCH, "Invalid entry size.")
+	CHECK(format == RESULT_BUS_INT8 || format == RESULT_BUS_UINT8, ERROR_OTHER, "Invalid entry format.")
+	return this->publish(data, (uint32_t)size, format, 1, size, frame, sensor_us);
+}
+
+/** published -> returns the number of published entries
+ */
+uint64_t Result_publisher::published()
+{
+	return this->header->head.load(std::memory_order_acquire);
+}
+
+/** Result_subscriber -> attaches read only to a bus, reading starts with the entries published afterwards
+ * @name: name of the bus
+ */
+Result_subscriber::Result_subscriber(const char *name)
+{
+	struct stat st;
+
+	CHECK_AND_THROW(name != NULL && strlen(name) < RESULT_BUS_NAME_LEN, ERROR_OTHER, "Invalid result bus name.")
+	int fd = shm_open(bus_path(name).c_str(), O_RDONLY, 0);
+	CHECK_AND_THROW(fd >= 0, ERROR_OTHER, "Result bus does not exist.")
+	if (0 != fstat(fd, &st) || (size_t)st.st_size < RESULT_BUS_HEADER_SIZE)
+	{
+		close(fd);
+		CHECK_AND_THROW(0, ERROR_OTHER, "Result bus is not initialised.")
+	}
+	this->size = st.st_size;
+	void *ptr = mmap(NULL, this->size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	CHECK_AND_THROW(ptr != MAP_FAILED, ERROR_OTHER, "Failed to map result bus.")
+	this->header = (struct result_bus_header *)ptr;
+
+	uint32_t magic = this->header->magic;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (magic != RESULT_BUS_MAGIC || this->header->version != RESULT_BUS_VERSION ||
+		RESULT_BUS_HEADER_SIZE + (size_t)this->header->slots * this->header->slot_stride > this->size)
+	{
+		munmap(ptr, this->size);
+		this->header = NULL;
+		CHECK_AND_THROW(0, ERROR_OTHER, "Result bus has an incompatible format.")
+	}
+	this->buffer.resize(this->header->slot_size);
+	memset(&this->meta, 0, sizeof(this->meta));
+	this->next_sequence = this->header->head.load(std::memory_order_acquire);
+}
+
+Result_subscriber::~Result_subscriber()
+{
+	if (this->header != NULL)
+	{
+		munmap(this->header, this->size);
+	}
+}
+
+/** read_entry -> copies entry sequence into the buffer
+ * @return: 0, RESULT_BUS_NO_DATA if it is not published yet or RESULT_BUS_OVERWRITTEN if it was overwritten
+ */
+int Result_subscriber::read_entry(uint64_t sequence)
+{
+	struct result_bus_slot *slot = bus_slot(this->header, sequence);
+	uint64_t expected = 2 * (sequence + 1);
+	struct result_entry_meta m;
+
+	uint64_t seq = slot->seq.load(std::memory_order_acquire);
+	if (seq != expected)
+	{
+		return seq < expected ? RESULT_BUS_NO_DATA : RESULT_BUS_OVERWRITTEN;
+	}
+	m = slot->meta;
+	size_t size = m.size <= this->header->slot_size ? m.size : 0;
+	memcpy(this->buffer.data(), (uint8_t *)slot + RESULT_BUS_SLOT_HEADER_SIZE, size);
+	// the copy is valid only if the producer did not touch the slot meanwhile
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (slot->seq.load(std::memory_order_relaxed) != expected)
+	{
+		return RESULT_BUS_OVERWRITTEN;
+	}
+	this->meta = m;
+	return 0;
+}
+
+/** latest -> reads the newest entry
+ * @return: 0, RESULT_BUS_NO_DATA if nothing was published yet or ERROR_BUS_CLOSED
+ */
+int Result_subscriber::latest()
+{
+	while (true)
+	{
+		uint64_t head = this->header->head.load(std::memory_order_acquire);
+		if (head == 0)
+		{
+			return this->header->closed.load(std::memory_order_acquire) ? ERROR_BUS_CLOSED : RESULT_BUS_NO_DATA;
+		}
+		// overwritten while copying: the producer is ahead, take its new latest entry
+		if (0 == this->read_entry(head - 1))
+		{
+			return 0;
+		}
+	}
+}
+
+/** next -> reads the entry following the last one read by next (follows the stream)
+ * 			 Entries overwritten before they were read are skipped and counted as overruns.
+ * @timeout_ms: time to wait for a new entry, 0 to poll, -1 to wait until one arrives
+ * @return: 0, RESULT_BUS_NO_DATA on timeout or signal, ERROR_BUS_CLOSED
+ */
+int Result_subscriber::next(int timeout_ms)
+{
+	uint64_t deadline = timeout_ms > 0 ? mono_us() + (uint64_t)timeout_ms * 1000 : 0;
+
+	while (true)
+	{
+		uint32_t wake = this->header->wake.load(std::memory_order_acquire);
+		uint64_t head = this->header->head.load(std::memory_order_acquire);
+		if (head > this->next_sequence)
+		{
+			// the oldest slot may be written right now, resume one entry after it
+			if (head - this->next_sequence >= this->header->slots)
+			{
+				uint64_t resume = head - this->header->slots + 1;
+				this->lost += resume - this->next_sequence;
+				this->next_sequence = resume;
+			}
+			int err = this->read_entry(this->next_sequence);
+			if (0 == err)
+			{
+				this->next_sequence++;
+				return 0;
+			}
+			if (RESULT_BUS_OVERWRITTEN == err)
+			{
+				this->lost++;
+				this->next_sequence++;
+			}
+			continue;
+		}
+		if (this->header->closed.load(std::memory_order_acquire))
+		{
+			return ERROR_BUS_CLOSED;
+		}
+		if (timeout_ms == 0)
+		{
+			return RESULT_BUS_NO_DATA;
+		}
+		struct timespec ts, *tsp = NULL;
+		if (timeout_ms > 0)
+		{
+			uint64_t now = mono_us();
+			if (now >= deadline)
+			{
+				return RESULT_BUS_NO_DATA;
+			}
+			ts.tv_sec = (deadline - now) / 1000000;
+			ts.tv_nsec = ((deadline - now) % 1000000) * 1000;
+			tsp = &ts;
+		}
+		// returns at once if an entry was published since wake was read
+		if (0 != syscall(SYS_futex, &this->header->wake, FUTEX_WAIT, wake, tsp, NULL, 0) && errno == EINTR)
+		{
+			return RESULT_BUS_NO_DATA;
+		}
+	}
+}
+
+/** seek_latest -> skips all published entries, next returns the following ones
+ */
+int Result_subscriber::seek_latest()
+{
+	this->next_sequence = this->header->head.load(std::memory_order_acquire);
+	return 0;
+}
+
+/** last_meta -> returns the metadata of the entry read last
+ */
+struct result_entry_meta Result_subscriber::last_meta()
+{
+	return this->meta;
+}
+
+/** data -> returns the data of the entry read last, valid until the next read
+ */
+const uint8_t *Result_subscriber::data()
+{
+	return this->buffer.data();
+}
+
+/** data_bytes -> returns the data of the entry read last as bytes
+ */
+void Result_subscriber::data_bytes(uint8_t **fmap_out, int *out_size)
+{
+	*fmap_out = this->buffer.data();
+	*out_size = this->meta.size;
+}
+
+/** data_float -> returns the data of the entry read last as [rows, cols] values
+ */
+int Result_subscriber::data_float(float **values, int *rows, int *cols)
+{
+	*values = (float *)this->buffer.data();
+	*rows = 0;
+	*cols = 0;
+	CHECK(this->meta.format == RESULT_BUS_FLOAT32 && (size_t)this->meta.rows * this->meta.cols * sizeof(float) == this->meta.size,
+		  ERROR_DIMENSION_MISMATCH, "Entry is not a float array.")
+	*rows = this->meta.rows;
+	*cols = this->meta.cols;
+	return 0;
+}
+
+/** overruns -> returns the number of entries next skipped because the producer overwrote them
+ */
+uint64_t Result_subscriber::overruns()
+{
+	return this->lost;
+}
+
+/** slots -> returns the number of entries kept by the bus
+ */
+int Result_subscriber::slots()
+{
+	return this->header->slots;
+}
+
+/** slot_size -> returns the maximum bytes of an entry
+ */
+int Result_subscriber::slot_size()
+{
+	return this->header->slot_size;
+}
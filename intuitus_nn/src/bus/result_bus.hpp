@@ -0,0 +1,109 @@
+/*
+ * result_bus.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Result bus: the inference process publishes its results (decoded detections or raw outputs)
+ * with frame metadata into a ring in POSIX shared memory (/dev/shm/intuitus_bus_<name>). Any
+ * number of consumer processes (recorder, forwarder, UI) attach read only and read the latest
+ * entry or follow the stream. The producer never waits for consumers: every slot is guarded by
+ * a sequence counter (seqlock), a consumer which is too slow detects the overwritten entries
+ * and counts them as overruns. New entries are signalled with a futex.
+ */
+#ifndef SRC_RESULT_BUS_H_
+#define SRC_RESULT_BUS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define RESULT_BUS_MAGIC 0x53554249 // "IBUS"
+#define RESULT_BUS_VERSION 1
+#define RESULT_BUS_PREFIX "/intuitus_bus_"
+#define RESULT_BUS_NAME_LEN 64
+#define RESULT_BUS_DEFAULT_SLOTS 16
+#define RESULT_BUS_DEFAULT_SLOT_SIZE (64 * 1024)
+#define RESULT_BUS_ALIGN 64
+
+// entry data formats
+#define RESULT_BUS_INT8 0
+#define RESULT_BUS_UINT8 1
+#define RESULT_BUS_FLOAT32 2
+
+#define RESULT_BUS_NO_DATA 1         // no new entry within the timeout
+#define ERROR_BUS_CLOSED (-14)       // producer closed the bus
+
+/**
+ * result_entry_meta -> metadata of a bus entry
+ * @sequence: bus sequence number, counts all published entries
+ * @frame: frame sequence number (camera / replay)
+ * @sensor_us: capture time of the frame (CLOCK_MONOTONIC)
+ * @publish_us: time of publication (CLOCK_MONOTONIC)
+ * @format: RESULT_BUS_INT8, RESULT_BUS_UINT8 or RESULT_BUS_FLOAT32
+ * @rows, @cols: shape of the data (e.g. detections x values)
+ * @size: bytes of data
+ */
+struct result_entry_meta
+{
+    uint64_t sequence;
+    uint64_t frame;
+    uint64_t sensor_us;
+    uint64_t publish_us;
+    int32_t format;
+    int32_t rows;
+    int32_t cols;
+    uint32_t size;
+};
+
+class Result_publisher
+{
+public:
+    Result_publisher(const char *name, int slots = RESULT_BUS_DEFAULT_SLOTS, int slot_size = RESULT_BUS_DEFAULT_SLOT_SIZE);
+    ~Result_publisher();
+
+    int publish(const void *data, uint32_t size, int format, int rows, int cols,
+                uint64_t frame, uint64_t sensor_us);
+    int publish_float(const float *values, int rows, int cols, uint64_t frame = 0, uint64_t sensor_us = 0);
+    int publish_bytes(const uint8_t *data, int size, uint64_t frame = 0, uint64_t sensor_us = 0, int format = RESULT_BUS_INT8);
+    uint64_t published();
+
+private:
+    std::string path;
+    struct result_bus_header *header = NULL;
+    size_t size = 0;
+    std::mutex lock; // threads of the producer process
+};
+
+class Result_subscriber
+{
+public:
+    Result_subscriber(const char *name);
+    ~Result_subscriber();
+
+    int latest();
+    int next(int timeout_ms = -1);
+    int seek_latest();
+    struct result_entry_meta last_meta();
+    const uint8_t *data();
+    void data_bytes(uint8_t **fmap_out, int *out_size);
+    int data_float(float **values, int *rows, int *cols);
+    uint64_t overruns();
+    int slots();
+    int slot_size();
+
+private:
+    struct result_bus_header *header = NULL;
+    size_t size = 0;
+    uint64_t next_sequence = 0;  // next entry to read by next
+    uint64_t lost = 0;           // entries overwritten before they were read
+    struct result_entry_meta meta;
+    std::vector<uint8_t> buffer; // copy of the last read entry
+
+    int read_entry(uint64_t sequence);
+};
+
+#endif /* SRC_RESULT_BUS_H_ */
@@ -0,0 +1,329 @@
+// Recordings of full HD streams exceed 2 GB
+#define _FILE_OFFSET_BITS 64
+
+#include "frame_record.hpp"
+#include "v4l_camera.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "arena.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+
+static inline off_t record_offset(uint32_t record_size, uint32_t index)
+{
+	return (off_t)FRAME_RECORD_ALIGN + (off_t)record_size * index;
+}
+
+Record_window::Record_window()
+{
+	this->base = NULL;
+	this->length = 0;
+	this->first = 0;
+	this->count = 0;
+}
+
+Record_window::~Record_window()
+{
+	unmap();
+}
+
+void Record_window::unmap()
+{
+	if (this->base != NULL)
+	{
+		munmap(this->base, this->length);
+		this->base = NULL;
+	}
+}
+
+/** map -> returns the address of a record. The window is moved if the record is not mapped.
+ * 		   Writable windows require the file to cover the whole window.
+ * @fd: file descriptor of the recording
+ * @writable: map for writing
+ * @record_size: size of a record (multiple of FRAME_RECORD_ALIGN)
+ * @index: record index
+ * @return: record address or NULL
+ */
+uint8_t *Record_window::map(int fd, bool writable, uint32_t record_size, uint32_t index)
+{
+	void *ptr;
+
+	if (this->base != NULL && index >= this->first && index < this->first + this->count)
+	{
+		return this->base + (size_t)record_size * (index - this->first);
+	}
+	unmap();
+	this->first = index - index % FRAME_RECORD_WINDOW;
+	this->count = FRAME_RECORD_WINDOW;
+	this->length = (size_t)record_size * this->count;
+	ptr = mmap(NULL, this->length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+			   fd, record_offset(record_size, this->first));
+	if (MAP_FAILED == ptr)
+	{
+		return NULL;
+	}
+	this->base = (uint8_t *)ptr;
+	return this->base + (size_t)record_size * (index - this->first);
+}
+
+/** Frame_recorder -> creates a new recording. An existing file is replaced.
+ * @path: file name of the recording
+ */
+Frame_recorder::Frame_recorder(const char *path)
+{
+	memset(&this->header, 0, sizeof(this->header));
+	this->header.magic = FRAME_RECORD_MAGIC;
+	this->header.version = FRAME_RECORD_VERSION;
+	this->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	CHECK_AND_THROW(this->fd != -1, ERROR_OTHER, "Failed to create recording.")
+	if (0 != ftruncate(this->fd, FRAME_RECORD_ALIGN) ||
+		sizeof(this->header) != pwrite(this->fd, &this->header, sizeof(this->header), 0))
+	{
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_OTHER, "Failed to write recording header.")
+	}
+}
+
+Frame_recorder::~Frame_recorder()
+{
+	close_record();
+}
+
+/** add_frame -> appends a frame. All frames of a recording must have the dimensions of the first one.
+ * @img_in: raw frame
+ * @sequence: frame sequence number
+ * @sensor_us: capture time stamp (CLOCK_MONOTONIC)
+ * @dequeue_us: time the frame was received by the application
+ */
+int Frame_recorder::add_frame(const uint8_t *img_in, int h_in, int w_in, int ci,
+							  uint32_t sequence, uint64_t sensor_us, uint64_t dequeue_us)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	struct frame_record_entry entry;
+	uint32_t frame_size = h_in * w_in * ci;
+	uint32_t index = this->header.frame_count;
+	uint8_t *record;
+
+	CHECK(this->fd != -1, ERROR_OTHER, "Recording is closed.")
+	if (0 == index)
+	{
+		this->header.width = w_in;
+		this->header.height = h_in;
+		this->header.channels = ci;
+		this->header.frame_size = frame_size;
+		this->header.record_size = (sizeof(entry) + frame_size + FRAME_RECORD_ALIGN - 1) & ~(FRAME_RECORD_ALIGN - 1);
+	}
+	CHECK((uint32_t)w_in == this->header.width && (uint32_t)h_in == this->header.height &&
+			  (uint32_t)ci == this->header.channels,
+		  ERROR_DIMENSION_MISMATCH, "Frame dimensions differ from the recording.")
+	// grow the file by a whole window before mapping it
+	if (0 == index % FRAME_RECORD_WINDOW)
+	{
+		CHECK(0 == ftruncate(this->fd, record_offset(this->header.record_size, index + FRAME_RECORD_WINDOW)),
+			  ERROR_MAX_MEMORY_LIMIT, "Failed to extend recording.")
+	}
+	record = this->window.map(this->fd, true, this->header.record_size, index);
+	CHECK(record != NULL, ERROR_MEMORY_ALLOC_FAIL, "Failed to map recording.")
+
+	memset(&entry, 0, sizeof(entry));
+	entry.sequence = sequence;
+	entry.frame_size = frame_size;
+	entry.sensor_us = sensor_us;
+	entry.dequeue_us = dequeue_us;
+	memcpy(record, &entry, sizeof(entry));
+	memcpy(record + sizeof(entry), img_in, frame_size);
+
+	// commit the record
+	this->header.frame_count++;
+	CHECK(sizeof(this->header) == pwrite(this->fd, &this->header, sizeof(this->header), 0),
+		  ERROR_OTHER, "Failed to update recording header.")
+	return 0;
+}
+
+/** record -> captures frames from a camera and appends them with their time stamps
+ * @cam: camera
+ * @frame_cnt: number of frames
+ */
+int Frame_recorder::record(Camera *cam, int frame_cnt)
+{
+	uint8_t *img;
+	int h, w, c, err;
+	struct frame_meta meta;
+
+	CHECK_NOT_NULL(cam, ERROR_NULL_POINTER_PARAMETER)
+	for (int i = 0; i < frame_cnt; i++)
+	{
+		CHECK(0 == cam->capture(&img, &h, &w, &c), ERROR_OTHER, "Failed to capture frame.")
+		meta = cam->last_frame_meta();
+		err = add_frame(img, h, w, c, meta.sequence, meta.sensor_us, meta.dequeue_us);
+		if (0 != err)
+		{
+			return err;
+		}
+	}
+	return 0;
+}
+
+int Frame_recorder::frames()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->header.frame_count;
+}
+
+/** close_record -> unmaps the recording and cuts the file to the committed records
+ */
+void Frame_recorder::close_record()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	if (this->fd == -1)
+	{
+		return;
+	}
+	this->window.unmap();
+	if (this->header.frame_count > 0 &&
+		0 != ftruncate(this->fd, record_offset(this->header.record_size, this->header.frame_count)))
+	{
+		log_warn(ERROR_OTHER, "Failed to truncate recording.");
+	}
+	close(this->fd);
+	this->fd = -1;
+}
+
+/** Frame_replay -> opens a recording as frame source with the interface of Camera
+ * @path: file name of the recording
+ * @realtime: serve frames at the recorded rate (1) or as fast as possible (0)
+ * @loop: restart at the first frame after the last one
+ */
+Frame_replay::Frame_replay(const char *path, int realtime, int loop)
+{
+	off_t file_size;
+
+	this->realtime = realtime != 0;
+	this->loop = loop != 0;
+	this->position = 0;
+	this->camdata = NULL;
+	this->tracker = NULL;
+	memset(&this->meta, 0, sizeof(this->meta));
+
+	this->fd = open(path, O_RDONLY);
+	CHECK_AND_THROW(this->fd != -1, ERROR_OTHER, "Failed to open recording.")
+	if (sizeof(this->header) != pread(this->fd, &this->header, sizeof(this->header), 0) ||
+		FRAME_RECORD_MAGIC != this->header.magic || FRAME_RECORD_VERSION != this->header.version ||
+		0 == this->header.frame_count ||
+		this->header.record_size < sizeof(struct frame_record_entry) + this->header.frame_size)
+	{
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_RECORD_FORMAT, "Invalid or empty recording.")
+	}
+	// the recording may be cut off if the recorder was not closed
+	file_size = lseek(this->fd, 0, SEEK_END);
+	while (this->header.frame_count > 0 &&
+		   record_offset(this->header.record_size, this->header.frame_count) > file_size)
+	{
+		this->header.frame_count--;
+	}
+	this->camdata = (uint8_t *)Host_arena::instance().acquire(this->header.frame_size);
+	if (this->camdata == NULL || 0 == this->header.frame_count)
+	{
+		Host_arena::instance().release(this->camdata);
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_MEMORY_ALLOC_FAIL, "Failed to set up replay.")
+	}
+}
+
+Frame_replay::~Frame_replay()
+{
+	this->window.unmap();
+	Host_arena::instance().release(this->camdata);
+	close(this->fd);
+}
+
+/** capture -> returns the next recorded frame. Time stamps are moved to the current monotonic
+ * 			   clock, so replayed frames can be tracked like live frames.
+ * @return: 0, FRAME_RECORD_END after the last frame or error code
+ */
+int Frame_replay::capture(uint8_t **img_out, int *h_out, int *w_out, int *co)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	struct frame_record_entry entry;
+	const uint8_t *record;
+	uint64_t now;
+
+	if (this->position >= this->header.frame_count)
+	{
+		if (!this->loop)
+		{
+			return FRAME_RECORD_END;
+		}
+		this->position = 0;
+	}
+	record = this->window.map(this->fd, false, this->header.record_size, this->position);
+	CHECK(record != NULL, ERROR_MEMORY_ALLOC_FAIL, "Failed to map recording.")
+	memcpy(&entry, record, sizeof(entry));
+
+	if (0 == this->position)
+	{
+		this->start_us = monotonic_us();
+		this->start_sensor_us = entry.sensor_us;
+	}
+	else if (this->realtime && entry.sensor_us > this->start_sensor_us)
+	{
+		uint64_t due = this->start_us + (entry.sensor_us - this->start_sensor_us);
+		struct timespec ts;
+		ts.tv_sec = due / 1000000;
+		ts.tv_nsec = (due % 1000000) * 1000;
+		while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+		{
+		}
+	}
+	memcpy(this->camdata, record + sizeof(entry), this->header.frame_size);
+	this->position++;
+
+	now = monotonic_us();
+	this->meta.sequence = entry.sequence;
+	this->meta.dequeue_us = now;
+	this->meta.sensor_us = now - (entry.dequeue_us > entry.sensor_us ? entry.dequeue_us - entry.sensor_us : 0);
+	if (this->tracker != NULL)
+	{
+		this->tracker->on_capture(this->meta.sequence, this->meta.sensor_us, this->meta.dequeue_us);
+	}
+	*img_out = this->camdata;
+	*h_out = this->header.height;
+	*w_out = this->header.width;
+	*co = this->header.channels;
+	return 0;
+}
+
+/** attach_tracker -> reports replayed frames to a latency tracker
+ */
+void Frame_replay::attach_tracker(Frame_tracker *tracker)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	this->tracker = tracker;
+}
+
+struct frame_meta Frame_replay::last_frame_meta()
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	return this->meta;
+}
+
+int Frame_replay::frames()
+{
+	return this->header.frame_count;
+}
+
+/** rewind -> restarts the replay at the first frame
+ */
+int Frame_replay::rewind()
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	this->position = 0;
+	return 0;
+}
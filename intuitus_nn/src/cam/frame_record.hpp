@@ -0,0 +1,113 @@
+/*
+ * frame_record.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Recording and replay of raw camera frames. A recording is an append-only container:
+ * one header page followed by page aligned records of equal size, each holding the
+ * frame time stamps and the raw frame. Records are accessed through mmapped windows.
+ */
+#ifndef SRC_FRAME_RECORD_H_
+#define SRC_FRAME_RECORD_H_
+
+#include <stdint.h>
+#include <mutex>
+
+#include "frame_tracker.hpp"
+
+class Camera;
+
+#define FRAME_RECORD_MAGIC 0x31524649 // "IFR1"
+#define FRAME_RECORD_VERSION 1
+#define FRAME_RECORD_ALIGN 4096 // header size and record alignment
+#define FRAME_RECORD_WINDOW 8   // records mapped at once
+#define FRAME_RECORD_END 1      // returned by capture after the last frame
+#define ERROR_RECORD_FORMAT (-11)
+
+struct frame_record_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t frame_size;
+    uint32_t record_size;
+    uint32_t frame_count; // committed records, updated after each frame
+};
+
+struct frame_record_entry
+{
+    uint32_t sequence;
+    uint32_t frame_size;
+    uint64_t sensor_us;
+    uint64_t dequeue_us;
+    uint64_t reserved;
+};
+
+/**
+ * Record_window -> mmapped window of FRAME_RECORD_WINDOW records of a recording
+ */
+class Record_window
+{
+public:
+    Record_window();
+    ~Record_window();
+    uint8_t *map(int fd, bool writable, uint32_t record_size, uint32_t index);
+    void unmap();
+
+private:
+    uint8_t *base;
+    size_t length;
+    uint32_t first;
+    uint32_t count;
+};
+
+class Frame_recorder
+{
+public:
+    Frame_recorder(const char *path);
+    ~Frame_recorder();
+
+    int add_frame(const uint8_t *img_in, int h_in, int w_in, int ci,
+                  uint32_t sequence, uint64_t sensor_us, uint64_t dequeue_us);
+    int record(Camera *cam, int frame_cnt);
+    int frames();
+    void close_record();
+
+private:
+    int fd;
+    struct frame_record_header header;
+    Record_window window;
+    std::mutex lock;
+};
+
+class Frame_replay
+{
+public:
+    Frame_replay(const char *path, int realtime = 1, int loop = 0);
+    ~Frame_replay();
+
+    int capture(uint8_t **img_out, int *h_out, int *w_out, int *co);
+    void attach_tracker(Frame_tracker *tracker);
+    struct frame_meta last_frame_meta();
+    int frames();
+    int rewind();
+
+private:
+    int fd;
+    bool realtime;
+    bool loop;
+    struct frame_record_header header;
+    Record_window window;
+    uint32_t position;
+    uint64_t start_us;        // monotonic time of the first replayed frame
+    uint64_t start_sensor_us; // recorded sensor time of the first replayed frame
+    uint8_t *camdata;
+    struct frame_meta meta;
+    Frame_tracker *tracker;
+    std::mutex capture_lock;
+};
+
+#endif /* SRC_FRAME_RECORD_H_ */
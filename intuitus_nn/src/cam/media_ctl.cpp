@@ -0,0 +1,161 @@
+#include "media_ctl.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <linux/media.h>
+#include <linux/v4l2-subdev.h>
+#include <iostream>
+
+static int xioctl(int fd, unsigned long request, void *arg)
+{
+	int r;
+	do
+	{
+		r = ioctl(fd, request, arg);
+	} while (-1 == r && EINTR == errno);
+	return r;
+}
+
+/** devnode_path -> resolves the device node of a char device using sysfs
+ * @major: device major number
+ * @minor: device minor number
+ * @path: resolved path (/dev/<DEVNAME>)
+ * @path_len: size of path
+ */
+static int devnode_path(uint32_t major, uint32_t minor, char *path, size_t path_len)
+{
+	char uevent[64];
+	char line[128];
+	FILE *f;
+	int found = 0;
+
+	snprintf(uevent, sizeof(uevent), "/sys/dev/char/%u:%u/uevent", major, minor);
+	f = fopen(uevent, "r");
+	if (f == NULL)
+	{
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		if (0 == strncmp(line, "DEVNAME=", 8))
+		{
+			line[strcspn(line, "\n")] = 0;
+			snprintf(path, path_len, "/dev/%s", line + 8);
+			found = 1;
+			break;
+		}
+	}
+	fclose(f);
+	return found ? 0 : -1;
+}
+
+/** media_find_subdev -> finds the subdevice node of a media entity
+ * @media_dev: media device (e.g. /dev/media0)
+ * @entity_name: entity name as reported by media-ctl -p
+ * @subdev_path: subdevice node of the entity (e.g. /dev/v4l-subdev0)
+ * @path_len: size of subdev_path
+ */
+int media_find_subdev(const char *media_dev, const char *entity_name, char *subdev_path, size_t path_len)
+{
+	struct media_entity_desc entity;
+	int fd, err = -1;
+
+	fd = open(media_dev, O_RDWR);
+	if (fd == -1)
+	{
+		std::cout << "Failed to open media device " << media_dev << std::endl;
+		return -1;
+	}
+
+	memset(&entity, 0, sizeof(entity));
+	entity.id = MEDIA_ENT_ID_FLAG_NEXT;
+	while (0 == xioctl(fd, MEDIA_IOC_ENUM_ENTITIES, &entity))
+	{
+		if (0 == strncmp(entity.name, entity_name, sizeof(entity.name)))
+		{
+			err = devnode_path(entity.dev.major, entity.dev.minor, subdev_path, path_len);
+			break;
+		}
+		entity.id |= MEDIA_ENT_ID_FLAG_NEXT;
+	}
+	close(fd);
+	if (0 != err)
+	{
+		std::cout << "Media entity not found: " << entity_name << std::endl;
+	}
+	return err;
+}
+
+/** subdev_set_format -> sets the active media bus format of a subdevice pad
+ * @subdev_path: subdevice node
+ * @pad: pad number
+ * @code: media bus format code (MEDIA_BUS_FMT_*)
+ * @width: frame width
+ * @height: frame height
+ */
+int subdev_set_format(const char *subdev_path, uint32_t pad, uint32_t code, uint32_t width, uint32_t height)
+{
+	struct v4l2_subdev_format fmt;
+	int fd, err;
+
+	fd = open(subdev_path, O_RDWR);
+	if (fd == -1)
+	{
+		std::cout << "Failed to open subdevice " << subdev_path << std::endl;
+		return -1;
+	}
+	memset(&fmt, 0, sizeof(fmt));
+	fmt.which = V4L2_SUBDEV_FORMAT_ACTIVE;
+	fmt.pad = pad;
+	fmt.format.code = code;
+	fmt.format.width = width;
+	fmt.format.height = height;
+	fmt.format.field = V4L2_FIELD_NONE;
+	err = xioctl(fd, VIDIOC_SUBDEV_S_FMT, &fmt);
+	close(fd);
+	if (-1 == err)
+	{
+		std::cout << "Failed to set format on " << subdev_path << " pad " << pad << std::endl;
+		return -1;
+	}
+	if (fmt.format.width != width || fmt.format.height != height)
+	{
+		std::cout << subdev_path << " adjusted format to " << fmt.format.width << "x" << fmt.format.height << std::endl;
+	}
+	return 0;
+}
+
+/** subdev_set_frame_interval -> sets the frame interval of a subdevice pad
+ * @subdev_path: subdevice node
+ * @pad: pad number
+ * @numerator: frame interval numerator (1 for numerator / fps)
+ * @denominator: frame interval denominator
+ */
+int subdev_set_frame_interval(const char *subdev_path, uint32_t pad, uint32_t numerator, uint32_t denominator)
+{
+	struct v4l2_subdev_frame_interval ival;
+	int fd, err;
+
+	fd = open(subdev_path, O_RDWR);
+	if (fd == -1)
+	{
+		std::cout << "Failed to open subdevice " << subdev_path << std::endl;
+		return -1;
+	}
+	memset(&ival, 0, sizeof(ival));
+	ival.pad = pad;
+	ival.interval.numerator = numerator;
+	ival.interval.denominator = denominator;
+	err = xioctl(fd, VIDIOC_SUBDEV_S_FRAME_INTERVAL, &ival);
+	close(fd);
+	if (-1 == err)
+	{
+		std::cout << "Failed to set frame interval on " << subdev_path << std::endl;
+		return -1;
+	}
+	return 0;
+}
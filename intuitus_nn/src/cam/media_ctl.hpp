@@ -0,0 +1,25 @@
+/*
+ * media_ctl.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Minimal media controller helpers. Replaces the media-ctl calls used to configure the
+ * pad formats of the camera pipeline by direct media and subdevice ioctls.
+ */
+#ifndef SRC_MEDIA_CTL_H_
+#define SRC_MEDIA_CTL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MEDIA_DEVICE "/dev/media0"
+#define MEDIA_ENTITY_SENSOR "ov5640 2-003c"
+#define MEDIA_ENTITY_MIPI_CSI "43c40000.mipi_csi2_rx_subsystem"
+#define MEDIA_SUBDEV_PATH_LEN 64
+
+int media_find_subdev(const char *media_dev, const char *entity_name, char *subdev_path, size_t path_len);
+int subdev_set_format(const char *subdev_path, uint32_t pad, uint32_t code, uint32_t width, uint32_t height);
+int subdev_set_frame_interval(const char *subdev_path, uint32_t pad, uint32_t numerator, uint32_t denominator);
+
+#endif /* SRC_MEDIA_CTL_H_ */
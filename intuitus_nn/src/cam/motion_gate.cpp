@@ -0,0 +1,204 @@
+#include "motion_gate.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <chrono>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MOTION_GATE_NEON
+#endif
+
+#define MOTION_BLOCK_PIXELS (2 * MOTION_BLOCK_SAMPLES)
+#define MOTION_BLOCK_ROWS (MOTION_SAMPLE_ROWS * MOTION_BLOCK_LINES)
+
+static inline uint64_t now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** block_sad -> samples the luma of one block into cur and returns its sum of absolute differences to ref
+ * @src: first UYVY pixel of the block
+ * @src_stride: bytes between sampled lines
+ * @ref, @cur: first sample of the block in the luma grids, NULL ref only samples the block
+ * @grid_stride: samples per grid line
+ */
+static uint32_t block_sad(const uint8_t *src, int src_stride, const uint8_t *ref, uint8_t *cur, int grid_stride)
+{
+#ifdef MOTION_GATE_NEON
+	uint16x8_t acc = vdupq_n_u16(0);
+	for (int l = 0; l < MOTION_BLOCK_LINES; l++)
+	{
+		// U Y0 V Y1: val[1] holds the luma of the first pixel of 16 pixel pairs
+		uint8x16_t y = vld4q_u8(src).val[1];
+		vst1q_u8(cur, y);
+		if (ref != NULL)
+		{
+			acc = vpadalq_u8(acc, vabdq_u8(y, vld1q_u8(ref)));
+			ref += grid_stride;
+		}
+		src += src_stride;
+		cur += grid_stride;
+	}
+	uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(acc));
+	return (uint32_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+#else
+	uint32_t sad = 0;
+	for (int l = 0; l < MOTION_BLOCK_LINES; l++)
+	{
+		for (int i = 0; i < MOTION_BLOCK_SAMPLES; i++)
+		{
+			uint8_t y = src[4 * i + 1];
+			cur[i] = y;
+			if (ref != NULL)
+			{
+				sad += y > ref[i] ? y - ref[i] : ref[i] - y;
+			}
+		}
+		if (ref != NULL)
+		{
+			ref += grid_stride;
+		}
+		src += src_stride;
+		cur += grid_stride;
+	}
+	return sad;
+#endif
+}
+
+/** Motion_gate -> change detector for camera frames
+ * @threshold: mean absolute luma difference (0..255) of a changed block
+ * @min_blocks: changed blocks which trigger an inference
+ * @max_interval_ms: maximum time between inferences, 0 to infer on changes only
+ */
+Motion_gate::Motion_gate(int threshold, int min_blocks, uint32_t max_interval_ms)
+{
+	this->threshold = threshold;
+	this->min_blocks = min_blocks;
+	this->max_interval_ms = max_interval_ms;
+	memset(&this->stats, 0, sizeof(this->stats));
+}
+
+/** check -> decides whether a frame has to be passed to the network
+ * 			 A frame which triggers an inference becomes the reference of the following frames.
+ * 			 Pixels right and below the last full block of 32x32 pixels are not checked.
+ * @img_in: camera frame [h_in, w_in, 2] (UYVY)
+ * @return: MOTION_INFER, MOTION_SKIP or an error code
+ */
+int Motion_gate::check(const uint8_t *img_in, int h_in, int w_in, int ci)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	uint64_t start = now_us();
+	int blocks_x = w_in / MOTION_BLOCK_PIXELS;
+	int blocks_y = h_in / MOTION_BLOCK_ROWS;
+	int grid_w = blocks_x * MOTION_BLOCK_SAMPLES;
+	int grid_h = blocks_y * MOTION_BLOCK_LINES;
+	int src_stride = w_in * 2 * MOTION_SAMPLE_ROWS;
+	uint32_t changed = 0, max_diff = 0;
+	bool motion, interval;
+
+	CHECK(ci == 2, ERROR_DIMENSION_MISMATCH, "Motion gate expects UYVY frames.")
+	CHECK(blocks_x > 0 && blocks_y > 0, ERROR_DIMENSION_MISMATCH, "Frame smaller than a motion block.")
+	if (grid_w != this->grid_w || grid_h != this->grid_h)
+	{
+		this->grid_w = grid_w;
+		this->grid_h = grid_h;
+		this->reference.assign((size_t)grid_w * grid_h, 0);
+		this->current.assign((size_t)grid_w * grid_h, 0);
+		this->has_reference = false;
+	}
+
+	for (int by = 0; by < blocks_y; by++)
+	{
+		for (int bx = 0; bx < blocks_x; bx++)
+		{
+			size_t grid_offset = (size_t)by * MOTION_BLOCK_LINES * grid_w + bx * MOTION_BLOCK_SAMPLES;
+			uint32_t sad = block_sad(img_in + (size_t)by * MOTION_BLOCK_LINES * src_stride + bx * MOTION_BLOCK_PIXELS * 2, src_stride,
+									 this->has_reference ? this->reference.data() + grid_offset : NULL,
+									 this->current.data() + grid_offset, grid_w);
+			uint32_t diff = sad / (MOTION_BLOCK_SAMPLES * MOTION_BLOCK_LINES);
+			changed += (diff >= (uint32_t)this->threshold);
+			max_diff = diff > max_diff ? diff : max_diff;
+		}
+	}
+
+	motion = this->has_reference && changed >= (uint32_t)this->min_blocks;
+	interval = !this->has_reference ||
+			   (this->max_interval_ms > 0 && start - this->reference_us >= (uint64_t)this->max_interval_ms * 1000);
+	this->stats.frames++;
+	this->stats.changed_blocks = changed;
+	this->stats.max_block_diff = max_diff;
+	if (motion || interval)
+	{
+		this->reference.swap(this->current);
+		this->has_reference = true;
+		this->reference_us = start;
+		this->stats.inferences++;
+		if (motion)
+		{
+			this->stats.motion_triggers++;
+		}
+		else
+		{
+			this->stats.interval_triggers++;
+		}
+	}
+	else
+	{
+		this->stats.skipped++;
+	}
+	this->stats.check_us += now_us() - start;
+	return (motion || interval) ? MOTION_INFER : MOTION_SKIP;
+}
+
+/** set_threshold -> sensitivity of the change detection
+ * @threshold: mean absolute luma difference (0..255) of a changed block
+ * @min_blocks: changed blocks which trigger an inference
+ */
+int Motion_gate::set_threshold(int threshold, int min_blocks)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(threshold >= 0 && threshold <= 255 && min_blocks > 0, ERROR_OTHER, "Invalid motion threshold.")
+	this->threshold = threshold;
+	this->min_blocks = min_blocks;
+	return 0;
+}
+
+/** set_max_interval -> maximum time between inferences
+ * @max_interval_ms: 0 to infer on changes only
+ */
+int Motion_gate::set_max_interval(uint32_t max_interval_ms)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	this->max_interval_ms = max_interval_ms;
+	return 0;
+}
+
+/** reset -> drops the reference, the next frame triggers an inference
+ */
+void Motion_gate::reset()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	this->has_reference = false;
+}
+
+/** get_stats -> returns the decisions of the gate
+ */
+struct motion_gate_stats Motion_gate::get_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	return this->stats;
+}
+
+/** reset_stats -> clears the statistics
+ */
+void Motion_gate::reset_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	memset(&this->stats, 0, sizeof(this->stats));
+}
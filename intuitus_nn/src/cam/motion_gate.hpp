@@ -0,0 +1,79 @@
+/*
+ * motion_gate.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Change detector for camera frames (UYVY). Decides whether a frame has to be passed to the
+ * network or whether the results of the last inference can be reused. The luma of every second
+ * pixel of every fourth line is compared to the frame of the last inference in blocks of
+ * 32x32 pixels (NEON on ARM). A frame triggers an inference if enough blocks changed by more
+ * than the threshold (mean absolute difference) or if the maximum interval has elapsed.
+ */
+#ifndef SRC_MOTION_GATE_H_
+#define SRC_MOTION_GATE_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+#define MOTION_SAMPLE_ROWS 4                // line step of the luma grid
+#define MOTION_BLOCK_SAMPLES 16             // luma samples per block and line (32 pixels)
+#define MOTION_BLOCK_LINES 8                // sampled lines per block (32 lines)
+#define MOTION_DEFAULT_THRESHOLD 12         // mean absolute luma difference of a changed block
+#define MOTION_DEFAULT_MIN_BLOCKS 1         // changed blocks which trigger an inference
+#define MOTION_DEFAULT_MAX_INTERVAL_MS 1000 // inference at least once per interval, 0 to disable
+
+#define MOTION_SKIP 0
+#define MOTION_INFER 1
+
+/**
+ * motion_gate_stats -> decisions of the motion gate
+ * @frames: checked frames
+ * @inferences: frames passed to the network
+ * @skipped: frames whose inference was skipped
+ * @motion_triggers: inferences triggered by changed blocks
+ * @interval_triggers: inferences triggered by the maximum interval (or the first frame)
+ * @changed_blocks: changed blocks of the last frame
+ * @max_block_diff: largest mean absolute difference of a block in the last frame
+ * @check_us: accumulated time of the change detection
+ */
+struct motion_gate_stats
+{
+    uint64_t frames;
+    uint64_t inferences;
+    uint64_t skipped;
+    uint64_t motion_triggers;
+    uint64_t interval_triggers;
+    uint32_t changed_blocks;
+    uint32_t max_block_diff;
+    uint64_t check_us;
+};
+
+class Motion_gate
+{
+public:
+    Motion_gate(int threshold = MOTION_DEFAULT_THRESHOLD, int min_blocks = MOTION_DEFAULT_MIN_BLOCKS,
+                uint32_t max_interval_ms = MOTION_DEFAULT_MAX_INTERVAL_MS);
+
+    int check(const uint8_t *img_in, int h_in, int w_in, int ci);
+    int set_threshold(int threshold, int min_blocks);
+    int set_max_interval(uint32_t max_interval_ms);
+    void reset();
+    struct motion_gate_stats get_stats();
+    void reset_stats();
+
+private:
+    int threshold;
+    int min_blocks;
+    uint32_t max_interval_ms;
+    int grid_w = 0, grid_h = 0;     // luma grid of the reference frame
+    std::vector<uint8_t> reference; // luma grid of the frame of the last inference
+    std::vector<uint8_t> current;
+    bool has_reference = false;
+    uint64_t reference_us = 0;
+    struct motion_gate_stats stats;
+    std::mutex lock;
+};
+
+#endif /* SRC_MOTION_GATE_H_ */
@@ -9,8 +9,13 @@
 #include <iostream>
 #include <fstream>
 #include <linux/videodev2.h>
+#include <linux/media-bus-format.h>
 #include <opencv2/opencv.hpp>
 
+#include "arena.hpp"
+#include "realtime.hpp"
+#include "probes.hpp"
+
 static int xioctl(int fd, unsigned int request, void *arg)
 {
 	int r;
@@ -23,23 +28,64 @@ static int xioctl(int fd, unsigned int request, void *arg)
 
 Camera::Camera(const char *dev)
 {
-// 0. Initialize Camera sensor and Mipi-CSI submodule
-#ifdef DEBUG
-	std::cout << MEDIA_INIT_OV5640 << std::endl;
-	std::cout << MEDIA_INIT_MIPI_CSI_SUBMODULE << std::endl;
-#endif
-	if (system(MEDIA_INIT_OV5640) != 0)
+	init(dev, WIDTH, HEIGHT, FPS);
+}
+
+/** Camera -> opens the camera with a runtime selected capture format
+ * @dev: video device (e.g. /dev/video0)
+ * @width: frame width
+ * @height: frame height
+ * @fps: frame rate of the sensor
+ */
+Camera::Camera(const char *dev, int width, int height, int fps)
+{
+	init(dev, width, height, fps);
+}
+
+/** configure_pipeline -> sets the pad formats of camera sensor and Mipi-CSI submodule
+ * 						  using media controller and subdevice ioctls
+ */
+int Camera::configure_pipeline()
+{
+	char subdev[MEDIA_SUBDEV_PATH_LEN];
+	int err = 0;
+
+	this->sensor_subdev[0] = 0;
+	if (0 != media_find_subdev(MEDIA_DEVICE, MEDIA_ENTITY_SENSOR, subdev, sizeof(subdev)) ||
+		0 != subdev_set_format(subdev, 0, MEDIA_BUS_FMT_UYVY8_1X16, this->width, this->height) ||
+		0 != subdev_set_frame_interval(subdev, 0, 1, this->fps))
 	{
-		std::cout << "Failed to initialize camera sensor using command:" << std::endl;
-		std::cout << MEDIA_INIT_OV5640 << std::endl;
+		std::cout << "Failed to initialize camera sensor " << MEDIA_ENTITY_SENSOR << std::endl;
+		err = -1;
 	}
-	if (system(MEDIA_INIT_MIPI_CSI_SUBMODULE) != 0)
+	else
 	{
-		std::cout << "Failed to initialize MIPI-CSI module using command:" << std::endl;
-		std::cout << MEDIA_INIT_MIPI_CSI_SUBMODULE << std::endl;
+		strncpy(this->sensor_subdev, subdev, sizeof(this->sensor_subdev));
 	}
+#ifdef DEBUG
+	std::cout << "Sensor subdevice: " << subdev << std::endl;
+#endif
+	if (0 != media_find_subdev(MEDIA_DEVICE, MEDIA_ENTITY_MIPI_CSI, subdev, sizeof(subdev)) ||
+		0 != subdev_set_format(subdev, 0, MEDIA_BUS_FMT_UYVY8_1X16, this->width, this->height))
+	{
+		std::cout << "Failed to initialize MIPI-CSI module " << MEDIA_ENTITY_MIPI_CSI << std::endl;
+		err = -1;
+	}
+	return err;
+}
+
+void Camera::init(const char *dev, int width, int height, int fps)
+{
+	this->width = width;
+	this->height = height;
+	this->fps = fps;
+	this->streaming = false;
+	this->tracker = NULL;
+	memset(&this->meta, 0, sizeof(this->meta));
+	// 0. Initialize Camera sensor and Mipi-CSI submodule
+	configure_pipeline();
 	// 1. Open Video Device.
-	this->fd = open("/dev/video0", O_RDWR, 0);
+	this->fd = open(dev, O_RDWR, 0);
 	if (this->fd == -1)
 	{
 		std::cout << "Failed to open video device." << std::endl;
@@ -61,29 +107,69 @@ Camera::Camera(const char *dev)
 	std::cout << "version	: " << caps.version << std::endl;
 #endif
 	// 3. Format Specification.
+	if (0 != set_format(this->width, this->height))
 	{
-		struct v4l2_format fmt;
-		memset(&(fmt), 0, sizeof(fmt));
+		std::cout << "Failed to set pixel format." << std::endl;
+		exit(1);
+	}
+	// crop rectangles have to fit into the negotiated format
+	this->format_width = this->width;
+	this->format_height = this->height;
+	// 4. Request Buffer, 5. Query Buffer
+	if (0 != map_buffers())
+	{
+		exit(1);
+	}
 
-		fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-		fmt.fmt.pix_mp.width = WIDTH;
-		fmt.fmt.pix_mp.height = HEIGHT;
-		fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_UYVY;
-		fmt.fmt.pix_mp.field = V4L2_FIELD_NONE;
+	this->camdata = (uint8_t *)Host_arena::instance().acquire(this->width * this->height * 2 * sizeof(uint8_t));
+	if (this->camdata == NULL)
+	{
+		std::cout << "Fail allocate memory for cam data.";
+		exit(1);
+	}
+}
 
-		if (-1 == xioctl(this->fd, VIDIOC_S_FMT, &fmt))
-		{
-			std::cout << "Failed to set pixel format." << std::endl;
-			exit(1);
-		}
+/** set_format -> sets the UYVY capture format and reads back the size chosen by the driver
+ * 				 (width, height and line stride of the buffers). Not while streaming.
+ */
+int Camera::set_format(int width, int height)
+{
+	struct v4l2_format fmt;
+	memset(&(fmt), 0, sizeof(fmt));
+
+	fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	fmt.fmt.pix_mp.width = width;
+	fmt.fmt.pix_mp.height = height;
+	fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_UYVY;
+	fmt.fmt.pix_mp.field = V4L2_FIELD_NONE;
+
+	if (-1 == xioctl(this->fd, VIDIOC_S_FMT, &fmt) || -1 == xioctl(this->fd, VIDIOC_G_FMT, &fmt))
+	{
+		return 1;
+	}
+	// the driver may adjust the format
+	this->width = fmt.fmt.pix_mp.width;
+	this->height = fmt.fmt.pix_mp.height;
+	this->bytesperline = fmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+	if (this->bytesperline < this->width * 2)
+	{
+		this->bytesperline = this->width * 2;
+	}
 #ifdef DEBUG
-		std::cout << "Video Format: " << std::endl;
-		std::cout << fmt.fmt.pix_mp.width << std::endl;
-		std::cout << fmt.fmt.pix_mp.height << std::endl;
-		std::cout << fmt.fmt.pix_mp.pixelformat << std::endl;
-		std::cout << fmt.fmt.pix_mp.field << std::endl;
+	std::cout << "Video Format: " << std::endl;
+	std::cout << fmt.fmt.pix_mp.width << std::endl;
+	std::cout << fmt.fmt.pix_mp.height << std::endl;
+	std::cout << fmt.fmt.pix_mp.pixelformat << std::endl;
+	std::cout << fmt.fmt.pix_mp.field << std::endl;
+	std::cout << fmt.fmt.pix_mp.plane_fmt[0].bytesperline << std::endl;
 #endif
-	}
+	return 0;
+}
+
+/** map_buffers -> requests the capture buffers of the current format and maps them
+ */
+int Camera::map_buffers()
+{
 	struct v4l2_requestbuffers reqbuf;
 	const int MAX_BUF_COUNT = 2; /*we want at least 3 buffers*/
 
@@ -97,16 +183,17 @@ Camera::Camera(const char *dev)
 		if (-1 == xioctl(this->fd, VIDIOC_REQBUFS, &reqbuf))
 		{
 			std::cout << "Failed to request buffer." << std::endl;
-			exit(1);
+			return 1;
 		}
 		if (reqbuf.count < MAX_BUF_COUNT)
 		{
 			std::cout << "Not enought buffer memory." << std::endl;
-			exit(1);
+			return 1;
 		}
 #ifdef DEBUG
 		std::cout << "reqbuf.count : " << reqbuf.count << std::endl;
 #endif
+		this->num_buffers = reqbuf.count;
 		this->buffers = (buffer_addr_struct_t *)calloc(reqbuf.count, sizeof(*(this->buffers)));
 		assert(this->buffers != NULL);
 	}
@@ -128,7 +215,7 @@ Camera::Camera(const char *dev)
 			if (-1 == xioctl(this->fd, VIDIOC_QUERYBUF, &buf))
 			{
 				std::cout << "Failed to query buffer." << std::endl;
-				exit(1);
+				return 1;
 			}
 			this->num_planes = buf.length;
 #ifdef DEBUG
@@ -153,46 +240,103 @@ Camera::Camera(const char *dev)
 			}
 		}
 	}
+	return 0;
+}
 
-	this->camdata = (uint8_t *)malloc(WIDTH * HEIGHT * 2 * sizeof(uint8_t));
-	if (this->camdata == NULL)
+/** unmap_buffers -> unmaps and frees the capture buffers. Not while streaming.
+ */
+void Camera::unmap_buffers()
+{
+	struct v4l2_requestbuffers reqbuf;
+
+	for (int i = 0; i < this->num_buffers; i++)
 	{
-		std::cout << "Fail allocate memory for cam data.";
-		exit(1);
+		for (int j = 0; j < this->num_planes; j++)
+		{
+			if (MAP_FAILED != this->buffers[i].start[j] && NULL != this->buffers[i].start[j])
+			{
+				munmap(this->buffers[i].start[j], this->buffers[i].length[j]);
+			}
+		}
 	}
+	free(this->buffers);
+	this->buffers = NULL;
+	this->num_buffers = 0;
+	memset(&(reqbuf), 0, sizeof(reqbuf));
+	reqbuf.count = 0;
+	reqbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	reqbuf.memory = V4L2_MEMORY_MMAP;
+	xioctl(this->fd, VIDIOC_REQBUFS, &reqbuf);
 }
-int Camera::capture(uint8_t **img_out, int *h_out, int *w_out, int *co)
+/** start_streaming -> queues all buffers and starts streaming. The camera keeps streaming between captures
+ * 						so the V4L2 sequence numbers reveal frames dropped by the pipeline.
+ */
+int Camera::start_streaming()
 {
-	// 6. Start Streaming
+	struct v4l2_buffer buf;
+	struct v4l2_plane planes[FMT_NUM_PLANES];
+
+	for (int i = 0; i < this->num_buffers; i++)
 	{
-		//struct 	v4l2_buffer buf;
-		struct v4l2_buffer buf;
-		memset(&(buf), 0, sizeof(buf));
+		memset(&buf, 0, sizeof(buf));
+		memset(planes, 0, sizeof(planes));
 		buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
-		if (-1 == xioctl(fd, VIDIOC_STREAMON, &buf.type))
+		buf.memory = V4L2_MEMORY_MMAP;
+		buf.index = i;
+		buf.m.planes = planes;
+		buf.length = FMT_NUM_PLANES;
+		if (-1 == xioctl(this->fd, VIDIOC_QBUF, &buf))
 		{
-			std::cout << "Fail to start Capture" << std::endl;
-			exit(1);
+			std::cout << "VIDIOC_QBUF" << std::endl;
+			return 1;
 		}
 	}
+	buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	if (-1 == xioctl(this->fd, VIDIOC_STREAMON, &buf.type))
+	{
+		std::cout << "Fail to start Capture" << std::endl;
+		return 1;
+	}
+	this->streaming = true;
+	return 0;
+}
+
+/** stop_streaming -> stops streaming, all buffers are returned to the application
+ */
+void Camera::stop_streaming()
+{
+	int type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+
+	if (!this->streaming)
+	{
+		return;
+	}
+	if (-1 == xioctl(this->fd, VIDIOC_STREAMOFF, &type))
+	{
+		std::cout << "VIDIOC_STREAMOFF" << std::endl;
+	}
+	this->streaming = false;
+}
+
+int Camera::capture(uint8_t **img_out, int *h_out, int *w_out, int *co)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	// 6. Start Streaming
+	if (!this->streaming && 0 != start_streaming())
+	{
+		return 1;
+	}
 	struct v4l2_buffer buf;
+	struct v4l2_plane planes[FMT_NUM_PLANES];
+	memset(&buf, 0, sizeof(buf));
 	buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE; //V4L2_BUF_TYPE_VIDEO_CAPTURE;
 	buf.memory = V4L2_MEMORY_MMAP;
-	buf.index = 0;
-	struct v4l2_plane planes[FMT_NUM_PLANES];
 	buf.m.planes = planes;
 	buf.length = FMT_NUM_PLANES;
 
 	// 7. Capture Image
+	INTUITUS_PROBE0(capture_start);
 	{
-		// Connect buffer to queue for next capture.
-		if (-1 == xioctl(this->fd, VIDIOC_QBUF, &buf))
-		{
-			std::cout << "VIDIOC_QBUF" << std::endl;
-		}
-#ifdef DEBUG
-		std::cout << "Queue buffer done " << std::endl;
-#endif
 		fd_set fds;
 		FD_ZERO(&fds);
 		FD_SET(this->fd, &fds);
@@ -200,7 +344,7 @@ int Camera::capture(uint8_t **img_out, int *h_out, int *w_out, int *co)
 		tv.tv_sec = 2;
 		int r = select(this->fd + 1, &fds, NULL, NULL, &tv);
 
-		if (-1 == r)
+		if (r <= 0)
 		{
 			std::cout << "Waiting for Frame" << std::endl;
 			return 1;
@@ -212,34 +356,225 @@ int Camera::capture(uint8_t **img_out, int *h_out, int *w_out, int *co)
 			return 1;
 		}
 	}
-	// 8. Store Image
+	INTUITUS_PROBE2(capture_dqbuf, buf.sequence, buf.m.planes[0].bytesused);
+	// 8. Store Image and time stamps
+	this->meta.sequence = buf.sequence;
+	this->meta.dequeue_us = monotonic_us();
+	if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+	{
+		this->meta.sensor_us = (uint64_t)buf.timestamp.tv_sec * 1000000ULL + buf.timestamp.tv_usec;
+	}
+	else
+	{
+		// time stamp not on the monotonic clock
+		this->meta.sensor_us = this->meta.dequeue_us;
+	}
 #ifdef DEBUG
 	std::cout << "Copy received image" << std::endl;
 	std::cout << "Plane number: " << num_planes << std::endl;
 #endif
 	{
-		for (int j = 0; j < this->num_planes; j++)
+		// UYVY is a single plane format, lines may be padded to bytesperline
+		const uint8_t *src = (const uint8_t *)buffers[buf.index].start[0];
+		size_t line = (size_t)this->width * 2;
+		if ((size_t)this->bytesperline == line)
+		{
+			memcpy(this->camdata, src, line * this->height);
+		}
+		else
 		{
-			memcpy(this->camdata, buffers[0].start[j], WIDTH * HEIGHT * 2);
+			for (int y = 0; y < this->height; y++)
+			{
+				memcpy(this->camdata + y * line, src + (size_t)y * this->bytesperline, line);
+			}
 		}
 		//memcpy(bayerRaw.data, buffer, WIDTH * HEIGHT);
 		//cv::cvtColor(bayerRaw, color, CV_BayerGB2BGR);
 	}
-	// 10. Turn off streaming.
-	if (-1 == xioctl(fd, VIDIOC_STREAMOFF, &buf.type))
+	// 9. Give the buffer back to the driver for the next frames
+	if (-1 == xioctl(this->fd, VIDIOC_QBUF, &buf))
 	{
-		std::cout << "VIDIOC_STREAMOFF" << std::endl;
+		std::cout << "VIDIOC_QBUF" << std::endl;
+	}
+	INTUITUS_PROBE2(capture_qbuf, this->meta.sequence, this->width * this->height * 2);
+	if (this->tracker != NULL)
+	{
+		this->tracker->on_capture(this->meta.sequence, this->meta.sensor_us, this->meta.dequeue_us);
 	}
 	*img_out = this->camdata;
 	*co = 2;
-	*h_out = HEIGHT;
-	*w_out = WIDTH;
+	*h_out = this->height;
+	*w_out = this->width;
+	return 0;
+}
+
+/** attach_tracker -> reports captured frames to a latency tracker
+ * @tracker: tracker, NULL to detach. Must outlive the camera or be detached.
+ */
+void Camera::attach_tracker(Frame_tracker *tracker)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	this->tracker = tracker;
+}
+
+/** prefault -> maps the capture buffers and the frame copy before the first capture (real-time mode)
+ */
+int Camera::prefault()
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+
+	for (int i = 0; i < this->num_buffers; i++)
+	{
+		for (int j = 0; j < this->num_planes; j++)
+		{
+			if (MAP_FAILED != this->buffers[i].start[j] && NULL != this->buffers[i].start[j])
+			{
+				rt_prefault(this->buffers[i].start[j], this->buffers[i].length[j], 0);
+			}
+		}
+	}
+	rt_prefault(this->camdata, (size_t)this->width * this->height * 2, 1);
+	return 0;
+}
+
+/** last_frame_meta -> returns sequence number, sensor and dequeue time of the last captured frame
+ */
+struct frame_meta Camera::last_frame_meta()
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	return this->meta;
+}
+
+/** set_crop -> selects a region of the sensor frame (VIDIOC_S_SELECTION). The capture format and buffers
+ * 				are negotiated again for the crop rectangle as adjusted by the driver, captured frames have
+ * 				its size. The rectangle has to fit into the format the camera was opened with, cropping
+ * 				to the full format restores the original frame size.
+ * @left: left edge of the crop rectangle
+ * @top: top edge of the crop rectangle
+ * @width: width of the crop rectangle
+ * @height: height of the crop rectangle
+ */
+int Camera::set_crop(int left, int top, int width, int height)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+	struct v4l2_selection sel, prev;
+	bool was_streaming = this->streaming;
+	int prev_width = this->width, prev_height = this->height;
+	uint8_t *camdata;
+
+	if (left < 0 || top < 0 || width <= 0 || height <= 0 ||
+		left + width > this->format_width || top + height > this->format_height)
+	{
+		std::cout << "Crop rectangle exceeds capture format." << std::endl;
+		return 1;
+	}
+	// the selection, format and buffers can not be changed while streaming
+	stop_streaming();
+	memset(&prev, 0, sizeof(prev));
+	prev.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	prev.target = V4L2_SEL_TGT_CROP;
+	if (-1 == xioctl(this->fd, VIDIOC_G_SELECTION, &prev))
+	{
+		// no crop rectangle yet: the full format
+		prev.r.left = 0;
+		prev.r.top = 0;
+		prev.r.width = this->format_width;
+		prev.r.height = this->format_height;
+	}
+	sel = prev;
+	sel.r.left = left;
+	sel.r.top = top;
+	sel.r.width = width;
+	sel.r.height = height;
+	if (-1 == xioctl(this->fd, VIDIOC_S_SELECTION, &sel))
+	{
+		std::cout << "Failed to set crop rectangle." << std::endl;
+		if (was_streaming)
+		{
+			start_streaming();
+		}
+		return 1;
+	}
+
+	// buffers of the old format are released before the new format is set
+	unmap_buffers();
+	if (0 != set_format(sel.r.width, sel.r.height) || 0 != map_buffers())
+	{
+		std::cout << "Failed to set capture format of crop rectangle." << std::endl;
+		restore_capture(prev.r, prev_width, prev_height, was_streaming);
+		return 1;
+	}
+	// the old frame buffer is kept until the new one exists
+	camdata = (uint8_t *)Host_arena::instance().acquire((size_t)this->width * this->height * 2);
+	if (camdata == NULL)
+	{
+		std::cout << "Fail allocate memory for cam data." << std::endl;
+		restore_capture(prev.r, prev_width, prev_height, was_streaming);
+		return 1;
+	}
+	Host_arena::instance().release(this->camdata);
+	this->camdata = camdata;
+	if (was_streaming && 0 != start_streaming())
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/** restore_capture -> rolls back a failed set_crop: crop rectangle, format and buffers of before,
+ * 					   streaming is restarted if it was running
+ * @crop: previous crop rectangle
+ * @width: previous capture width
+ * @height: previous capture height
+ * @restart: start streaming again
+ */
+int Camera::restore_capture(const struct v4l2_rect &crop, int width, int height, bool restart)
+{
+	struct v4l2_selection sel;
+
+	memset(&sel, 0, sizeof(sel));
+	sel.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	sel.target = V4L2_SEL_TGT_CROP;
+	sel.r = crop;
+	xioctl(this->fd, VIDIOC_S_SELECTION, &sel);
+	unmap_buffers();
+	if (0 != set_format(width, height) || 0 != map_buffers())
+	{
+		std::cout << "Failed to restore capture format." << std::endl;
+		unmap_buffers();
+		return 1;
+	}
+	if (restart && 0 != start_streaming())
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/** set_frame_rate -> sets the frame interval of the camera sensor
+ * @fps: frames per second
+ */
+int Camera::set_frame_rate(int fps)
+{
+	std::lock_guard<std::mutex> guard(this->capture_lock);
+
+	if (fps <= 0 || 0 == this->sensor_subdev[0])
+	{
+		std::cout << "Frame rate can not be set." << std::endl;
+		return 1;
+	}
+	if (0 != subdev_set_frame_interval(this->sensor_subdev, 0, 1, fps))
+	{
+		return 1;
+	}
+	this->fps = fps;
 	return 0;
 }
 
 Camera::~Camera()
 {
-	free(this->buffers);
-	free(this->camdata);
+	stop_streaming();
+	unmap_buffers();
+	Host_arena::instance().release(this->camdata);
 	close(this->fd);
 }
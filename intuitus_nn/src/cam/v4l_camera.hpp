@@ -10,13 +10,16 @@
 #include <linux/videodev2.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <mutex>
+
+#include "media_ctl.hpp"
+#include "frame_tracker.hpp"
 
 #define FMT_NUM_PLANES 3
+// Default capture format
 #define WIDTH 1920
 #define HEIGHT 1080
-
-#define MEDIA_INIT_OV5640 "sudo media-ctl -d /dev/media0 -V \'\"ov5640 2-003c\":0 [fmt:UYVY/\'1920x1080\'@1/\'15\' field:none]\'"
-#define MEDIA_INIT_MIPI_CSI_SUBMODULE "sudo media-ctl -d /dev/media0 -V \'\"43c40000.mipi_csi2_rx_subsystem\":0 [fmt:UYVY/\'1920x1080\' field:none]\'"
+#define FPS 15
 
 typedef struct buffer_addr_struct_s{
 	void *start[FMT_NUM_PLANES];
@@ -27,13 +30,39 @@ class Camera {        // The class
 	public:          // Access specifier
 		uint8_t* camdata = 0;
 		Camera(const char* dev); // Constructor declaration
+		Camera(const char* dev, int width, int height, int fps);
 		~Camera();
         int capture(uint8_t **img_out, int *h_out, int *w_out, int *co);
+		int set_crop(int left, int top, int width, int height);
+		int set_frame_rate(int fps);
+		void attach_tracker(Frame_tracker *tracker);
+		int prefault();
+		struct frame_meta last_frame_meta();
 	private:
 		int fd;  // Attribute
 		int num_planes;
+		int num_buffers;
+		bool streaming;
+		struct frame_meta meta; // time stamps of the last captured frame
+		Frame_tracker *tracker;
+		int width;          // capture size (crop rectangle)
+		int height;
+		int bytesperline;   // line stride of the capture buffers
+		int format_width;   // format the camera was opened with, bounds of the crop rectangle
+		int format_height;
+		int fps;
+		char sensor_subdev[MEDIA_SUBDEV_PATH_LEN];
+		void init(const char* dev, int width, int height, int fps);
+		int configure_pipeline();
+		int set_format(int width, int height);
+		int map_buffers();
+		void unmap_buffers();
+		int restore_capture(const struct v4l2_rect &crop, int width, int height, bool restart);
+		int start_streaming();
+		void stop_streaming();
         struct  v4l2_buffer buf;
 		buffer_addr_struct_t* buffers;
+		std::mutex capture_lock; // serializes capture calls from several threads
 };
 
 #endif /* SRC_V4L_CAMERA_H_ */
\ No newline at end of file
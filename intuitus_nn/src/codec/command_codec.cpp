@@ -0,0 +1,273 @@
+#include "command_codec.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+#include <unordered_map>
+
+#define VARINT_MAX_BYTES 10
+
+static inline uint32_t zigzag_encode(int32_t v)
+{
+	return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t zigzag_decode(uint32_t v)
+{
+	return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static void put_varint(std::vector<uint8_t> &out, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		out.push_back((uint8_t)(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back((uint8_t)v);
+}
+
+static void put_uint32(std::vector<uint8_t> &out, uint32_t v)
+{
+	out.push_back((uint8_t)v);
+	out.push_back((uint8_t)(v >> 8));
+	out.push_back((uint8_t)(v >> 16));
+	out.push_back((uint8_t)(v >> 24));
+}
+
+/** get_varint -> reads a varint from stream
+ * @return: number of bytes consumed, 0 on truncated or overlong input
+ */
+static inline size_t get_varint(const uint8_t *stream, size_t len, size_t pos, uint64_t *v)
+{
+	uint64_t res = 0;
+	size_t i;
+	for (i = 0; i < VARINT_MAX_BYTES && pos + i < len; i++)
+	{
+		res |= (uint64_t)(stream[pos + i] & 0x7f) << (7 * i);
+		if (!(stream[pos + i] & 0x80))
+		{
+			*v = res;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+static inline uint32_t get_uint32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t hash_block(const int32_t *block, uint32_t len)
+{
+	uint64_t h = 0xcbf29ce484222325ULL; // FNV-1a
+	uint32_t i;
+	for (i = 0; i < len; i++)
+	{
+		h ^= (uint32_t)block[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h ^ len;
+}
+
+static void encode_block(std::vector<uint8_t> &out, const int32_t *block, uint32_t len)
+{
+	uint32_t i = 0;
+	uint32_t run;
+	int32_t prev = 0;
+	int32_t delta;
+
+	while (i < len)
+	{
+		delta = (int32_t)((uint32_t)block[i] - (uint32_t)prev);
+		prev = block[i];
+		run = 0;
+		while (i + run + 1 < len && (int32_t)((uint32_t)block[i + run + 1] - (uint32_t)block[i + run]) == delta)
+		{
+			run++;
+		}
+		if (run > 0)
+		{
+			put_varint(out, ((uint64_t)zigzag_encode(delta) << 1) | 1);
+			put_varint(out, run);
+			prev = block[i + run];
+		}
+		else
+		{
+			put_varint(out, (uint64_t)zigzag_encode(delta) << 1);
+		}
+		i += run + 1;
+	}
+}
+
+/** encode_command_blocks -> compresses the command blocks of a conv2d layer
+ * @com_block: command block array (concatenated 32 bit command words of all blocks)
+ * @com_block_dim: length of command block array
+ * @com_lengths: length of each command block in 32 bit words
+ * @com_block_cnt: number of command blocks
+ * @com_stream_out: compressed stream (allocated using malloc, owned by caller)
+ * @com_stream_len: length of compressed stream in bytes
+ */
+int encode_command_blocks(const int32_t *com_block, int com_block_dim,
+						  const uint32_t *com_lengths, int com_block_cnt,
+						  uint8_t **com_stream_out, int *com_stream_len)
+{
+	std::vector<uint8_t> out;
+	std::unordered_map<uint64_t, std::vector<int>> known_blocks;
+	std::vector<const int32_t *> block_ptrs(com_block_cnt);
+	const int32_t *block = com_block;
+	uint64_t check_length = 0;
+	uint64_t h;
+	int i, ref;
+
+	*com_stream_out = NULL;
+	*com_stream_len = 0;
+
+	for (i = 0; i < com_block_cnt; i++)
+	{
+		check_length += com_lengths[i];
+	}
+	CHECK((uint64_t)com_block_dim == check_length, ERROR_DIMENSION_MISMATCH, "Command block lenght does not match sum of command lengths. Got %d, expected to be %d.", com_block_dim, (int)check_length)
+
+	out.reserve(COM_STREAM_HEADER_SIZE + com_block_dim);
+	put_uint32(out, COM_STREAM_MAGIC);
+	put_uint32(out, (uint32_t)com_block_cnt);
+	put_uint32(out, (uint32_t)com_block_dim);
+
+	for (i = 0; i < com_block_cnt; i++)
+	{
+		block_ptrs[i] = block;
+		h = hash_block(block, com_lengths[i]);
+		ref = -1;
+		std::vector<int> &candidates = known_blocks[h];
+		for (int c : candidates)
+		{
+			if (com_lengths[c] == com_lengths[i] &&
+				0 == memcmp(block_ptrs[c], block, sizeof(int32_t) * com_lengths[i]))
+			{
+				ref = c;
+				break;
+			}
+		}
+		if (ref >= 0)
+		{
+			put_varint(out, (uint64_t)ref + 1);
+		}
+		else
+		{
+			put_varint(out, 0);
+			encode_block(out, block, com_lengths[i]);
+			candidates.push_back(i);
+		}
+		block += com_lengths[i];
+	}
+
+	*com_stream_out = (uint8_t *)malloc(out.size());
+	CHECK_NOT_NULL(*com_stream_out, ERROR_MEMORY_ALLOC_FAIL)
+	memcpy(*com_stream_out, out.data(), out.size());
+	*com_stream_len = (int)out.size();
+	return 0;
+}
+
+Command_decoder::Command_decoder(const uint8_t *stream, size_t stream_len)
+{
+	this->stream = stream;
+	this->stream_len = stream_len;
+	this->pos = COM_STREAM_HEADER_SIZE;
+	this->block_idx = 0;
+	this->block_cnt = 0;
+	this->block_offsets = NULL;
+}
+
+Command_decoder::~Command_decoder()
+{
+	if (this->block_offsets != NULL)
+	{
+		free(this->block_offsets);
+	}
+}
+
+/** check_header -> validates the stream header against the expected layer dimensions
+ * @block_cnt: expected number of command blocks
+ * @word_cnt: expected total number of command words
+ */
+int Command_decoder::check_header(uint32_t block_cnt, uint32_t word_cnt)
+{
+	CHECK(this->stream_len >= COM_STREAM_HEADER_SIZE, ERROR_DIMENSION_MISMATCH, "Compressed command stream is truncated.")
+	CHECK(COM_STREAM_MAGIC == get_uint32(this->stream), ERROR_OTHER, "Invalid compressed command stream.")
+	CHECK(block_cnt == get_uint32(this->stream + 4), ERROR_DIMENSION_MISMATCH, "Command block number missmatch. Got %d, expected %d.", get_uint32(this->stream + 4), block_cnt)
+	CHECK(word_cnt == get_uint32(this->stream + 8), ERROR_DIMENSION_MISMATCH, "Command block lenght missmatch. Got %d, expected %d.", get_uint32(this->stream + 8), word_cnt)
+
+	this->block_cnt = block_cnt;
+	this->block_offsets = (size_t *)malloc(sizeof(size_t) * (block_cnt > 0 ? block_cnt : 1));
+	CHECK_NOT_NULL(this->block_offsets, ERROR_MEMORY_ALLOC_FAIL)
+	return 0;
+}
+
+/** next_block -> decodes the next command block
+ * @dst: destination of decoded command words (e.g. the kernel interface buffer)
+ * @word_cnt: length of command block in 32 bit words
+ */
+int Command_decoder::next_block(int32_t *dst, uint32_t word_cnt)
+{
+	uint64_t ref;
+	size_t n, end;
+	int err;
+
+	CHECK(this->block_idx < this->block_cnt, ERROR_DIMENSION_MISMATCH, "Compressed command stream contains only %d blocks.", this->block_cnt)
+	n = get_varint(this->stream, this->stream_len, this->pos, &ref);
+	CHECK(0 != n, ERROR_OTHER, "Compressed command stream is truncated at block %d.", this->block_idx)
+	this->pos += n;
+
+	if (ref > 0)
+	{
+		CHECK(ref <= this->block_idx, ERROR_OTHER, "Invalid block reference in compressed command stream at block %d.", this->block_idx)
+		this->block_offsets[this->block_idx] = this->block_offsets[ref - 1];
+		err = decode_payload(this->block_offsets[ref - 1], dst, word_cnt, &end);
+	}
+	else
+	{
+		this->block_offsets[this->block_idx] = this->pos;
+		err = decode_payload(this->pos, dst, word_cnt, &end);
+		this->pos = end;
+	}
+	CHECK(0 == err, err, "Failed to decode command block %d.", this->block_idx)
+	this->block_idx++;
+	return 0;
+}
+
+int Command_decoder::decode_payload(size_t offs, int32_t *dst, uint32_t word_cnt, size_t *end)
+{
+	uint32_t i = 0;
+	uint64_t token, run;
+	int32_t prev = 0;
+	int32_t delta;
+	size_t n;
+
+	while (i < word_cnt)
+	{
+		n = get_varint(this->stream, this->stream_len, offs, &token);
+		CHECK(0 != n, ERROR_OTHER, "Compressed command stream is truncated.")
+		offs += n;
+		delta = zigzag_decode((uint32_t)(token >> 1));
+		run = 0;
+		if (token & 1)
+		{
+			n = get_varint(this->stream, this->stream_len, offs, &run);
+			CHECK(0 != n, ERROR_OTHER, "Compressed command stream is truncated.")
+			offs += n;
+		}
+		CHECK(run < (uint64_t)(word_cnt - i), ERROR_DIMENSION_MISMATCH, "Command block exceeds expected length of %d words.", word_cnt)
+		for (run++; run > 0; run--)
+		{
+			prev = (int32_t)((uint32_t)prev + (uint32_t)delta);
+			dst[i++] = prev;
+		}
+	}
+	*end = offs;
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * command_codec.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Compressed storage of conv2d command blocks (tx_bin).
+ *
+ * Stream layout (little endian):
+ *  uint32 magic (COM_STREAM_MAGIC)
+ *  uint32 number of command blocks
+ *  uint32 total number of 32 bit command words
+ *  block 0 .. block n-1
+ *
+ * Every block starts with a varint reference field. A value r > 0 marks the block as
+ * an exact copy of block r - 1 (command blocks of different tiles are mostly identical).
+ * A value of 0 is followed by the inline coded block: zigzag encoded word deltas, each
+ * written as varint ((zz << 1) | run) followed by a varint repeat count if run is set.
+ * The delta chain restarts at every block so blocks can be decoded independently.
+ */
+#ifndef SRC_COMMAND_CODEC_H_
+#define SRC_COMMAND_CODEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COM_STREAM_MAGIC 0x31424349 // "ICB1"
+#define COM_STREAM_HEADER_SIZE 12
+
+/** encode_command_blocks -> compresses the command blocks of a conv2d layer
+ * @com_block: command block array (concatenated 32 bit command words of all blocks)
+ * @com_block_dim: length of command block array
+ * @com_lengths: length of each command block in 32 bit words
+ * @com_block_cnt: number of command blocks
+ * @com_stream_out: compressed stream (allocated using malloc, owned by caller)
+ * @com_stream_len: length of compressed stream in bytes
+ */
+int encode_command_blocks(const int32_t *com_block, int com_block_dim,
+                          const uint32_t *com_lengths, int com_block_cnt,
+                          uint8_t **com_stream_out, int *com_stream_len);
+
+/** Command_decoder -> streaming decoder for compressed command blocks.
+ * Blocks are decoded one after another directly into the destination buffer. Nothing
+ * but the block offsets is kept, so the decoded layer never exists in host memory.
+ */
+class Command_decoder
+{
+public:
+    Command_decoder(const uint8_t *stream, size_t stream_len);
+    ~Command_decoder();
+
+    int check_header(uint32_t block_cnt, uint32_t word_cnt);
+    int next_block(int32_t *dst, uint32_t word_cnt);
+
+private:
+    const uint8_t *stream;
+    size_t stream_len;
+    size_t pos;
+    uint32_t block_idx;
+    uint32_t block_cnt;
+    size_t *block_offsets; // offset of the inline coded payload of each block
+
+    int decode_payload(size_t offs, int32_t *dst, uint32_t word_cnt, size_t *end);
+};
+
+#endif /* SRC_COMMAND_CODEC_H_ */
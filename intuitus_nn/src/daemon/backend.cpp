@@ -0,0 +1,227 @@
+#include "backend.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "journal.hpp"
+#include "arena.hpp"
+#include "realtime.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+static inline uint64_t now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** run_batch -> executes n frames [n, ci, h, w] one after another
+ * @batch_out: outputs [n, output_size] (allocated using malloc, owned by caller)
+ */
+int Inference_backend::run_batch(const uint8_t *frames, int n, int8_t **batch_out)
+{
+	int ci, h, w, err = 0;
+
+	input_dims(&ci, &h, &w);
+	*batch_out = (int8_t *)malloc((size_t)n * output_size());
+	CHECK_NOT_NULL(*batch_out, ERROR_MEMORY_ALLOC_FAIL)
+	for (int i = 0; i < n && 0 == err; i++)
+	{
+		err = run(frames + (size_t)i * ci * h * w, *batch_out + (size_t)i * output_size());
+	}
+	if (0 != err)
+	{
+		free(*batch_out);
+		*batch_out = NULL;
+	}
+	return err;
+}
+
+const char *Device_backend::name()
+{
+	return "device";
+}
+
+/** load -> creates the network of a network file (Intuitus_intf::save_network) on the device
+ */
+int Device_backend::load(const char *path)
+{
+	int err = this->net.load_network(path);
+
+	if (0 != err)
+	{
+		return err;
+	}
+	for (int i = 0; i < this->net.layer_count(); i++)
+	{
+		struct intuitus_layer_info info = this->net.get_layer_info(i);
+		if (Input == info.layer_type)
+		{
+			this->ci = info.out_channels;
+			this->h = info.out_height;
+			this->w = info.out_width;
+		}
+	}
+	this->out_size = this->net.get_network_info().output_bytes;
+	return 0;
+}
+
+void Device_backend::input_dims(int *ci, int *h, int *w)
+{
+	*ci = this->ci;
+	*h = this->h;
+	*w = this->w;
+}
+
+int Device_backend::output_size()
+{
+	return this->out_size;
+}
+
+int Device_backend::run(const uint8_t *fmap_in, int8_t *fmap_out)
+{
+	return this->net.execute_into(fmap_in, this->ci, this->h, this->w, fmap_out, this->out_size);
+}
+
+/** run_batch -> executes n frames with Intuitus_intf::execute_batch
+ */
+int Device_backend::run_batch(const uint8_t *frames, int n, int8_t **batch_out)
+{
+	int batch, size;
+
+	return this->net.execute_batch(frames, n, this->ci, this->h, this->w, batch_out, &batch, &size);
+}
+
+struct stage_totals Device_backend::totals()
+{
+	struct intuitus_exec_stats stats = this->net.get_exec_stats();
+	struct stage_totals t = {stats.upload_us, stats.execute_us, stats.readout_us};
+	return t;
+}
+
+int Device_backend::prefault()
+{
+	return this->net.prefault();
+}
+
+Sim_backend::Sim_backend(uint32_t latency_us)
+{
+	this->latency_us = latency_us;
+}
+
+Sim_backend::~Sim_backend()
+{
+	Host_arena::instance().release(this->intf);
+}
+
+const char *Sim_backend::name()
+{
+	return "sim";
+}
+
+/** load -> reads the layer dimensions of a network file. Nothing is uploaded.
+ */
+int Sim_backend::load(const char *path)
+{
+	std::vector<struct journal_record> journal;
+	std::map<int, uint32_t> channels, heights, widths;
+	int err = journal_load(path, journal);
+
+	if (0 != err)
+	{
+		return err;
+	}
+	// output dimensions of each layer (buffer id == layer id)
+	for (auto &r : journal)
+	{
+		const int32_t *a = r.args;
+		switch (r.op)
+		{
+		case JOURNAL_INPUT:
+			this->ci = channels[0] = a[0];
+			this->h = heights[0] = a[1];
+			this->w = widths[0] = a[2];
+			break;
+		case JOURNAL_OUTPUT:
+			this->out_size += channels[a[1]] * heights[a[1]] * widths[a[1]];
+			break;
+		case JOURNAL_CONV2D:
+			channels[a[0]] = a[6];
+			heights[a[0]] = a[4];
+			widths[a[0]] = a[5];
+			break;
+		case JOURNAL_CONCAT:
+			channels[a[0]] = channels[a[1]] + channels[a[2]];
+			heights[a[0]] = heights[a[1]];
+			widths[a[0]] = widths[a[1]];
+			break;
+		case JOURNAL_SPLIT:
+			// groups layers with ongoing ids
+			for (int g = 0; g < a[2]; g++)
+			{
+				channels[a[0] + g] = channels[a[1]] / a[2];
+				heights[a[0] + g] = heights[a[1]];
+				widths[a[0] + g] = widths[a[1]];
+			}
+			break;
+		case JOURNAL_UPSAMPLE:
+		case JOURNAL_MAXPOOL2D:
+		case JOURNAL_COPY:
+			channels[a[0]] = a[2];
+			heights[a[0]] = a[3];
+			widths[a[0]] = a[4];
+			break;
+		}
+	}
+	CHECK(this->ci > 0 && this->out_size > 0, ERROR_NETWORK_FORMAT, "Network has no input or output layer.")
+	this->intf = (uint8_t *)Host_arena::instance().acquire(this->ci * this->h * this->w + this->out_size);
+	CHECK_NOT_NULL(this->intf, ERROR_MEMORY_ALLOC_FAIL)
+	return 0;
+}
+
+void Sim_backend::input_dims(int *ci, int *h, int *w)
+{
+	*ci = this->ci;
+	*h = this->h;
+	*w = this->w;
+}
+
+int Sim_backend::output_size()
+{
+	return this->out_size;
+}
+
+int Sim_backend::run(const uint8_t *fmap_in, int8_t *fmap_out)
+{
+	size_t size_in = this->ci * this->h * this->w;
+	std::lock_guard<std::mutex> guard(this->device_lock);
+
+	uint64_t upload = now_us();
+	memcpy(this->intf, fmap_in, size_in);
+	uint64_t start = now_us();
+	std::this_thread::sleep_for(std::chrono::microseconds(this->latency_us));
+	uint64_t readout = now_us();
+	memcpy(fmap_out, this->intf + size_in, this->out_size);
+	uint64_t stop = now_us();
+
+	this->stages.upload_us += start - upload;
+	this->stages.execute_us += readout - start;
+	this->stages.readout_us += stop - readout;
+	return 0;
+}
+
+struct stage_totals Sim_backend::totals()
+{
+	std::lock_guard<std::mutex> guard(this->device_lock);
+	return this->stages;
+}
+
+int Sim_backend::prefault()
+{
+	std::lock_guard<std::mutex> guard(this->device_lock);
+
+	rt_prefault(this->intf, this->ci * this->h * this->w + this->out_size, 1);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * backend.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Execution backends of the host tools (intuitus_bench, intuitusd): the intuitus device or a
+ * simulated accelerator. The simulation runs without driver and FPGA, so tools can be tested
+ * and compared on any machine.
+ */
+#ifndef SRC_BACKEND_H_
+#define SRC_BACKEND_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include "intuitus.hpp"
+
+#define SIM_DEFAULT_LATENCY_US 20000
+
+/** stage_totals -> accumulated time of the device stages of all executions
+ */
+struct stage_totals
+{
+    uint64_t upload_us;
+    uint64_t execute_us;
+    uint64_t readout_us;
+};
+
+/** Inference_backend -> executes one network. run may be called from several threads.
+ */
+class Inference_backend
+{
+public:
+    virtual ~Inference_backend() {}
+    virtual const char *name() = 0;
+    virtual int load(const char *path) = 0;
+    virtual void input_dims(int *ci, int *h, int *w) = 0;
+    virtual int output_size() = 0;
+    virtual int run(const uint8_t *fmap_in, int8_t *fmap_out) = 0;
+    virtual int run_batch(const uint8_t *frames, int n, int8_t **batch_out);
+    virtual struct stage_totals totals() = 0;
+    virtual int prefault() = 0;
+};
+
+/** Device_backend -> network uploaded to the intuitus device. The constructor opens the
+ *                   device and throws DMA_Exception on failure.
+ */
+class Device_backend : public Inference_backend
+{
+public:
+    const char *name();
+    int load(const char *path);
+    void input_dims(int *ci, int *h, int *w);
+    int output_size();
+    int run(const uint8_t *fmap_in, int8_t *fmap_out);
+    int run_batch(const uint8_t *frames, int n, int8_t **batch_out);
+    struct stage_totals totals();
+    int prefault();
+
+private:
+    Intuitus_intf net;
+    int ci = 0, h = 0, w = 0;
+    int out_size = 0;
+};
+
+/** Sim_backend -> models a single accelerator: executions are serialized, input and output are
+ *                copied through a host interface buffer and each execution takes latency_us.
+ */
+class Sim_backend : public Inference_backend
+{
+public:
+    Sim_backend(uint32_t latency_us = SIM_DEFAULT_LATENCY_US);
+    ~Sim_backend();
+    const char *name();
+    int load(const char *path);
+    void input_dims(int *ci, int *h, int *w);
+    int output_size();
+    int run(const uint8_t *fmap_in, int8_t *fmap_out);
+    struct stage_totals totals();
+    int prefault();
+
+private:
+    uint32_t latency_us;
+    int ci = 0, h = 0, w = 0;
+    int out_size = 0;
+    uint8_t *intf = NULL;
+    std::mutex device_lock;
+    struct stage_totals stages = {0, 0, 0};
+};
+
+#endif /* SRC_BACKEND_H_ */
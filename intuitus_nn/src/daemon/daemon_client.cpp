@@ -0,0 +1,249 @@
+#include "daemon_client.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/** Daemon_client -> connects to the daemon and attaches to a network. Throws DMA_Exception
+ * 					 if the daemon is not running or does not serve the network.
+ * @network: network name given to the daemon
+ * @slots: number of frames which can be in flight
+ * @socket_path: socket of the daemon
+ */
+Daemon_client::Daemon_client(const char *network, int slots, const char *socket_path)
+{
+	struct sockaddr_un addr;
+	struct daemon_msg msg;
+	int memfd = -1, err;
+
+	CHECK_AND_THROW(strlen(network) < DAEMON_NAME_LEN && strlen(socket_path) < sizeof(addr.sun_path), ERROR_OTHER,
+					"Network name or socket path too long.")
+	this->fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	CHECK_AND_THROW(this->fd >= 0, ERROR_OTHER, "Failed to create socket.")
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+	if (0 != connect(this->fd, (struct sockaddr *)&addr, sizeof(addr)))
+	{
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_DAEMON_DISCONNECTED, "Failed to connect to the intuitus daemon.")
+	}
+
+	memset(&msg, 0, sizeof(msg));
+	msg.type = DAEMON_OPEN;
+	msg.version = DAEMON_PROTOCOL_VERSION;
+	msg.slots = slots;
+	strncpy(msg.network, network, DAEMON_NAME_LEN - 1);
+	err = daemon_send(this->fd, &msg);
+	if (0 == err)
+	{
+		err = daemon_recv(this->fd, &this->layout, &memfd);
+	}
+	if (0 != err || DAEMON_OPENED != this->layout.type || memfd < 0)
+	{
+		if (memfd >= 0)
+		{
+			close(memfd);
+		}
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_OTHER, "Daemon refused the network.")
+	}
+	this->size = (size_t)this->layout.slots * this->layout.slot_stride;
+	void *ptr = mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+	close(memfd);
+	if (MAP_FAILED == ptr)
+	{
+		close(this->fd);
+		CHECK_AND_THROW(0, ERROR_MEMORY_ALLOC_FAIL, "Failed to map daemon slots.")
+	}
+	this->base = (uint8_t *)ptr;
+	this->state.assign(this->layout.slots, SLOT_FREE);
+}
+
+Daemon_client::~Daemon_client()
+{
+	// the daemon drops queued frames of disconnected clients
+	close(this->fd);
+	munmap(this->base, this->size);
+}
+
+int Daemon_client::slots() { return this->layout.slots; }
+int Daemon_client::channels() { return this->layout.in_channels; }
+int Daemon_client::height() { return this->layout.in_height; }
+int Daemon_client::width() { return this->layout.in_width; }
+int Daemon_client::output_size() { return this->layout.output_size; }
+
+/** input_buffer -> input region of a slot (ci * h * w bytes). Fill it, then submit_slot.
+ * 					 The view is valid as long as the client exists.
+ */
+int Daemon_client::input_buffer(int slot, uint8_t **fmap_out, int *out_size)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+	CHECK(slot >= 0 && slot < (int)this->layout.slots, ERROR_OTHER, "Invalid slot.")
+	*fmap_out = this->base + (size_t)slot * this->layout.slot_stride;
+	*out_size = this->layout.input_size;
+	return 0;
+}
+
+/** submit_slot -> hands the input of a free slot to the daemon
+ */
+int Daemon_client::submit_slot(int slot)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+	struct daemon_msg msg;
+	int err;
+
+	CHECK(slot >= 0 && slot < (int)this->layout.slots && SLOT_FREE == this->state[slot], ERROR_OTHER, "Slot is not free.")
+	memset(&msg, 0, sizeof(msg));
+	msg.type = DAEMON_SUBMIT;
+	msg.version = DAEMON_PROTOCOL_VERSION;
+	msg.slot = slot;
+	msg.sequence = this->sequence++;
+	err = daemon_send(this->fd, &msg);
+	CHECK(0 == err, err, "Lost connection to the intuitus daemon.")
+	this->state[slot] = SLOT_SUBMITTED;
+	return 0;
+}
+
+/** submit -> copies a frame into a free slot and submits it
+ * @slot: slot of the frame, identifies its result in wait
+ */
+int Daemon_client::submit(const uint8_t *fmap_in, int ci, int h_in, int w_in, int *slot)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+	int i;
+
+	CHECK((uint32_t)ci * h_in * w_in == this->layout.input_size, ERROR_DIMENSION_MISMATCH, "Input does not match the network.")
+	for (i = 0; i < (int)this->layout.slots && SLOT_FREE != this->state[i]; i++)
+	{
+	}
+	CHECK(i < (int)this->layout.slots, ERROR_OTHER, "No free slot. Wait for results and release them.")
+	memcpy(this->base + (size_t)i * this->layout.slot_stride, fmap_in, this->layout.input_size);
+	*slot = i;
+	return submit_slot(i);
+}
+
+/** receive -> next message of the daemon. Caller holds lock.
+ */
+int Daemon_client::receive(struct daemon_msg *msg)
+{
+	int err = daemon_recv(this->fd, msg);
+
+	CHECK(0 == err, err, "Lost connection to the intuitus daemon.")
+	CHECK(msg->slot < this->layout.slots && SLOT_SUBMITTED == this->state[msg->slot], ERROR_OTHER, "Unexpected daemon message.")
+	return 0;
+}
+
+/** wait -> blocks until the next result is available
+ * @slot: slot of the result. Owned by the caller until release.
+ * @fmap_out: network output in the slot
+ * @return: execution status of the frame
+ */
+int Daemon_client::wait(int *slot, int8_t **fmap_out, int *out_size)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+	struct daemon_msg msg;
+	int err;
+
+	if (this->completed.empty())
+	{
+		bool pending = false;
+		for (auto s : this->state)
+		{
+			pending |= (SLOT_SUBMITTED == s);
+		}
+		CHECK(pending, ERROR_OTHER, "No frame submitted.")
+		err = receive(&msg);
+		if (0 != err)
+		{
+			return err;
+		}
+	}
+	else
+	{
+		msg = this->completed.front();
+		this->completed.pop_front();
+	}
+	this->state[msg.slot] = SLOT_DONE;
+	this->queue_us = msg.queue_us;
+	this->exec_us = msg.exec_us;
+	*slot = msg.slot;
+	*fmap_out = (int8_t *)(this->base + (size_t)msg.slot * this->layout.slot_stride + this->layout.output_offset);
+	*out_size = this->layout.output_size;
+	return msg.status;
+}
+
+/** release -> returns a slot after its result was consumed
+ */
+int Daemon_client::release(int slot)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+	CHECK(slot >= 0 && slot < (int)this->layout.slots && SLOT_DONE == this->state[slot], ERROR_OTHER, "Slot holds no result.")
+	this->state[slot] = SLOT_FREE;
+	if (slot == this->held_slot)
+	{
+		this->held_slot = -1;
+	}
+	return 0;
+}
+
+/** execute -> submits a frame and waits for its result. Results of frames submitted before
+ * 			   are kept for wait. The output is valid until the next execute.
+ */
+int Daemon_client::execute(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+						   int8_t **fmap_out, int *out_size)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->lock);
+	struct daemon_msg msg;
+	int slot, err;
+
+	if (this->held_slot >= 0)
+	{
+		release(this->held_slot);
+	}
+	err = submit(fmap_in, ci, h_in, w_in, &slot);
+	if (0 != err)
+	{
+		return err;
+	}
+	while (true)
+	{
+		err = receive(&msg);
+		if (0 != err)
+		{
+			return err;
+		}
+		if ((int)msg.slot == slot)
+		{
+			break;
+		}
+		this->completed.push_back(msg);
+	}
+	this->state[slot] = SLOT_DONE;
+	this->held_slot = slot;
+	this->queue_us = msg.queue_us;
+	this->exec_us = msg.exec_us;
+	*fmap_out = (int8_t *)(this->base + (size_t)slot * this->layout.slot_stride + this->layout.output_offset);
+	*out_size = this->layout.output_size;
+	return msg.status;
+}
+
+/** last_queue_us -> time the last returned frame waited in the daemon
+ */
+uint64_t Daemon_client::last_queue_us()
+{
+	return this->queue_us;
+}
+
+/** last_exec_us -> execution time of the last returned frame
+ */
+uint64_t Daemon_client::last_exec_us()
+{
+	return this->exec_us;
+}
@@ -0,0 +1,66 @@
+/*
+ * daemon_client.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Client of the inference daemon (tools/intuitusd). Several processes can share the
+ * accelerator without opening the device or uploading the network themselves.
+ * Frames are written to shared memory slots (input_buffer gives zero copy access), results
+ * are read from the same slot. A slot is owned by the client again after its result was
+ * returned by wait and is reused after release.
+ */
+#ifndef SRC_DAEMON_CLIENT_H_
+#define SRC_DAEMON_CLIENT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "daemon_protocol.hpp"
+
+class Daemon_client
+{
+public:
+    Daemon_client(const char *network, int slots = DAEMON_DEFAULT_SLOTS, const char *socket_path = DAEMON_SOCKET_PATH);
+    ~Daemon_client();
+
+    int slots();
+    int channels();
+    int height();
+    int width();
+    int output_size();
+
+    int input_buffer(int slot, uint8_t **fmap_out, int *out_size);
+    int submit_slot(int slot);
+    int submit(const uint8_t *fmap_in, int ci, int h_in, int w_in, int *slot);
+    int wait(int *slot, int8_t **fmap_out, int *out_size);
+    int release(int slot);
+    int execute(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+                int8_t **fmap_out, int *out_size);
+    uint64_t last_queue_us();
+    uint64_t last_exec_us();
+
+private:
+    enum slot_state
+    {
+        SLOT_FREE,
+        SLOT_SUBMITTED,
+        SLOT_DONE // result returned, owned by the caller until release
+    };
+    int fd = -1;
+    uint8_t *base = NULL;
+    size_t size = 0;
+    struct daemon_msg layout;
+    std::vector<enum slot_state> state;
+    std::deque<struct daemon_msg> completed; // results received but not returned by wait yet
+    uint64_t sequence = 0;
+    uint64_t queue_us = 0, exec_us = 0;
+    int held_slot = -1; // slot of the last execute
+    std::recursive_mutex lock;
+
+    int receive(struct daemon_msg *msg);
+};
+
+#endif /* SRC_DAEMON_CLIENT_H_ */
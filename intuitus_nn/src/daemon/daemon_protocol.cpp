@@ -0,0 +1,107 @@
+#include "daemon_protocol.hpp"
+#include "intuitus-intf.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+/** daemon_send -> sends one message
+ * @pass_fd: file descriptor passed along (SCM_RIGHTS), -1 for none
+ * @return: 0, ERROR_DAEMON_DISCONNECTED if the peer is gone
+ */
+int daemon_send(int fd, const struct daemon_msg *msg, int pass_fd)
+{
+	struct iovec iov = {(void *)msg, sizeof(*msg)};
+	struct msghdr hdr;
+	char control[CMSG_SPACE(sizeof(int))];
+	ssize_t n;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.msg_iov = &iov;
+	hdr.msg_iovlen = 1;
+	if (pass_fd >= 0)
+	{
+		memset(control, 0, sizeof(control));
+		hdr.msg_control = control;
+		hdr.msg_controllen = sizeof(control);
+		struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+		memcpy(CMSG_DATA(cmsg), &pass_fd, sizeof(int));
+	}
+	do
+	{
+		n = sendmsg(fd, &hdr, MSG_NOSIGNAL);
+	} while (n < 0 && EINTR == errno);
+	return (n == (ssize_t)sizeof(*msg)) ? 0 : ERROR_DAEMON_DISCONNECTED;
+}
+
+/** daemon_recv -> receives one message (blocking)
+ * @recv_fd: receives a passed file descriptor (-1 if none). NULL: passed descriptors are closed.
+ * @return: 0, ERROR_DAEMON_DISCONNECTED if the peer is gone, ERROR_OTHER for invalid messages
+ */
+int daemon_recv(int fd, struct daemon_msg *msg, int *recv_fd)
+{
+	struct iovec iov = {(void *)msg, sizeof(*msg)};
+	struct msghdr hdr;
+	char control[CMSG_SPACE(sizeof(int))];
+	int passed = -1;
+	ssize_t n;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.msg_iov = &iov;
+	hdr.msg_iovlen = 1;
+	hdr.msg_control = control;
+	hdr.msg_controllen = sizeof(control);
+	do
+	{
+		n = recvmsg(fd, &hdr, MSG_CMSG_CLOEXEC);
+	} while (n < 0 && EINTR == errno);
+	if (n <= 0)
+	{
+		return ERROR_DAEMON_DISCONNECTED;
+	}
+	for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+	{
+		if (SOL_SOCKET == cmsg->cmsg_level && SCM_RIGHTS == cmsg->cmsg_type)
+		{
+			// only the first descriptor is used, further ones would leak
+			size_t cnt = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+			for (size_t i = 0; i < cnt; i++)
+			{
+				int pfd;
+				memcpy(&pfd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+				if (passed < 0)
+				{
+					passed = pfd;
+				}
+				else
+				{
+					close(pfd);
+				}
+			}
+		}
+	}
+	if (recv_fd != NULL)
+	{
+		*recv_fd = passed;
+	}
+	else if (passed >= 0)
+	{
+		close(passed);
+	}
+	if (n != (ssize_t)sizeof(*msg) || DAEMON_PROTOCOL_VERSION != msg->version ||
+		(hdr.msg_flags & (MSG_TRUNC | MSG_CTRUNC)))
+	{
+		if (recv_fd != NULL && passed >= 0)
+		{
+			close(passed);
+			*recv_fd = -1;
+		}
+		return ERROR_OTHER;
+	}
+	msg->network[DAEMON_NAME_LEN - 1] = '\0';
+	return 0;
+}
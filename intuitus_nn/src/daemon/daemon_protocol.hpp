@@ -0,0 +1,74 @@
+/*
+ * daemon_protocol.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Protocol between the inference daemon (tools/intuitusd) and its clients. Messages of fixed
+ * size are exchanged over a SOCK_SEQPACKET unix socket. Frames and results are not sent over
+ * the socket: on DAEMON_OPEN the daemon creates a memfd with the client's slots and passes it
+ * along with DAEMON_OPENED (SCM_RIGHTS). A slot holds one input frame and one network output,
+ * DAEMON_SUBMIT and DAEMON_RESULT only ring the doorbell for a slot.
+ */
+#ifndef SRC_DAEMON_PROTOCOL_H_
+#define SRC_DAEMON_PROTOCOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DAEMON_SOCKET_PATH "/run/intuitusd.sock"
+#define DAEMON_PROTOCOL_VERSION 1
+#define DAEMON_DEFAULT_SLOTS 2
+#define DAEMON_MAX_SLOTS 16
+#define DAEMON_NAME_LEN 64
+#define DAEMON_SLOT_ALIGN 4096
+
+#define ERROR_DAEMON_DISCONNECTED (-13)
+
+enum daemon_msg_type
+{
+    DAEMON_OPEN,   // client -> daemon: attach to network, request slots
+    DAEMON_OPENED, // daemon -> client: slot layout, memfd attached
+    DAEMON_SUBMIT, // client -> daemon: input of slot is ready
+    DAEMON_RESULT, // daemon -> client: output of slot is ready (or status < 0)
+    DAEMON_ERROR   // daemon -> client: request rejected
+};
+
+/** daemon_msg -> message of the daemon protocol
+ * @type: daemon_msg_type
+ * @version: DAEMON_PROTOCOL_VERSION
+ * @status: 0 or error code of the execution / request
+ * @slot: slot of DAEMON_SUBMIT and DAEMON_RESULT
+ * @sequence: chosen by the client on submit, returned with the result
+ * @queue_us, @exec_us: time the request waited in the daemon and its execution time
+ * @slots: requested (OPEN) and granted (OPENED) number of slots
+ * @in_channels, @in_height, @in_width: input shape of the network
+ * @input_size, @output_size: bytes of input and output
+ * @slot_stride: distance of slots in the shared memory, input at offset 0 of a slot
+ * @output_offset: offset of the output within a slot
+ * @network: name of the network (OPEN)
+ */
+struct daemon_msg
+{
+    uint32_t type;
+    uint32_t version;
+    int32_t status;
+    uint32_t slot;
+    uint64_t sequence;
+    uint64_t queue_us;
+    uint64_t exec_us;
+    uint32_t slots;
+    uint32_t in_channels;
+    uint32_t in_height;
+    uint32_t in_width;
+    uint32_t input_size;
+    uint32_t output_size;
+    uint32_t slot_stride;
+    uint32_t output_offset;
+    char network[DAEMON_NAME_LEN];
+};
+
+int daemon_send(int fd, const struct daemon_msg *msg, int pass_fd = -1);
+int daemon_recv(int fd, struct daemon_msg *msg, int *recv_fd = NULL);
+
+#endif /* SRC_DAEMON_PROTOCOL_H_ */
@@ -0,0 +1,412 @@
+#include "daemon_server.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <linux/memfd.h>
+#include <chrono>
+
+#ifndef F_ADD_SEALS // glibc < 2.27
+#define F_ADD_SEALS 1033
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+static inline uint64_t now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint32_t align_up(uint32_t size, uint32_t align)
+{
+	return (size + align - 1) / align * align;
+}
+
+Daemon_server::client::~client()
+{
+	if (this->base != NULL)
+	{
+		munmap(this->base, this->size);
+	}
+	if (this->fd >= 0)
+	{
+		close(this->fd);
+	}
+}
+
+/** Daemon_server -> creates the listening socket. Throws DMA_Exception on failure.
+ * @socket_path: unix socket of the daemon. A stale socket file is replaced.
+ * @socket_mode: access mode of the socket (which users may submit frames)
+ */
+Daemon_server::Daemon_server(const char *socket_path, int socket_mode)
+{
+	struct sockaddr_un addr;
+
+	this->stopping = false;
+	this->socket_path = socket_path;
+	CHECK_AND_THROW(strlen(socket_path) < sizeof(addr.sun_path), ERROR_OTHER, "Socket path too long.")
+	CHECK_AND_THROW(0 == pipe2(this->stop_pipe, O_CLOEXEC | O_NONBLOCK), ERROR_OTHER, "Failed to create stop pipe.")
+	this->listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	CHECK_AND_THROW(this->listen_fd >= 0, ERROR_OTHER, "Failed to create daemon socket.")
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+	unlink(socket_path);
+	CHECK_AND_THROW(0 == bind(this->listen_fd, (struct sockaddr *)&addr, sizeof(addr)), ERROR_OTHER, "Failed to bind daemon socket.")
+	chmod(socket_path, socket_mode);
+	CHECK_AND_THROW(0 == listen(this->listen_fd, 16), ERROR_OTHER, "Failed to listen on daemon socket.")
+}
+
+Daemon_server::~Daemon_server()
+{
+	stop();
+	for (auto &entry : this->networks)
+	{
+		struct network *net = entry.second.get();
+		{
+			std::lock_guard<std::mutex> guard(net->lock);
+			net->cv.notify_all();
+		}
+		if (net->executor.joinable())
+		{
+			net->executor.join();
+		}
+	}
+	this->clients.clear();
+	this->networks.clear();
+	if (this->listen_fd >= 0)
+	{
+		close(this->listen_fd);
+		unlink(this->socket_path.c_str());
+	}
+	close(this->stop_pipe[0]);
+	close(this->stop_pipe[1]);
+}
+
+/** add_network -> makes a network available to clients and starts its executor
+ * @name: name used by clients in DAEMON_OPEN
+ * @backend: backend with the loaded network, owned by the server
+ */
+int Daemon_server::add_network(const char *name, Inference_backend *backend)
+{
+	std::unique_ptr<Inference_backend> owned(backend);
+	std::unique_ptr<struct network> net(new network());
+
+	CHECK(strlen(name) > 0 && strlen(name) < DAEMON_NAME_LEN, ERROR_OTHER, "Invalid network name.")
+	CHECK(this->networks.count(name) == 0, ERROR_OTHER, "Network name already in use.")
+	net->name = name;
+	net->backend = std::move(owned);
+	net->backend->input_dims(&net->ci, &net->h, &net->w);
+	net->input_size = net->ci * net->h * net->w;
+	net->output_size = net->backend->output_size();
+	net->output_offset = align_up(net->input_size, DAEMON_SLOT_ALIGN);
+	net->slot_stride = net->output_offset + align_up(net->output_size, DAEMON_SLOT_ALIGN);
+	memset(&net->stats, 0, sizeof(net->stats));
+	net->executor = std::thread(&Daemon_server::executor_loop, this, net.get());
+	this->networks[name] = std::move(net);
+	log_info("Network added.");
+	return 0;
+}
+
+/** stop -> ends run. Async signal safe.
+ */
+void Daemon_server::stop()
+{
+	char c = 0;
+
+	this->stopping = true;
+	if (write(this->stop_pipe[1], &c, 1) < 0)
+	{
+		// pipe full: a stop is already pending
+	}
+}
+
+/** run -> serves clients until stop is called
+ */
+int Daemon_server::run()
+{
+	std::vector<struct pollfd> fds;
+
+	while (!this->stopping)
+	{
+		fds.clear();
+		fds.push_back({this->stop_pipe[0], POLLIN, 0});
+		fds.push_back({this->listen_fd, POLLIN, 0});
+		for (auto &entry : this->clients)
+		{
+			fds.push_back({entry.first, POLLIN, 0});
+		}
+		if (poll(fds.data(), fds.size(), -1) < 0)
+		{
+			CHECK(EINTR == errno, ERROR_OTHER, "Daemon poll failed.")
+			continue;
+		}
+		if (fds[1].revents & POLLIN)
+		{
+			accept_client();
+		}
+		for (size_t i = 2; i < fds.size(); i++)
+		{
+			if (0 == fds[i].revents)
+			{
+				continue;
+			}
+			auto c = this->clients.find(fds[i].fd);
+			if (c == this->clients.end() || 0 != handle_message(c->second))
+			{
+				drop_client(fds[i].fd);
+			}
+		}
+	}
+	return 0;
+}
+
+void Daemon_server::accept_client()
+{
+	int fd = accept4(this->listen_fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+	if (fd < 0)
+	{
+		log_warn(ERROR_OTHER, "Failed to accept client.");
+		return;
+	}
+	std::shared_ptr<struct client> c = std::make_shared<struct client>();
+	c->fd = fd;
+	this->clients[fd] = c;
+}
+
+/** handle_message -> processes one message of a client
+ * @return: 0, an error code if the client has to be dropped
+ */
+int Daemon_server::handle_message(std::shared_ptr<struct client> &c)
+{
+	struct daemon_msg msg;
+	int err = daemon_recv(c->fd, &msg);
+
+	if (0 != err)
+	{
+		return err;
+	}
+	switch (msg.type)
+	{
+	case DAEMON_OPEN:
+		return open_client(c, msg);
+	case DAEMON_SUBMIT:
+		return submit(c, msg);
+	default:
+		log_warn(ERROR_OTHER, "Unexpected client message.");
+		return ERROR_OTHER;
+	}
+}
+
+/** open_client -> attaches a client to a network and passes it a memfd with its slots
+ * 				   The memfd is sealed against resizing, a client cannot make the daemon fault.
+ */
+int Daemon_server::open_client(std::shared_ptr<struct client> &c, const struct daemon_msg &msg)
+{
+	struct daemon_msg reply;
+	int memfd, err;
+
+	memset(&reply, 0, sizeof(reply));
+	reply.version = DAEMON_PROTOCOL_VERSION;
+	auto entry = this->networks.find(msg.network);
+	if (c->net != NULL || entry == this->networks.end())
+	{
+		reply.type = DAEMON_ERROR;
+		reply.status = ERROR_OTHER;
+		daemon_send(c->fd, &reply);
+		return ERROR_OTHER;
+	}
+	struct network *net = entry->second.get();
+	c->slots = (msg.slots > 0) ? std::min((uint32_t)DAEMON_MAX_SLOTS, msg.slots) : DAEMON_DEFAULT_SLOTS;
+	c->size = (size_t)c->slots * net->slot_stride;
+	c->busy.assign(c->slots, false);
+
+	memfd = syscall(SYS_memfd_create, "intuitusd-slots", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	CHECK(memfd >= 0, ERROR_MEMORY_ALLOC_FAIL, "Failed to create shared memory.")
+	if (0 != ftruncate(memfd, c->size) || 0 != fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW))
+	{
+		close(memfd);
+		CHECK(0, ERROR_MEMORY_ALLOC_FAIL, "Failed to size shared memory.")
+	}
+	void *base = mmap(NULL, c->size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+	if (MAP_FAILED == base)
+	{
+		close(memfd);
+		CHECK(0, ERROR_MEMORY_ALLOC_FAIL, "Failed to map shared memory.")
+	}
+	c->base = (uint8_t *)base;
+
+	reply.type = DAEMON_OPENED;
+	reply.slots = c->slots;
+	reply.in_channels = net->ci;
+	reply.in_height = net->h;
+	reply.in_width = net->w;
+	reply.input_size = net->input_size;
+	reply.output_size = net->output_size;
+	reply.slot_stride = net->slot_stride;
+	reply.output_offset = net->output_offset;
+	strncpy(reply.network, net->name.c_str(), DAEMON_NAME_LEN - 1);
+	err = daemon_send(c->fd, &reply, memfd);
+	close(memfd); // the client holds its own descriptor, the daemon its mapping
+	if (0 != err)
+	{
+		return err;
+	}
+	{
+		std::lock_guard<std::mutex> guard(net->lock);
+		c->net = net;
+		net->stats.clients++;
+	}
+	return 0;
+}
+
+/** submit -> queues the request of a slot and puts the client into the network's rotation
+ */
+int Daemon_server::submit(std::shared_ptr<struct client> &c, const struct daemon_msg &msg)
+{
+	struct daemon_msg reply;
+	struct network *net = c->net;
+
+	if (net != NULL)
+	{
+		std::lock_guard<std::mutex> guard(net->lock);
+		if (msg.slot < c->slots && !c->busy[msg.slot])
+		{
+			c->busy[msg.slot] = true;
+			c->queue.push_back({msg.slot, msg.sequence, now_us()});
+			net->stats.queued++;
+			if (!c->scheduled)
+			{
+				c->scheduled = true;
+				net->rotation.push_back(c);
+			}
+			net->cv.notify_one();
+			return 0;
+		}
+	}
+	// not attached, invalid or busy slot
+	memset(&reply, 0, sizeof(reply));
+	reply.version = DAEMON_PROTOCOL_VERSION;
+	reply.type = DAEMON_ERROR;
+	reply.status = ERROR_OTHER;
+	reply.slot = msg.slot;
+	reply.sequence = msg.sequence;
+	return daemon_send(c->fd, &reply);
+}
+
+/** drop_client -> detaches a disconnected client. Its queued requests are discarded, the
+ * 				  shared memory is unmapped once the executor released the client.
+ */
+void Daemon_server::drop_client(int fd)
+{
+	auto entry = this->clients.find(fd);
+
+	if (entry == this->clients.end())
+	{
+		return;
+	}
+	std::shared_ptr<struct client> c = entry->second;
+	c->closed = true;
+	if (c->net != NULL)
+	{
+		std::lock_guard<std::mutex> guard(c->net->lock);
+		c->net->stats.clients--;
+		c->net->stats.queued -= c->queue.size();
+		c->queue.clear();
+		c->net->rotation.remove(c);
+		c->scheduled = false;
+	}
+	this->clients.erase(entry);
+}
+
+/** executor_loop -> executes the requests of a network's clients round robin
+ */
+void Daemon_server::executor_loop(struct network *net)
+{
+	std::unique_lock<std::mutex> lock(net->lock);
+
+	while (!this->stopping)
+	{
+		if (net->rotation.empty())
+		{
+			net->cv.wait(lock);
+			continue;
+		}
+		std::shared_ptr<struct client> c = net->rotation.front();
+		net->rotation.pop_front();
+		struct request req = c->queue.front();
+		c->queue.pop_front();
+		net->stats.queued--;
+		if (c->queue.empty())
+		{
+			c->scheduled = false;
+		}
+		else
+		{
+			net->rotation.push_back(c); // one request per turn
+		}
+		lock.unlock();
+
+		// input and output stay in the client's slot
+		uint8_t *slot = c->base + (size_t)req.slot * net->slot_stride;
+		uint64_t start = now_us();
+		int err = net->backend->run(slot, (int8_t *)(slot + net->output_offset));
+		uint64_t stop = now_us();
+
+		struct daemon_msg result;
+		memset(&result, 0, sizeof(result));
+		result.version = DAEMON_PROTOCOL_VERSION;
+		result.type = DAEMON_RESULT;
+		result.status = err;
+		result.slot = req.slot;
+		result.sequence = req.sequence;
+		result.queue_us = start - req.enqueue_us;
+		result.exec_us = stop - start;
+
+		lock.lock();
+		c->busy[req.slot] = false;
+		net->stats.executions++;
+		if (0 != err)
+		{
+			net->stats.failures++;
+		}
+		lock.unlock();
+		// the socket stays open while c is referenced. It is non blocking: a client which
+		// does not read its results is disconnected instead of stalling the other clients.
+		if (!c->closed && 0 != daemon_send(c->fd, &result))
+		{
+			c->closed = true;
+			shutdown(c->fd, SHUT_RDWR); // the main loop sees the hangup and drops the client
+		}
+		lock.lock();
+	}
+}
+
+/** get_stats -> counters of a network
+ */
+struct daemon_network_stats Daemon_server::get_stats(const char *name)
+{
+	struct daemon_network_stats stats;
+	auto entry = this->networks.find(name);
+
+	memset(&stats, 0, sizeof(stats));
+	if (entry != this->networks.end())
+	{
+		std::lock_guard<std::mutex> guard(entry->second->lock);
+		stats = entry->second->stats;
+	}
+	return stats;
+}
@@ -0,0 +1,107 @@
+/*
+ * daemon_server.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Inference daemon: owns the execution backends (device or simulation) and their networks and
+ * executes frames submitted by client processes (see daemon_protocol.hpp). Each network has an
+ * executor thread which serves its clients round robin, one request per client and turn, so a
+ * client with many queued frames cannot starve the others. Inputs are read from and outputs
+ * written to the clients' shared memory slots directly.
+ */
+#ifndef SRC_DAEMON_SERVER_H_
+#define SRC_DAEMON_SERVER_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "backend.hpp"
+#include "daemon_protocol.hpp"
+
+/**
+ * daemon_network_stats -> per network counters
+ * @clients: attached clients
+ * @executions: executed requests
+ * @failures: failed executions
+ * @queued: requests waiting for execution
+ */
+struct daemon_network_stats
+{
+    uint32_t clients;
+    uint64_t executions;
+    uint64_t failures;
+    uint32_t queued;
+};
+
+class Daemon_server
+{
+public:
+    Daemon_server(const char *socket_path = DAEMON_SOCKET_PATH, int socket_mode = 0660);
+    ~Daemon_server();
+
+    int add_network(const char *name, Inference_backend *backend);
+    int run();
+    void stop();
+    struct daemon_network_stats get_stats(const char *name);
+
+private:
+    struct request
+    {
+        uint32_t slot;
+        uint64_t sequence;
+        uint64_t enqueue_us;
+    };
+    struct network;
+    struct client
+    {
+        int fd = -1;
+        struct network *net = NULL;
+        uint8_t *base = NULL; // shared slots
+        size_t size = 0;
+        uint32_t slots = 0;
+        std::vector<bool> busy;         // slot submitted and not yet answered
+        std::deque<struct request> queue;
+        bool scheduled = false;         // in the network's rotation
+        std::atomic<bool> closed;
+
+        client() : closed(false) {}
+        ~client();
+    };
+    struct network
+    {
+        std::string name;
+        std::unique_ptr<Inference_backend> backend;
+        int ci, h, w;
+        uint32_t input_size, output_size, slot_stride, output_offset;
+        std::mutex lock;
+        std::condition_variable cv;
+        std::list<std::shared_ptr<struct client>> rotation; // clients with queued requests
+        struct daemon_network_stats stats;
+        std::thread executor;
+    };
+
+    std::string socket_path;
+    int listen_fd = -1;
+    int stop_pipe[2] = {-1, -1};
+    std::atomic<bool> stopping;
+    std::map<std::string, std::unique_ptr<struct network>> networks;
+    std::map<int, std::shared_ptr<struct client>> clients; // by socket, main thread only
+
+    void accept_client();
+    int handle_message(std::shared_ptr<struct client> &c);
+    int open_client(std::shared_ptr<struct client> &c, const struct daemon_msg &msg);
+    int submit(std::shared_ptr<struct client> &c, const struct daemon_msg &msg);
+    void drop_client(int fd);
+    void executor_loop(struct network *net);
+};
+
+#endif /* SRC_DAEMON_SERVER_H_ */
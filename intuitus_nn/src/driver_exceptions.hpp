@@ -99,6 +99,20 @@ private:
         exit(e.getCode());                    \
     }
 
+/**
+ * @brief Check if a condition holds and throw a DMA_Exception if not. Used where no
+ * error code can be returned (constructors). The python wrapper raises a RuntimeError.
+ * @param A The condition that should be checked
+ * @param C The code of the exception
+ * @param M The message that should be printed in case of an error
+ */
+#define CHECK_AND_THROW(A, C, M, ...)         \
+    if (!(A))                                 \
+    {                                         \
+        log_err(C, M, ##__VA_ARGS__);         \
+        throw(DMA_Exception(C, M));           \
+    }
+
 /**
  * @brief Check if a variable is not null. If it is null, an error message is
  * printed and the program exits with error code C  
@@ -1,4 +1,6 @@
 #include "framebuffer.hpp"
+#include "realtime.hpp"
+#include "probes.hpp"
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -16,6 +18,10 @@
 
 Framebuffer::Framebuffer(const char *dev)
 {
+    this->tracker = NULL;
+    this->frames_shown = 0;
+    this->tty_open = 0;
+    this->ttyfd = -1;
     this->fbfd = open(dev, O_RDWR);
     if (this->fbfd == -1)
     {
@@ -49,6 +55,18 @@ Framebuffer::Framebuffer(const char *dev)
 #ifdef DEBUG
     printf("Screen: %d bytes\n", this->screensize);
 #endif
+    if (0 != pixel_format_from_fb(&this->vinfo, &this->pixel_fmt))
+    {
+        printf("Warning: unsupported framebuffer pixel format. show_uyvy is not available\n");
+        this->pixel_fmt.bytes_per_pixel = 0;
+    }
+
+    this->fbp = (uint8_t *)mmap(0, this->screensize, PROT_READ | PROT_WRITE, MAP_SHARED, this->fbfd, 0);
+    if (MAP_FAILED == (void *)this->fbp)
+    {
+        printf("Error: failed to map framebuffer device to memory\n");
+        exit(4);
+    }
 }
 
 Framebuffer::~Framebuffer()
@@ -57,11 +75,16 @@ Framebuffer::~Framebuffer()
     {
         this->close_tty();
     }
+    munmap(this->fbp, this->screensize);
     free(this->screensize_arr);
     close(this->fbfd);
 }
 
-int Framebuffer::show(const uint8_t *img_ptr, int height, int length, int depth, int offs)
+/** show -> copies a BGR image into the framebuffer
+ * @offs: byte offset of the top left pixel in the framebuffer
+ * @sequence: camera frame shown (latency tracker), TRACKER_CURRENT_FRAME for the most recently captured frame
+ */
+int Framebuffer::show(const uint8_t *img_ptr, int height, int length, int depth, int offs, int64_t sequence)
 {
 
     int i;
@@ -69,6 +92,7 @@ int Framebuffer::show(const uint8_t *img_ptr, int height, int length, int depth,
     uint8_t *fb_pos;
 
     size_t img_size = depth * height * length;
+    std::lock_guard<std::mutex> guard(this->show_lock);
 
     if (3 != depth)
     {
@@ -82,21 +106,108 @@ int Framebuffer::show(const uint8_t *img_ptr, int height, int length, int depth,
         return 5;
     }
 
-    this->fbp = (uint8_t *)mmap(0, this->screensize, PROT_READ | PROT_WRITE, MAP_SHARED, this->fbfd, 0);
+    set_graphics_mode();
+    INTUITUS_PROBE2(show_start, this->frames_shown, img_size);
+    fb_pos = this->fbp + offs;
+    for (i = 0; i < height; i++)
+    {
+        memcpy(FB_LINE(i), IMG_LINE(i), length * 3);
+    }
+    INTUITUS_PROBE2(show_done, this->frames_shown, img_size);
+    this->frames_shown++;
+    if (this->tracker != NULL)
+    {
+        this->tracker->mark_frame(sequence, STAGE_DISPLAY);
+    }
+
+    /*for (i=0; i<vinfo.xres; i++) {
+		  for (j=0; j<vinfo.yres; j++) {
+			  for(k=0; k<3; k++){
+				  fbp[m] = test_img[l];
+				  m++;
+			  }
+			  l++;
+		  }
+	  }*/
+    return 0;
+}
 
-    if ((int)this->fbp == -1)
+/** attach_tracker -> marks shown frames as displayed in a latency tracker
+ * @tracker: tracker, NULL to detach
+ */
+void Framebuffer::attach_tracker(Frame_tracker *tracker)
+{
+    std::lock_guard<std::mutex> guard(this->show_lock);
+    this->tracker = tracker;
+}
+
+/** prefault -> maps the framebuffer before the first frame is shown (real-time mode)
+ */
+int Framebuffer::prefault()
+{
+    std::lock_guard<std::mutex> guard(this->show_lock);
+    rt_prefault(this->fbp, this->screensize, 0);
+    return 0;
+}
+
+/** show_uyvy -> shows a camera frame (UYVY) without prior conversion. Color conversion and 
+ *               downscaling are done in one pass into the framebuffer's native pixel format.
+ * @img_ptr: UYVY frame as returned by Camera::capture (depth 2)
+ * @offs: byte offset of the top left pixel in the framebuffer
+ * @scale: downscaling factor (1, 2, 4, ...)
+ * @sequence: camera frame shown (latency tracker), TRACKER_CURRENT_FRAME for the most recently captured frame
+ */
+int Framebuffer::show_uyvy(const uint8_t *img_ptr, int height, int length, int depth, int offs, int scale,
+                           int64_t sequence)
+{
+    int i, out_height, out_length;
+    std::lock_guard<std::mutex> guard(this->show_lock);
+
+    if (2 != depth || 0 != (length & 1))
     {
-        printf("Error: failed to map framebuffer device to memory\n");
-        return (4);
+        printf("Error: Expected UYVY frame with even length. Got matrix with depth %d. Aborting", depth);
+        return 5;
+    }
+    if (scale < 1 || 0 == this->pixel_fmt.bytes_per_pixel)
+    {
+        printf("Error: Invalid scale or unsupported framebuffer format");
+        return 5;
+    }
+    out_height = (height + scale - 1) / scale;
+    out_length = (length + scale - 1) / scale;
+    if (offs < 0 || (offs + (out_height - 1) * (int)this->finfo.line_length +
+                     out_length * this->pixel_fmt.bytes_per_pixel) > this->screensize)
+    {
+        printf("Error: Image size exceeds frame buffer size");
+        return 5;
     }
 
+    set_graphics_mode();
+    INTUITUS_PROBE2(show_start, this->frames_shown, height * length * 2);
+    for (i = 0; i < out_height; i++)
+    {
+        uyvy_to_fb_line(img_ptr + (size_t)i * scale * length * 2, length, scale,
+                        this->fbp + offs + i * this->finfo.line_length, &this->pixel_fmt);
+    }
+    INTUITUS_PROBE2(show_done, this->frames_shown, height * length * 2);
+    this->frames_shown++;
+    if (this->tracker != NULL)
+    {
+        this->tracker->mark_frame(sequence, STAGE_DISPLAY);
+    }
+    return 0;
+}
+
+/** set_graphics_mode -> opens the tty on first use and sets it to graphics mode. Caller holds show_lock.
+ */
+void Framebuffer::set_graphics_mode()
+{
     /* Attempt to open the tty and set it to graphics mode */
     if (0 == this->tty_open)
     {
         this->ttyfd = open("/dev/tty1", O_RDWR);
-        this->tty_open = 1; 
+        this->tty_open = 1;
     }
-    
     if (this->ttyfd == -1)
     {
         printf("Error: could not open the tty\n");
@@ -105,34 +216,20 @@ int Framebuffer::show(const uint8_t *img_ptr, int height, int length, int depth,
     {
         ioctl(this->ttyfd, KDSETMODE, KD_GRAPHICS);
     }
-    fb_pos = this->fbp + offs;
-    for (i = 0; i < height; i++)
-    {
-        memcpy(FB_LINE(i), IMG_LINE(i), length * 3);
-    }
-
-    /*for (i=0; i<vinfo.xres; i++) {
-		  for (j=0; j<vinfo.yres; j++) {
-			  for(k=0; k<3; k++){
-				  fbp[m] = test_img[l];
-				  m++;
-			  }
-			  l++;
-		  }
-	  }*/
-    return 0;
 }
 
 void Framebuffer::close_tty()
 {
-    /* Unmap the memory and release all the files */    
-    munmap(this->fbp, this->screensize);
+    std::lock_guard<std::mutex> guard(this->show_lock);
+    /* Release the tty, the framebuffer stays mapped until destruction */
 
     if (this->ttyfd != -1)
     {
         ioctl(this->ttyfd, KDSETMODE, KD_TEXT);
         close(this->ttyfd);
+        this->ttyfd = -1;
     }
+    this->tty_open = 0;
     return;
 }
 
@@ -9,14 +9,23 @@
 #define SRC_FRAMEBUFFER_H_
 #include <linux/fb.h>
 #include <stdint.h>
+#include <mutex>
+
+#include "frame_tracker.hpp"
+#include "pixel_convert.hpp"
 
 class Framebuffer {
     public:
         Framebuffer(const char* dev);
         ~Framebuffer();
-        int show(const uint8_t* img_ptr, int height, int length, int depth, int offs);
+        int show(const uint8_t* img_ptr, int height, int length, int depth, int offs,
+                 int64_t sequence = TRACKER_CURRENT_FRAME);
+        int show_uyvy(const uint8_t* img_ptr, int height, int length, int depth, int offs, int scale = 1,
+                      int64_t sequence = TRACKER_CURRENT_FRAME);
         void close_tty();
         void get_screensize(int32_t **screen_size, int *dim);
+        void attach_tracker(Frame_tracker *tracker);
+        int prefault();
     private:
         struct fb_var_screeninfo vinfo;
         struct fb_fix_screeninfo finfo;    
@@ -24,8 +33,13 @@ class Framebuffer {
         int fbfd;
         int ttyfd;
         int tty_open; 
-        uint8_t *fbp;
+        uint8_t *fbp; // mapped once in the constructor
+        struct pixel_format pixel_fmt;
         int *screensize_arr;
+        std::mutex show_lock; // guards the mapping and the tty state
+        Frame_tracker *tracker;
+        uint32_t frames_shown; // frame id of the show probes
+        void set_graphics_mode();
 
 };
 
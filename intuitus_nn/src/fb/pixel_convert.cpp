@@ -0,0 +1,152 @@
+#include "pixel_convert.hpp"
+
+#include <string.h>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PIXEL_CONVERT_NEON
+#endif
+
+/** pixel_format_from_fb -> derives the pixel layout from the framebuffer screen info
+ * @return: 0 or -1 if the format is not a supported true color format
+ */
+int pixel_format_from_fb(const struct fb_var_screeninfo *vinfo, struct pixel_format *fmt)
+{
+    memset(fmt, 0, sizeof(*fmt));
+    fmt->bytes_per_pixel = vinfo->bits_per_pixel / 8;
+    if (fmt->bytes_per_pixel < 2 || fmt->bytes_per_pixel > 4 ||
+        vinfo->red.length == 0 || vinfo->green.length == 0 || vinfo->blue.length == 0)
+    {
+        return -1;
+    }
+    fmt->red_offset = vinfo->red.offset;
+    fmt->red_length = vinfo->red.length;
+    fmt->green_offset = vinfo->green.offset;
+    fmt->green_length = vinfo->green.length;
+    fmt->blue_offset = vinfo->blue.offset;
+    fmt->blue_length = vinfo->blue.length;
+    if (vinfo->transp.length > 0)
+    {
+        fmt->fill = ((1u << vinfo->transp.length) - 1) << vinfo->transp.offset;
+    }
+    return 0;
+}
+
+static inline uint8_t clamp_u8(int v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// BT.601 limited range, coefficients scaled by 64 (same as the NEON path)
+static inline void put_pixel(uint8_t *dst, int y, int u, int v, const struct pixel_format *fmt)
+{
+    int c = 74 * (y - 16);
+    int d = u - 128;
+    int e = v - 128;
+    uint32_t r = clamp_u8((c + 102 * e + 32) >> 6);
+    uint32_t g = clamp_u8((c - 25 * d - 52 * e + 32) >> 6);
+    uint32_t b = clamp_u8((c + 129 * d + 32) >> 6);
+    uint32_t pixel = fmt->fill |
+                     ((r >> (8 - fmt->red_length)) << fmt->red_offset) |
+                     ((g >> (8 - fmt->green_length)) << fmt->green_offset) |
+                     ((b >> (8 - fmt->blue_length)) << fmt->blue_offset);
+
+    for (int i = 0; i < fmt->bytes_per_pixel; i++)
+    {
+        dst[i] = pixel >> (8 * i);
+    }
+}
+
+#ifdef PIXEL_CONVERT_NEON
+static inline uint8x8x3_t yuv_to_bgr_neon(uint8x8_t y, int16x8_t rv, int16x8_t guv, int16x8_t bu)
+{
+    uint8x8x3_t bgr;
+    int16x8_t c = vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(16)), 74);
+
+    bgr.val[0] = vqrshrun_n_s16(vqaddq_s16(c, bu), 6);
+    bgr.val[1] = vqrshrun_n_s16(vqaddq_s16(c, guv), 6);
+    bgr.val[2] = vqrshrun_n_s16(vqaddq_s16(c, rv), 6);
+    return bgr;
+}
+
+/** uyvy_to_bgr_neon -> converts 16 source pixels per iteration, returns the number of source pixels done
+ */
+static int uyvy_to_bgr_neon(const uint8_t *src, int width, int scale, uint8_t *dst, int bytes_per_pixel, uint8_t fill)
+{
+    int x;
+
+    for (x = 0; x + 16 <= width; x += 16)
+    {
+        uint8x8x4_t uyvy = vld4_u8(src + 2 * x); // U, Y0, V, Y1 of 8 pixel pairs
+        int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uyvy.val[0])), vdupq_n_s16(128));
+        int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uyvy.val[2])), vdupq_n_s16(128));
+        int16x8_t rv = vmulq_n_s16(e, 102);
+        int16x8_t guv = vaddq_s16(vmulq_n_s16(d, -25), vmulq_n_s16(e, -52));
+        int16x8_t bu = vmulq_n_s16(d, 129);
+        uint8x8x3_t even = yuv_to_bgr_neon(uyvy.val[1], rv, guv, bu);
+
+        if (scale == 2)
+        {
+            if (bytes_per_pixel == 3)
+            {
+                vst3_u8(dst, even);
+            }
+            else
+            {
+                uint8x8x4_t bgrx = {{even.val[0], even.val[1], even.val[2], vdup_n_u8(fill)}};
+                vst4_u8(dst, bgrx);
+            }
+            dst += 8 * bytes_per_pixel;
+            continue;
+        }
+        uint8x8x3_t odd = yuv_to_bgr_neon(uyvy.val[3], rv, guv, bu);
+        uint8x8x2_t b = vzip_u8(even.val[0], odd.val[0]);
+        uint8x8x2_t g = vzip_u8(even.val[1], odd.val[1]);
+        uint8x8x2_t r = vzip_u8(even.val[2], odd.val[2]);
+        if (bytes_per_pixel == 3)
+        {
+            uint8x16x3_t bgr = {{vcombine_u8(b.val[0], b.val[1]), vcombine_u8(g.val[0], g.val[1]),
+                                 vcombine_u8(r.val[0], r.val[1])}};
+            vst3q_u8(dst, bgr);
+        }
+        else
+        {
+            uint8x16x4_t bgrx = {{vcombine_u8(b.val[0], b.val[1]), vcombine_u8(g.val[0], g.val[1]),
+                                  vcombine_u8(r.val[0], r.val[1]), vdupq_n_u8(fill)}};
+            vst4q_u8(dst, bgrx);
+        }
+        dst += 16 * bytes_per_pixel;
+    }
+    return x;
+}
+#endif
+
+/** uyvy_to_fb_line -> converts one camera line into framebuffer pixels. The line is downscaled by
+ * 					   dropping pixels, the caller drops lines accordingly.
+ * @src: UYVY line
+ * @width: source pixels (even)
+ * @scale: downscaling factor (1 -> width pixels, 2 -> width / 2 pixels, ...)
+ * @dst: first framebuffer pixel
+ * @fmt: framebuffer pixel format
+ */
+void uyvy_to_fb_line(const uint8_t *src, int width, int scale, uint8_t *dst,
+                     const struct pixel_format *fmt)
+{
+    int x = 0;
+
+#ifdef PIXEL_CONVERT_NEON
+    // byte order B, G, R (, X)
+    if ((scale == 1 || scale == 2) && fmt->bytes_per_pixel >= 3 &&
+        fmt->blue_offset == 0 && fmt->green_offset == 8 && fmt->red_offset == 16 &&
+        fmt->blue_length == 8 && fmt->green_length == 8 && fmt->red_length == 8)
+    {
+        x = uyvy_to_bgr_neon(src, width, scale, dst, fmt->bytes_per_pixel, fmt->fill >> 24);
+        dst += (x / scale) * fmt->bytes_per_pixel;
+    }
+#endif
+    for (; x < width; x += scale)
+    {
+        const uint8_t *pair = src + 2 * (x & ~1);
+        put_pixel(dst, pair[1 + 2 * (x & 1)], pair[0], pair[2], fmt);
+        dst += fmt->bytes_per_pixel;
+    }
+}
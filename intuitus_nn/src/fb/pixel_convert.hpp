@@ -0,0 +1,30 @@
+/*
+ * pixel_convert.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Conversion of camera lines (UYVY, BT.601 limited range) into the native pixel format
+ * of the framebuffer. NEON is used for BGR888 and XRGB8888 framebuffers on ARM, all other
+ * formats use the scalar path.
+ */
+#ifndef SRC_PIXEL_CONVERT_H_
+#define SRC_PIXEL_CONVERT_H_
+
+#include <stdint.h>
+#include <linux/fb.h>
+
+struct pixel_format
+{
+    int bytes_per_pixel; // 2, 3 or 4
+    uint8_t red_offset, red_length;
+    uint8_t green_offset, green_length;
+    uint8_t blue_offset, blue_length;
+    uint32_t fill; // constant bits (alpha) of each pixel
+};
+
+int pixel_format_from_fb(const struct fb_var_screeninfo *vinfo, struct pixel_format *fmt);
+void uyvy_to_fb_line(const uint8_t *src, int width, int scale, uint8_t *dst,
+                     const struct pixel_format *fmt);
+
+#endif /* SRC_PIXEL_CONVERT_H_ */
@@ -1,6 +1,11 @@
 #include "intuitus.hpp"
 #include "intuitus-intf.h"
 #include "driver_exceptions.hpp"
+#include "command_codec.hpp"
+#include "dma_copy.hpp"
+#include "roi.hpp"
+#include "realtime.hpp"
+#include "probes.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,6 +19,7 @@
 
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 #define TILE_TX_ARRAY(i, j) *(tile_tx_arr + j + (4 * i))
 #define TILE_RX_ARRAY(i, j) *(tile_rx_arr + j + (6 * i))
@@ -24,6 +30,21 @@
 
 #define VERBOSE
 
+/** layer_ioctl -> issues a layer creation ioctl (layer_create probes)
+ * @request: ioctl request
+ * @args: kernel arguments of the request
+ * @layer_id: id of the created layer
+ */
+int Intuitus_intf::layer_ioctl(unsigned long request, void *args, int layer_id)
+{
+	int err;
+
+	INTUITUS_PROBE2(layer_create_start, layer_id, (int)_IOC_NR(request));
+	err = ioctl(this->intuitus_fd, request, args);
+	INTUITUS_PROBE2(layer_create_done, layer_id, err);
+	return err;
+}
+
 /** input_layer --> Creates an input layer
  * @depth: channel number of input layer (3 for RGB, 1 for grayscale)
  * @height: height of input image 
@@ -32,6 +53,7 @@
 int Intuitus_intf::input_layer(uint32_t depth, uint32_t height, uint32_t length)
 {
 	int err;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	struct intuitus_layer_args kernel_args = {
 		.layer_type = Input,
@@ -48,10 +70,14 @@ int Intuitus_intf::input_layer(uint32_t depth, uint32_t height, uint32_t length)
 	this->input_height = height;
 	this->input_depth = depth;
 
-	err = ioctl(this->intuitus_fd, _IOW(0, INPUT_LAYER, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, INPUT_LAYER, sizeof(struct intuitus_layer_args)), &kernel_args, 0);
 	CHECK(0 == err, err, "Failed to create input layer.\n")
 	this->output_intf_ptr = (uint8_t *)this->interface_p->buffer + (length * height * depth); // Set output interface start pointer at the end of the input interface
 	debug("Input intf_p: %p | Output intf_p: %p.\n", this->interface_p->buffer, this->output_intf_ptr);
+	layer_info_add(0, Input, 0, depth, depth, height, length);
+
+	int32_t record[] = {(int32_t)depth, (int32_t)height, (int32_t)length};
+	journal_add(JOURNAL_INPUT, 3, record);
 	return 0;
 }
 
@@ -63,6 +89,7 @@ int Intuitus_intf::input_layer(uint32_t depth, uint32_t height, uint32_t length)
 int Intuitus_intf::output_layer(int layer_id, int src_layer_id)
 {
 	int err;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	struct intuitus_layer_args kernel_args = {
 		.layer_type = Output,
@@ -75,12 +102,16 @@ int Intuitus_intf::output_layer(int layer_id, int src_layer_id)
 		.dst_length = 0,
 		.dst_height = 0};
 
-	err = ioctl(this->intuitus_fd, _IOW(0, OUTPUT_LAYER, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, OUTPUT_LAYER, sizeof(struct intuitus_layer_args)), &kernel_args, layer_id);
 	CHECK(0 == err, err, "Failed to create output layer.\n")
 
 	this->output_size += this->interface_p->length * this->interface_p->height * this->interface_p->depth;
-	this->out_buffer = (int8_t *)realloc(this->out_buffer, this->output_size);
 	debug("New Output size: %d\n",this->output_size);
+	layer_info_add(layer_id, Output, src_layer_id, this->interface_p->depth, this->interface_p->depth,
+				   this->interface_p->height, this->interface_p->length);
+
+	int32_t record[] = {layer_id, src_layer_id};
+	journal_add(JOURNAL_OUTPUT, 2, record);
 	return 0;
 }
 
@@ -107,15 +138,109 @@ int Intuitus_intf::conv2d(int layer_id, int layer_type, int input_buffer_id, uin
 						  const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
 						  const int32_t *command_block, int com_block_dim,
 						  const uint32_t *command_lengths, int com_block_cnt)
+{
+	int err;
+	uint8_t *com_stream;
+	int com_stream_len;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	INTUITUS_PROBE2(conv2d_upload_start, layer_id, (int)(com_block_dim * sizeof(int32_t)));
+	err = conv2d_upload(layer_id, layer_type, input_buffer_id, in_channel_cnt,
+						out_height, out_width, out_channel_cnt, scattered_lines,
+						tile_tx_arr, tile_tx_cnt, tile_tx_dim,
+						tile_rx_arr, tile_rx_cnt, tile_rx_dim,
+						command_block, NULL, com_block_dim,
+						command_lengths, com_block_cnt);
+	INTUITUS_PROBE2(conv2d_upload_done, layer_id, err);
+	if (0 != err || this->replaying)
+	{
+		return err;
+	}
+
+	// the journal keeps command blocks compressed
+	err = encode_command_blocks(command_block, com_block_dim, command_lengths, com_block_cnt, &com_stream, &com_stream_len);
+	CHECK(0 == err, err, "Failed to record layer %d.", layer_id)
+	int32_t record[] = {layer_id, layer_type, input_buffer_id, (int32_t)in_channel_cnt,
+						(int32_t)out_height, (int32_t)out_width, (int32_t)out_channel_cnt, (int32_t)scattered_lines};
+	journal_add(JOURNAL_CONV2D, 8, record);
+	journal_add_tiles(tile_tx_arr, tile_tx_cnt, tile_rx_arr, tile_rx_cnt,
+					  com_stream, com_stream_len, command_lengths, com_block_cnt);
+	free(com_stream);
+	return 0;
+}
+
+/** conv2d_compressed --> Creates a conv2d layer in kernel driver from compressed command blocks.
+ * 						  Command blocks are decoded one by one directly into the kernel interface buffer.
+ * @com_stream: compressed command blocks (see encode_command_blocks).
+ * @com_stream_len: length of compressed command blocks in bytes.
+ * @com_lengths: length of each decoded command block in 32 bit words.
+ * For all other parameters see conv2d.
+ */
+int Intuitus_intf::conv2d_compressed(int layer_id, int layer_type, int input_buffer_id, uint32_t in_channel_cnt,
+									 uint32_t out_height, uint32_t out_width,
+									 uint32_t out_channel_cnt, uint32_t scattered_lines,
+									 const uint32_t *tile_tx_arr, int tile_tx_cnt, int tile_tx_dim,
+									 const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
+									 const uint8_t *com_stream, int com_stream_len,
+									 const uint32_t *command_lengths, int com_block_cnt)
+{
+	int i, err;
+	uint64_t com_block_dim = 0;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	for (i = 0; i < com_block_cnt; i++)
+	{
+		com_block_dim += command_lengths[i];
+	}
+
+	Command_decoder decoder(com_stream, com_stream_len);
+	err = decoder.check_header(com_block_cnt, com_block_dim);
+	CHECK(0 == err, err, "Invalid compressed command blocks for layer %d.", layer_id)
+
+	INTUITUS_PROBE2(conv2d_upload_start, layer_id, (int)(com_block_dim * sizeof(int32_t)));
+	err = conv2d_upload(layer_id, layer_type, input_buffer_id, in_channel_cnt,
+						out_height, out_width, out_channel_cnt, scattered_lines,
+						tile_tx_arr, tile_tx_cnt, tile_tx_dim,
+						tile_rx_arr, tile_rx_cnt, tile_rx_dim,
+						NULL, &decoder, (int)com_block_dim,
+						command_lengths, com_block_cnt);
+	INTUITUS_PROBE2(conv2d_upload_done, layer_id, err);
+	if (0 != err || this->replaying)
+	{
+		return err;
+	}
+
+	int32_t record[] = {layer_id, layer_type, input_buffer_id, (int32_t)in_channel_cnt,
+						(int32_t)out_height, (int32_t)out_width, (int32_t)out_channel_cnt, (int32_t)scattered_lines};
+	journal_add(JOURNAL_CONV2D, 8, record);
+	journal_add_tiles(tile_tx_arr, tile_tx_cnt, tile_rx_arr, tile_rx_cnt,
+					  com_stream, com_stream_len, command_lengths, com_block_cnt);
+	return 0;
+}
+
+/** conv2d_upload --> Creates a conv2d layer in kernel driver and uploads its tx commands and rx tiles.
+ * @command_block: uncompressed command block array. NULL if decoder is used.
+ * @decoder: decoder for compressed command blocks. NULL if command_block is used.
+ * For all other parameters see conv2d.
+ */
+int Intuitus_intf::conv2d_upload(int layer_id, int layer_type, int input_buffer_id, uint32_t in_channel_cnt,
+								 uint32_t out_height, uint32_t out_width,
+								 uint32_t out_channel_cnt, uint32_t scattered_lines,
+								 const uint32_t *tile_tx_arr, int tile_tx_cnt, int tile_tx_dim,
+								 const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
+								 const int32_t *command_block, Command_decoder *decoder, int com_block_dim,
+								 const uint32_t *command_lengths, int com_block_cnt)
 {
 	enum intuitus_layer_types layer_type_enum = (enum intuitus_layer_types)layer_type;
 	int i, j, k, err;
 	int check_length = 0;
+	uint32_t max_com_length = 0;
 	uint8_t last_tile = 0;
 	const int32_t *command_block_pos = 0;
 	struct tile_idx tile;
 	uint32_t tx_scatter_list_size = 0;
 	uint32_t rx_scatter_list_size = 0;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	/*std::cout << "tile_tx: [" << tile_tx_cnt << "," << tile_tx_dim << "]" << std::endl;
 	std::cout << "tile_rx: [" << tile_rx_cnt << "," << tile_rx_dim << "]" << std::endl;
@@ -131,6 +256,8 @@ int Intuitus_intf::conv2d(int layer_id, int layer_type, int input_buffer_id, uin
 	for (i = 0; i < com_block_cnt; i++)
 	{
 		check_length += command_lengths[i];
+		max_com_length = std::max(max_com_length, command_lengths[i]);
+		CHECK(command_lengths[i] * sizeof(int32_t) <= INTF_BUFFER_SIZE, ERROR_MAX_MEMORY_LIMIT, "Command block %d exceeds interface buffer size.", i)
 	}
 	CHECK(com_block_dim == check_length, ERROR_DIMENSION_MISMATCH, "Command block lenght does not match sum of command lengths. Got %d, expected to be %d.", com_block_dim, check_length)
 
@@ -146,7 +273,7 @@ int Intuitus_intf::conv2d(int layer_id, int layer_type, int input_buffer_id, uin
 		.dst_height = out_height,
 		.scattered_lines = (int8_t)scattered_lines};
 
-	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args, layer_id);
 	CHECK(0 == err, err, "Failed to create layer %d.\n", layer_id)
 
 	tx_scatter_list_size = 0;
@@ -164,11 +291,21 @@ int Intuitus_intf::conv2d(int layer_id, int layer_type, int input_buffer_id, uin
 				  << "," << TILE_RX_ARRAY(k, 4) << "]" << std::endl;*/
 		for (j = 0; j < ((int)(in_channel_cnt)); j++)
 		{
-			err = layer_add_command(tile, command_block_pos, COMMAND_LENGTHS(k, j),
-									j, k * in_channel_cnt + j, layer_id);
+			if (decoder != NULL)
+			{
+				// decode next command block straight into the interface buffer
+				err = decoder->next_block((int32_t *)this->interface_p->buffer, COMMAND_LENGTHS(k, j));
+				CHECK(0 == err, err, "Decode commands of layer %d failed at tile %d channel %d", layer_id, k, j)
+				err = layer_submit_command(tile, COMMAND_LENGTHS(k, j), j, k * in_channel_cnt + j, layer_id);
+			}
+			else
+			{
+				err = layer_add_command(tile, command_block_pos, COMMAND_LENGTHS(k, j),
+										j, k * in_channel_cnt + j, layer_id);
+				command_block_pos += COMMAND_LENGTHS(k, j);
+			}
 			CHECK(0 == err, err, "Add commands to layer %d failed at tile %d channel %d", layer_id, k, j)
 
-			command_block_pos += COMMAND_LENGTHS(k, j);
 			tx_scatter_list_size += (tile.y1 - tile.y0) + 1;
 		}
 	}
@@ -199,7 +336,22 @@ int Intuitus_intf::conv2d(int layer_id, int layer_type, int input_buffer_id, uin
 			//std::cout 	<< "In channel: " << j << " id: " << i << std::endl;
 		}
 	}
-	//err = layer_opt_dma(tx_scatter_list_size, rx_scatter_list_size, layer_id);
+	if (layer_dma_opt(layer_id))
+	{
+		err = layer_opt_dma(tx_scatter_list_size, rx_scatter_list_size, layer_id);
+		CHECK(0 == err, err, "Failed to optimize dma of layer %d.", layer_id)
+	}
+
+	struct intuitus_layer_info &info = layer_info_add(layer_id, layer_type, input_buffer_id, in_channel_cnt,
+													  out_channel_cnt, out_height, out_width);
+	info.tx_tiles = tile_tx_cnt;
+	info.rx_tiles = tile_rx_cnt;
+	info.command_blocks = com_block_cnt;
+	info.command_bytes = check_length * sizeof(int32_t);
+	info.max_command_bytes = max_com_length * sizeof(int32_t);
+	info.tx_scatter_list_size = tx_scatter_list_size;
+	info.rx_scatter_list_size = rx_scatter_list_size;
+	info.dma_optimized = layer_dma_opt(layer_id);
 	return err;
 }
 
@@ -223,7 +375,30 @@ int Intuitus_intf::layer_add_command(struct tile_idx src_tile, const int32_t *co
 		.src_tile = src_tile,
 		.channel_idx = channel_idx,
 		.command_id = command_id};
-	memcpy((void *)this->interface_p->buffer, (const void *)com_ptr, sizeof(int32_t) * com_length);
+	dma_copy_to_device((void *)this->interface_p->buffer, (const void *)com_ptr, sizeof(int32_t) * com_length);
+	this->interface_p->length = sizeof(int32_t) * com_length;
+	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_ADD_TX_COM, sizeof(struct intuitus_command_args)), &kernel_args);
+	CHECK(0 == err, err, "Failed to add command for input channel %d.\n", channel_idx)
+	return 0;
+}
+
+/** layer_submit_command ->	adds command to layer in kernel driver
+ * 							expects the command block to be already staged in the interface buffer
+ * @src_tile: start and end points of src tile
+ * @com_length: lenght of staged command block in 32 bit vectors 
+ * @channel_idx: channel id. Indicates position tile in associated tensor
+ * @command_id: command identification number
+ * @layer_id: layer id number
+ */
+int Intuitus_intf::layer_submit_command(struct tile_idx src_tile, uint32_t com_length,
+										int channel_idx, int command_id, int layer_id)
+{
+	int err;
+	struct intuitus_command_args kernel_args = {
+		.layer_id = layer_id,
+		.src_tile = src_tile,
+		.channel_idx = channel_idx,
+		.command_id = command_id};
 	this->interface_p->length = sizeof(int32_t) * com_length;
 	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_ADD_TX_COM, sizeof(struct intuitus_command_args)), &kernel_args);
 	CHECK(0 == err, err, "Failed to add command for input channel %d.\n", channel_idx)
@@ -252,11 +427,9 @@ int Intuitus_intf::layer_add_rx_tile(struct tile_idx dst_tile, int channel_idx,
 	return 0;
 }
 
-/** layer_add_rx_tile ->	adds rx tile to layer in kernel driver
- * 							creates a dma rx descriptor 
- * @dst_tile: start and end points of dst tile
- * @channel_idx: channel id. Indicates position tile in associated tensor
- * @num_channels: number of ouput channels in this load
+/** layer_opt_dma ->	optimizes the dma transfers of a layer (LAYER_OPTIMIZE_DMA)
+ * @tx_scatterlist_size: number of tx scatter list entries
+ * @rx_scatterlist_size: number of rx scatter list entries
  * @layer_id: layer id number
  */
 int Intuitus_intf::layer_opt_dma(uint32_t tx_scatterlist_size, uint32_t rx_scatterlist_size, int layer_id)
@@ -267,8 +440,7 @@ int Intuitus_intf::layer_opt_dma(uint32_t tx_scatterlist_size, uint32_t rx_scatt
 		.tx_scatterlist_size = tx_scatterlist_size,
 		.rx_scatterlist_size = rx_scatterlist_size};
 
-	std::cout << "Tx dma scatterlist size: " << tx_scatterlist_size << std::endl;
-	std::cout << "Rx dma scatterlist size: " << rx_scatterlist_size << std::endl;
+	debug("Layer %d dma scatterlist size tx: %u rx: %u", layer_id, tx_scatterlist_size, rx_scatterlist_size);
 
 	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_OPTIMIZE_DMA, sizeof(struct intuitus_opt_args)), &kernel_args);
 	CHECK(0 == err, err, "Failed to optimize dma transfers for layer %d.\n", layer_id)
@@ -287,9 +459,28 @@ int Intuitus_intf::concat(int concat_layer_id, int layer_1_id, int layer_2_id)
 		.concat_layer_id = concat_layer_id,
 		.layer1_id = layer_1_id,
 		.layer2_id = layer_2_id};
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
-	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_CONCAT, sizeof(struct intuitus_concat_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, LAYER_CONCAT, sizeof(struct intuitus_concat_args)), &kernel_args, concat_layer_id);
 	CHECK(0 == err, err, "Failed to concat layer %d and %d.\n", layer_1_id, layer_2_id)
+
+	{
+		uint32_t channels = 0, height = 0, width = 0;
+		for (int id : {layer_1_id, layer_2_id})
+		{
+			auto src = this->layer_table.find(id);
+			if (src != this->layer_table.end())
+			{
+				channels += src->second.out_channels;
+				height = src->second.out_height;
+				width = src->second.out_width;
+			}
+		}
+		layer_info_add(concat_layer_id, Concat, layer_1_id, channels, channels, height, width).src2_buffer_id = layer_2_id;
+	}
+
+	int32_t record[] = {concat_layer_id, layer_1_id, layer_2_id};
+	journal_add(JOURNAL_CONCAT, 3, record);
 	return err;
 }
 
@@ -307,9 +498,28 @@ int Intuitus_intf::split(int split_layer_id, int in_layer_id, int groups)
 		.split_layer_id = split_layer_id,
 		.in_layer_id = in_layer_id,
 		.groups = groups};
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
-	err = ioctl(this->intuitus_fd, _IOW(0, BUFFER_SPLIT, sizeof(struct intuitus_split_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, BUFFER_SPLIT, sizeof(struct intuitus_split_args)), &kernel_args, split_layer_id);
 	CHECK(0 == err, err, "Failed to split buffer of layer %d.\n", in_layer_id)
+
+	{
+		auto src = this->layer_table.find(in_layer_id);
+		uint32_t channels = 0, height = 0, width = 0;
+		if (src != this->layer_table.end() && groups > 0)
+		{
+			channels = src->second.out_channels / groups;
+			height = src->second.out_height;
+			width = src->second.out_width;
+		}
+		for (int g = 0; g < groups; g++)
+		{
+			layer_info_add(split_layer_id + g, Split, in_layer_id, channels, channels, height, width);
+		}
+	}
+
+	int32_t record[] = {split_layer_id, in_layer_id, groups};
+	journal_add(JOURNAL_SPLIT, 3, record);
 	return err;
 }
 
@@ -324,6 +534,7 @@ int Intuitus_intf::upsample(int upsample_layer_id, int in_buffer_id, uint32_t in
 							uint32_t out_height, uint32_t out_width)
 {
 	int err = 0;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	struct intuitus_layer_args kernel_args = {
 		.layer_type = Upsample,
@@ -337,8 +548,12 @@ int Intuitus_intf::upsample(int upsample_layer_id, int in_buffer_id, uint32_t in
 		.dst_height = out_height,
 		.scattered_lines = 0};
 
-	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args, upsample_layer_id);
 	CHECK(0 == err, err, "Failed to create layer %d.\n", upsample_layer_id)
+	layer_info_add(upsample_layer_id, Upsample, in_buffer_id, in_channel_cnt, in_channel_cnt, out_height, out_width);
+
+	int32_t record[] = {upsample_layer_id, in_buffer_id, (int32_t)in_channel_cnt, (int32_t)out_height, (int32_t)out_width};
+	journal_add(JOURNAL_UPSAMPLE, 5, record);
 	return err;
 }
 
@@ -354,6 +569,7 @@ int Intuitus_intf::maxpool2d(int maxpool_layer_id, int in_buffer_id, uint32_t in
 							 uint32_t out_height, uint32_t out_width, int8_t stride)
 {
 	int err = 0;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	struct intuitus_layer_args kernel_args = {
 		.layer_type = Maxpooling2d,
@@ -367,8 +583,12 @@ int Intuitus_intf::maxpool2d(int maxpool_layer_id, int in_buffer_id, uint32_t in
 		.dst_height = out_height,
 		.scattered_lines = stride};
 
-	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args, maxpool_layer_id);
 	CHECK(0 == err, err, "Failed to create layer %d.\n", maxpool_layer_id)
+	layer_info_add(maxpool_layer_id, Maxpooling2d, in_buffer_id, in_channel_cnt, in_channel_cnt, out_height, out_width);
+
+	int32_t record[] = {maxpool_layer_id, in_buffer_id, (int32_t)in_channel_cnt, (int32_t)out_height, (int32_t)out_width, stride};
+	journal_add(JOURNAL_MAXPOOL2D, 6, record);
 	return err;
 }
 
@@ -383,6 +603,7 @@ int Intuitus_intf::copy(int copy_layer_id, int in_buffer_id, uint32_t in_channel
 						uint32_t out_height, uint32_t out_width)
 {
 	int err = 0;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	struct intuitus_layer_args kernel_args = {
 		.layer_type = Copy,
@@ -396,8 +617,12 @@ int Intuitus_intf::copy(int copy_layer_id, int in_buffer_id, uint32_t in_channel
 		.dst_height = out_height,
 		.scattered_lines = 0};
 
-	err = ioctl(this->intuitus_fd, _IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args);
+	err = layer_ioctl(_IOW(0, LAYER_CREATE, sizeof(struct intuitus_layer_args)), &kernel_args, copy_layer_id);
 	CHECK(0 == err, err, "Failed to create layer %d.\n", copy_layer_id)
+	layer_info_add(copy_layer_id, Copy, in_buffer_id, in_channel_cnt, in_channel_cnt, out_height, out_width);
+
+	int32_t record[] = {copy_layer_id, in_buffer_id, (int32_t)in_channel_cnt, (int32_t)out_height, (int32_t)out_width};
+	journal_add(JOURNAL_COPY, 5, record);
 	return err;
 }
 
@@ -424,7 +649,7 @@ int Intuitus_intf::copy(int copy_layer_id, int in_buffer_id, uint32_t in_channel
 	std::cout << "start execution of layer " << layer_id << std::endl;
 
 	CHECK(size_in < INTF_BUFFER_SIZE, ERROR_DIMENSION_MISMATCH, "Feature map size exeeds buffer size.")
-	memcpy((void *)this->interface_p->buffer, (const void *)fmap_in, size_in);
+	dma_copy_to_device((void *)this->interface_p->buffer, (const void *)fmap_in, size_in);
 	this->interface_p->status = PROXY_NO_ERROR;
 	this->interface_p->depth = ci;
 	this->interface_p->height = h_in;
@@ -441,7 +666,7 @@ int Intuitus_intf::copy(int copy_layer_id, int in_buffer_id, uint32_t in_channel
 
 	size_out = this->interface_p->length * this->interface_p->height * this->interface_p->depth;
 	this->out_buffer = (int8_t *)realloc(this->out_buffer, size_out);
-	memcpy((void *)this->out_buffer, (void *)(this->interface_p->buffer + INTF_BUFFER_SIZE / 2), size_out);
+	dma_copy_from_device((void *)this->out_buffer, (void *)(this->interface_p->buffer + INTF_BUFFER_SIZE / 2), size_out);
 	*co = this->interface_p->depth;
 	*h_out = this->interface_p->height;
 	*w_out = this->interface_p->length;
@@ -454,45 +679,467 @@ int Intuitus_intf::copy(int copy_layer_id, int in_buffer_id, uint32_t in_channel
  * @ci: channel number of input tensor
  * @h_in: height of input tensor 
  * @w_in: width of input tensor 
- * @fmap_out: pointer to output tensor 
- * @co: output channel number 
- * @h_out: output tensor height 
- * @w_out: output tensor width 
+ * @fmap_out: pointer to output tensor. Valid until the next execute of the calling thread or until it exits.
+ * @out_size: output tensor size 
+ * @sequence: camera frame executed (latency tracker), TRACKER_CURRENT_FRAME for the most recently captured frame
  */
 int Intuitus_intf::execute(const uint8_t *fmap_in, int ci, int h_in, int w_in,
-						   int8_t **fmap_out, int *out_size)
+						   int8_t **fmap_out, int *out_size, int64_t sequence)
+{
+	int err;
+	int8_t *out_buffer;
+	if (this->recovering)
+	{
+		count_missed_frame();
+		return ERROR_DEVICE_BUSY;
+	}
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	out_buffer = thread_out_buffer();
+	CHECK_NOT_NULL(out_buffer, ERROR_MEMORY_ALLOC_FAIL)
+	err = run_network(fmap_in, ci, h_in, w_in, out_buffer, sequence);
+	if (0 != err)
+	{
+		return err;
+	}
+	*out_size = this->output_size;
+	*fmap_out = out_buffer;
+	return 0;
+}
+
+/** execute_into -> executes the network and writes the output to a caller provided buffer
+ * 					e.g. a shared memory slot of a daemon client
+ * @fmap_out: destination of the network output
+ * @out_size: size of fmap_out, at least the network output size
+ */
+int Intuitus_intf::execute_into(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+								int8_t *fmap_out, int out_size)
+{
+	if (this->recovering)
+	{
+		count_missed_frame();
+		return ERROR_DEVICE_BUSY;
+	}
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	CHECK(out_size >= this->output_size, ERROR_DIMENSION_MISMATCH, "Output buffer too small.")
+	return run_network(fmap_in, ci, h_in, w_in, fmap_out);
+}
+
+/** execute_batch -> executes the network for a sequence of frames 
+ * 					 The frames are uploaded from where they are, one after another under a single 
+ * 					 device lock, into one output allocation. The device input region is fixed, so 
+ * 					 frame i+1 can only be copied to the interface once frame i has finished.
+ * @frames: input tensors [n, ci, h_in, w_in] (contignous allocation required)
+ * @n: number of frames
+ * @ci: channel number of input tensors
+ * @h_in: height of input tensors 
+ * @w_in: width of input tensors 
+ * @batch_out: output tensors [n, out_size] (allocated using malloc, owned by caller)
+ * @batch: number of output tensors 
+ * @out_size: output tensor size 
+ */
+int Intuitus_intf::execute_batch(const uint8_t *frames, int n, int ci, int h_in, int w_in,
+								 int8_t **batch_out, int *batch, int *out_size)
+{
+	size_t size_in = ci * h_in * w_in;
+
+	// frames are in host memory already: a staging copy would only add a memcpy per frame
+	return run_batch(n, ci, h_in, w_in, [&](int j) { return frames + j * size_in; }, nullptr,
+					 batch_out, batch, out_size);
+}
+
+/** execute_rois -> executes the network for regions of a frame
+ * 					Each region is cropped, resized to the network input and converted to the 
+ * 					network layout while the previous one executes (see execute_batch).
+ * 					Regions of a tile grid are created with roi_tiles, the detections of all 
+ * 					regions are merged with roi_merge_detections.
+ * @img_in: frame [h_in, w_in, ci] (camera layout, may exceed the interface buffer)
+ * @rois: regions [roi_cnt, roi_dim] = x, y, w, h in frame pixels
+ * @batch_out: output tensors [roi_cnt, out_size] (allocated using malloc, owned by caller)
+ * @batch: number of output tensors 
+ * @out_size: output tensor size 
+ */
+int Intuitus_intf::execute_rois(const uint8_t *img_in, int h_in, int w_in, int ci,
+								const int32_t *rois, int roi_cnt, int roi_dim,
+								int8_t **batch_out, int *batch, int *out_size)
+{
+	int err;
+
+	*batch_out = NULL;
+	*batch = 0;
+	*out_size = 0;
+	CHECK(this->input_height > 0 && this->input_width > 0, ERROR_OTHER, "Network has no input layer.")
+	CHECK(ci == (int)this->input_depth, ERROR_DIMENSION_MISMATCH, "Frame channels do not match the network input.")
+	err = roi_validate(rois, roi_cnt, roi_dim, h_in, w_in);
+	if (0 != err)
+	{
+		return err;
+	}
+	const struct roi_rect *regions = (const struct roi_rect *)rois;
+	int h = this->input_height, w = this->input_width;
+	return run_batch(roi_cnt, ci, h, w, nullptr, [&](int j, uint8_t *dst) { roi_stage(img_in, w_in, ci, regions[j], dst, h, w); },
+					 batch_out, batch, out_size);
+}
+
+/** run_batch -> executes the network n times
+ * @input: input(j) returns input j in network layout (executed in place), or
+ * @stage: stage(j, buffer) writes input j to a staging buffer (crop, resize). A helper thread 
+ * 		   stages input i+1 while input i is executed.
+ */
+int Intuitus_intf::run_batch(int n, int ci, int h_in, int w_in, const std::function<const uint8_t *(int)> &input,
+							 const std::function<void(int, uint8_t *)> &stage,
+							 int8_t **batch_out, int *batch, int *out_size)
+{
+	int i, err = 0;
+	size_t size_in = ci * h_in * w_in;
+	uint8_t *staging[BATCH_STAGING_BUFFERS] = {NULL};
+	int8_t *out;
+	int staged = 0;	  // number of frames copied to a staging buffer
+	int consumed = 0; // number of frames whose staging buffer is free again
+	bool abort = false;
+	std::mutex batch_lock;
+	std::condition_variable batch_cv;
+
+	*batch_out = NULL;
+	*batch = 0;
+	*out_size = 0;
+	CHECK(n > 0, ERROR_DIMENSION_MISMATCH, "Empty batch.")
+	CHECK(size_in < INTF_BUFFER_SIZE, ERROR_DIMENSION_MISMATCH, "Feature map size exeeds buffer size.")
+	if (this->recovering)
+	{
+		count_missed_frame();
+		return ERROR_DEVICE_BUSY;
+	}
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	out = (int8_t *)malloc((size_t)n * (this->output_size > 0 ? this->output_size : 1));
+	CHECK_NOT_NULL(out, ERROR_MEMORY_ALLOC_FAIL)
+	if (input)
+	{
+		for (i = 0; i < n && 0 == err; i++)
+		{
+			err = run_network(input(i), ci, h_in, w_in, out + (size_t)i * this->output_size);
+		}
+		if (0 != err)
+		{
+			free(out);
+			return err;
+		}
+		*batch_out = out;
+		*batch = n;
+		*out_size = this->output_size;
+		return 0;
+	}
+	for (i = 0; i < BATCH_STAGING_BUFFERS; i++)
+	{
+		// page aligned, reused from previous batches
+		staging[i] = (uint8_t *)Host_arena::instance().acquire(size_in);
+		if (staging[i] == NULL)
+		{
+			err = ERROR_MEMORY_ALLOC_FAIL;
+		}
+	}
+	if (0 != err)
+	{
+		for (i = 0; i < BATCH_STAGING_BUFFERS; i++)
+		{
+			Host_arena::instance().release(staging[i]);
+		}
+		free(out);
+	}
+	CHECK(0 == err, err, "Failed to allocate staging buffers.")
+
+	std::thread stager([&]() {
+		for (int j = 0; j < n; j++)
+		{
+			{
+				std::unique_lock<std::mutex> lock(batch_lock);
+				batch_cv.wait(lock, [&]() { return abort || consumed >= j - (BATCH_STAGING_BUFFERS - 1); });
+				if (abort)
+				{
+					return;
+				}
+			}
+			stage(j, staging[j % BATCH_STAGING_BUFFERS]);
+			{
+				std::lock_guard<std::mutex> lock(batch_lock);
+				staged = j + 1;
+			}
+			batch_cv.notify_all();
+		}
+	});
+
+	for (i = 0; i < n; i++)
+	{
+		{
+			std::unique_lock<std::mutex> lock(batch_lock);
+			batch_cv.wait(lock, [&]() { return staged > i; });
+		}
+		err = run_network(staging[i % BATCH_STAGING_BUFFERS], ci, h_in, w_in, out + (size_t)i * this->output_size);
+		{
+			std::lock_guard<std::mutex> lock(batch_lock);
+			consumed = i + 1;
+			abort = (0 != err);
+		}
+		batch_cv.notify_all();
+		if (0 != err)
+		{
+			break;
+		}
+	}
+	stager.join();
+	for (i = 0; i < BATCH_STAGING_BUFFERS; i++)
+	{
+		Host_arena::instance().release(staging[i]);
+	}
+	if (0 != err)
+	{
+		free(out);
+		return err;
+	}
+
+	*batch_out = out;
+	*batch = n;
+	*out_size = this->output_size;
+	return 0;
+}
+
+/** execute_pooled -> executes the network into a result buffer taken from the result pool 
+ * 					  The result stays valid until the slot is released (see get_result_pool).
+ * @fmap_in: input tensor (contignous allocation required)
+ * @ci: channel number of input tensor
+ * @h_in: height of input tensor 
+ * @w_in: width of input tensor 
+ * @slot: result pool slot holding the output. Owned by the caller (one reference).
+ * @fmap_out: pointer to output tensor 
+ * @out_size: output tensor size 
+ * @sequence: camera frame executed (latency tracker), TRACKER_CURRENT_FRAME for the most recently captured frame
+ */
+int Intuitus_intf::execute_pooled(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+								  int *slot, int8_t **fmap_out, int *out_size, int64_t sequence)
+{
+	int err;
+	int8_t *out_buffer;
+	if (this->recovering)
+	{
+		count_missed_frame();
+		return ERROR_DEVICE_BUSY;
+	}
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	*slot = this->result_pool->acquire(this->output_size, &out_buffer);
+	CHECK(*slot >= 0, *slot, "No free result buffer. Release results or increase the result pool size.")
+	err = run_network(fmap_in, ci, h_in, w_in, out_buffer, sequence);
+	if (0 != err)
+	{
+		this->result_pool->release(*slot);
+		*slot = -1;
+		return err;
+	}
+	*out_size = this->output_size;
+	*fmap_out = out_buffer;
+	return 0;
+}
+
+/** run_network -> copies the input to the interface, executes the network and copies the output 
+ * 				   Caller has to hold device_lock.
+ * @out_buffer: destination of network output (output_size bytes)
+ * @sequence: camera frame marked in the latency tracker
+ */
+int Intuitus_intf::run_network(const uint8_t *fmap_in, int ci, int h_in, int w_in, int8_t *out_buffer, int64_t sequence)
 {
 	int err;
 	size_t size_in = ci * h_in * w_in;
 
 	int dummy;
+	bool expired;
+	enum proxy_status status;
+	uint32_t exec_id;
 	CHECK(size_in < INTF_BUFFER_SIZE, ERROR_DIMENSION_MISMATCH, "Feature map size exeeds buffer size.")
-	memcpy((void *)this->interface_p->buffer, (const void *)fmap_in, size_in);
+	{
+		std::lock_guard<std::mutex> guard(this->stats_lock);
+		exec_id = ++this->exec_stats.executions;
+	}
+	INTUITUS_PROBE2(exec_start, exec_id, size_in);
+	CHECK(this->interface_p != NULL, execution_failed(ERROR_DEVICE_RECOVERY), "Device is not available.")
+	auto upload = std::chrono::steady_clock::now();
+	dma_copy_to_device((void *)this->interface_p->buffer, (const void *)fmap_in, size_in);
 	this->interface_p->status = PROXY_NO_ERROR;
 	this->interface_p->depth = ci;
 	this->interface_p->height = h_in;
 	this->interface_p->length = w_in;
 
-	auto start = std::chrono::high_resolution_clock::now();
+	if (this->tracker != NULL)
+	{
+		this->tracker->mark_frame(sequence, STAGE_SUBMIT);
+	}
+	auto start = std::chrono::steady_clock::now();
+	arm_deadline();
+	INTUITUS_PROBE1(exec_submit, exec_id);
 	err = ioctl(this->intuitus_fd, _IO(0, NETWORK_EXECUTE), &dummy);
-	CHECK(0 == err, err, "Failed to execute network.")
+	INTUITUS_PROBE1(exec_complete, exec_id);
+	expired = disarm_deadline();
+	CHECK(!(0 != err && EINTR == errno && expired), execution_failed(ERROR_EXECUTION_TIMEOUT), "Network execution exceeded deadline. Execution cancelled.")
+	CHECK(0 == err, execution_failed(err), "Failed to execute network.")
+	status = this->interface_p->status;
+	CHECK(PROXY_TIMEOUT != status, execution_failed(ERROR_EXECUTION_TIMEOUT), "Network execution timed out in driver.")
+	CHECK(PROXY_BUSY != status, execution_failed(ERROR_DEVICE_BUSY), "Device busy.")
+	CHECK(PROXY_ERROR != status, execution_failed(ERROR_DMA), "Network execution failed in driver.")
 	/*auto stop = std::chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
 	cout << "Execution completed successfully after: "
 		 << duration.count() << "µs" << endl;*/
 
-	memcpy((void *)this->out_buffer, (void *)(this->output_intf_ptr), this->output_size);
-	*out_size = this->output_size;
-	*fmap_out = this->out_buffer;
+	auto readout = std::chrono::steady_clock::now();
+	dma_copy_from_device_mt((void *)out_buffer, (void *)(this->output_intf_ptr), this->output_size);
+	auto stop = std::chrono::steady_clock::now();
+	INTUITUS_PROBE2(exec_done, exec_id, this->output_size);
+	if (this->tracker != NULL)
+	{
+		this->tracker->mark_frame(sequence, STAGE_COMPLETE);
+	}
+	{
+		std::lock_guard<std::mutex> guard(this->stats_lock);
+		this->exec_stats.upload_us += std::chrono::duration_cast<std::chrono::microseconds>(start - upload).count();
+		this->exec_stats.execute_us += std::chrono::duration_cast<std::chrono::microseconds>(readout - start).count();
+		this->exec_stats.readout_us += std::chrono::duration_cast<std::chrono::microseconds>(stop - readout).count();
+	}
+	return 0;
+}
+
+/** attach_tracker -> marks submit and completion of executions in a latency tracker.
+ * 					  The marks refer to the frame passed to execute (sequence number), by default to the
+ * 					  frame most recently captured by the tracker.
+ * @tracker: tracker, NULL to detach
+ */
+void Intuitus_intf::attach_tracker(Frame_tracker *tracker)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	this->tracker = tracker;
+}
+
+/** get_result_pool -> returns the pool of execute_pooled results
+ */
+std::shared_ptr<Result_pool> Intuitus_intf::get_result_pool()
+{
+	return this->result_pool;
+}
+
+/** set_result_pool_size -> limits the number of simultaneously referenced results
+ * 							  The pool is unlimited by default. With a limit, execution fails with
+ * 							  ERROR_MAX_MEMORY_LIMIT while max_slots results are still referenced.
+ * @max_slots: maximal number of result buffers (0 -> unlimited)
+ */
+int Intuitus_intf::set_result_pool_size(int max_slots)
+{
+	CHECK(max_slots >= 0, ERROR_OTHER, "Result pool size must not be negative.")
+	this->result_pool->set_max_slots(max_slots);
+	return 0;
+}
+
+/** results_in_use -> returns the number of pooled results which are not yet released
+ */
+int Intuitus_intf::results_in_use()
+{
+	return this->result_pool->slots_in_use();
+}
+
+/** prefault -> maps the interface buffer and the output buffer of the calling thread 
+ * 				before the first execution (real-time mode, see realtime.hpp)
+ */
+int Intuitus_intf::prefault()
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	int8_t *out_buffer;
+
+	CHECK(this->interface_p != NULL, ERROR_DEVICE_RECOVERY, "Device is not available.")
+	rt_prefault(this->interface_p, sizeof(struct intuitus_interface), 0);
+	if (this->output_size > 0)
+	{
+		out_buffer = thread_out_buffer();
+		CHECK_NOT_NULL(out_buffer, ERROR_MEMORY_ALLOC_FAIL)
+		rt_prefault(out_buffer, this->output_size, 1);
+	}
 	return 0;
 }
 
+/** thread_out_buffer -> returns the output buffer of the calling thread 
+ * 						 takes a larger buffer from the arena if the network output size grew.
+ * 						 The buffer is released when the thread exits. Caller has to hold device_lock. 
+ */
+int8_t *Intuitus_intf::thread_out_buffer()
+{
+	// interfaces the calling thread holds a buffer of, released on thread exit
+	static thread_local struct out_buffer_owner_t
+	{
+		std::vector<std::weak_ptr<out_buffer_map>> maps;
+		~out_buffer_owner_t()
+		{
+			for (auto &map : this->maps)
+			{
+				std::shared_ptr<out_buffer_map> owner = map.lock();
+				if (owner)
+				{
+					owner->release(std::this_thread::get_id());
+				}
+			}
+		}
+	} owner;
+	std::lock_guard<std::mutex> guard(this->out_buffers->lock);
+	auto buf = this->out_buffers->buffers.find(std::this_thread::get_id());
+	int8_t *ptr;
+
+	if (buf == this->out_buffers->buffers.end())
+	{
+		buf = this->out_buffers->buffers.emplace(std::this_thread::get_id(), out_buffer_t()).first;
+		owner.maps.erase(std::remove_if(owner.maps.begin(), owner.maps.end(),
+										[](const std::weak_ptr<out_buffer_map> &map) { return map.expired(); }),
+						 owner.maps.end());
+		owner.maps.push_back(this->out_buffers);
+	}
+	if (buf->second.size != this->output_size || buf->second.ptr == NULL)
+	{
+		ptr = (int8_t *)Host_arena::instance().resize(buf->second.ptr, this->output_size);
+		if (ptr == NULL)
+		{
+			return NULL;
+		}
+		buf->second.ptr = ptr;
+		buf->second.size = this->output_size;
+	}
+	return buf->second.ptr;
+}
+
+/** release -> returns the output buffer of a thread to the arena
+ */
+void Intuitus_intf::out_buffer_map::release(std::thread::id id)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	auto buf = this->buffers.find(id);
+
+	if (buf != this->buffers.end())
+	{
+		Host_arena::instance().release(buf->second.ptr);
+		this->buffers.erase(buf);
+	}
+}
+
+Intuitus_intf::out_buffer_map::~out_buffer_map()
+{
+	for (auto &buf : this->buffers)
+	{
+		Host_arena::instance().release(buf.second.ptr);
+	}
+}
+
 /** float8_to_float32 -> converts float8 network output to float32 
  * @fmap_in: input tensor 
  * @ci: channel number of input tensor
  * @h_in: height of input tensor 
  * @w_in: width of input tensor 
- * @fmap_out: pointer to output tensor 
+ * @fmap_out: pointer to output tensor, allocated from the host arena. Owned by the caller (Host_arena::release),
+ * 				the python wrapper hands it to the returned numpy array.
  * @co: output channel number 
  * @h_out: output tensor height 
  * @w_out: output tensor width 
@@ -500,14 +1147,16 @@ int Intuitus_intf::execute(const uint8_t *fmap_in, int ci, int h_in, int w_in,
 int Intuitus_intf::float8_to_float32(const uint8_t *fmap_in, int ci, int h_in, int w_in,
 									 float **fmap_out, int *co, int *h_out, int *w_out)
 {
-	float out[ci * h_in * w_in];
+	float *out;
 	size_t size = ci * h_in * w_in;
-	size_t i;
 
-	for (i = 0; i < size; i++)
-	{
-		out[i] = ((float)(fmap_in[i] & 0xf)) * pow(2.0, (-1) * (fmap_in[i] >> 4) - 4);
-	}
+	*fmap_out = NULL;
+	INTUITUS_PROBE1(float8_start, size);
+	// released buffers of the same size class are reused, steady state conversions map nothing new
+	out = (float *)Host_arena::instance().acquire(size * sizeof(float));
+	CHECK_NOT_NULL(out, ERROR_MEMORY_ALLOC_FAIL)
+	float8_decode(fmap_in, out, size);
+	INTUITUS_PROBE1(float8_done, size);
 	*fmap_out = out;
 	*co = ci;
 	*h_out = h_in;
@@ -521,6 +1170,7 @@ int Intuitus_intf::self_test()
 	int err;
 	unsigned long dummy;
 	auto start = std::chrono::high_resolution_clock::now();
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	err = ioctl(this->intuitus_fd, _IO(0, SELF_TEST), &dummy);
 	CHECK(0 == err, err, "Self test failed. See kernel log for details.\n")
@@ -536,6 +1186,7 @@ int Intuitus_intf::print_network()
 {
 	int err;
 	unsigned long dummy;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
 
 	err = ioctl(this->intuitus_fd, _IO(0, PRINT_NETWORK), &dummy);
 	CHECK(0 == err, err, "Failed to print network. See kernel log for details.\n")
@@ -546,44 +1197,10 @@ int Intuitus_intf::print_network()
 int Intuitus_intf::print_layer(int layer_id)
 {
 	int err;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
 	err = ioctl(this->intuitus_fd, _IO(0, PRINT_LAYER), &layer_id);
 	CHECK(0 == err, err, "Failed to print network. See kernel log for details.\n")
 	std::cout << "Layer structure prined to kernel log. " << std::endl;
 	return 0;
 }
-
-Intuitus_intf::Intuitus_intf()
-{
-	debug("Start init ");
-	this->out_buffer = NULL;
-	// try to get root privileges
-	CHECK_AND_EXIT(geteuid() == 0, ERROR_CREATE_DEVICE, "Driver requires root privileges");
-	// Load dma-proxy driver into kernel
-	if (access(LINUX_DEV_PATH, F_OK) != 0) // Check availability of device
-	{
-		debug("Execute: %s", LINUX_ADD_KERNEL_MODULE_COMMAND);
-		CHECK_AND_EXIT(system(LINUX_ADD_KERNEL_MODULE_COMMAND) == 0, ERROR_CREATE_DEVICE, "Error loading intuitus-vdma kernel module.\nCheck if kernel module is available in given path and AXI VDMA IP core is correctly connected in device tree.");
-	}
-	// open intuitus vdma driver
-	this->intuitus_fd = open(LINUX_DEV_PATH, O_RDWR);
-	CHECK_AND_EXIT(this->intuitus_fd >= 1, ERROR_CREATE_DEVICE, "Unable to open intuitus_vdma device file.\nCheck if intuitus.ko is inserted and intuitus_vdma are available in /dev");
-
-	// Map memory with proxy interfaces for tx and rx device
-	this->interface_p = (struct intuitus_interface *)mmap(NULL, sizeof(struct intuitus_interface),
-														  PROT_READ | PROT_WRITE, MAP_SHARED, this->intuitus_fd, 0);
-}
-
-Intuitus_intf::~Intuitus_intf()
-{
-	// Unmap memory
-	if (this->interface_p != NULL)
-	{
-		CHECK_AND_EXIT(munmap(this->interface_p, sizeof(struct intuitus_interface)) == 0, ERROR_CREATE_DEVICE, "Error unmap kernel interface");
-	}
-	if (this->out_buffer != NULL)
-	{
-		free(this->out_buffer);
-	}
-	close(this->intuitus_fd);
-	debug("Exit intuitus interface.\n");
-}
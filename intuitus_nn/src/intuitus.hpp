@@ -11,15 +11,146 @@
 #define SRC_INTUITUS_H_
 
 #include "intuitus-intf.h"
+#include "command_codec.hpp"
 #include <stdint.h>
+#include <pthread.h>
+#include <signal.h>
+#include <mutex>
+#include <thread>
+#include <map>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include "result_pool.hpp"
+#include "arena.hpp"
+#include "tensor.hpp"
+#include "journal.hpp"
+#include "frame_tracker.hpp"
 //#include <opencv2/core/core.hpp>
 
 #define DRIVER_KEXT_NAME "intuitus.ko"
+#define DRIVER_MODULE_NAME "intuitus"
 #define LINUX_KERNEL_MODULE_PATH "~/intuitus.ko"
 //#define LINUX_KERNEL_MODULE_PATH "/lib/modules/4.9.0-xilinx-v2017.4/extra/intuitus.ko"
-#define LINUX_ADD_KERNEL_MODULE_COMMAND "insmod " LINUX_KERNEL_MODULE_PATH
 #define LINUX_DEV_PATH "/dev/intuitus_vdma"
 
+// result buffers of execute_pooled / execute_result: 0 -> unlimited, every result kept alive holds
+// its own buffer (released ones are reused). set_result_pool_size caps the pool on request.
+#define RESULT_POOL_DEFAULT_SLOTS 0
+
+// execute_rois: host staging buffers (double buffering, page aligned from the arena)
+#define BATCH_STAGING_BUFFERS 2
+
+// Errors of deadline aware execution (extend the codes of intuitus-intf.h)
+#define ERROR_EXECUTION_TIMEOUT (-8)
+#define ERROR_DEVICE_BUSY (-9)
+#define ERROR_DEVICE_RECOVERY (-10)
+
+// Signal used by the watchdog to interrupt a blocking execution ioctl
+#define WATCHDOG_SIGNAL (SIGRTMIN + 1)
+
+// DMA scatter list optimisation modes (LAYER_OPTIMIZE_DMA)
+#define DMA_OPT_OFF 0     // never optimize
+#define DMA_OPT_ALL 1     // optimize all conv2d layers
+#define DMA_OPT_PROFILE 2 // optimize the layers selected in the profile (autotune_dma, load_dma_profile)
+#define DMA_PROFILE_MAGIC "# intuitus dma profile v1"
+#define DMA_TUNE_MIN_GAIN 0.01f // relative speedup required to keep an optimisation
+
+/**
+ * intuitus_exec_stats -> execution and recovery metrics
+ * @executions: number of network executions
+ * @timeouts: executions cancelled because their deadline expired or the driver reported PROXY_TIMEOUT
+ * @device_errors: executions failed with a driver error
+ * @missed_frames: frames without result (timeouts, errors, busy device, rejected during recovery)
+ * @recoveries: successful device re-initialisations
+ * @failed_recoveries: failed device re-initialisations
+ * @last_recovery_us: duration of the last recovery
+ * @total_recovery_us: accumulated duration of all recoveries
+ * @upload_us, @execute_us, @readout_us: accumulated time of the execution stages (input copy, 
+ *                                       device execution, output copy) of successful executions
+ */
+struct intuitus_exec_stats
+{
+    uint32_t executions;
+    uint32_t timeouts;
+    uint32_t device_errors;
+    uint32_t missed_frames;
+    uint32_t recoveries;
+    uint32_t failed_recoveries;
+    uint64_t last_recovery_us;
+    uint64_t total_recovery_us;
+    uint64_t upload_us;
+    uint64_t execute_us;
+    uint64_t readout_us;
+};
+
+/**
+ * intuitus_layer_info -> layer configuration and its memory / DMA footprint
+ * @layer_id: layer id (equal to its output buffer id)
+ * @layer_type: intuitus_layer_types
+ * @src_buffer_id: input buffer id (first input of concat layers)
+ * @src2_buffer_id: second input of concat layers, -1 otherwise
+ * @in_channels, @out_channels, @out_height, @out_width: dimensions
+ * @output_bytes: size of the output feature map
+ * @tx_tiles, @rx_tiles: number of tx and rx tiles
+ * @command_blocks: number of command blocks (tx tiles times input channels)
+ * @command_bytes: size of all command blocks
+ * @max_command_bytes: size of the largest command block (staged in the interface buffer)
+ * @tx_scatter_list_size, @rx_scatter_list_size: DMA scatter list entries as computed in conv2d
+ * @dma_optimized: LAYER_OPTIMIZE_DMA was applied to the layer
+ */
+struct intuitus_layer_info
+{
+    int32_t layer_id;
+    int32_t layer_type;
+    int32_t src_buffer_id;
+    int32_t src2_buffer_id;
+    uint32_t in_channels;
+    uint32_t out_channels;
+    uint32_t out_height;
+    uint32_t out_width;
+    uint32_t output_bytes;
+    uint32_t tx_tiles;
+    uint32_t rx_tiles;
+    uint32_t command_blocks;
+    uint32_t command_bytes;
+    uint32_t max_command_bytes;
+    uint32_t tx_scatter_list_size;
+    uint32_t rx_scatter_list_size;
+    int32_t dma_optimized;
+};
+
+/**
+ * intuitus_network_info -> network totals and interface buffer usage
+ * @layers: number of layers
+ * @command_bytes: command blocks of all layers
+ * @buffer_bytes: feature map buffers allocated by the driver (input and layer outputs)
+ * @tx_scatter_list_size, @rx_scatter_list_size: scatter list entries of all layers
+ * @input_bytes, @output_bytes: input and output region of the interface buffer
+ * @max_command_bytes: largest command block staged in the interface buffer
+ * @intf_buffer_size: INTF_BUFFER_SIZE
+ * @intf_buffer_peak: peak usage of the interface buffer (input + output or largest command block)
+ * @network_status, @execution_status: driver status (NETWORK_STATUS / EXECUTION_STATUS), negative on error
+ */
+struct intuitus_network_info
+{
+    uint32_t layers;
+    uint64_t command_bytes;
+    uint64_t buffer_bytes;
+    uint64_t tx_scatter_list_size;
+    uint64_t rx_scatter_list_size;
+    uint32_t input_bytes;
+    uint32_t output_bytes;
+    uint32_t max_command_bytes;
+    uint32_t intf_buffer_size;
+    uint32_t intf_buffer_peak;
+    int32_t network_status;
+    int32_t execution_status;
+};
+
 #define NDEBUG
 
 class Intuitus_intf
@@ -40,6 +171,13 @@ public:
                const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
                const int32_t *com_block, int com_block_dim,
                const uint32_t *com_lengths, int com_block_cnt);
+    int conv2d_compressed(int layer_id, int layer_type, int input_buffer_id, uint32_t in_channel_cnt,
+                          uint32_t out_height, uint32_t out_width,
+                          uint32_t out_channel_cnt, uint32_t scattered_lines,
+                          const uint32_t *tile_tx_arr, int tile_tx_cnt, int tile_tx_dim,
+                          const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
+                          const uint8_t *com_stream, int com_stream_len,
+                          const uint32_t *com_lengths, int com_block_cnt);
     int concat(int concat_layer_id, int layer_1_id, int layer_2_id);
     int split(int split_layer_id, int in_layer_id, int groups);
     int upsample(int upsample_layer_id, int in_buffer_id, uint32_t in_channel_cnt,
@@ -54,7 +192,42 @@ public:
                       int8_t **fmap_out, int *co, int *h_out, int *w_out);*/
 
     int execute(const uint8_t *fmap_in, int ci, int h_in, int w_in,
-                int8_t **fmap_out, int *out_size);
+                int8_t **fmap_out, int *out_size, int64_t sequence = TRACKER_CURRENT_FRAME);
+
+    int execute_batch(const uint8_t *frames, int n, int ci, int h_in, int w_in,
+                      int8_t **batch_out, int *batch, int *out_size);
+    int execute_rois(const uint8_t *img_in, int h_in, int w_in, int ci,
+                     const int32_t *rois, int roi_cnt, int roi_dim,
+                     int8_t **batch_out, int *batch, int *out_size);
+    int execute_pooled(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+                       int *slot, int8_t **fmap_out, int *out_size,
+                       int64_t sequence = TRACKER_CURRENT_FRAME);
+    int execute_into(const uint8_t *fmap_in, int ci, int h_in, int w_in,
+                     int8_t *fmap_out, int out_size);
+    std::shared_ptr<Result_pool> get_result_pool();
+    int set_result_pool_size(int max_slots);
+    int results_in_use();
+    int prefault();
+
+    int set_deadline(uint32_t timeout_ms);
+    int enable_recovery(int enable);
+    int recover();
+    struct intuitus_exec_stats get_exec_stats();
+    void attach_tracker(Frame_tracker *tracker);
+
+    int layer_count();
+    struct intuitus_layer_info get_layer_info(int index);
+    struct intuitus_network_info get_network_info();
+
+    int set_dma_optimization(int mode);
+    int set_layer_dma_opt(int layer_id, int enable);
+    int autotune_dma(const uint8_t *fmap_in, int ci, int h_in, int w_in, int runs);
+    int save_dma_profile(const char *path);
+    int load_dma_profile(const char *path);
+
+    int save_network(const char *path);
+    int load_network(const char *path);
+    int upload_network(const std::vector<struct journal_record> &records);
 
     int float8_to_float32(const uint8_t *fmap_in, int ci, int h_in, int w_in,
                           float **fmap_out, int *co, int *h_out, int *w_out);
@@ -67,13 +240,103 @@ private:
     uint32_t input_width;
     uint32_t input_depth; // 1 for grayscale, 3 for RGB | Attention: Color channels of cv images have to be splitted
 
-    int8_t *out_buffer;
     uint8_t *output_intf_ptr;
     int output_size = 0;
 
+    // Guards the device file and the shared interface buffer. Public methods lock it,
+    // private helpers expect the caller to hold it. Recursive for journal replay.
+    std::recursive_mutex device_lock;
+    // Output buffers are kept per calling thread so that a thread's result is only
+    // overwritten by its own next call to execute. A buffer is returned to the arena when
+    // its thread exits, so short-lived callers (thread pools) do not accumulate buffers.
+    struct out_buffer_t
+    {
+        int8_t *ptr = NULL;
+        int size = 0;
+    };
+    struct out_buffer_map
+    {
+        std::mutex lock;
+        std::map<std::thread::id, out_buffer_t> buffers;
+        void release(std::thread::id id);
+        ~out_buffer_map();
+    };
+    std::shared_ptr<out_buffer_map> out_buffers = std::make_shared<out_buffer_map>();
+    int8_t *thread_out_buffer();
+    // Pool of results handed out by execute_pooled. Exported results keep it alive.
+    std::shared_ptr<Result_pool> result_pool;
+
+    int run_network(const uint8_t *fmap_in, int ci, int h_in, int w_in, int8_t *out_buffer,
+                    int64_t sequence = TRACKER_CURRENT_FRAME);
+    int layer_ioctl(unsigned long request, void *args, int layer_id);
+    int run_batch(int n, int ci, int h_in, int w_in, const std::function<const uint8_t *(int)> &input,
+                  const std::function<void(int, uint8_t *)> &stage,
+                  int8_t **batch_out, int *batch, int *out_size);
+    // Latency tracker, marks submit and completion of the executed frame
+    Frame_tracker *tracker = NULL;
+
+    // Device handling and recovery (intuitus_recovery.cpp)
+    std::vector<struct journal_record> journal;
+    bool replaying = false;
+    bool recovery_enabled = true;
+    uint32_t deadline_ms = 0;
+    std::thread watchdog;
+    std::mutex watchdog_lock;
+    std::condition_variable watchdog_cv;
+    bool watchdog_stop = false;
+    bool deadline_armed = false;
+    bool recovery_requested = false;
+    std::chrono::steady_clock::time_point deadline;
+    pthread_t exec_thread;
+    std::atomic<bool> deadline_expired;
+    std::atomic<bool> recovering;
+    std::mutex stats_lock;
+    struct intuitus_exec_stats exec_stats;
+
+    int open_device();
+    void close_device();
+    int load_kernel_module();
+    void unload_kernel_module();
+    void journal_add(enum journal_op op, int arg_cnt, const int32_t *args);
+    void journal_add_tiles(const uint32_t *tile_tx_arr, int tile_tx_cnt,
+                           const uint32_t *tile_rx_arr, int tile_rx_cnt,
+                           const uint8_t *com_stream, int com_stream_len,
+                           const uint32_t *com_lengths, int com_block_cnt);
+    int replay_record(const struct journal_record &r);
+    int replay_journal();
+    void start_watchdog();
+    void watchdog_loop();
+    void arm_deadline();
+    bool disarm_deadline();
+    int execution_failed(int err);
+    void count_missed_frame();
+
+    // Layer table for introspection (intuitus_info.cpp), ordered by layer id
+    std::map<int, struct intuitus_layer_info> layer_table;
+    struct intuitus_layer_info &layer_info_add(int layer_id, int layer_type, int src_buffer_id,
+                                               uint32_t in_channels, uint32_t out_channels,
+                                               uint32_t out_height, uint32_t out_width);
+    int query_status(int cmd);
+
+    // DMA optimisation (intuitus_tuning.cpp)
+    int dma_opt_mode = DMA_OPT_OFF;
+    std::map<int, bool> dma_profile;
+    bool layer_dma_opt(int layer_id);
+    int rebuild_network();
+    int time_network(const uint8_t *fmap_in, int ci, int h_in, int w_in, int runs, uint64_t *median_us);
+
     int layer_add_command(struct tile_idx src_tile,
                           const int32_t *com_ptr, uint32_t com_length,
                           int channel_idx, int command_id, int layer_id);
+    int layer_submit_command(struct tile_idx src_tile, uint32_t com_length,
+                             int channel_idx, int command_id, int layer_id);
+    int conv2d_upload(int layer_id, int layer_type, int input_buffer_id, uint32_t in_channel_cnt,
+                      uint32_t out_height, uint32_t out_width,
+                      uint32_t out_channel_cnt, uint32_t scattered_lines,
+                      const uint32_t *tile_tx_arr, int tile_tx_cnt, int tile_tx_dim,
+                      const uint32_t *tile_rx_arr, int tile_rx_cnt, int tile_rx_dim,
+                      const int32_t *com_block, Command_decoder *decoder, int com_block_dim,
+                      const uint32_t *com_lengths, int com_block_cnt);
     int layer_add_rx_tile(struct tile_idx dst_tile, int channel_idx,
                           int tile_id, uint8_t last_tile, int layer_id);
 
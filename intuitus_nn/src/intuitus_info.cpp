@@ -0,0 +1,116 @@
+/*
+ * intuitus_info.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * User space introspection of Intuitus_intf: per layer configuration, memory and DMA
+ * footprint as uploaded to the driver, and the driver's network / execution status.
+ */
+#include "intuitus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <algorithm>
+
+/** layer_info_add -> creates or replaces the table entry of a layer. Caller holds device_lock.
+ * @return: entry for layer specific additions
+ */
+struct intuitus_layer_info &Intuitus_intf::layer_info_add(int layer_id, int layer_type, int src_buffer_id,
+														  uint32_t in_channels, uint32_t out_channels,
+														  uint32_t out_height, uint32_t out_width)
+{
+	struct intuitus_layer_info &info = this->layer_table[layer_id];
+
+	memset(&info, 0, sizeof(info));
+	info.layer_id = layer_id;
+	info.layer_type = layer_type;
+	info.src_buffer_id = src_buffer_id;
+	info.src2_buffer_id = -1;
+	info.in_channels = in_channels;
+	info.out_channels = out_channels;
+	info.out_height = out_height;
+	info.out_width = out_width;
+	info.output_bytes = out_channels * out_height * out_width;
+	return info;
+}
+
+/** query_status -> issues a status ioctl (NETWORK_STATUS, EXECUTION_STATUS). Caller holds device_lock.
+ * @return: status reported by the driver or negative errno
+ */
+int Intuitus_intf::query_status(int cmd)
+{
+	int status = 0;
+
+	if (this->intuitus_fd < 0)
+	{
+		return ERROR_CREATE_DEVICE;
+	}
+	if (0 != ioctl(this->intuitus_fd, _IO(0, cmd), &status))
+	{
+		return -errno;
+	}
+	return status;
+}
+
+/** layer_count -> returns the number of layers in the layer table
+ */
+int Intuitus_intf::layer_count()
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	return (int)this->layer_table.size();
+}
+
+/** get_layer_info -> returns configuration and footprint of a layer
+ * @index: position in the layer table (ordered by layer id), 0 <= index < layer_count()
+ * @return: layer info, layer_id is -1 for an invalid index
+ */
+struct intuitus_layer_info Intuitus_intf::get_layer_info(int index)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	struct intuitus_layer_info info;
+
+	if (index < 0 || index >= (int)this->layer_table.size())
+	{
+		memset(&info, 0, sizeof(info));
+		info.layer_id = -1;
+		return info;
+	}
+	auto it = this->layer_table.begin();
+	std::advance(it, index);
+	return it->second;
+}
+
+/** get_network_info -> returns network totals, interface buffer usage and driver status
+ */
+struct intuitus_network_info Intuitus_intf::get_network_info()
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	struct intuitus_network_info info;
+
+	memset(&info, 0, sizeof(info));
+	info.layers = this->layer_table.size();
+	for (auto &entry : this->layer_table)
+	{
+		const struct intuitus_layer_info &layer = entry.second;
+		info.command_bytes += layer.command_bytes;
+		info.tx_scatter_list_size += layer.tx_scatter_list_size;
+		info.rx_scatter_list_size += layer.rx_scatter_list_size;
+		info.max_command_bytes = std::max(info.max_command_bytes, layer.max_command_bytes);
+		// concat, split and output layers reference existing buffers
+		if (Concat != layer.layer_type && Split != layer.layer_type && Output != layer.layer_type)
+		{
+			info.buffer_bytes += layer.output_bytes;
+		}
+	}
+	info.input_bytes = this->input_depth * this->input_height * this->input_width;
+	info.output_bytes = this->output_size;
+	info.intf_buffer_size = INTF_BUFFER_SIZE;
+	info.intf_buffer_peak = std::max(info.input_bytes + info.output_bytes, info.max_command_bytes);
+	info.network_status = query_status(NETWORK_STATUS);
+	info.execution_status = query_status(EXECUTION_STATUS);
+	return info;
+}
@@ -0,0 +1,476 @@
+/*
+ * intuitus_recovery.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Device handling of Intuitus_intf: opening the device, deadline watchdog and automatic
+ * recovery (device re-initialisation and network upload from the journal).
+ */
+#include "intuitus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "probes.hpp"
+#include "kmod.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+
+static void watchdog_signal_handler(int sig)
+{
+	// Nothing to do. The signal only interrupts the blocking ioctl (EINTR).
+	(void)sig;
+}
+
+/** install_watchdog_signal -> installs the watchdog signal handler without SA_RESTART 
+ * 							   so interrupted ioctls return EINTR instead of being restarted.
+ */
+static void install_watchdog_signal()
+{
+	static std::once_flag installed;
+	std::call_once(installed, []() {
+		struct sigaction sa;
+		memset(&sa, 0, sizeof(sa));
+		sa.sa_handler = watchdog_signal_handler;
+		sigemptyset(&sa.sa_mask);
+		sa.sa_flags = 0;
+		sigaction(WATCHDOG_SIGNAL, &sa, NULL);
+	});
+}
+
+/** load_kernel_module -> inserts the intuitus kernel module (finit_module) if the device is not available
+ */
+int Intuitus_intf::load_kernel_module()
+{
+	int err = kmod_ensure_device(DRIVER_MODULE_NAME, LINUX_KERNEL_MODULE_PATH, LINUX_DEV_PATH, NULL);
+	CHECK(0 == err, ERROR_CREATE_DEVICE, "Error loading intuitus-vdma kernel module.\nCheck if kernel module is available in given path and AXI VDMA IP core is correctly connected in device tree.")
+	return 0;
+}
+
+/** unload_kernel_module -> removes the intuitus kernel module to reset the driver state
+ * 							Fails silently if the module is built in or still in use by another process.
+ */
+void Intuitus_intf::unload_kernel_module()
+{
+	if (syscall(SYS_delete_module, DRIVER_MODULE_NAME, O_NONBLOCK) != 0)
+	{
+		debug("Kernel module not removed: %s", clean_errno());
+	}
+}
+
+/** open_device -> loads the kernel module, opens the device and maps the kernel interface
+ */
+int Intuitus_intf::open_device()
+{
+	int err;
+
+	// try to get root privileges
+	CHECK(geteuid() == 0, ERROR_CREATE_DEVICE, "Driver requires root privileges")
+	// Load dma-proxy driver into kernel
+	err = load_kernel_module();
+	if (0 != err)
+	{
+		return err;
+	}
+	// open intuitus vdma driver
+	this->intuitus_fd = open(LINUX_DEV_PATH, O_RDWR);
+	CHECK(this->intuitus_fd >= 1, ERROR_CREATE_DEVICE, "Unable to open intuitus_vdma device file.\nCheck if intuitus.ko is inserted and intuitus_vdma are available in /dev")
+
+	// Map memory with proxy interfaces for tx and rx device
+	this->interface_p = (struct intuitus_interface *)mmap(NULL, sizeof(struct intuitus_interface),
+														  PROT_READ | PROT_WRITE, MAP_SHARED, this->intuitus_fd, 0);
+	if (this->interface_p == MAP_FAILED)
+	{
+		this->interface_p = NULL;
+		close(this->intuitus_fd);
+		this->intuitus_fd = -1;
+	}
+	CHECK(this->interface_p != NULL, ERROR_CREATE_DEVICE, "Unable to map kernel interface.")
+	return 0;
+}
+
+/** close_device -> unmaps the kernel interface and closes the device
+ */
+void Intuitus_intf::close_device()
+{
+	if (this->interface_p != NULL)
+	{
+		CHECK_WARNING(munmap(this->interface_p, sizeof(struct intuitus_interface)) == 0, ERROR_CREATE_DEVICE, "Error unmap kernel interface")
+		this->interface_p = NULL;
+	}
+	if (this->intuitus_fd >= 0)
+	{
+		close(this->intuitus_fd);
+		this->intuitus_fd = -1;
+	}
+}
+
+/** journal_add -> records a successfully created layer. Caller has to hold device_lock.
+ * @op: layer creation call
+ * @arg_cnt: number of scalar arguments
+ * @args: scalar arguments
+ */
+void Intuitus_intf::journal_add(enum journal_op op, int arg_cnt, const int32_t *args)
+{
+	struct journal_record record;
+
+	if (this->replaying)
+	{
+		return;
+	}
+	record.op = op;
+	memset(record.args, 0, sizeof(record.args));
+	memcpy(record.args, args, sizeof(int32_t) * arg_cnt);
+	this->journal.push_back(record);
+}
+
+/** journal_add_tiles -> adds tile arrays and compressed command blocks to the last (conv2d) record
+ */
+void Intuitus_intf::journal_add_tiles(const uint32_t *tile_tx_arr, int tile_tx_cnt,
+									  const uint32_t *tile_rx_arr, int tile_rx_cnt,
+									  const uint8_t *com_stream, int com_stream_len,
+									  const uint32_t *com_lengths, int com_block_cnt)
+{
+	struct journal_record &record = this->journal.back();
+
+	record.tile_tx.assign(tile_tx_arr, tile_tx_arr + 4 * tile_tx_cnt);
+	record.tile_rx.assign(tile_rx_arr, tile_rx_arr + 6 * tile_rx_cnt);
+	record.com_stream.assign(com_stream, com_stream + com_stream_len);
+	record.com_lengths.assign(com_lengths, com_lengths + com_block_cnt);
+}
+
+/** replay_record -> creates the layer of a journal record. Caller has to hold device_lock.
+ */
+int Intuitus_intf::replay_record(const struct journal_record &r)
+{
+	const int32_t *a = r.args;
+
+	switch (r.op)
+	{
+	case JOURNAL_INPUT:
+		return input_layer(a[0], a[1], a[2]);
+	case JOURNAL_OUTPUT:
+		return output_layer(a[0], a[1]);
+	case JOURNAL_CONV2D:
+		return conv2d_compressed(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7],
+								 r.tile_tx.data(), (int)(r.tile_tx.size() / 4), 4,
+								 r.tile_rx.data(), (int)(r.tile_rx.size() / 6), 6,
+								 r.com_stream.data(), (int)r.com_stream.size(),
+								 r.com_lengths.data(), (int)r.com_lengths.size());
+	case JOURNAL_CONCAT:
+		return concat(a[0], a[1], a[2]);
+	case JOURNAL_SPLIT:
+		return split(a[0], a[1], a[2]);
+	case JOURNAL_UPSAMPLE:
+		return upsample(a[0], a[1], a[2], a[3], a[4]);
+	case JOURNAL_MAXPOOL2D:
+		return maxpool2d(a[0], a[1], a[2], a[3], a[4], (int8_t)a[5]);
+	case JOURNAL_COPY:
+		return copy(a[0], a[1], a[2], a[3], a[4]);
+	}
+	return ERROR_OTHER;
+}
+
+/** replay_journal -> uploads the recorded network to the device. Caller has to hold device_lock.
+ */
+int Intuitus_intf::replay_journal()
+{
+	int err = 0;
+
+	this->replaying = true;
+	this->output_size = 0;
+	for (auto &r : this->journal)
+	{
+		err = replay_record(r);
+		if (0 != err)
+		{
+			break;
+		}
+	}
+	this->replaying = false;
+	CHECK(0 == err, err, "Failed to upload network from journal.")
+	return 0;
+}
+
+/** save_network -> writes the uploaded network to a network file
+ * @path: network file, loaded by load_network or tools/intuitus_bench
+ */
+int Intuitus_intf::save_network(const char *path)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	CHECK(!this->journal.empty(), ERROR_OTHER, "No network to save.")
+	return journal_save(path, this->journal);
+}
+
+/** load_network -> creates all layers of a network file
+ * 					 Only possible before the first layer is created.
+ * @path: network file written by save_network
+ */
+int Intuitus_intf::load_network(const char *path)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	std::vector<struct journal_record> records;
+	int err;
+
+	CHECK(this->journal.empty(), ERROR_OTHER, "Network already created.")
+	err = journal_load(path, records);
+	if (0 != err)
+	{
+		return err;
+	}
+	return upload_network(records);
+}
+
+/** upload_network -> creates all layers of a network read by journal_load
+ * 					   (file reading can overlap device start-up, see startup.hpp)
+ * 					   Only possible before the first layer is created.
+ * @records: layer creation calls of a network file
+ */
+int Intuitus_intf::upload_network(const std::vector<struct journal_record> &records)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	int err;
+
+	CHECK(this->journal.empty(), ERROR_OTHER, "Network already created.")
+	for (auto &r : records)
+	{
+		// layers journal themselves, the network can be recovered and saved again
+		err = replay_record(r);
+		CHECK(0 == err, err, "Failed to create layer of network file.")
+	}
+	return 0;
+}
+
+/** rebuild_network -> re-initialises the device and uploads the network from the journal. Caller holds device_lock.
+ */
+int Intuitus_intf::rebuild_network()
+{
+	int err;
+
+	close_device();
+	unload_kernel_module();
+	err = open_device();
+	if (0 == err)
+	{
+		err = replay_journal();
+	}
+	return err;
+}
+
+/** recover -> re-initialises the device and uploads the network again
+ * 			   Executions arriving during recovery are rejected with ERROR_DEVICE_BUSY.
+ */
+int Intuitus_intf::recover()
+{
+	int err;
+	uint64_t duration;
+
+	this->recovering = true;
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	auto start = std::chrono::steady_clock::now();
+
+	err = rebuild_network();
+
+	duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	{
+		std::lock_guard<std::mutex> stats_guard(this->stats_lock);
+		this->exec_stats.last_recovery_us = duration;
+		this->exec_stats.total_recovery_us += duration;
+		if (0 == err)
+		{
+			this->exec_stats.recoveries++;
+		}
+		else
+		{
+			this->exec_stats.failed_recoveries++;
+		}
+	}
+	this->recovering = false;
+	CHECK(0 == err, ERROR_DEVICE_RECOVERY, "Device recovery failed.")
+	log_info("Device recovered.");
+	return 0;
+}
+
+/** set_deadline -> sets the deadline of each network execution
+ * 					An execution exceeding the deadline is cancelled and the device is recovered.
+ * @timeout_ms: deadline in ms (0 -> wait indefinitely)
+ */
+int Intuitus_intf::set_deadline(uint32_t timeout_ms)
+{
+	std::lock_guard<std::mutex> guard(this->watchdog_lock);
+	this->deadline_ms = timeout_ms;
+	if (timeout_ms > 0)
+	{
+		install_watchdog_signal();
+		start_watchdog();
+	}
+	return 0;
+}
+
+/** enable_recovery -> enables or disables automatic recovery after timeouts and device errors
+ * @enable: 1 -> recover automatically, 0 -> only report the error
+ */
+int Intuitus_intf::enable_recovery(int enable)
+{
+	std::lock_guard<std::mutex> guard(this->watchdog_lock);
+	this->recovery_enabled = (0 != enable);
+	return 0;
+}
+
+struct intuitus_exec_stats Intuitus_intf::get_exec_stats()
+{
+	std::lock_guard<std::mutex> guard(this->stats_lock);
+	return this->exec_stats;
+}
+
+/** start_watchdog -> starts the watchdog thread if it is not running. Caller has to hold watchdog_lock.
+ */
+void Intuitus_intf::start_watchdog()
+{
+	if (!this->watchdog.joinable())
+	{
+		this->watchdog_stop = false;
+		this->watchdog = std::thread(&Intuitus_intf::watchdog_loop, this);
+	}
+}
+
+/** watchdog_loop -> interrupts executions exceeding their deadline and runs requested recoveries
+ */
+void Intuitus_intf::watchdog_loop()
+{
+	std::unique_lock<std::mutex> lock(this->watchdog_lock);
+
+	while (!this->watchdog_stop)
+	{
+		if (this->recovery_requested)
+		{
+			this->recovery_requested = false;
+			lock.unlock();
+			recover();
+			lock.lock();
+		}
+		else if (this->deadline_armed)
+		{
+			if (std::chrono::steady_clock::now() >= this->deadline)
+			{
+				this->deadline_armed = false;
+				this->deadline_expired = true;
+				pthread_kill(this->exec_thread, WATCHDOG_SIGNAL);
+			}
+			else
+			{
+				this->watchdog_cv.wait_until(lock, this->deadline);
+			}
+		}
+		else
+		{
+			this->watchdog_cv.wait(lock);
+		}
+	}
+}
+
+/** arm_deadline -> starts deadline supervision of the calling thread's execution
+ */
+void Intuitus_intf::arm_deadline()
+{
+	std::lock_guard<std::mutex> guard(this->watchdog_lock);
+	this->deadline_expired = false;
+	if (this->deadline_ms > 0)
+	{
+		this->exec_thread = pthread_self();
+		this->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->deadline_ms);
+		this->deadline_armed = true;
+		this->watchdog_cv.notify_all();
+	}
+}
+
+/** disarm_deadline -> stops deadline supervision
+ * @return: true if the deadline expired during the execution
+ */
+bool Intuitus_intf::disarm_deadline()
+{
+	std::lock_guard<std::mutex> guard(this->watchdog_lock);
+	this->deadline_armed = false;
+	return this->deadline_expired;
+}
+
+/** execution_failed -> accounts a failed execution and requests a recovery if the device hangs
+ * @err: execution error
+ * @return: err
+ */
+int Intuitus_intf::execution_failed(int err)
+{
+	{
+		std::lock_guard<std::mutex> guard(this->stats_lock);
+		INTUITUS_PROBE2(exec_failed, this->exec_stats.executions, err);
+		if (ERROR_EXECUTION_TIMEOUT == err)
+		{
+			this->exec_stats.timeouts++;
+		}
+		else if (ERROR_DEVICE_BUSY != err)
+		{
+			this->exec_stats.device_errors++;
+		}
+		this->exec_stats.missed_frames++;
+	}
+	if (ERROR_DEVICE_BUSY != err)
+	{
+		std::lock_guard<std::mutex> guard(this->watchdog_lock);
+		if (this->recovery_enabled)
+		{
+			this->recovery_requested = true;
+			start_watchdog();
+			this->watchdog_cv.notify_all();
+		}
+	}
+	return err;
+}
+
+/** count_missed_frame -> accounts a frame rejected before execution (e.g. during recovery)
+ */
+void Intuitus_intf::count_missed_frame()
+{
+	std::lock_guard<std::mutex> guard(this->stats_lock);
+	this->exec_stats.missed_frames++;
+}
+
+Intuitus_intf::Intuitus_intf()
+{
+	int err;
+
+	debug("Start init ");
+	this->result_pool = std::make_shared<Result_pool>(RESULT_POOL_DEFAULT_SLOTS);
+	this->interface_p = NULL;
+	this->intuitus_fd = -1;
+	this->input_depth = 0;
+	this->input_height = 0;
+	this->input_width = 0;
+	this->deadline_expired = false;
+	this->recovering = false;
+	memset(&this->exec_stats, 0, sizeof(this->exec_stats));
+
+	err = open_device();
+	CHECK_AND_THROW(0 == err, err, "Failed to initialize intuitus device.")
+}
+
+Intuitus_intf::~Intuitus_intf()
+{
+	{
+		std::lock_guard<std::mutex> guard(this->watchdog_lock);
+		this->watchdog_stop = true;
+		this->watchdog_cv.notify_all();
+	}
+	if (this->watchdog.joinable())
+	{
+		this->watchdog.join();
+	}
+	close_device();
+	debug("Exit intuitus interface.\n");
+}
@@ -0,0 +1,202 @@
+/*
+ * intuitus_tuning.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * DMA scatter list optimisation of Intuitus_intf. LAYER_OPTIMIZE_DMA can not be undone
+ * for an uploaded layer, so changing the selection rebuilds the network from the journal.
+ */
+#include "intuitus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+/** layer_dma_opt -> returns whether LAYER_OPTIMIZE_DMA is applied to a layer. Caller holds device_lock.
+ */
+bool Intuitus_intf::layer_dma_opt(int layer_id)
+{
+	if (DMA_OPT_ALL == this->dma_opt_mode)
+	{
+		return true;
+	}
+	if (DMA_OPT_PROFILE == this->dma_opt_mode)
+	{
+		auto it = this->dma_profile.find(layer_id);
+		return it != this->dma_profile.end() && it->second;
+	}
+	return false;
+}
+
+/** set_dma_optimization -> selects which conv2d layers are DMA optimized.
+ * 							An already uploaded network is rebuilt.
+ * @mode: DMA_OPT_OFF, DMA_OPT_ALL or DMA_OPT_PROFILE
+ */
+int Intuitus_intf::set_dma_optimization(int mode)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+
+	CHECK(DMA_OPT_OFF == mode || DMA_OPT_ALL == mode || DMA_OPT_PROFILE == mode, ERROR_OTHER, "Invalid dma optimization mode %d.", mode)
+	if (mode == this->dma_opt_mode)
+	{
+		return 0;
+	}
+	this->dma_opt_mode = mode;
+	if (this->journal.empty())
+	{
+		return 0;
+	}
+	return rebuild_network();
+}
+
+/** set_layer_dma_opt -> selects a layer for DMA optimisation in the profile (DMA_OPT_PROFILE).
+ * 						 Takes effect for layers uploaded afterwards or on the next rebuild.
+ * @layer_id: conv2d layer id
+ * @enable: 1 -> optimize, 0 -> do not optimize
+ */
+int Intuitus_intf::set_layer_dma_opt(int layer_id, int enable)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	this->dma_profile[layer_id] = (0 != enable);
+	return 0;
+}
+
+/** time_network -> returns the median execution time of the network. Caller holds device_lock.
+ * @runs: number of timed executions (after one warm up execution)
+ */
+int Intuitus_intf::time_network(const uint8_t *fmap_in, int ci, int h_in, int w_in, int runs, uint64_t *median_us)
+{
+	std::vector<uint64_t> times;
+	int8_t *out_buffer = thread_out_buffer();
+	int err;
+
+	CHECK_NOT_NULL(out_buffer, ERROR_MEMORY_ALLOC_FAIL)
+	err = run_network(fmap_in, ci, h_in, w_in, out_buffer);
+	CHECK(0 == err, err, "Warm up execution failed.")
+	for (int i = 0; i < runs; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		err = run_network(fmap_in, ci, h_in, w_in, out_buffer);
+		CHECK(0 == err, err, "Timed execution failed.")
+		times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	*median_us = times[times.size() / 2];
+	return 0;
+}
+
+/** autotune_dma -> times the network with and without DMA optimisation of each conv2d layer and
+ * 					keeps the optimisation where it is faster. Layers are tuned one after another
+ * 					on top of the previous choices, each trial rebuilds the network.
+ * 					Afterwards the network runs in DMA_OPT_PROFILE mode with the tuned profile.
+ * @fmap_in: representative input tensor
+ * @runs: timed executions per trial
+ */
+int Intuitus_intf::autotune_dma(const uint8_t *fmap_in, int ci, int h_in, int w_in, int runs)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	std::vector<int> conv_layers;
+	uint64_t best_us, trial_us;
+	bool rebuild = false;
+	int err;
+
+	CHECK(runs > 0, ERROR_OTHER, "Autotuning requires at least one run.")
+	CHECK(!this->journal.empty() && this->output_size > 0, ERROR_OTHER, "Network has to be built before autotuning.")
+	for (auto &entry : this->layer_table)
+	{
+		if (entry.second.tx_tiles > 0 && entry.second.layer_type != Input && entry.second.layer_type != Output)
+		{
+			conv_layers.push_back(entry.first);
+		}
+	}
+
+	this->dma_opt_mode = DMA_OPT_PROFILE;
+	this->dma_profile.clear();
+	err = rebuild_network();
+	CHECK(0 == err, err, "Failed to rebuild network without dma optimization.")
+	err = time_network(fmap_in, ci, h_in, w_in, runs, &best_us);
+	CHECK(0 == err, err, "Failed to time network.")
+	debug("DMA autotuning baseline: %llu us", (unsigned long long)best_us);
+
+	for (int layer_id : conv_layers)
+	{
+		this->dma_profile[layer_id] = true;
+		err = rebuild_network();
+		CHECK(0 == err, err, "Failed to rebuild network for layer %d.", layer_id)
+		err = time_network(fmap_in, ci, h_in, w_in, runs, &trial_us);
+		CHECK(0 == err, err, "Failed to time network for layer %d.", layer_id)
+		debug("DMA autotuning layer %d: %llu us (best %llu us)", layer_id, (unsigned long long)trial_us, (unsigned long long)best_us);
+		if (trial_us < best_us * (1.0f - DMA_TUNE_MIN_GAIN))
+		{
+			best_us = trial_us;
+			rebuild = false;
+		}
+		else
+		{
+			this->dma_profile[layer_id] = false;
+			rebuild = true;
+		}
+	}
+	if (rebuild)
+	{
+		err = rebuild_network();
+		CHECK(0 == err, err, "Failed to rebuild network with tuned profile.")
+	}
+	return 0;
+}
+
+/** save_dma_profile -> writes the DMA profile (one "layer_id enabled" line per layer)
+ * @path: profile file, e.g. next to the model's command files
+ */
+int Intuitus_intf::save_dma_profile(const char *path)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	std::ofstream file(path);
+
+	CHECK(file.is_open(), ERROR_OTHER, "Failed to create dma profile.")
+	file << DMA_PROFILE_MAGIC << std::endl;
+	for (auto &entry : this->dma_profile)
+	{
+		file << entry.first << " " << (entry.second ? 1 : 0) << std::endl;
+	}
+	CHECK(file.good(), ERROR_OTHER, "Failed to write dma profile.")
+	return 0;
+}
+
+/** load_dma_profile -> loads a DMA profile and switches to DMA_OPT_PROFILE.
+ * 						An already uploaded network is rebuilt.
+ * @path: profile file written by save_dma_profile
+ */
+int Intuitus_intf::load_dma_profile(const char *path)
+{
+	std::lock_guard<std::recursive_mutex> guard(this->device_lock);
+	std::ifstream file(path);
+	std::map<int, bool> profile;
+	std::string line;
+	int layer_id, enable;
+
+	CHECK(file.is_open(), ERROR_OTHER, "Failed to open dma profile.")
+	CHECK(std::getline(file, line) && line == DMA_PROFILE_MAGIC, ERROR_OTHER, "Invalid dma profile.")
+	while (std::getline(file, line))
+	{
+		std::istringstream fields(line);
+		if (line.empty())
+		{
+			continue;
+		}
+		CHECK(fields >> layer_id >> enable, ERROR_OTHER, "Invalid dma profile entry.")
+		profile[layer_id] = (0 != enable);
+	}
+	this->dma_profile = profile;
+	this->dma_opt_mode = DMA_OPT_PROFILE;
+	if (this->journal.empty())
+	{
+		return 0;
+	}
+	return rebuild_network();
+}
@@ -0,0 +1,100 @@
+/*
+ * journal.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Network files: binary image of the network journal (host byte order).
+ */
+#include "journal.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <fstream>
+
+// Upper bounds of a single record and of the record count, protect against corrupted files
+#define JOURNAL_FILE_MAX_ARRAY (64 * 1024 * 1024)
+#define JOURNAL_FILE_MAX_RECORDS (64 * 1024)
+
+template <typename T>
+static bool write_array(std::ofstream &file, const std::vector<T> &v)
+{
+	return (bool)file.write((const char *)v.data(), v.size() * sizeof(T));
+}
+
+template <typename T>
+static bool read_array(std::ifstream &file, std::vector<T> &v, uint32_t cnt)
+{
+	if (cnt > JOURNAL_FILE_MAX_ARRAY / sizeof(T))
+	{
+		return false;
+	}
+	v.resize(cnt);
+	return (bool)file.read((char *)v.data(), cnt * sizeof(T));
+}
+
+/** journal_save -> writes the journal to a network file
+ * @path: network file
+ * @journal: recorded layer creation calls
+ */
+int journal_save(const char *path, const std::vector<struct journal_record> &journal)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	struct journal_file_header header = {JOURNAL_FILE_MAGIC, JOURNAL_FILE_VERSION, (uint32_t)journal.size(), 0};
+
+	CHECK(file.is_open(), ERROR_OTHER, "Failed to create network file.")
+	file.write((const char *)&header, sizeof(header));
+	for (auto &r : journal)
+	{
+		struct journal_file_entry entry;
+		entry.op = r.op;
+		memcpy(entry.args, r.args, sizeof(entry.args));
+		entry.tile_tx_cnt = r.tile_tx.size();
+		entry.tile_rx_cnt = r.tile_rx.size();
+		entry.com_lengths_cnt = r.com_lengths.size();
+		entry.com_stream_len = r.com_stream.size();
+		file.write((const char *)&entry, sizeof(entry));
+		write_array(file, r.tile_tx);
+		write_array(file, r.tile_rx);
+		write_array(file, r.com_lengths);
+		write_array(file, r.com_stream);
+	}
+	CHECK(file.good(), ERROR_OTHER, "Failed to write network file.")
+	return 0;
+}
+
+/** journal_load -> reads a network file written by journal_save
+ * @path: network file
+ * @journal: loaded records, replaces the content
+ */
+int journal_load(const char *path, std::vector<struct journal_record> &journal)
+{
+	std::ifstream file(path, std::ios::binary);
+	struct journal_file_header header;
+	std::vector<struct journal_record> records;
+
+	CHECK(file.is_open(), ERROR_OTHER, "Failed to open network file.")
+	CHECK(file.read((char *)&header, sizeof(header)), ERROR_NETWORK_FORMAT, "Network file is truncated.")
+	CHECK(JOURNAL_FILE_MAGIC == header.magic && JOURNAL_FILE_VERSION == header.version, ERROR_NETWORK_FORMAT,
+		  "Not a network file.")
+	CHECK(header.record_cnt <= JOURNAL_FILE_MAX_RECORDS, ERROR_NETWORK_FORMAT, "Invalid record count in network file.")
+	// records are appended as they are read, a truncated file fails before allocating all of them
+	for (uint32_t i = 0; i < header.record_cnt; i++)
+	{
+		struct journal_file_entry entry;
+		CHECK(file.read((char *)&entry, sizeof(entry)), ERROR_NETWORK_FORMAT, "Network file is truncated.")
+		CHECK(entry.op <= JOURNAL_COPY, ERROR_NETWORK_FORMAT, "Invalid record in network file.")
+		records.emplace_back();
+		struct journal_record &r = records.back();
+		r.op = (enum journal_op)entry.op;
+		memcpy(r.args, entry.args, sizeof(r.args));
+		CHECK(read_array(file, r.tile_tx, entry.tile_tx_cnt) &&
+				  read_array(file, r.tile_rx, entry.tile_rx_cnt) &&
+				  read_array(file, r.com_lengths, entry.com_lengths_cnt) &&
+				  read_array(file, r.com_stream, entry.com_stream_len),
+			  ERROR_NETWORK_FORMAT, "Network file is truncated.")
+	}
+	journal.swap(records);
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * journal.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Network journal: every successfully created layer is recorded, so the network can be
+ * uploaded again after the device was re-initialised. Command blocks are kept as
+ * compressed streams (see command_codec.hpp). The journal can be saved to a network file
+ * and loaded again without the python model description (see tools/intuitus_bench.cpp).
+ */
+#ifndef SRC_JOURNAL_H_
+#define SRC_JOURNAL_H_
+
+#include <stdint.h>
+#include <vector>
+
+#define JOURNAL_MAX_ARGS 8
+#define JOURNAL_FILE_MAGIC 0x3154454e // "NET1"
+#define JOURNAL_FILE_VERSION 1
+#define ERROR_NETWORK_FORMAT (-12)
+
+enum journal_op
+{
+    JOURNAL_INPUT,
+    JOURNAL_OUTPUT,
+    JOURNAL_CONV2D,
+    JOURNAL_CONCAT,
+    JOURNAL_SPLIT,
+    JOURNAL_UPSAMPLE,
+    JOURNAL_MAXPOOL2D,
+    JOURNAL_COPY
+};
+
+/** journal_record -> arguments of one layer creation call
+ * @op: layer creation call
+ * @args: scalar arguments in order of the call's parameter list
+ * @tile_tx: tx tile array of conv2d layers (4 values per tile)
+ * @tile_rx: rx tile array of conv2d layers (6 values per tile)
+ * @com_lengths: command block lengths of conv2d layers
+ * @com_stream: compressed command blocks of conv2d layers
+ */
+struct journal_record
+{
+    enum journal_op op;
+    int32_t args[JOURNAL_MAX_ARGS];
+    std::vector<uint32_t> tile_tx;
+    std::vector<uint32_t> tile_rx;
+    std::vector<uint32_t> com_lengths;
+    std::vector<uint8_t> com_stream;
+};
+
+/** journal_file_header -> header of a network file, followed by record_cnt records
+ *                        (journal_file_entry followed by the record's arrays)
+ */
+struct journal_file_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_cnt;
+    uint32_t reserved;
+};
+
+struct journal_file_entry
+{
+    uint32_t op;
+    int32_t args[JOURNAL_MAX_ARGS];
+    uint32_t tile_tx_cnt;
+    uint32_t tile_rx_cnt;
+    uint32_t com_lengths_cnt;
+    uint32_t com_stream_len;
+};
+
+int journal_save(const char *path, const std::vector<struct journal_record> &journal);
+int journal_load(const char *path, std::vector<struct journal_record> &journal);
+
+#endif /* SRC_JOURNAL_H_ */
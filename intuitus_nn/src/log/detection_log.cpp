@@ -0,0 +1,501 @@
+#include "detection_log.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+
+#define DETLOG_VARINT_MAX 10
+#define DETLOG_BLOCK_HEADER_MAX (1 + 3 * DETLOG_VARINT_MAX)
+#define DETLOG_DETECTION_MAX (4 * sizeof(int16_t) + 2 + 5) // fixed columns and a 32 bit id
+
+static_assert(sizeof(struct detlog_segment_header) == 64, "segment header layout");
+
+static inline uint64_t mono_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline uint64_t wall_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline uint64_t zigzag(int64_t v)
+{
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v)
+{
+	return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline uint8_t *put_varint(uint8_t *p, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		*p++ = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = (uint8_t)v;
+	return p;
+}
+
+/** get_varint -> decodes a varint, returns false if it exceeds end
+ */
+static inline bool get_varint(const uint8_t *&p, const uint8_t *end, uint64_t *v)
+{
+	*v = 0;
+	for (int shift = 0; shift < 64 && p < end; shift += 7)
+	{
+		uint8_t b = *p++;
+		*v |= (uint64_t)(b & 0x7f) << shift;
+		if (!(b & 0x80))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline int16_t to_fixed(float v)
+{
+	float f = roundf(v * (1 << DETLOG_BOX_FRAC_BITS));
+	return (int16_t)std::min(32767.0f, std::max(-32768.0f, f));
+}
+
+/** Detection_log -> starts a new segment after the segments already in dir
+ * @dir: existing directory
+ * @prefix: file name prefix of the segments
+ * @segment_size: bytes allocated per segment
+ * @max_segments: segments kept, older ones are deleted (0: keep all)
+ */
+Detection_log::Detection_log(const char *dir, const char *prefix, int segment_size, int max_segments)
+{
+	struct stat st;
+	DIR *d;
+	struct dirent *entry;
+
+	CHECK_AND_THROW(dir != NULL && 0 == stat(dir, &st) && S_ISDIR(st.st_mode), ERROR_OTHER, "Log directory does not exist.")
+	CHECK_AND_THROW(prefix != NULL && prefix[0] != '\0' && strchr(prefix, '/') == NULL, ERROR_OTHER, "Invalid log prefix.")
+	CHECK_AND_THROW(segment_size >= DETLOG_MIN_SEGMENT_SIZE && max_segments >= 0, ERROR_OTHER, "Invalid log segment size.")
+	this->dir = dir;
+	this->prefix = prefix;
+	this->segment_size = segment_size;
+	this->max_segments = max_segments;
+	memset(&this->stats, 0, sizeof(this->stats));
+
+	// continue after the highest segment index of earlier runs
+	d = opendir(dir);
+	CHECK_AND_THROW(d != NULL, ERROR_OTHER, "Unable to read log directory.")
+	while ((entry = readdir(d)) != NULL)
+	{
+		unsigned int idx;
+		char ext[8];
+		if (0 == strncmp(entry->d_name, this->prefix.c_str(), this->prefix.size()) &&
+			2 == sscanf(entry->d_name + this->prefix.size(), "_%u%7s", &idx, ext) && 0 == strcmp(ext, DETLOG_EXTENSION))
+		{
+			this->index = std::max(this->index, (uint32_t)idx + 1);
+		}
+	}
+	closedir(d);
+	CHECK_AND_THROW(0 == open_segment(), ERROR_OTHER, "Unable to create log segment.")
+}
+
+Detection_log::~Detection_log()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	if (this->map != NULL)
+	{
+		sync(MS_SYNC);
+	}
+	close_segment();
+}
+
+std::string Detection_log::path_of(uint32_t index)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "_%06u" DETLOG_EXTENSION, index);
+	return this->dir + "/" + this->prefix + name;
+}
+
+/** open_segment -> creates, allocates and maps the segment this->index. Caller holds lock.
+ */
+int Detection_log::open_segment()
+{
+	int err;
+
+	this->path = path_of(this->index);
+	this->fd = open(this->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	CHECK(this->fd >= 0, ERROR_OTHER, "Unable to create log segment.")
+	// allocate all blocks now: appends never wait for the allocator and a full disk fails here instead of faulting later
+	err = posix_fallocate(this->fd, 0, this->segment_size);
+	if (0 == err)
+	{
+		void *ptr = mmap(NULL, this->segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+		this->map = (ptr == MAP_FAILED) ? NULL : (uint8_t *)ptr;
+	}
+	if (0 != err || this->map == NULL)
+	{
+		close(this->fd);
+		this->fd = -1;
+		unlink(this->path.c_str());
+		CHECK(0, ERROR_OTHER, "Unable to allocate log segment.")
+	}
+
+	this->header = (struct detlog_segment_header *)this->map;
+	memset(this->header, 0, sizeof(*this->header));
+	memcpy(this->header->magic, DETLOG_MAGIC, sizeof(DETLOG_MAGIC));
+	this->header->version = DETLOG_VERSION;
+	this->header->header_size = sizeof(struct detlog_segment_header);
+	this->header->segment = this->index;
+	this->header->segment_size = this->segment_size;
+	this->header->box_frac_bits = DETLOG_BOX_FRAC_BITS;
+	this->header->used = sizeof(struct detlog_segment_header);
+	this->synced = 0;
+	this->sync_us = mono_us();
+	this->stats.segments++;
+
+	if (this->max_segments > 0 && this->index >= (uint32_t)this->max_segments)
+	{
+		unlink(path_of(this->index - this->max_segments).c_str());
+	}
+	return 0;
+}
+
+/** close_segment -> unmaps the segment and truncates the file to the used bytes. Caller holds lock.
+ */
+void Detection_log::close_segment()
+{
+	uint32_t used;
+
+	if (this->map == NULL)
+	{
+		return;
+	}
+	used = this->header->used;
+	munmap(this->map, this->segment_size);
+	this->map = NULL;
+	this->header = NULL;
+	CHECK_WARNING(0 == ftruncate(this->fd, used), ERROR_OTHER, "Unable to truncate log segment.")
+	close(this->fd);
+	this->fd = -1;
+}
+
+/** sync -> writes back the bytes appended since the last sync. Caller holds lock.
+ * @flags: MS_ASYNC (start writeback) or MS_SYNC (wait for it)
+ */
+void Detection_log::sync(int flags)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	uint32_t start = this->synced / page * page;
+	uint32_t end = this->header->used;
+
+	// the header page is included: it holds the used bytes
+	msync(this->map, page, flags);
+	if (end > start)
+	{
+		msync(this->map + start, end - start, flags);
+	}
+	this->synced = end;
+	this->sync_us = mono_us();
+	this->stats.syncs++;
+}
+
+/** append -> logs the detections of one frame
+ * @dets: detections [det_cnt, 6] = x1, y1, x2, y2, score, class or
+ * 		  tracks [det_cnt, 8] = id, x1, y1, x2, y2, score, class, confidence (Tracker, confidence is not logged)
+ * @frame: frame number
+ * @timestamp_us: time stamp of the frame, 0: current time (CLOCK_REALTIME)
+ */
+int Detection_log::append(const float *dets, int det_cnt, int det_dim, uint64_t frame, uint64_t timestamp_us)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	uint64_t start = mono_us();
+	bool ids = det_dim == DETLOG_TRACK_DIM;
+	int o = ids ? 1 : 0; // column offset of x1
+	size_t bound;
+	uint8_t *p;
+	int err;
+
+	CHECK(this->map != NULL, ERROR_OTHER, "Log segment not available.")
+	CHECK(det_dim == DETLOG_DETECTION_DIM || det_dim == DETLOG_TRACK_DIM, ERROR_DIMENSION_MISMATCH,
+		  "Detections have to be [n, 6] (x1, y1, x2, y2, score, class) or tracks [n, 8].")
+	CHECK(det_cnt >= 0 && det_cnt <= DETLOG_MAX_DETECTIONS, ERROR_DIMENSION_MISMATCH, "Too many detections.")
+	if (0 == timestamp_us)
+	{
+		timestamp_us = wall_us();
+	}
+
+	bound = DETLOG_BLOCK_HEADER_MAX + (size_t)det_cnt * DETLOG_DETECTION_MAX;
+	CHECK(bound <= this->segment_size - sizeof(struct detlog_segment_header), ERROR_OTHER, "Frame larger than a log segment.")
+	if (this->header->used + bound > this->segment_size)
+	{
+		// rotate: the previous segment is written back by the kernel, the new one is already allocated
+		sync(MS_ASYNC);
+		close_segment();
+		this->index++;
+		err = open_segment();
+		if (0 != err)
+		{
+			return err;
+		}
+	}
+	if (0 == this->header->frames)
+	{
+		this->header->base_us = timestamp_us;
+		this->header->base_frame = frame;
+		this->last_us = timestamp_us;
+		this->last_frame = frame;
+	}
+
+	this->block.resize(bound);
+	p = this->block.data();
+	*p++ = DETLOG_BLOCK_MARK | (ids ? DETLOG_BLOCK_IDS : 0);
+	p = put_varint(p, zigzag((int64_t)(timestamp_us - this->last_us)));
+	p = put_varint(p, zigzag((int64_t)(frame - this->last_frame)));
+	p = put_varint(p, det_cnt);
+	for (int c = 0; c < 4; c++)
+	{
+		for (int i = 0; i < det_cnt; i++)
+		{
+			const float *d = dets + (size_t)i * det_dim + o;
+			int16_t v = to_fixed(c < 2 ? d[c] : d[c] - d[c - 2]); // x1, y1, w, h
+			memcpy(p, &v, sizeof(v));
+			p += sizeof(v);
+		}
+	}
+	for (int i = 0; i < det_cnt; i++)
+	{
+		float score = dets[(size_t)i * det_dim + o + 4];
+		*p++ = (uint8_t)std::min(255.0f, std::max(0.0f, roundf(score * 255)));
+	}
+	for (int i = 0; i < det_cnt; i++)
+	{
+		float cls = dets[(size_t)i * det_dim + o + 5];
+		*p++ = (uint8_t)std::min(255.0f, std::max(0.0f, cls));
+	}
+	if (ids)
+	{
+		for (int i = 0; i < det_cnt; i++)
+		{
+			p = put_varint(p, (uint32_t)std::max(0.0f, dets[(size_t)i * det_dim]));
+		}
+	}
+
+	size_t len = p - this->block.data();
+	memcpy(this->map + this->header->used, this->block.data(), len);
+	// a reader of the live segment sees the block before the used bytes
+	std::atomic_thread_fence(std::memory_order_release);
+	this->header->used += len;
+	this->header->frames++;
+	this->last_us = timestamp_us;
+	this->last_frame = frame;
+
+	this->stats.frames++;
+	this->stats.detections += det_cnt;
+	this->stats.bytes += len;
+	uint64_t now = mono_us();
+	if (now - this->sync_us >= (uint64_t)this->sync_interval_ms * 1000)
+	{
+		sync(MS_ASYNC);
+	}
+	now = mono_us() - start;
+	this->stats.append_us += now;
+	this->stats.max_append_us = std::max(this->stats.max_append_us, (uint32_t)now);
+	return 0;
+}
+
+/** flush -> writes the open segment back and waits for it
+ */
+int Detection_log::flush()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(this->map != NULL, ERROR_OTHER, "Log segment not available.")
+	sync(MS_SYNC);
+	return 0;
+}
+
+/** set_sync_interval -> time between msync calls of append (0: every frame)
+ */
+int Detection_log::set_sync_interval(uint32_t sync_interval_ms)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	this->sync_interval_ms = sync_interval_ms;
+	return 0;
+}
+
+/** segment_path -> file of the open segment (valid until the next segment is started)
+ */
+const char *Detection_log::segment_path()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->path.c_str();
+}
+
+struct detection_log_stats Detection_log::get_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->stats;
+}
+
+/** Detection_log_reader -> maps a segment file for reading
+ * 							A segment which is still written is read up to the blocks appended before.
+ */
+Detection_log_reader::Detection_log_reader(const char *path)
+{
+	struct stat st;
+	int fd;
+
+	CHECK_AND_THROW(path != NULL, ERROR_NULL_POINTER_PARAMETER, "Missing log file.")
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	CHECK_AND_THROW(fd >= 0, ERROR_OTHER, "Unable to open log file.")
+	if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(struct detlog_segment_header))
+	{
+		close(fd);
+		CHECK_AND_THROW(0, ERROR_LOG_FORMAT, "Not a detection log.")
+	}
+	void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	CHECK_AND_THROW(ptr != MAP_FAILED, ERROR_OTHER, "Unable to map log file.")
+	this->map = (uint8_t *)ptr;
+	this->size = st.st_size;
+
+	memcpy(&this->header, this->map, sizeof(this->header));
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (0 != memcmp(this->header.magic, DETLOG_MAGIC, sizeof(DETLOG_MAGIC)) || this->header.version != DETLOG_VERSION ||
+		this->header.header_size < sizeof(struct detlog_segment_header) || this->header.header_size > this->size)
+	{
+		munmap(this->map, this->size);
+		this->map = NULL;
+		CHECK_AND_THROW(0, ERROR_LOG_FORMAT, "Not a detection log.")
+	}
+	// a truncated copy is read up to its last complete block
+	this->header.used = std::max(this->header.header_size, (uint32_t)std::min((size_t)this->header.used, this->size));
+	this->pos = this->header.header_size;
+	this->last_us = this->header.base_us;
+	this->last_frame = this->header.base_frame;
+}
+
+Detection_log_reader::~Detection_log_reader()
+{
+	if (this->map != NULL)
+	{
+		munmap(this->map, this->size);
+	}
+}
+
+/** next -> decodes the next block
+ * @dets_out: [det_cnt, 7] = x1, y1, x2, y2, score, class, id (-1 without id)
+ * 			  (allocated using malloc, owned by caller)
+ * @return: 0, DETLOG_END after the last block or ERROR_LOG_FORMAT
+ */
+int Detection_log_reader::next(float **dets_out, int *det_cnt, int *det_dim)
+{
+	const uint8_t *p = this->map + this->pos, *end = this->map + this->header.used;
+	float scale = 1.0f / (1 << this->header.box_frac_bits);
+	uint64_t dt, dframe, n, id;
+	uint8_t flags;
+
+	*dets_out = NULL;
+	*det_cnt = 0;
+	*det_dim = DETLOG_DIM;
+	if (p >= end)
+	{
+		// at least one element: numpy needs a valid pointer for empty results
+		*dets_out = (float *)malloc(DETLOG_DIM * sizeof(float));
+		CHECK_NOT_NULL(*dets_out, ERROR_MEMORY_ALLOC_FAIL)
+		return DETLOG_END;
+	}
+	flags = *p++;
+	CHECK((flags & 0xf0) == DETLOG_BLOCK_MARK, ERROR_LOG_FORMAT, "Corrupt log block.")
+	CHECK(get_varint(p, end, &dt) && get_varint(p, end, &dframe) && get_varint(p, end, &n) && n <= DETLOG_MAX_DETECTIONS,
+		  ERROR_LOG_FORMAT, "Corrupt log block.")
+	CHECK((size_t)(end - p) >= n * (4 * sizeof(int16_t) + 2), ERROR_LOG_FORMAT, "Truncated log block.")
+
+	*dets_out = (float *)malloc(std::max(n, (uint64_t)1) * DETLOG_DIM * sizeof(float));
+	CHECK_NOT_NULL(*dets_out, ERROR_MEMORY_ALLOC_FAIL)
+	float *out = *dets_out;
+	for (int c = 0; c < 4; c++)
+	{
+		for (uint64_t i = 0; i < n; i++)
+		{
+			int16_t v;
+			memcpy(&v, p, sizeof(v));
+			p += sizeof(v);
+			out[i * DETLOG_DIM + c] = v * scale + (c < 2 ? 0.0f : out[i * DETLOG_DIM + c - 2]); // x2 = x1 + w
+		}
+	}
+	for (uint64_t i = 0; i < n; i++)
+	{
+		out[i * DETLOG_DIM + 4] = *p++ / 255.0f;
+	}
+	for (uint64_t i = 0; i < n; i++)
+	{
+		out[i * DETLOG_DIM + 5] = *p++;
+	}
+	for (uint64_t i = 0; i < n; i++)
+	{
+		if (flags & DETLOG_BLOCK_IDS)
+		{
+			if (!get_varint(p, end, &id))
+			{
+				free(*dets_out);
+				*dets_out = NULL;
+				CHECK(0, ERROR_LOG_FORMAT, "Truncated log block.")
+			}
+			out[i * DETLOG_DIM + 6] = (float)id;
+		}
+		else
+		{
+			out[i * DETLOG_DIM + 6] = -1.0f;
+		}
+	}
+
+	this->pos = p - this->map;
+	this->last_us += unzigzag(dt);
+	this->last_frame += unzigzag(dframe);
+	*det_cnt = (int)n;
+	return 0;
+}
+
+/** frame -> frame number of the last block read
+ */
+uint64_t Detection_log_reader::frame()
+{
+	return this->last_frame;
+}
+
+/** timestamp_us -> time stamp of the last block read
+ */
+uint64_t Detection_log_reader::timestamp_us()
+{
+	return this->last_us;
+}
+
+uint32_t Detection_log_reader::segment()
+{
+	return this->header.segment;
+}
+
+uint32_t Detection_log_reader::frames()
+{
+	return this->header.frames;
+}
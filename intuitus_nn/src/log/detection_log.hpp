@@ -0,0 +1,149 @@
+/*
+ * detection_log.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Binary audit log of detections. Every frame is appended as one block with its values stored
+ * column by column: zigzag varint deltas of time stamp and frame number, boxes as 16 bit fixed
+ * point (1/8 pixel), score and class as one byte each, track ids as varints. A detection takes
+ * 10 bytes (JSON lines: about 80).
+ * Blocks are copied into memory mapped segment files which are allocated in full when they are
+ * created (no block allocation and no SIGBUS on a full disk while appending). Dirty pages are
+ * handed to the kernel writeback with one msync per sync interval, not per frame. A full
+ * segment is truncated to its used size and the next one is started; the oldest segments are
+ * deleted beyond max_segments. Read and export with Detection_log_reader or tools/intuitus_log.
+ *
+ * Segment file: <dir>/<prefix>_<index>.idl
+ *   header (detlog_segment_header, 64 bytes)
+ *   blocks: flags (DETLOG_BLOCK_MARK | DETLOG_BLOCK_IDS), varint dt_us, varint dframe, varint n,
+ *           int16 x1[n], y1[n], w[n], h[n], uint8 score[n] (score * 255), uint8 class[n],
+ *           varint id[n] (DETLOG_BLOCK_IDS only), little endian
+ */
+#ifndef SRC_DETECTION_LOG_H_
+#define SRC_DETECTION_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define DETLOG_MAGIC "INTDLOG"
+#define DETLOG_VERSION 1
+#define DETLOG_EXTENSION ".idl"
+#define DETLOG_DEFAULT_PREFIX "detections"
+#define DETLOG_DEFAULT_SEGMENT_SIZE (4 * 1024 * 1024)
+#define DETLOG_DEFAULT_MAX_SEGMENTS 16        // 0: keep all segments
+#define DETLOG_DEFAULT_SYNC_INTERVAL_MS 1000
+#define DETLOG_MIN_SEGMENT_SIZE 4096
+#define DETLOG_BOX_FRAC_BITS 3                // boxes in 1/8 pixel, range +-4096 pixels
+#define DETLOG_MAX_DETECTIONS 65535           // per frame
+
+#define DETLOG_BLOCK_MARK 0xa0
+#define DETLOG_BLOCK_IDS 0x01
+
+#define DETLOG_DETECTION_DIM 6 // append: [n, 6] = x1, y1, x2, y2, score, class
+#define DETLOG_TRACK_DIM 8     // append: [n, 8] = id, x1, y1, x2, y2, score, class, confidence (Tracker)
+#define DETLOG_DIM 7           // read: [n, 7] = x1, y1, x2, y2, score, class, id (-1 without id)
+
+#define DETLOG_END 1               // no further block in the segment
+#define ERROR_LOG_FORMAT (-15)     // not a detection log or corrupt block
+
+/**
+ * detlog_segment_header -> first bytes of a segment file
+ * @used: valid bytes including the header, updated after every block
+ * @base_us, @base_frame: time stamp and frame of the first block, the first deltas refer to them
+ */
+struct detlog_segment_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t segment;
+    uint32_t segment_size;
+    uint32_t used;
+    uint32_t frames;
+    uint64_t base_us;
+    uint64_t base_frame;
+    uint32_t box_frac_bits;
+    uint32_t reserved[3];
+};
+
+/**
+ * detection_log_stats -> logger metrics
+ * @frames, @detections: appended blocks and detections
+ * @bytes: bytes of appended blocks
+ * @segments: segments created
+ * @syncs: msync calls
+ * @append_us, @max_append_us: accumulated and longest time of append (including rotation)
+ */
+struct detection_log_stats
+{
+    uint64_t frames;
+    uint64_t detections;
+    uint64_t bytes;
+    uint32_t segments;
+    uint64_t syncs;
+    uint64_t append_us;
+    uint32_t max_append_us;
+};
+
+class Detection_log
+{
+public:
+    Detection_log(const char *dir, const char *prefix = DETLOG_DEFAULT_PREFIX,
+                  int segment_size = DETLOG_DEFAULT_SEGMENT_SIZE, int max_segments = DETLOG_DEFAULT_MAX_SEGMENTS);
+    ~Detection_log();
+
+    int append(const float *dets, int det_cnt, int det_dim, uint64_t frame = 0, uint64_t timestamp_us = 0);
+    int flush();
+    int set_sync_interval(uint32_t sync_interval_ms);
+    const char *segment_path();
+    struct detection_log_stats get_stats();
+
+private:
+    std::string dir;
+    std::string prefix;
+    uint32_t segment_size;
+    int max_segments;
+    uint32_t sync_interval_ms = DETLOG_DEFAULT_SYNC_INTERVAL_MS;
+    uint32_t index = 0;                          // index of the open segment
+    std::string path;                            // file of the open segment
+    int fd = -1;
+    uint8_t *map = NULL;
+    struct detlog_segment_header *header = NULL;
+    uint64_t last_us = 0, last_frame = 0;        // previous block
+    uint32_t synced = 0;                         // bytes handed to msync
+    uint64_t sync_us = 0;                        // time of the last msync
+    std::vector<uint8_t> block;
+    struct detection_log_stats stats;
+    std::mutex lock;
+
+    std::string path_of(uint32_t index);
+    int open_segment();
+    void close_segment();
+    void sync(int flags);
+};
+
+class Detection_log_reader
+{
+public:
+    Detection_log_reader(const char *path);
+    ~Detection_log_reader();
+
+    int next(float **dets_out, int *det_cnt, int *det_dim);
+    uint64_t frame();
+    uint64_t timestamp_us();
+    uint32_t segment();
+    uint32_t frames();
+
+private:
+    uint8_t *map = NULL;
+    size_t size = 0;
+    size_t pos = 0;
+    struct detlog_segment_header header;
+    uint64_t last_us = 0, last_frame = 0; // previous block
+};
+
+#endif /* SRC_DETECTION_LOG_H_ */
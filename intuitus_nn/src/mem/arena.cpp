@@ -0,0 +1,199 @@
+#include "arena.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <sys/mman.h>
+
+static inline size_t round_up(size_t size, size_t align)
+{
+	return (size + align - 1) & ~(align - 1);
+}
+
+Host_arena::Host_arena()
+{
+	this->default_flags = ARENA_PLAIN;
+	memset(&this->stats, 0, sizeof(this->stats));
+}
+
+/** instance -> returns the process wide arena. It is never destroyed, so buffers may be
+ * 				released during static destruction (e.g. by python objects).
+ */
+Host_arena &Host_arena::instance()
+{
+	static Host_arena *arena = new Host_arena();
+	return *arena;
+}
+
+/** acquire -> returns a page aligned buffer of at least size bytes
+ * @size: buffer size in bytes
+ * @flags: ARENA_HUGE_PAGES | ARENA_LOCKED, ARENA_USE_DEFAULT for the arena defaults
+ * @return: buffer or NULL
+ */
+void *Host_arena::acquire(size_t size, int flags)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	struct block blk;
+	void *ptr;
+
+	if (ARENA_USE_DEFAULT == flags)
+	{
+		flags = this->default_flags;
+	}
+	blk.flags = flags;
+	blk.applied = flags;
+	blk.huge_tlb = false;
+	blk.size = round_up(size > 0 ? size : 1, (flags & ARENA_HUGE_PAGES) ? ARENA_HUGE_PAGE_SIZE : ARENA_PAGE_SIZE);
+
+	auto it = this->free_blocks.find(std::make_pair(blk.size, flags));
+	if (it != this->free_blocks.end())
+	{
+		ptr = it->second.first;
+		blk = it->second.second;
+		this->free_blocks.erase(it);
+	}
+	else
+	{
+		ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+		if (flags & ARENA_HUGE_PAGES)
+		{
+			// reserved huge pages first, transparent huge pages as fallback
+			ptr = mmap(NULL, blk.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			blk.huge_tlb = (MAP_FAILED != ptr);
+		}
+#endif
+		if (MAP_FAILED == ptr)
+		{
+			ptr = mmap(NULL, blk.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (MAP_FAILED == ptr)
+			{
+				log_err(ERROR_MEMORY_ALLOC_FAIL, "Failed to map host buffer.");
+				return NULL;
+			}
+#ifdef MADV_HUGEPAGE
+			if (flags & ARENA_HUGE_PAGES)
+			{
+				madvise(ptr, blk.size, MADV_HUGEPAGE);
+			}
+#endif
+		}
+		if (flags & ARENA_LOCKED)
+		{
+			if (0 == mlock(ptr, blk.size))
+			{
+				this->stats.bytes_locked += blk.size;
+			}
+			else
+			{
+				log_warn(ERROR_MEMORY_ALLOC_FAIL, "Failed to lock host buffer (RLIMIT_MEMLOCK).");
+				blk.applied &= ~ARENA_LOCKED; // still kept under the requested flags
+			}
+		}
+		this->stats.system_allocs++;
+		this->stats.bytes_mapped += blk.size;
+		this->stats.huge_page_buffers += blk.huge_tlb ? 1 : 0;
+	}
+	this->in_use[ptr] = blk;
+	this->stats.acquires++;
+	this->stats.bytes_in_use += blk.size;
+	return ptr;
+}
+
+/** resize -> returns a buffer of at least size bytes. The buffer is kept if it is large enough,
+ * 			  otherwise it is released and a new one is acquired. The content is not preserved.
+ * @ptr: buffer from acquire or NULL
+ */
+void *Host_arena::resize(void *ptr, size_t size, int flags)
+{
+	if (ptr != NULL)
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		auto it = this->in_use.find(ptr);
+		if (it != this->in_use.end() && it->second.size >= size &&
+			(ARENA_USE_DEFAULT == flags || it->second.flags == flags))
+		{
+			return ptr;
+		}
+	}
+	release(ptr);
+	return acquire(size, flags);
+}
+
+/** release -> gives a buffer back to the arena. It is kept for later acquires of the same size.
+ * @ptr: buffer from acquire or NULL
+ */
+void Host_arena::release(void *ptr)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	if (ptr == NULL)
+	{
+		return;
+	}
+	auto it = this->in_use.find(ptr);
+	if (it == this->in_use.end())
+	{
+		log_warn(ERROR_OTHER, "Released buffer does not belong to the arena.");
+		return;
+	}
+	this->free_blocks.insert(std::make_pair(std::make_pair(it->second.size, it->second.flags),
+											std::make_pair(ptr, it->second)));
+	this->stats.releases++;
+	this->stats.bytes_in_use -= it->second.size;
+	this->in_use.erase(it);
+}
+
+/** set_default_flags -> sets the flags of buffers acquired with ARENA_USE_DEFAULT
+ */
+void Host_arena::set_default_flags(int flags)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	this->default_flags = flags & (ARENA_HUGE_PAGES | ARENA_LOCKED);
+}
+
+struct host_arena_stats Host_arena::get_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->stats;
+}
+
+/** trim -> returns all released buffers to the system
+ */
+void Host_arena::trim()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	for (auto &entry : this->free_blocks)
+	{
+		unmap_block(entry.second.first, entry.second.second);
+	}
+	this->free_blocks.clear();
+}
+
+void Host_arena::unmap_block(void *ptr, const struct block &blk)
+{
+	if (blk.applied & ARENA_LOCKED)
+	{
+		munlock(ptr, blk.size);
+		this->stats.bytes_locked -= blk.size;
+	}
+	munmap(ptr, blk.size);
+	this->stats.system_frees++;
+	this->stats.bytes_mapped -= blk.size;
+	this->stats.huge_page_buffers -= blk.huge_tlb ? 1 : 0;
+}
+
+/** get_arena_stats -> allocation counters of the process wide arena
+ */
+struct host_arena_stats get_arena_stats()
+{
+	return Host_arena::instance().get_stats();
+}
+
+/** set_arena_flags -> default flags of the process wide arena (ARENA_HUGE_PAGES | ARENA_LOCKED)
+ */
+void set_arena_flags(int flags)
+{
+	Host_arena::instance().set_default_flags(flags);
+}
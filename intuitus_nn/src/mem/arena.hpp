@@ -0,0 +1,86 @@
+/*
+ * arena.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Pool of page aligned host buffers (camera frames, staging buffers, network outputs,
+ * decoded tensors). Released buffers are kept and handed out again for the same size
+ * class, so a pipeline in steady state does not allocate. The allocation counters
+ * make this verifiable.
+ */
+#ifndef SRC_ARENA_H_
+#define SRC_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <map>
+
+#define ARENA_CACHE_LINE 64
+#define ARENA_PAGE_SIZE 4096
+#define ARENA_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Buffer flags
+#define ARENA_USE_DEFAULT (-1) // use the default flags of the arena
+#define ARENA_PLAIN 0
+#define ARENA_HUGE_PAGES 1 // back the buffer by huge pages (hugetlbfs or transparent huge pages)
+#define ARENA_LOCKED 2     // mlock the buffer (no page faults, no swapping)
+
+/**
+ * host_arena_stats -> allocation counters
+ * @system_allocs: buffers mapped from the system
+ * @system_frees: buffers returned to the system (trim)
+ * @acquires: buffers handed out
+ * @releases: buffers given back
+ * @bytes_mapped: bytes mapped from the system
+ * @bytes_in_use: bytes handed out and not yet released
+ * @bytes_locked: mlocked bytes
+ * @huge_page_buffers: buffers backed by hugetlbfs pages
+ */
+struct host_arena_stats
+{
+    uint64_t system_allocs;
+    uint64_t system_frees;
+    uint64_t acquires;
+    uint64_t releases;
+    uint64_t bytes_mapped;
+    uint64_t bytes_in_use;
+    uint64_t bytes_locked;
+    uint32_t huge_page_buffers;
+};
+
+class Host_arena
+{
+public:
+    static Host_arena &instance();
+
+    void *acquire(size_t size, int flags = ARENA_USE_DEFAULT);
+    void *resize(void *ptr, size_t size, int flags = ARENA_USE_DEFAULT);
+    void release(void *ptr);
+    void set_default_flags(int flags);
+    struct host_arena_stats get_stats();
+    void trim();
+
+private:
+    Host_arena();
+    struct block
+    {
+        size_t size; // mapped size
+        int flags;   // requested flags, key of free_blocks
+        int applied; // flags in effect (mlock may fail)
+        bool huge_tlb;
+    };
+    std::mutex lock;
+    int default_flags;
+    std::map<void *, struct block> in_use;
+    std::multimap<std::pair<size_t, int>, std::pair<void *, struct block>> free_blocks; // (size, flags) -> block
+    struct host_arena_stats stats;
+
+    void unmap_block(void *ptr, const struct block &blk);
+};
+
+struct host_arena_stats get_arena_stats();
+void set_arena_flags(int flags);
+
+#endif /* SRC_ARENA_H_ */
@@ -0,0 +1,45 @@
+#include "dlpack_export.hpp"
+
+#include <stdlib.h>
+
+struct dlpack_ctx
+{
+	Result_ref *ref;
+	int64_t shape[1];
+};
+
+static void dlpack_deleter(DLManagedTensor *self)
+{
+	struct dlpack_ctx *ctx = (struct dlpack_ctx *)self->manager_ctx;
+	delete ctx->ref;
+	delete ctx;
+	delete self;
+}
+
+/** result_to_dlpack -> wraps a pooled result into a one dimensional int8 DLPack tensor
+ * @ref: slot reference. Ownership is passed to the tensor and released by its deleter.
+ * @data: result buffer of the slot
+ * @length: number of result bytes
+ */
+DLManagedTensor *result_to_dlpack(Result_ref *ref, int8_t *data, int64_t length)
+{
+	struct dlpack_ctx *ctx = new dlpack_ctx;
+	DLManagedTensor *tensor = new DLManagedTensor;
+
+	ctx->ref = ref;
+	ctx->shape[0] = length;
+
+	tensor->dl_tensor.data = data;
+	tensor->dl_tensor.device.device_type = kDLCPU;
+	tensor->dl_tensor.device.device_id = 0;
+	tensor->dl_tensor.ndim = 1;
+	tensor->dl_tensor.dtype.code = kDLInt;
+	tensor->dl_tensor.dtype.bits = 8;
+	tensor->dl_tensor.dtype.lanes = 1;
+	tensor->dl_tensor.shape = ctx->shape;
+	tensor->dl_tensor.strides = NULL; // compact row major
+	tensor->dl_tensor.byte_offset = 0;
+	tensor->manager_ctx = ctx;
+	tensor->deleter = dlpack_deleter;
+	return tensor;
+}
@@ -0,0 +1,63 @@
+/*
+ * dlpack_export.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Export of pooled results as DLPack tensors (ABI of dlpack.h, DLPack >= 0.2).
+ * Only the CPU device and integer types are required here.
+ */
+#ifndef SRC_DLPACK_EXPORT_H_
+#define SRC_DLPACK_EXPORT_H_
+
+#include <stdint.h>
+#include "result_pool.hpp"
+
+#define DLPACK_CAPSULE_NAME "dltensor"
+#define DLPACK_USED_CAPSULE_NAME "used_dltensor"
+
+enum dl_device_type
+{
+    kDLCPU = 1
+};
+
+enum dl_data_type_code
+{
+    kDLInt = 0,
+    kDLUInt = 1
+};
+
+typedef struct
+{
+    int device_type;
+    int device_id;
+} DLDevice;
+
+typedef struct
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+} DLDataType;
+
+typedef struct
+{
+    void *data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t *shape;
+    int64_t *strides;
+    uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor
+{
+    DLTensor dl_tensor;
+    void *manager_ctx;
+    void (*deleter)(struct DLManagedTensor *self);
+} DLManagedTensor;
+
+DLManagedTensor *result_to_dlpack(Result_ref *ref, int8_t *data, int64_t length);
+
+#endif /* SRC_DLPACK_EXPORT_H_ */
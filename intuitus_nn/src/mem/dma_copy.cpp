@@ -0,0 +1,210 @@
+#include "dma_copy.hpp"
+#include "realtime.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DMA_COPY_NEON
+#endif
+
+/** copy_bursts -> copies n bytes (multiple of DMA_COPY_BURST) in 64 byte bursts:
+ * 				   all loads of a burst are issued before its stores
+ */
+static inline void copy_bursts(uint8_t *dst, const uint8_t *src, size_t n)
+{
+	for (; n >= DMA_COPY_BURST; n -= DMA_COPY_BURST, src += DMA_COPY_BURST, dst += DMA_COPY_BURST)
+	{
+		__builtin_prefetch(src + DMA_COPY_PREFETCH);
+#ifdef DMA_COPY_NEON
+		uint8x16_t a = vld1q_u8(src);
+		uint8x16_t b = vld1q_u8(src + 16);
+		uint8x16_t c = vld1q_u8(src + 32);
+		uint8x16_t d = vld1q_u8(src + 48);
+		vst1q_u8(dst, a);
+		vst1q_u8(dst + 16, b);
+		vst1q_u8(dst + 32, c);
+		vst1q_u8(dst + 48, d);
+#else
+		uint64_t w[DMA_COPY_BURST / 8];
+		memcpy(w, src, DMA_COPY_BURST);
+		memcpy(dst, w, DMA_COPY_BURST);
+#endif
+	}
+}
+
+/** copy_aligned -> copies the unaligned head and tail bytewise and the rest in bursts.
+ * @align_ptr: pointer which is aligned to 16 bytes for the bursts (the uncached side)
+ */
+static void copy_aligned(uint8_t *dst, const uint8_t *src, size_t n, uintptr_t align_ptr)
+{
+	size_t head = (16 - (align_ptr & 15)) & 15;
+	size_t body;
+
+	if (head > n)
+	{
+		head = n;
+	}
+	memcpy(dst, src, head);
+	dst += head;
+	src += head;
+	n -= head;
+	body = n & ~(size_t)(DMA_COPY_BURST - 1);
+	copy_bursts(dst, src, body);
+	memcpy(dst + body, src + body, n - body);
+}
+
+/** dma_copy_to_device -> copies from cached memory into the interface buffer (stores aligned)
+ */
+void dma_copy_to_device(void *dst, const void *src, size_t n)
+{
+	copy_aligned((uint8_t *)dst, (const uint8_t *)src, n, (uintptr_t)dst);
+}
+
+/** dma_copy_from_device -> copies from the interface buffer into cached memory (loads aligned)
+ */
+void dma_copy_from_device(void *dst, const void *src, size_t n)
+{
+	copy_aligned((uint8_t *)dst, (const uint8_t *)src, n, (uintptr_t)src);
+}
+
+/**
+ * Copy_workers -> persistent helper threads for dma_copy_from_device_mt. 
+ * 				   They are started on first use and wait for jobs, so a copy does not allocate.
+ */
+class Copy_workers
+{
+public:
+	static Copy_workers &instance()
+	{
+		static Copy_workers *workers = new Copy_workers(); // never destroyed, threads are detached
+		return *workers;
+	}
+
+	void copy(uint8_t *dst, const uint8_t *src, size_t n)
+	{
+		std::lock_guard<std::mutex> call_guard(this->call_lock);
+		size_t chunk;
+		int parts, i;
+
+		start_workers();
+		parts = this->threads;
+		chunk = ((n / parts) + DMA_COPY_BURST - 1) & ~(size_t)(DMA_COPY_BURST - 1);
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			for (i = 1; i < parts; i++)
+			{
+				size_t offs = chunk * i;
+				this->jobs[i - 1].dst = dst + offs;
+				this->jobs[i - 1].src = src + offs;
+				this->jobs[i - 1].n = offs < n ? (offs + chunk < n ? chunk : n - offs) : 0;
+			}
+			this->active = parts - 1;
+			this->pending = parts - 1;
+			this->generation++;
+		}
+		this->job_cv.notify_all();
+		dma_copy_from_device(dst, src, chunk < n ? chunk : n);
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->done_cv.wait(guard, [this]() { return 0 == this->pending; });
+	}
+
+	int set_threads(int threads)
+	{
+		std::lock_guard<std::mutex> call_guard(this->call_lock);
+		if (threads < 1 || threads > DMA_COPY_MAX_THREADS)
+		{
+			return -1;
+		}
+		this->threads = threads;
+		return 0;
+	}
+
+private:
+	struct job
+	{
+		uint8_t *dst;
+		const uint8_t *src;
+		size_t n;
+	};
+	std::mutex call_lock; // one parallel copy at a time
+	std::mutex lock;
+	std::condition_variable job_cv;
+	std::condition_variable done_cv;
+	struct job jobs[DMA_COPY_MAX_THREADS - 1];
+	uint64_t generation = 0;
+	int active = 0;  // workers taking part in the current copy
+	int pending = 0; // active workers not yet finished
+	int threads;
+	int started = 0;
+
+	Copy_workers()
+	{
+		unsigned int cores = std::thread::hardware_concurrency();
+		this->threads = cores < 1 ? 1 : (cores > DMA_COPY_MAX_THREADS ? DMA_COPY_MAX_THREADS : cores);
+	}
+
+	void start_workers()
+	{
+		for (; this->started < this->threads - 1; this->started++)
+		{
+			std::thread(&Copy_workers::worker, this, this->started).detach();
+		}
+	}
+
+	void worker(int idx)
+	{
+		uint64_t seen = 0;
+		struct job j;
+
+		// started by the first large copy, possibly from a pinned real-time thread: the worker
+		// role sets cores and priority independent of that thread (realtime.hpp)
+		rt_register_worker();
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->job_cv.wait(guard, [&]() { return this->generation != seen; });
+				seen = this->generation;
+				if (idx >= this->active)
+				{
+					continue; // not part of this copy
+				}
+				j = this->jobs[idx];
+			}
+			dma_copy_from_device(j.dst, j.src, j.n);
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->pending--;
+			}
+			this->done_cv.notify_all();
+		}
+	}
+};
+
+/** dma_copy_from_device_mt -> copies large outputs from the interface buffer using several cores
+ */
+void dma_copy_from_device_mt(void *dst, const void *src, size_t n)
+{
+	if (n < DMA_COPY_MT_THRESHOLD)
+	{
+		dma_copy_from_device(dst, src, n);
+		return;
+	}
+	Copy_workers::instance().copy((uint8_t *)dst, (const uint8_t *)src, n);
+}
+
+/** dma_copy_set_threads -> number of threads of dma_copy_from_device_mt (including the caller)
+ * @return: 0 or -1 if threads is out of range
+ */
+int dma_copy_set_threads(int threads)
+{
+	return Copy_workers::instance().set_threads(threads);
+}
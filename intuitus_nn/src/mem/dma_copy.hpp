@@ -0,0 +1,27 @@
+/*
+ * dma_copy.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Copy routines for the DMA coherent interface buffer. The mapping is uncached or write
+ * combined on Zynq, so every access is a bus transaction: copies use aligned 64 byte
+ * bursts (NEON where available) instead of memcpy's mixed access sizes. Large outputs
+ * are read by several cores in parallel.
+ */
+#ifndef SRC_DMA_COPY_H_
+#define SRC_DMA_COPY_H_
+
+#include <stddef.h>
+
+#define DMA_COPY_BURST 64                  // bytes per load/store burst
+#define DMA_COPY_PREFETCH 256              // prefetch distance of cached sources
+#define DMA_COPY_MAX_THREADS 4             // copy threads including the caller
+#define DMA_COPY_MT_THRESHOLD (256 * 1024) // smaller copies are done by the caller alone
+
+void dma_copy_to_device(void *dst, const void *src, size_t n);
+void dma_copy_from_device(void *dst, const void *src, size_t n);
+void dma_copy_from_device_mt(void *dst, const void *src, size_t n);
+int dma_copy_set_threads(int threads);
+
+#endif /* SRC_DMA_COPY_H_ */
@@ -0,0 +1,113 @@
+#include "result_pool.hpp"
+#include "intuitus-intf.h"
+#include "arena.hpp"
+
+Result_pool::Result_pool(int max_slots)
+{
+	this->max_slots = max_slots;
+	this->in_use = 0;
+}
+
+Result_pool::~Result_pool()
+{
+	for (auto &slot : this->slots)
+	{
+		Host_arena::instance().release(slot.ptr);
+	}
+}
+
+/** acquire -> takes a free result buffer from the pool. The returned slot has a reference count of one.
+ * @size: required buffer size in bytes
+ * @data: pointer to result buffer
+ * @return: slot id or ERROR_MAX_MEMORY_LIMIT if all slots are referenced / ERROR_MEMORY_ALLOC_FAIL
+ */
+int Result_pool::acquire(size_t size, int8_t **data)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	int8_t *ptr;
+	int slot;
+
+	if (!this->free_slots.empty())
+	{
+		slot = this->free_slots.back();
+		this->free_slots.pop_back();
+	}
+	else
+	{
+		if (this->max_slots > 0 && (int)this->slots.size() >= this->max_slots)
+		{
+			return ERROR_MAX_MEMORY_LIMIT;
+		}
+		slot_t new_slot = {NULL, 0, 0};
+		this->slots.push_back(new_slot);
+		slot = (int)this->slots.size() - 1;
+	}
+
+	if (this->slots[slot].size != size || this->slots[slot].ptr == NULL)
+	{
+		ptr = (int8_t *)Host_arena::instance().resize(this->slots[slot].ptr, size);
+		if (ptr == NULL)
+		{
+			this->free_slots.push_back(slot);
+			return ERROR_MEMORY_ALLOC_FAIL;
+		}
+		this->slots[slot].ptr = ptr;
+		this->slots[slot].size = size;
+	}
+	this->slots[slot].refcnt = 1;
+	this->in_use++;
+	*data = this->slots[slot].ptr;
+	return slot;
+}
+
+void Result_pool::retain(int slot)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	this->slots[slot].refcnt++;
+}
+
+/** release -> drops a reference. The slot returns to the pool when the last reference is released.
+ */
+void Result_pool::release(int slot)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	if (--this->slots[slot].refcnt == 0)
+	{
+		this->free_slots.push_back(slot);
+		this->in_use--;
+	}
+}
+
+int8_t *Result_pool::data(int slot)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->slots[slot].ptr;
+}
+
+size_t Result_pool::size(int slot)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->slots[slot].size;
+}
+
+/** set_max_slots -> limits the number of result buffers. Execution fails with ERROR_MAX_MEMORY_LIMIT
+ * 					 if all buffers are still referenced. Already allocated buffers are kept.
+ * @max_slots: maximal number of buffers (0 -> unlimited)
+ */
+void Result_pool::set_max_slots(int max_slots)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	this->max_slots = max_slots;
+}
+
+int Result_pool::slots_in_use()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->in_use;
+}
+
+int Result_pool::slots_allocated()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return (int)this->slots.size();
+}
@@ -0,0 +1,62 @@
+/*
+ * result_pool.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Reference counted pool of network result buffers. A slot stays valid until its last
+ * reference is released, independent of later calls to execute. The pool is held by a
+ * shared_ptr so exported results may outlive the interface that produced them.
+ */
+#ifndef SRC_RESULT_POOL_H_
+#define SRC_RESULT_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+#include <memory>
+
+class Result_pool
+{
+public:
+    Result_pool(int max_slots);
+    ~Result_pool();
+
+    int acquire(size_t size, int8_t **data);
+    void retain(int slot);
+    void release(int slot);
+    int8_t *data(int slot);
+    size_t size(int slot);
+
+    void set_max_slots(int max_slots);
+    int slots_in_use();
+    int slots_allocated();
+
+private:
+    struct slot_t
+    {
+        int8_t *ptr;
+        size_t size;
+        int refcnt;
+    };
+    std::mutex lock;
+    std::vector<slot_t> slots;
+    std::vector<int> free_slots;
+    int max_slots; // 0 -> unlimited
+    int in_use;
+};
+
+/** Result_ref -> owning reference to a pool slot. Releases the slot on destruction.
+ * Used as context of exported numpy arrays and DLPack tensors.
+ */
+struct Result_ref
+{
+    std::shared_ptr<Result_pool> pool;
+    int slot;
+
+    Result_ref(std::shared_ptr<Result_pool> pool, int slot) : pool(pool), slot(slot) {}
+    ~Result_ref() { pool->release(slot); }
+};
+
+#endif /* SRC_RESULT_POOL_H_ */
@@ -0,0 +1,239 @@
+#include "tensor.hpp"
+#include "arena.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+/** float8_decode -> converts float8 values (4 bit mantissa, 4 bit negative exponent) to float32
+ * @fmap_in: float8 values
+ * @fmap_out: float32 values
+ * @n: number of values
+ */
+void float8_decode(const uint8_t *fmap_in, float *fmap_out, size_t n)
+{
+	static const std::vector<float> lut = []() {
+		std::vector<float> table(256);
+		for (int v = 0; v < 256; v++)
+		{
+			table[v] = ((float)(v & 0xf)) * pow(2.0, (-1) * (v >> 4) - 4);
+		}
+		return table;
+	}();
+
+	for (size_t i = 0; i < n; i++)
+	{
+		fmap_out[i] = lut[fmap_in[i]];
+	}
+}
+
+tensor_storage::~tensor_storage()
+{
+	Host_arena::instance().release(this->owned);
+	Host_arena::instance().release(this->decoded);
+}
+
+/** Tensor -> tensor owning a copy of the data
+ * @data: elements in the given layout
+ * @c, @h, @w: channels, height, width
+ * @format: tensor_format of the elements
+ * @layout: tensor_layout of data
+ */
+Tensor::Tensor(const int8_t *data, int c, int h, int w, int format, int layout)
+{
+	size_t size = (size_t)c * h * w;
+
+	CHECK_AND_THROW(c > 0 && h > 0 && w > 0, ERROR_DIMENSION_MISMATCH, "Invalid tensor shape.")
+	CHECK_AND_THROW(format >= TENSOR_INT8 && format <= TENSOR_FLOAT8 && (layout == TENSOR_CHW || layout == TENSOR_HWC),
+					ERROR_OTHER, "Invalid tensor format or layout.")
+	this->storage = std::make_shared<struct tensor_storage>();
+	this->storage->owned = (int8_t *)Host_arena::instance().acquire(size);
+	CHECK_AND_THROW(this->storage->owned != NULL, ERROR_MEMORY_ALLOC_FAIL, "Failed to allocate tensor.")
+	memcpy(this->storage->owned, data, size);
+	this->storage->data = this->storage->owned;
+	this->storage->size = size;
+	this->storage->format = (enum tensor_format)format;
+	this->offset = 0;
+	this->dims[0] = c;
+	this->dims[1] = h;
+	this->dims[2] = w;
+	this->dim_layout = (enum tensor_layout)layout;
+}
+
+/** Tensor -> tensor of a pooled network result (no copy). The result slot is released with
+ * 			  the last tensor, view or exported array referencing it.
+ * @result: reference to the pool slot, taken over by the tensor
+ * @data: slot data
+ */
+Tensor::Tensor(std::shared_ptr<Result_ref> result, const int8_t *data, int c, int h, int w, int format, int layout)
+{
+	CHECK_AND_THROW(c > 0 && h > 0 && w > 0, ERROR_DIMENSION_MISMATCH, "Invalid tensor shape.")
+	CHECK_AND_THROW(format >= TENSOR_INT8 && format <= TENSOR_FLOAT8 && (layout == TENSOR_CHW || layout == TENSOR_HWC),
+					ERROR_OTHER, "Invalid tensor format or layout.")
+	this->storage = std::make_shared<struct tensor_storage>();
+	this->storage->result = result;
+	this->storage->data = data;
+	this->storage->size = (size_t)c * h * w;
+	this->storage->format = (enum tensor_format)format;
+	this->offset = 0;
+	this->dims[0] = c;
+	this->dims[1] = h;
+	this->dims[2] = w;
+	this->dim_layout = (enum tensor_layout)layout;
+}
+
+Tensor::Tensor(std::shared_ptr<struct tensor_storage> storage, size_t offset, int c, int h, int w, int layout)
+{
+	this->storage = storage;
+	this->offset = offset;
+	this->dims[0] = c;
+	this->dims[1] = h;
+	this->dims[2] = w;
+	this->dim_layout = (enum tensor_layout)layout;
+}
+
+int Tensor::channels() { return this->dims[0]; }
+int Tensor::height() { return this->dims[1]; }
+int Tensor::width() { return this->dims[2]; }
+int Tensor::size() { return this->dims[0] * this->dims[1] * this->dims[2]; }
+int Tensor::format() { return this->storage->format; }
+int Tensor::layout() { return this->dim_layout; }
+
+/** view -> tensor of a part of this tensor's elements (same format and layout). Shares the
+ * 			data and the decode cache.
+ * @offset: first element of the view
+ * @c, @h, @w: shape of the view
+ * @return: new tensor, NULL if the view exceeds the tensor
+ */
+Tensor *Tensor::view(int offset, int c, int h, int w)
+{
+	if (offset < 0 || c <= 0 || h <= 0 || w <= 0 || (size_t)offset + (size_t)c * h * w > (size_t)size())
+	{
+		log_err(ERROR_DIMENSION_MISMATCH, "View exceeds tensor.");
+		return NULL;
+	}
+	return new Tensor(this->storage, this->offset + offset, c, h, w, this->dim_layout);
+}
+
+/** decode -> decodes the tiles covering elements [begin, end) to float32
+ * @return: decoded elements starting with begin, valid as long as the storage exists.
+ * 			NULL if the range exceeds the tensor.
+ */
+const float *Tensor::decode(size_t begin, size_t end)
+{
+	struct tensor_storage *s = this->storage.get();
+	std::lock_guard<std::mutex> guard(s->lock);
+
+	if (begin > end || end > (size_t)size())
+	{
+		log_err(ERROR_DIMENSION_MISMATCH, "Decode range exceeds tensor.");
+		return NULL;
+	}
+	if (s->decoded == NULL)
+	{
+		s->decoded = (float *)Host_arena::instance().acquire(s->size * sizeof(float));
+		if (s->decoded == NULL)
+		{
+			log_err(ERROR_MEMORY_ALLOC_FAIL, "Failed to allocate decode cache.");
+			return NULL;
+		}
+		s->tile_done.assign((s->size + TENSOR_TILE_SIZE - 1) / TENSOR_TILE_SIZE, false);
+	}
+	begin += this->offset;
+	end += this->offset;
+	for (size_t tile = begin / TENSOR_TILE_SIZE; tile * TENSOR_TILE_SIZE < end; tile++)
+	{
+		if (s->tile_done[tile])
+		{
+			continue;
+		}
+		size_t first = tile * TENSOR_TILE_SIZE;
+		size_t n = std::min((size_t)TENSOR_TILE_SIZE, s->size - first);
+		switch (s->format)
+		{
+		case TENSOR_FLOAT8:
+			float8_decode((const uint8_t *)s->data + first, s->decoded + first, n);
+			break;
+		case TENSOR_UINT8:
+			std::copy((const uint8_t *)s->data + first, (const uint8_t *)s->data + first + n, s->decoded + first);
+			break;
+		case TENSOR_INT8:
+			std::copy(s->data + first, s->data + first + n, s->decoded + first);
+			break;
+		}
+		s->tile_done[tile] = true;
+		s->tiles_decoded++;
+	}
+	return s->decoded + begin;
+}
+
+/** at -> decoded value of one element
+ */
+float Tensor::at(int c, int h, int w)
+{
+	size_t idx;
+	const float *value;
+
+	CHECK_AND_THROW(c >= 0 && c < this->dims[0] && h >= 0 && h < this->dims[1] && w >= 0 && w < this->dims[2],
+					ERROR_DIMENSION_MISMATCH, "Tensor index out of range.")
+	if (TENSOR_CHW == this->dim_layout)
+	{
+		idx = ((size_t)c * this->dims[1] + h) * this->dims[2] + w;
+	}
+	else
+	{
+		idx = ((size_t)h * this->dims[2] + w) * this->dims[0] + c;
+	}
+	value = decode(idx, idx + 1);
+	CHECK_AND_THROW(value != NULL, ERROR_MEMORY_ALLOC_FAIL, "Failed to decode tensor.")
+	return *value;
+}
+
+/** slice -> decodes entries [begin, end) of the outermost dimension
+ * 			 (channels for TENSOR_CHW, rows for TENSOR_HWC)
+ * @values: decoded values, valid as long as the tensor or one of its views exists
+ * @n: number of values
+ */
+int Tensor::slice(int begin, int end, const float **values, int *n)
+{
+	size_t inner = (TENSOR_CHW == this->dim_layout) ? (size_t)this->dims[1] * this->dims[2]
+													 : (size_t)this->dims[2] * this->dims[0];
+	int outer = (TENSOR_CHW == this->dim_layout) ? this->dims[0] : this->dims[1];
+
+	CHECK(begin >= 0 && begin <= end && end <= outer, ERROR_DIMENSION_MISMATCH, "Slice exceeds tensor.")
+	*values = decode(begin * inner, end * inner);
+	CHECK_NOT_NULL(*values, ERROR_MEMORY_ALLOC_FAIL)
+	*n = (int)((end - begin) * inner);
+	return 0;
+}
+
+/** raw -> undecoded elements
+ */
+int Tensor::raw(const int8_t **data, int *n)
+{
+	*data = this->storage->data + this->offset;
+	*n = size();
+	return 0;
+}
+
+/** tile_count -> number of decode tiles of the storage (shared with all views)
+ */
+int Tensor::tile_count()
+{
+	return (int)((this->storage->size + TENSOR_TILE_SIZE - 1) / TENSOR_TILE_SIZE);
+}
+
+/** decoded_tiles -> tiles decoded so far (shared with all views)
+ */
+int Tensor::decoded_tiles()
+{
+	std::lock_guard<std::mutex> guard(this->storage->lock);
+	return this->storage->tiles_decoded;
+}
+
+std::shared_ptr<struct tensor_storage> Tensor::get_storage()
+{
+	return this->storage;
+}
@@ -0,0 +1,91 @@
+/*
+ * tensor.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Network outputs as typed tensors: shape, layout and element format travel with the data.
+ * float32 values are decoded lazily per tile of TENSOR_TILE_SIZE elements when they are
+ * accessed and cached, so postprocessing reading a few values only pays for those tiles.
+ * Views (e.g. the outputs of a multi output network) share data and cache of their tensor.
+ */
+#ifndef SRC_TENSOR_H_
+#define SRC_TENSOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include "result_pool.hpp"
+
+#define TENSOR_TILE_SIZE 1024 // elements decoded at once
+
+enum tensor_format
+{
+    TENSOR_INT8,
+    TENSOR_UINT8,
+    TENSOR_FLOAT8 // 4 bit mantissa, 4 bit negative exponent (network outputs)
+};
+
+enum tensor_layout
+{
+    TENSOR_CHW,
+    TENSOR_HWC
+};
+
+void float8_decode(const uint8_t *fmap_in, float *fmap_out, size_t n);
+
+/** tensor_storage -> data and decode cache shared by a tensor, its views and exported arrays
+ * @result: pooled network result (NULL if the data is owned)
+ * @owned: copy of the data (arena)
+ * @decoded: float32 cache (arena), allocated by the first decode
+ * @tile_done: decoded tiles
+ */
+struct tensor_storage
+{
+    std::shared_ptr<Result_ref> result;
+    int8_t *owned = NULL;
+    const int8_t *data = NULL;
+    size_t size = 0;
+    enum tensor_format format = TENSOR_INT8;
+    float *decoded = NULL;
+    std::vector<bool> tile_done;
+    int tiles_decoded = 0;
+    std::mutex lock;
+
+    ~tensor_storage();
+};
+
+class Tensor
+{
+public:
+    Tensor(const int8_t *data, int c, int h, int w, int format = TENSOR_FLOAT8, int layout = TENSOR_CHW);
+    Tensor(std::shared_ptr<Result_ref> result, const int8_t *data, int c, int h, int w,
+           int format = TENSOR_FLOAT8, int layout = TENSOR_CHW);
+
+    int channels();
+    int height();
+    int width();
+    int size();
+    int format();
+    int layout();
+    Tensor *view(int offset, int c, int h, int w);
+
+    float at(int c, int h, int w);
+    const float *decode(size_t begin, size_t end);
+    int slice(int begin, int end, const float **values, int *n);
+    int raw(const int8_t **data, int *n);
+    int tile_count();
+    int decoded_tiles();
+    std::shared_ptr<struct tensor_storage> get_storage();
+
+private:
+    Tensor(std::shared_ptr<struct tensor_storage> storage, size_t offset, int c, int h, int w, int layout);
+    std::shared_ptr<struct tensor_storage> storage;
+    size_t offset; // first element in the storage
+    int dims[3];   // channels, height, width
+    enum tensor_layout dim_layout;
+};
+
+#endif /* SRC_TENSOR_H_ */
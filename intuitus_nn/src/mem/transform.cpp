@@ -0,0 +1,462 @@
+#include "transform.hpp"
+#include "tensor.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "realtime.hpp"
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TRANSFORM_NEON
+#endif
+
+/**
+ * transform_plan -> one transform_tensor call. The source is a matrix [rows, cols] which is
+ * 					 written transposed ([cols, rows]) or in place order to the destination.
+ * @flut, @ulut: decoded, scaled (and saturated) value of each of the 256 source bytes
+ */
+struct transform_plan
+{
+	const uint8_t *src;
+	void *dst;
+	size_t rows;
+	size_t cols;
+	bool transpose;
+	int src_format;
+	int dst_format;
+	float scale;
+	float offset;
+	float flut[256];
+	uint8_t ulut[256];
+};
+
+/** decode_float -> decodes n source bytes to float32
+ */
+static inline void decode_float(const struct transform_plan &p, const uint8_t *src, float *dst, size_t n)
+{
+	size_t i = 0;
+#ifdef TRANSFORM_NEON
+	if (p.src_format == TENSOR_FLOAT8)
+	{
+		// value = mantissa * 2^(-exponent - 4): the power of two is built as float bits (exponent 123 - e)
+		float32x4_t scale = vdupq_n_f32(p.scale), offset = vdupq_n_f32(p.offset);
+		uint16x8_t bias = vdupq_n_u16(123);
+		for (; i + 8 <= n; i += 8)
+		{
+			uint8x8_t v = vld1_u8(src + i);
+			uint16x8_t m = vmovl_u8(vand_u8(v, vdup_n_u8(0xf)));
+			uint16x8_t e = vsubq_u16(bias, vmovl_u8(vshr_n_u8(v, 4)));
+			float32x4_t lo = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(m))),
+									   vreinterpretq_f32_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(e)), 23)));
+			float32x4_t hi = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(m))),
+									   vreinterpretq_f32_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(e)), 23)));
+			vst1q_f32(dst + i, vmlaq_f32(offset, lo, scale));
+			vst1q_f32(dst + i + 4, vmlaq_f32(offset, hi, scale));
+		}
+	}
+#endif
+	for (; i < n; i++)
+	{
+		dst[i] = p.flut[src[i]];
+	}
+}
+
+/** decode_uint8 -> decodes n source bytes to saturated uint8
+ */
+static inline void decode_uint8(const struct transform_plan &p, const uint8_t *src, uint8_t *dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		dst[i] = p.ulut[src[i]];
+	}
+}
+
+/** store_transposed_float -> writes block[rn][kn] (row stride TRANSFORM_BLOCK_COLS) to dst[k][r]
+ * @stride: elements per destination line
+ */
+static inline void store_transposed_float(const float *block, size_t rn, size_t kn, float *dst, size_t stride)
+{
+	size_t r = 0, k;
+#ifdef TRANSFORM_NEON
+	for (; r + 4 <= rn; r += 4)
+	{
+		const float *b = block + r * TRANSFORM_BLOCK_COLS;
+		for (k = 0; k + 4 <= kn; k += 4)
+		{
+			// 4x4 transpose: rows r..r+3 of columns k..k+3 become 4 destination lines
+			float32x4x2_t t01 = vtrnq_f32(vld1q_f32(b + k), vld1q_f32(b + TRANSFORM_BLOCK_COLS + k));
+			float32x4x2_t t23 = vtrnq_f32(vld1q_f32(b + 2 * TRANSFORM_BLOCK_COLS + k), vld1q_f32(b + 3 * TRANSFORM_BLOCK_COLS + k));
+			float *d = dst + k * stride + r;
+			vst1q_f32(d, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+			vst1q_f32(d + stride, vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+			vst1q_f32(d + 2 * stride, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+			vst1q_f32(d + 3 * stride, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+		}
+		for (; k < kn; k++)
+		{
+			for (size_t i = 0; i < 4; i++)
+			{
+				dst[k * stride + r + i] = b[i * TRANSFORM_BLOCK_COLS + k];
+			}
+		}
+	}
+#endif
+	for (k = 0; k < kn && r < rn; k++)
+	{
+		for (size_t i = r; i < rn; i++)
+		{
+			dst[k * stride + i] = block[i * TRANSFORM_BLOCK_COLS + k];
+		}
+	}
+}
+
+/** store_transposed_uint8 -> writes block[rn][kn] (row stride TRANSFORM_BLOCK_COLS) to dst[k][r]
+ */
+static inline void store_transposed_uint8(const uint8_t *block, size_t rn, size_t kn, uint8_t *dst, size_t stride)
+{
+	for (size_t k = 0; k < kn; k++)
+	{
+		for (size_t r = 0; r < rn; r++)
+		{
+			dst[k * stride + r] = block[r * TRANSFORM_BLOCK_COLS + k];
+		}
+	}
+}
+
+/** transform_range -> transforms the source rows [r0, r1) and columns [k0, k1)
+ */
+static void transform_range(const struct transform_plan &p, size_t r0, size_t r1, size_t k0, size_t k1)
+{
+	alignas(64) float fblock[TRANSFORM_BLOCK_ROWS * TRANSFORM_BLOCK_COLS];
+	alignas(64) uint8_t ublock[TRANSFORM_BLOCK_ROWS * TRANSFORM_BLOCK_COLS];
+
+	if (!p.transpose)
+	{
+		for (size_t r = r0; r < r1; r++)
+		{
+			size_t pos = r * p.cols + k0;
+			if (p.dst_format == TRANSFORM_FLOAT32)
+			{
+				decode_float(p, p.src + pos, (float *)p.dst + pos, k1 - k0);
+			}
+			else
+			{
+				decode_uint8(p, p.src + pos, (uint8_t *)p.dst + pos, k1 - k0);
+			}
+		}
+		return;
+	}
+	for (size_t rb = r0; rb < r1; rb += TRANSFORM_BLOCK_ROWS)
+	{
+		size_t rn = std::min((size_t)TRANSFORM_BLOCK_ROWS, r1 - rb);
+		for (size_t kb = k0; kb < k1; kb += TRANSFORM_BLOCK_COLS)
+		{
+			size_t kn = std::min((size_t)TRANSFORM_BLOCK_COLS, k1 - kb);
+			const uint8_t *src = p.src + rb * p.cols + kb;
+			if (p.dst_format == TRANSFORM_FLOAT32)
+			{
+				for (size_t r = 0; r < rn; r++)
+				{
+					decode_float(p, src + r * p.cols, fblock + r * TRANSFORM_BLOCK_COLS, kn);
+				}
+				store_transposed_float(fblock, rn, kn, (float *)p.dst + kb * p.rows + rb, p.rows);
+			}
+			else
+			{
+				for (size_t r = 0; r < rn; r++)
+				{
+					decode_uint8(p, src + r * p.cols, ublock + r * TRANSFORM_BLOCK_COLS, kn);
+				}
+				store_transposed_uint8(ublock, rn, kn, (uint8_t *)p.dst + kb * p.rows + rb, p.rows);
+			}
+		}
+	}
+}
+
+/**
+ * Transform_workers -> persistent helper threads for large transforms (see Copy_workers in dma_copy.cpp).
+ * 						The source is split along its longer dimension in whole blocks.
+ */
+class Transform_workers
+{
+public:
+	static Transform_workers &instance()
+	{
+		static Transform_workers *workers = new Transform_workers(); // never destroyed, threads are detached
+		return *workers;
+	}
+
+	void run(const struct transform_plan &p)
+	{
+		std::lock_guard<std::mutex> call_guard(this->call_lock);
+		int parts, i;
+
+		start_workers();
+		parts = this->threads;
+		bool split_rows = p.rows >= p.cols;
+		size_t len = split_rows ? p.rows : p.cols;
+		size_t unit = split_rows ? TRANSFORM_BLOCK_ROWS : TRANSFORM_BLOCK_COLS;
+		size_t chunk = ((len + parts - 1) / parts + unit - 1) / unit * unit;
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->plan = &p;
+			for (i = 0; i < parts; i++)
+			{
+				size_t begin = std::min(len, chunk * i), end = std::min(len, chunk * (i + 1));
+				this->jobs[i] = split_rows ? job{begin, end, 0, p.cols} : job{0, p.rows, begin, end};
+			}
+			this->active = parts - 1;
+			this->pending = parts - 1;
+			this->generation++;
+		}
+		this->job_cv.notify_all();
+		transform_range(p, this->jobs[0].r0, this->jobs[0].r1, this->jobs[0].k0, this->jobs[0].k1);
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->done_cv.wait(guard, [this]() { return 0 == this->pending; });
+	}
+
+	int set_threads(int threads)
+	{
+		std::lock_guard<std::mutex> call_guard(this->call_lock);
+		if (threads < 1 || threads > TRANSFORM_MAX_THREADS)
+		{
+			return -1;
+		}
+		this->threads = threads;
+		return 0;
+	}
+
+	int get_threads()
+	{
+		std::lock_guard<std::mutex> call_guard(this->call_lock);
+		return this->threads;
+	}
+
+private:
+	struct job
+	{
+		size_t r0, r1;
+		size_t k0, k1;
+	};
+	std::mutex call_lock; // one parallel transform at a time
+	std::mutex lock;
+	std::condition_variable job_cv;
+	std::condition_variable done_cv;
+	const struct transform_plan *plan = NULL;
+	struct job jobs[TRANSFORM_MAX_THREADS];
+	uint64_t generation = 0;
+	int active = 0;  // workers taking part in the current transform
+	int pending = 0; // active workers not yet finished
+	int threads;
+	int started = 0;
+
+	Transform_workers()
+	{
+		unsigned int cores = std::thread::hardware_concurrency();
+		this->threads = cores < 1 ? 1 : (cores > TRANSFORM_MAX_THREADS ? TRANSFORM_MAX_THREADS : cores);
+	}
+
+	void start_workers()
+	{
+		for (; this->started < this->threads - 1; this->started++)
+		{
+			std::thread(&Transform_workers::worker, this, this->started).detach();
+		}
+	}
+
+	void worker(int idx)
+	{
+		uint64_t seen = 0;
+		const struct transform_plan *p;
+		struct job j;
+
+		// may be started from a pinned real-time thread: worker role (realtime.hpp)
+		rt_register_worker();
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->job_cv.wait(guard, [&]() { return this->generation != seen; });
+				seen = this->generation;
+				if (idx >= this->active)
+				{
+					continue; // not part of this transform
+				}
+				p = this->plan;
+				j = this->jobs[idx + 1];
+			}
+			transform_range(*p, j.r0, j.r1, j.k0, j.k1);
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->pending--;
+			}
+			this->done_cv.notify_all();
+		}
+	}
+};
+
+/** transform_tensor -> decodes, permutes and scales a tensor in one pass
+ * @src: source elements [c, h, w] (CHW) or [h, w, c] (HWC), one byte each
+ * @c, @h, @w: channels, height, width
+ * @desc: formats, layouts and scaling
+ * @dst: destination, c * h * w elements of desc.dst_format
+ */
+int transform_tensor(const uint8_t *src, int c, int h, int w, const struct transform_desc &desc, void *dst)
+{
+	struct transform_plan p;
+	size_t pixels = (size_t)h * w;
+
+	CHECK(src != NULL && dst != NULL, ERROR_NULL_POINTER_PARAMETER, "Missing transform buffer.")
+	CHECK(c > 0 && h > 0 && w > 0, ERROR_DIMENSION_MISMATCH, "Invalid tensor shape.")
+	CHECK(desc.src_format >= TENSOR_INT8 && desc.src_format <= TENSOR_FLOAT8 &&
+			  (desc.dst_format == TRANSFORM_FLOAT32 || desc.dst_format == TRANSFORM_UINT8) &&
+			  (desc.src_layout == TENSOR_CHW || desc.src_layout == TENSOR_HWC) &&
+			  (desc.dst_layout == TENSOR_CHW || desc.dst_layout == TENSOR_HWC),
+		  ERROR_OTHER, "Invalid transform format or layout.")
+
+	p.src = src;
+	p.dst = dst;
+	p.transpose = desc.src_layout != desc.dst_layout;
+	p.rows = desc.src_layout == TENSOR_CHW ? (size_t)c : pixels;
+	p.cols = desc.src_layout == TENSOR_CHW ? pixels : (size_t)c;
+	if (!p.transpose)
+	{
+		p.rows = 1;
+		p.cols = (size_t)c * pixels;
+	}
+	p.src_format = desc.src_format;
+	p.dst_format = desc.dst_format;
+	p.scale = desc.scale;
+	p.offset = desc.offset;
+	for (int v = 0; v < 256; v++)
+	{
+		float value;
+		if (desc.src_format == TENSOR_FLOAT8)
+		{
+			value = ldexpf((float)(v & 0xf), (-1) * (v >> 4) - 4);
+		}
+		else
+		{
+			value = desc.src_format == TENSOR_INT8 ? (float)(int8_t)v : (float)v;
+		}
+		value = value * desc.scale + desc.offset;
+		if (desc.dst_format == TRANSFORM_FLOAT32)
+		{
+			p.flut[v] = value;
+		}
+		else
+		{
+			p.ulut[v] = (uint8_t)std::min(255.0f, std::max(0.0f, roundf(value)));
+		}
+	}
+
+	if ((size_t)c * pixels < TRANSFORM_MT_THRESHOLD || Transform_workers::instance().get_threads() < 2)
+	{
+		transform_range(p, 0, p.rows, 0, p.cols);
+		return 0;
+	}
+	Transform_workers::instance().run(p);
+	return 0;
+}
+
+/** transform_set_threads -> number of threads of large transforms (including the caller)
+ * @return: 0 or -1 if threads is out of range
+ */
+int transform_set_threads(int threads)
+{
+	return Transform_workers::instance().set_threads(threads);
+}
+
+/** transform_to_hwc_float -> converts a network output to HWC float32
+ * @fmap_in: output tensor [ci, h_in, w_in] (CHW)
+ * @format: tensor_format of the output (TENSOR_FLOAT8, TENSOR_INT8, TENSOR_UINT8)
+ * @scale, @offset: value * scale + offset
+ * @hwc_out: [h_out, w_out, co] (allocated using malloc, owned by caller)
+ */
+int transform_to_hwc_float(const uint8_t *fmap_in, int ci, int h_in, int w_in, int format, float scale, float offset,
+						   float **hwc_out, int *h_out, int *w_out, int *co)
+{
+	struct transform_desc desc = {format, TENSOR_CHW, TRANSFORM_FLOAT32, TENSOR_HWC, scale, offset};
+	float *out = (float *)malloc((size_t)ci * h_in * w_in * sizeof(float));
+	int err;
+
+	*hwc_out = NULL;
+	*h_out = *w_out = *co = 0;
+	CHECK_NOT_NULL(out, ERROR_MEMORY_ALLOC_FAIL)
+	err = transform_tensor(fmap_in, ci, h_in, w_in, desc, out);
+	if (0 != err)
+	{
+		free(out);
+		return err;
+	}
+	*hwc_out = out;
+	*h_out = h_in;
+	*w_out = w_in;
+	*co = ci;
+	return 0;
+}
+
+/** transform_to_hwc_uint8 -> converts a network output to HWC uint8 (e.g. for the framebuffer)
+ * @scale, @offset: value * scale + offset, rounded and saturated to 0..255
+ * @hwc_out: [h_out, w_out, co] (allocated using malloc, owned by caller)
+ */
+int transform_to_hwc_uint8(const uint8_t *fmap_in, int ci, int h_in, int w_in, int format, float scale, float offset,
+						   uint8_t **hwc_out, int *h_out, int *w_out, int *co)
+{
+	struct transform_desc desc = {format, TENSOR_CHW, TRANSFORM_UINT8, TENSOR_HWC, scale, offset};
+	uint8_t *out = (uint8_t *)malloc((size_t)ci * h_in * w_in);
+	int err;
+
+	*hwc_out = NULL;
+	*h_out = *w_out = *co = 0;
+	CHECK_NOT_NULL(out, ERROR_MEMORY_ALLOC_FAIL)
+	err = transform_tensor(fmap_in, ci, h_in, w_in, desc, out);
+	if (0 != err)
+	{
+		free(out);
+		return err;
+	}
+	*hwc_out = out;
+	*h_out = h_in;
+	*w_out = w_in;
+	*co = ci;
+	return 0;
+}
+
+/** transform_to_chw -> converts an image to the network input layout
+ * @img_in: image [h_in, w_in, ci] (HWC uint8)
+ * @scale, @offset: value * scale + offset, rounded and saturated to 0..255
+ * @chw_out: [co, h_out, w_out] (allocated using malloc, owned by caller)
+ */
+int transform_to_chw(const uint8_t *img_in, int h_in, int w_in, int ci, float scale, float offset,
+					 uint8_t **chw_out, int *co, int *h_out, int *w_out)
+{
+	struct transform_desc desc = {TENSOR_UINT8, TENSOR_HWC, TRANSFORM_UINT8, TENSOR_CHW, scale, offset};
+	uint8_t *out = (uint8_t *)malloc((size_t)ci * h_in * w_in);
+	int err;
+
+	*chw_out = NULL;
+	*co = *h_out = *w_out = 0;
+	CHECK_NOT_NULL(out, ERROR_MEMORY_ALLOC_FAIL)
+	err = transform_tensor(img_in, ci, h_in, w_in, desc, out);
+	if (0 != err)
+	{
+		free(out);
+		return err;
+	}
+	*chw_out = out;
+	*co = ci;
+	*h_out = h_in;
+	*w_out = w_in;
+	return 0;
+}
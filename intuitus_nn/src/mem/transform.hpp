@@ -0,0 +1,57 @@
+/*
+ * transform.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Fused tensor transform: element decoding (int8, uint8, float8), layout permutation
+ * (CHW <-> HWC) and scaling (value * scale + offset, saturated for uint8 output) in one pass.
+ * The permutation works on blocks of TRANSFORM_BLOCK_ROWS x TRANSFORM_BLOCK_COLS elements which
+ * stay in the L1 cache: source rows are decoded into the block (NEON for float8), then the block
+ * is written transposed (NEON 4x4 transposes). Large tensors are split over several cores.
+ * Replaces float8_to_float32 + numpy transpose + copy for network outputs (CHW float8 ->
+ * HWC float32 / uint8) and prepares camera images for the network (HWC uint8 -> CHW).
+ */
+#ifndef SRC_TRANSFORM_H_
+#define SRC_TRANSFORM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// output formats
+#define TRANSFORM_FLOAT32 0
+#define TRANSFORM_UINT8 1
+
+#define TRANSFORM_BLOCK_ROWS 16               // source rows per block (elements of a destination line)
+#define TRANSFORM_BLOCK_COLS 64               // source columns per block
+#define TRANSFORM_MAX_THREADS 4               // transform threads including the caller
+#define TRANSFORM_MT_THRESHOLD (128 * 1024)   // smaller tensors are transformed by the caller alone
+
+/**
+ * transform_desc -> conversion applied by transform_tensor
+ * @src_format: tensor_format of the source (TENSOR_INT8, TENSOR_UINT8, TENSOR_FLOAT8)
+ * @src_layout, @dst_layout: TENSOR_CHW or TENSOR_HWC
+ * @dst_format: TRANSFORM_FLOAT32 or TRANSFORM_UINT8
+ * @scale, @offset: dst = decoded * scale + offset (uint8: rounded and saturated)
+ */
+struct transform_desc
+{
+    int src_format;
+    int src_layout;
+    int dst_format;
+    int dst_layout;
+    float scale;
+    float offset;
+};
+
+int transform_tensor(const uint8_t *src, int c, int h, int w, const struct transform_desc &desc, void *dst);
+int transform_set_threads(int threads);
+
+int transform_to_hwc_float(const uint8_t *fmap_in, int ci, int h_in, int w_in, int format, float scale, float offset,
+                           float **hwc_out, int *h_out, int *w_out, int *co);
+int transform_to_hwc_uint8(const uint8_t *fmap_in, int ci, int h_in, int w_in, int format, float scale, float offset,
+                           uint8_t **hwc_out, int *h_out, int *w_out, int *co);
+int transform_to_chw(const uint8_t *img_in, int h_in, int w_in, int ci, float scale, float offset,
+                     uint8_t **chw_out, int *co, int *h_out, int *w_out);
+
+#endif /* SRC_TRANSFORM_H_ */
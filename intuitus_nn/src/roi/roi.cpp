@@ -0,0 +1,294 @@
+#include "roi.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#define ROI_WEIGHT_BITS 8 // fixed point fraction of the bilinear weights
+
+/** roi_validate -> checks a region list [roi_cnt, roi_dim] against the frame size
+ */
+int roi_validate(const int32_t *rois, int roi_cnt, int roi_dim, int frame_h, int frame_w)
+{
+	CHECK(roi_dim == ROI_DIM, ERROR_DIMENSION_MISMATCH, "Regions need 4 values: x, y, w, h.")
+	CHECK(roi_cnt > 0 && roi_cnt <= ROI_MAX_REGIONS, ERROR_DIMENSION_MISMATCH, "Invalid number of regions.")
+	for (int i = 0; i < roi_cnt; i++)
+	{
+		const int32_t *r = rois + i * ROI_DIM;
+		CHECK(r[0] >= 0 && r[1] >= 0 && r[2] > 0 && r[3] > 0 && r[0] + r[2] <= frame_w && r[1] + r[3] <= frame_h,
+			  ERROR_DIMENSION_MISMATCH, "Region exceeds the frame.")
+	}
+	return 0;
+}
+
+// tile offsets along one axis
+static void tile_positions(int frame, int tile, int overlap, std::vector<int> &pos, int *size)
+{
+	pos.clear();
+	if (frame <= tile)
+	{
+		pos.push_back(0);
+		*size = frame;
+		return;
+	}
+	int stride = tile - overlap;
+	int n = (frame - tile + stride - 1) / stride + 1;
+	for (int i = 0; i < n; i++)
+	{
+		pos.push_back((int)(((int64_t)i * (frame - tile) + (n - 1) / 2) / (n - 1)));
+	}
+	*size = tile;
+}
+
+/** roi_tile_grid -> overlapping tiles covering the frame
+ * 					 Tiles are spread evenly: neighbours overlap by at least overlap pixels and
+ * 					 the last tile ends at the frame border. A frame smaller than a tile is
+ * 					 covered by a single tile of the frame size (upscaled when staged).
+ * @tile_h, @tile_w: tile size, usually the network input size (no scaling)
+ * @overlap: minimum overlap of neighbouring tiles, should exceed the size of the expected objects
+ */
+int roi_tile_grid(int frame_h, int frame_w, int tile_h, int tile_w, int overlap,
+				  std::vector<struct roi_rect> &tiles)
+{
+	std::vector<int> xs, ys;
+	int w, h;
+
+	CHECK(frame_h > 0 && frame_w > 0 && tile_h > 0 && tile_w > 0, ERROR_DIMENSION_MISMATCH, "Invalid frame or tile size.")
+	CHECK(overlap >= 0 && overlap < tile_h && overlap < tile_w, ERROR_DIMENSION_MISMATCH, "Overlap has to be smaller than the tile.")
+	tile_positions(frame_w, tile_w, overlap, xs, &w);
+	tile_positions(frame_h, tile_h, overlap, ys, &h);
+	CHECK(xs.size() * ys.size() <= ROI_MAX_REGIONS, ERROR_DIMENSION_MISMATCH, "Too many tiles.")
+	tiles.clear();
+	for (int y : ys)
+	{
+		for (int x : xs)
+		{
+			tiles.push_back({x, y, w, h});
+		}
+	}
+	return 0;
+}
+
+/** roi_stage -> crops a region of a frame (h, w, c), resizes it bilinearly to (dst_h, dst_w) and
+ * 				 writes it in network layout (c, dst_h, dst_w). The region has to be checked by roi_validate.
+ */
+void roi_stage(const uint8_t *img, int img_w, int img_c, const struct roi_rect &roi,
+			   uint8_t *dst, int dst_h, int dst_w)
+{
+	const int one = 1 << ROI_WEIGHT_BITS;
+	size_t plane = (size_t)dst_h * dst_w;
+	int x, y, c;
+
+	if (roi.w == dst_w && roi.h == dst_h)
+	{
+		// 1:1 crop, layout conversion only
+		for (y = 0; y < dst_h; y++)
+		{
+			const uint8_t *src = img + ((size_t)(roi.y + y) * img_w + roi.x) * img_c;
+			for (x = 0; x < dst_w; x++)
+			{
+				for (c = 0; c < img_c; c++)
+				{
+					dst[c * plane + (size_t)y * dst_w + x] = src[x * img_c + c];
+				}
+			}
+		}
+		return;
+	}
+
+	// source columns and weights, shared by all rows
+	std::vector<int> x0(dst_w), x1(dst_w), wx(dst_w);
+	for (x = 0; x < dst_w; x++)
+	{
+		float sx = ((float)x + 0.5f) * roi.w / dst_w - 0.5f;
+		sx = std::max(sx, 0.0f);
+		int ix = std::min((int)sx, roi.w - 1);
+		x0[x] = (roi.x + ix) * img_c;
+		x1[x] = (roi.x + std::min(ix + 1, roi.w - 1)) * img_c;
+		wx[x] = (int)((sx - ix) * one);
+	}
+	for (y = 0; y < dst_h; y++)
+	{
+		float sy = ((float)y + 0.5f) * roi.h / dst_h - 0.5f;
+		sy = std::max(sy, 0.0f);
+		int iy = std::min((int)sy, roi.h - 1);
+		int wy = (int)((sy - iy) * one);
+		const uint8_t *row0 = img + (size_t)(roi.y + iy) * img_w * img_c;
+		const uint8_t *row1 = img + (size_t)(roi.y + std::min(iy + 1, roi.h - 1)) * img_w * img_c;
+		for (x = 0; x < dst_w; x++)
+		{
+			for (c = 0; c < img_c; c++)
+			{
+				int top = row0[x0[x] + c] * (one - wx[x]) + row0[x1[x] + c] * wx[x];
+				int bottom = row1[x0[x] + c] * (one - wx[x]) + row1[x1[x] + c] * wx[x];
+				int v = top * (one - wy) + bottom * wy;
+				dst[c * plane + (size_t)y * dst_w + x] = (uint8_t)((v + (1 << (2 * ROI_WEIGHT_BITS - 1))) >> (2 * ROI_WEIGHT_BITS));
+			}
+		}
+	}
+}
+
+struct roi_box
+{
+	float x1, y1, x2, y2;
+	float score;
+	float cls;
+	bool cut; // touches a tile border inside the frame, the object may continue in a neighbour
+};
+
+static float box_area(const struct roi_box &b)
+{
+	return std::max(b.x2 - b.x1, 0.0f) * std::max(b.y2 - b.y1, 0.0f);
+}
+
+/** roi_merge -> maps detections of the regions to frame coordinates and removes duplicates
+ * 				 Class wise non maximum suppression: a box is dropped if it overlaps a stronger
+ * 				 box by iou_threshold. Boxes cut by a tile border are compared by intersection
+ * 				 over the smaller box instead, the stronger box is then extended to the union
+ * 				 so an object split between two tiles is reported once and completely.
+ * @dets: detections [det_cnt, ROI_DETECTION_DIM] in network input pixels of their region
+ * @rois: regions [roi_cnt, ROI_DIM] the network was executed on
+ * @net_h, @net_w: network input size
+ * @merged: detections [n, ROI_MERGED_DIM] in frame pixels, by descending score
+ */
+int roi_merge(const float *dets, int det_cnt, int det_dim,
+			  const int32_t *rois, int roi_cnt, int roi_dim,
+			  int frame_h, int frame_w, int net_h, int net_w, float iou_threshold,
+			  std::vector<float> &merged)
+{
+	std::vector<struct roi_box> boxes;
+	std::vector<int> order;
+	std::vector<bool> dropped;
+	int err, i, j;
+
+	merged.clear();
+	err = roi_validate(rois, roi_cnt, roi_dim, frame_h, frame_w);
+	if (0 != err)
+	{
+		return err;
+	}
+	CHECK(det_dim == ROI_DETECTION_DIM && det_cnt >= 0, ERROR_DIMENSION_MISMATCH, "Detections need 7 values: roi, x1, y1, x2, y2, score, class.")
+	CHECK(net_h > 0 && net_w > 0, ERROR_DIMENSION_MISMATCH, "Invalid network input size.")
+
+	boxes.reserve(det_cnt);
+	for (i = 0; i < det_cnt; i++)
+	{
+		const float *d = dets + (size_t)i * ROI_DETECTION_DIM;
+		int r = (int)d[0];
+		CHECK(r >= 0 && r < roi_cnt, ERROR_DIMENSION_MISMATCH, "Detection refers to an unknown region.")
+		const int32_t *roi = rois + r * ROI_DIM;
+		float sx = (float)roi[2] / net_w;
+		float sy = (float)roi[3] / net_h;
+		struct roi_box b;
+		b.x1 = std::min(std::max(roi[0] + d[1] * sx, 0.0f), (float)frame_w);
+		b.y1 = std::min(std::max(roi[1] + d[2] * sy, 0.0f), (float)frame_h);
+		b.x2 = std::min(std::max(roi[0] + d[3] * sx, 0.0f), (float)frame_w);
+		b.y2 = std::min(std::max(roi[1] + d[4] * sy, 0.0f), (float)frame_h);
+		b.score = d[5];
+		b.cls = d[6];
+		b.cut = (d[1] < ROI_BORDER_MARGIN && roi[0] > 0) ||
+				(d[2] < ROI_BORDER_MARGIN && roi[1] > 0) ||
+				(d[3] > net_w - ROI_BORDER_MARGIN && roi[0] + roi[2] < frame_w) ||
+				(d[4] > net_h - ROI_BORDER_MARGIN && roi[1] + roi[3] < frame_h);
+		boxes.push_back(b);
+		order.push_back(i);
+	}
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return boxes[a].score > boxes[b].score; });
+
+	dropped.assign(det_cnt, false);
+	for (i = 0; i < det_cnt; i++)
+	{
+		struct roi_box &keep = boxes[order[i]];
+		if (dropped[order[i]])
+		{
+			continue;
+		}
+		for (j = i + 1; j < det_cnt; j++)
+		{
+			struct roi_box &other = boxes[order[j]];
+			if (dropped[order[j]] || other.cls != keep.cls)
+			{
+				continue;
+			}
+			float iw = std::min(keep.x2, other.x2) - std::max(keep.x1, other.x1);
+			float ih = std::min(keep.y2, other.y2) - std::max(keep.y1, other.y1);
+			if (iw <= 0.0f || ih <= 0.0f)
+			{
+				continue;
+			}
+			float inter = iw * ih;
+			float a = box_area(keep), b = box_area(other);
+			if (inter >= iou_threshold * (a + b - inter))
+			{
+				dropped[order[j]] = true;
+			}
+			else if ((keep.cut || other.cut) && inter >= iou_threshold * std::min(a, b))
+			{
+				dropped[order[j]] = true;
+				keep.x1 = std::min(keep.x1, other.x1);
+				keep.y1 = std::min(keep.y1, other.y1);
+				keep.x2 = std::max(keep.x2, other.x2);
+				keep.y2 = std::max(keep.y2, other.y2);
+				keep.cut = keep.cut && other.cut;
+			}
+		}
+		merged.insert(merged.end(), {keep.x1, keep.y1, keep.x2, keep.y2, keep.score, keep.cls});
+	}
+	return 0;
+}
+
+/** roi_tiles -> roi_tile_grid as region array
+ * @rois_out: regions [roi_cnt, ROI_DIM] (allocated using malloc, owned by caller)
+ */
+int roi_tiles(int frame_h, int frame_w, int tile_h, int tile_w, int overlap,
+			  int32_t **rois_out, int *roi_cnt, int *roi_dim)
+{
+	std::vector<struct roi_rect> tiles;
+	int err;
+
+	*rois_out = NULL;
+	*roi_cnt = 0;
+	*roi_dim = ROI_DIM;
+	err = roi_tile_grid(frame_h, frame_w, tile_h, tile_w, overlap, tiles);
+	if (0 != err)
+	{
+		return err;
+	}
+	*rois_out = (int32_t *)malloc(tiles.size() * sizeof(struct roi_rect));
+	CHECK_NOT_NULL(*rois_out, ERROR_MEMORY_ALLOC_FAIL)
+	memcpy(*rois_out, tiles.data(), tiles.size() * sizeof(struct roi_rect));
+	*roi_cnt = tiles.size();
+	return 0;
+}
+
+/** roi_merge_detections -> roi_merge as array
+ * @merged_out: detections [merged_cnt, ROI_MERGED_DIM] in frame pixels (allocated using malloc, owned by caller)
+ */
+int roi_merge_detections(const float *dets, int det_cnt, int det_dim,
+						 const int32_t *rois, int roi_cnt, int roi_dim,
+						 int frame_h, int frame_w, int net_h, int net_w, float iou_threshold,
+						 float **merged_out, int *merged_cnt, int *merged_dim)
+{
+	std::vector<float> merged;
+	int err;
+
+	*merged_out = NULL;
+	*merged_cnt = 0;
+	*merged_dim = ROI_MERGED_DIM;
+	err = roi_merge(dets, det_cnt, det_dim, rois, roi_cnt, roi_dim, frame_h, frame_w, net_h, net_w, iou_threshold, merged);
+	if (0 != err)
+	{
+		return err;
+	}
+	// at least one element: numpy needs a valid pointer for empty results
+	*merged_out = (float *)malloc(std::max(merged.size(), (size_t)1) * sizeof(float));
+	CHECK_NOT_NULL(*merged_out, ERROR_MEMORY_ALLOC_FAIL)
+	if (!merged.empty())
+	{
+		memcpy(*merged_out, merged.data(), merged.size() * sizeof(float));
+	}
+	*merged_cnt = merged.size() / ROI_MERGED_DIM;
+	return 0;
+}
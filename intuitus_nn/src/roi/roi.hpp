@@ -0,0 +1,48 @@
+/*
+ * roi.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Inference on regions of full resolution frames. The network input size is fixed, so small
+ * objects in large frames are detected by running the network on several crops (explicit
+ * regions or an overlapping tile grid). Crops are resized and converted from the frame layout
+ * (h, w, c) to the network layout (c, h, w) while they are staged (Intuitus_intf::execute_rois).
+ * Detections of all crops are mapped back to frame coordinates and deduplicated, including
+ * objects which were cut by a tile border.
+ */
+#ifndef SRC_ROI_H_
+#define SRC_ROI_H_
+
+#include <stdint.h>
+#include <vector>
+
+#define ROI_DIM 4               // rois: [n, 4] = x, y, w, h in frame pixels
+#define ROI_MAX_REGIONS 1024    // regions per call
+#define ROI_DETECTION_DIM 7     // detections: [n, 7] = roi, x1, y1, x2, y2, score, class (network input pixels)
+#define ROI_MERGED_DIM 6        // merged: [n, 6] = x1, y1, x2, y2, score, class (frame pixels)
+#define ROI_BORDER_MARGIN 2.0f  // boxes closer to an inner tile border (network input pixels) count as cut
+
+struct roi_rect
+{
+    int32_t x, y, w, h;
+};
+
+int roi_validate(const int32_t *rois, int roi_cnt, int roi_dim, int frame_h, int frame_w);
+int roi_tile_grid(int frame_h, int frame_w, int tile_h, int tile_w, int overlap,
+                  std::vector<struct roi_rect> &tiles);
+void roi_stage(const uint8_t *img, int img_w, int img_c, const struct roi_rect &roi,
+               uint8_t *dst, int dst_h, int dst_w);
+int roi_merge(const float *dets, int det_cnt, int det_dim,
+              const int32_t *rois, int roi_cnt, int roi_dim,
+              int frame_h, int frame_w, int net_h, int net_w, float iou_threshold,
+              std::vector<float> &merged);
+
+int roi_tiles(int frame_h, int frame_w, int tile_h, int tile_w, int overlap,
+              int32_t **rois_out, int *roi_cnt, int *roi_dim);
+int roi_merge_detections(const float *dets, int det_cnt, int det_dim,
+                         const int32_t *rois, int roi_cnt, int roi_dim,
+                         int frame_h, int frame_w, int net_h, int net_w, float iou_threshold,
+                         float **merged_out, int *merged_cnt, int *merged_dim);
+
+#endif /* SRC_ROI_H_ */
@@ -0,0 +1,292 @@
+#include "realtime.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+struct rt_role
+{
+	int cpu;
+	int priority;
+};
+
+static std::mutex roles_lock;
+static struct rt_role roles[RT_ROLES] = {
+	{RT_DEFAULT_CAPTURE_CPU, RT_DEFAULT_CAPTURE_PRIORITY},
+	{RT_DEFAULT_INFERENCE_CPU, RT_DEFAULT_INFERENCE_PRIORITY},
+	{RT_DEFAULT_DISPLAY_CPU, RT_DEFAULT_DISPLAY_PRIORITY},
+	{RT_DEFAULT_WORKER_CPU, RT_DEFAULT_WORKER_PRIORITY}};
+// registered worker threads and whether they run with the worker role (guarded by roles_lock)
+static std::vector<pthread_t> workers;
+static bool workers_realtime = false;
+static std::atomic<bool> memory_locked(false);
+// missing privileges are reported once per process
+static std::atomic<bool> warned_affinity(false);
+static std::atomic<bool> warned_fifo(false);
+static std::atomic<bool> warned_mlock(false);
+
+static void warn_once(std::atomic<bool> &warned, int code, const char *msg)
+{
+	if (!warned.exchange(true))
+	{
+		log_warn(code, msg);
+	}
+}
+
+// touches the stack the thread may use later, so the real-time loop takes no page faults on it
+static void __attribute__((noinline)) prefault_stack()
+{
+	volatile uint8_t stack[RT_STACK_PREFAULT];
+	long page = sysconf(_SC_PAGESIZE);
+
+	for (size_t i = 0; i < sizeof(stack); i += page)
+	{
+		stack[i] = 0;
+	}
+}
+
+/** apply_worker -> sets the scheduling of a worker thread: the worker role once real-time mode is
+ * 				   in use, otherwise the default scheduler. Unpinned workers run on all cores.
+ * 				   Caller holds roles_lock.
+ */
+static void apply_worker(pthread_t thread)
+{
+	const struct rt_role &r = roles[RT_ROLE_WORKER];
+	struct sched_param param;
+	cpu_set_t set;
+	int err;
+
+	CPU_ZERO(&set);
+	if (workers_realtime && r.cpu != RT_NO_CPU)
+	{
+		CPU_SET(r.cpu, &set);
+	}
+	else
+	{
+		for (long i = 0; i < sysconf(_SC_NPROCESSORS_ONLN) && i < CPU_SETSIZE; i++)
+		{
+			CPU_SET(i, &set);
+		}
+	}
+	err = pthread_setaffinity_np(thread, sizeof(set), &set);
+	if (0 != err)
+	{
+		warn_once(warned_affinity, err, "Failed to set the cores of a worker thread.");
+	}
+	memset(&param, 0, sizeof(param));
+	if (workers_realtime && r.priority > 0)
+	{
+		param.sched_priority = r.priority;
+		err = pthread_setschedparam(thread, SCHED_FIFO, &param);
+		if (0 != err)
+		{
+			warn_once(warned_fifo, err, "SCHED_FIFO not permitted (CAP_SYS_NICE or RLIMIT_RTPRIO required). Using the default scheduler.");
+		}
+	}
+	else
+	{
+		// a worker started by a real-time thread inherits its policy
+		pthread_setschedparam(thread, SCHED_OTHER, &param);
+	}
+}
+
+/** rt_set_role -> configures the core and priority of a role
+ * @role: RT_ROLE_CAPTURE, RT_ROLE_INFERENCE, RT_ROLE_DISPLAY or RT_ROLE_WORKER (applied to running workers)
+ * @cpu: core of the role, RT_NO_CPU to run on all cores
+ * @priority: SCHED_FIFO priority (1..99), 0 to keep the default scheduler
+ */
+int rt_set_role(int role, int cpu, int priority)
+{
+	CHECK(role >= 0 && role < RT_ROLES, ERROR_OTHER, "Unknown real-time role.")
+	CHECK(cpu >= RT_NO_CPU && cpu < CPU_SETSIZE, ERROR_OTHER, "Invalid core.")
+	CHECK(priority >= 0 && priority <= sched_get_priority_max(SCHED_FIFO), ERROR_OTHER, "Invalid real-time priority.")
+	std::lock_guard<std::mutex> guard(roles_lock);
+	roles[role].cpu = cpu;
+	roles[role].priority = priority;
+	if (RT_ROLE_WORKER == role && workers_realtime)
+	{
+		for (pthread_t thread : workers)
+		{
+			apply_worker(thread);
+		}
+	}
+	return 0;
+}
+
+/** rt_enter -> applies the configuration of a role to the calling thread. The first real-time role
+ * 				entered also moves the worker threads to RT_ROLE_WORKER.
+ * @return: RT_APPLIED_* bits of the applied parts (0 without privileges) or an error code
+ */
+int rt_enter(int role)
+{
+	struct rt_role r;
+	int applied = 0, err;
+
+	CHECK(role >= 0 && role < RT_ROLES, ERROR_OTHER, "Unknown real-time role.")
+	{
+		std::lock_guard<std::mutex> guard(roles_lock);
+		r = roles[role];
+		if (r.priority > 0 && !workers_realtime)
+		{
+			workers_realtime = true;
+			for (pthread_t thread : workers)
+			{
+				apply_worker(thread);
+			}
+		}
+	}
+	if (r.cpu != RT_NO_CPU)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(r.cpu, &set);
+		err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+		if (0 == err)
+		{
+			applied |= RT_APPLIED_AFFINITY;
+		}
+		else
+		{
+			warn_once(warned_affinity, err, "Failed to pin thread to its core. Running unpinned.");
+		}
+	}
+	if (r.priority > 0)
+	{
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = r.priority;
+		err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+		if (0 == err)
+		{
+			applied |= RT_APPLIED_FIFO;
+		}
+		else
+		{
+			warn_once(warned_fifo, err, "SCHED_FIFO not permitted (CAP_SYS_NICE or RLIMIT_RTPRIO required). Using the default scheduler.");
+		}
+	}
+	prefault_stack();
+	if (memory_locked)
+	{
+		applied |= RT_APPLIED_MLOCK;
+	}
+	return applied;
+}
+
+/** rt_leave -> returns the calling thread to the default scheduler on all cores
+ */
+int rt_leave()
+{
+	struct sched_param param;
+	cpu_set_t set;
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+	memset(&param, 0, sizeof(param));
+	CPU_ZERO(&set);
+	for (long i = 0; i < cores && i < CPU_SETSIZE; i++)
+	{
+		CPU_SET(i, &set);
+	}
+	CHECK(0 == pthread_setschedparam(pthread_self(), SCHED_OTHER, &param), ERROR_OTHER, "Failed to restore the default scheduler.")
+	CHECK(0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set), ERROR_OTHER, "Failed to restore the core affinity.")
+	return 0;
+}
+
+/** rt_register_worker -> registers the calling thread as worker of the driver (DMA copy and transform
+ * 						 workers) and sets its scheduling (see apply_worker). Workers live until the
+ * 						 process exits.
+ */
+int rt_register_worker()
+{
+	std::lock_guard<std::mutex> guard(roles_lock);
+	workers.push_back(pthread_self());
+	apply_worker(pthread_self());
+	return 0;
+}
+
+/** rt_lock_memory -> locks all current and future pages of the process (mlockall)
+ * @return: RT_APPLIED_MLOCK or 0 without privileges
+ */
+int rt_lock_memory()
+{
+	if (0 != mlockall(MCL_CURRENT | MCL_FUTURE))
+	{
+		warn_once(warned_mlock, errno, "mlockall failed (CAP_IPC_LOCK or RLIMIT_MEMLOCK required). Memory stays pageable.");
+		return 0;
+	}
+	memory_locked = true;
+	return RT_APPLIED_MLOCK;
+}
+
+/** rt_unlock_memory -> ends rt_lock_memory
+ */
+int rt_unlock_memory()
+{
+	CHECK(0 == munlockall(), ERROR_OTHER, "munlockall failed.")
+	memory_locked = false;
+	return 0;
+}
+
+/** rt_prefault -> touches every page of a buffer
+ * @writable: write the pages (private memory), 0 to only read them (device and shared mappings)
+ */
+void rt_prefault(const void *ptr, size_t size, int writable)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	volatile uint8_t *p = (volatile uint8_t *)ptr;
+
+	if (ptr == NULL || size == 0)
+	{
+		return;
+	}
+	for (size_t i = 0; i < size; i += page)
+	{
+		uint8_t v = p[i];
+		if (writable)
+		{
+			p[i] = v;
+		}
+	}
+	if (writable)
+	{
+		p[size - 1] = p[size - 1];
+	}
+	else
+	{
+		(void)p[size - 1];
+	}
+}
+
+/** rt_get_thread_state -> returns the scheduling of the calling thread
+ */
+struct rt_thread_state rt_get_thread_state()
+{
+	struct rt_thread_state state;
+	struct sched_param param;
+	cpu_set_t set;
+	int policy = 0;
+
+	memset(&state, 0, sizeof(state));
+	if (0 == pthread_getschedparam(pthread_self(), &policy, &param))
+	{
+		state.policy = policy;
+		state.priority = param.sched_priority;
+	}
+	if (0 == pthread_getaffinity_np(pthread_self(), sizeof(set), &set))
+	{
+		for (int i = 0; i < 32; i++)
+		{
+			state.cpu_mask |= CPU_ISSET(i, &set) ? (1u << i) : 0;
+		}
+	}
+	state.memory_locked = memory_locked;
+	return state;
+}
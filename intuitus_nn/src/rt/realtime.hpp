@@ -0,0 +1,75 @@
+/*
+ * realtime.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Real-time mode of the camera -> inference -> display path. Each thread of the path enters its
+ * role (rt_enter): it is pinned to the configured core and scheduled with SCHED_FIFO at the
+ * configured priority. rt_lock_memory locks all current and future pages (mlockall), the
+ * prefault methods of Intuitus_intf, Camera and Framebuffer touch the buffers which mlockall
+ * does not populate (device mappings) or which are used first in the real-time loop.
+ * Missing privileges (CAP_SYS_NICE, CAP_IPC_LOCK / RLIMIT_MEMLOCK) are reported once and the
+ * affected part is skipped: the return values tell which parts were applied.
+ * The DMA copy and transform workers of the driver have their own role (RT_ROLE_WORKER): the
+ * inference thread waits for them, so once a thread of the process entered a real-time role they
+ * run with SCHED_FIFO at the inference priority (on all cores by default) and are not preempted
+ * by the capture and display threads. Before that they use the default scheduler, independent
+ * of the thread which started them. Batch staging threads inherit the scheduling of their creator.
+ */
+#ifndef SRC_REALTIME_H_
+#define SRC_REALTIME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RT_ROLE_CAPTURE 0
+#define RT_ROLE_INFERENCE 1
+#define RT_ROLE_DISPLAY 2
+#define RT_ROLE_WORKER 3 // helper threads of the driver, applied by rt_register_worker
+#define RT_ROLES 4
+
+// defaults for the dual core Zynq: camera and display share core 0, inference owns core 1
+#define RT_DEFAULT_CAPTURE_CPU 0
+#define RT_DEFAULT_CAPTURE_PRIORITY 70
+#define RT_DEFAULT_INFERENCE_CPU 1
+#define RT_DEFAULT_INFERENCE_PRIORITY 80
+#define RT_DEFAULT_DISPLAY_CPU 0
+#define RT_DEFAULT_DISPLAY_PRIORITY 60
+
+#define RT_NO_CPU (-1)        // role is not pinned
+// workers split the copies of the inference thread over all cores at its priority
+#define RT_DEFAULT_WORKER_CPU RT_NO_CPU
+#define RT_DEFAULT_WORKER_PRIORITY RT_DEFAULT_INFERENCE_PRIORITY
+#define RT_STACK_PREFAULT (64 * 1024) // stack touched by rt_enter
+
+// parts applied by rt_enter / rt_lock_memory
+#define RT_APPLIED_AFFINITY 0x1
+#define RT_APPLIED_FIFO 0x2
+#define RT_APPLIED_MLOCK 0x4
+
+/**
+ * rt_thread_state -> scheduling of the calling thread
+ * @policy: SCHED_OTHER (0), SCHED_FIFO (1), ...
+ * @priority: real-time priority, 0 for SCHED_OTHER
+ * @cpu_mask: allowed cores (bit n: core n, first 32 cores)
+ * @memory_locked: mlockall is active
+ */
+struct rt_thread_state
+{
+    int32_t policy;
+    int32_t priority;
+    uint32_t cpu_mask;
+    int32_t memory_locked;
+};
+
+int rt_set_role(int role, int cpu, int priority);
+int rt_enter(int role);
+int rt_leave();
+int rt_register_worker();
+int rt_lock_memory();
+int rt_unlock_memory();
+void rt_prefault(const void *ptr, size_t size, int writable);
+struct rt_thread_state rt_get_thread_state();
+
+#endif /* SRC_REALTIME_H_ */
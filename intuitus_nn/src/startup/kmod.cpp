@@ -0,0 +1,99 @@
+#include "kmod.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <string>
+
+/** kmod_is_loaded -> checks if a module is loaded (or built in with parameters)
+ * @name: module name (e.g. intuitus)
+ * @return: 1 if /sys/module/<name> exists, 0 otherwise
+ */
+int kmod_is_loaded(const char *name)
+{
+	std::string path = std::string(KMOD_SYSFS_PATH) + name;
+	struct stat st;
+
+	return (0 == stat(path.c_str(), &st) && S_ISDIR(st.st_mode)) ? 1 : 0;
+}
+
+/** kmod_load -> inserts a kernel module using finit_module
+ * @path: module file, a leading ~/ is replaced by $HOME like the shell did for insmod
+ * @params: module parameters ("" for none)
+ * @return: 0 if the module is loaded (also if it was loaded already)
+ */
+int kmod_load(const char *path, const char *params)
+{
+	std::string file(path);
+	const char *home = getenv("HOME");
+	int fd, err;
+
+	if (0 == file.compare(0, 2, "~/") && home != NULL)
+	{
+		file = std::string(home) + file.substr(1);
+	}
+	fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+	CHECK(fd >= 0, ERROR_CREATE_DEVICE, "Unable to open kernel module file.")
+	err = syscall(SYS_finit_module, fd, params, 0);
+	if (0 != err && EEXIST == errno)
+	{
+		err = 0; // loaded concurrently
+	}
+	close(fd);
+	CHECK(0 == err, ERROR_CREATE_DEVICE, "finit_module failed.")
+	return 0;
+}
+
+/** kmod_wait_device -> waits until a device node exists
+ * @timeout_ms: maximum wait time
+ */
+int kmod_wait_device(const char *dev_path, int timeout_ms)
+{
+	for (int waited_us = 0; access(dev_path, F_OK) != 0; waited_us += KMOD_DEVICE_POLL_US)
+	{
+		CHECK(waited_us < timeout_ms * 1000, ERROR_CREATE_DEVICE, "Device node not created.")
+		usleep(KMOD_DEVICE_POLL_US);
+	}
+	return 0;
+}
+
+/** kmod_ensure_device -> loads a module if its device node is missing and waits for the node
+ * @name: module name
+ * @path: module file
+ * @dev_path: device node created by the module
+ * @inserted: set to 1 if the module was inserted, 0 if it was loaded or built in already (may be NULL)
+ */
+int kmod_ensure_device(const char *name, const char *path, const char *dev_path, int *inserted)
+{
+	int err;
+
+	if (inserted != NULL)
+	{
+		*inserted = 0;
+	}
+	if (access(dev_path, F_OK) == 0)
+	{
+		return 0;
+	}
+	if (!kmod_is_loaded(name))
+	{
+		debug("Load kernel module: %s", path);
+		err = kmod_load(path, "");
+		if (0 != err)
+		{
+			return err;
+		}
+		if (inserted != NULL)
+		{
+			*inserted = 1;
+		}
+	}
+	return kmod_wait_device(dev_path, KMOD_DEVICE_TIMEOUT_MS);
+}
@@ -0,0 +1,22 @@
+/*
+ * kmod.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Kernel module loading without a shell: /sys/module lookup and finit_module instead of
+ * system("insmod ..."), which forks a shell and the insmod binary on every start.
+ */
+#ifndef SRC_KMOD_H_
+#define SRC_KMOD_H_
+
+#define KMOD_SYSFS_PATH "/sys/module/"
+#define KMOD_DEVICE_TIMEOUT_MS 2000 // time for devtmpfs / udev to create the device node
+#define KMOD_DEVICE_POLL_US 1000
+
+int kmod_is_loaded(const char *name);
+int kmod_load(const char *path, const char *params);
+int kmod_wait_device(const char *dev_path, int timeout_ms);
+int kmod_ensure_device(const char *name, const char *path, const char *dev_path, int *inserted);
+
+#endif /* SRC_KMOD_H_ */
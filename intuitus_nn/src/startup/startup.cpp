@@ -0,0 +1,206 @@
+#include "startup.hpp"
+#include "kmod.hpp"
+#include "journal.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "frame_tracker.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+/** Startup -> prepares the start-up, nothing is opened before run
+ * @network_path: network file written by save_network (NULL or "": device only)
+ * @camera_dev: video device (NULL or "": no camera)
+ * @width, @height, @fps: capture format of the camera
+ */
+Startup::Startup(const char *network_path, const char *camera_dev, int width, int height, int fps)
+{
+	this->network_path = network_path != NULL ? network_path : "";
+	this->camera_dev = camera_dev != NULL ? camera_dev : "";
+	this->width = width;
+	this->height = height;
+	this->fps = fps;
+	this->start_us = 0;
+	memset(&this->report, 0, sizeof(this->report));
+}
+
+Startup::~Startup()
+{
+	// camera and device are released by the unique pointers
+}
+
+/** start_device -> loads the kernel module and opens the device
+ */
+int Startup::start_device()
+{
+	uint64_t t0 = monotonic_us();
+	int err;
+
+	CHECK(geteuid() == 0, ERROR_CREATE_DEVICE, "Driver requires root privileges")
+	err = kmod_ensure_device(DRIVER_MODULE_NAME, LINUX_KERNEL_MODULE_PATH, LINUX_DEV_PATH, &this->report.module_inserted);
+	this->report.module_us = monotonic_us() - t0;
+	CHECK(0 == err, err, "Error loading intuitus-vdma kernel module.")
+
+	t0 = monotonic_us();
+	try
+	{
+		this->net.reset(new Intuitus_intf()); // finds the device, the module is not loaded again
+	}
+	catch (DMA_Exception &e)
+	{
+		this->report.device_us = monotonic_us() - t0;
+		return e.getCode();
+	}
+	this->report.device_us = monotonic_us() - t0;
+	return 0;
+}
+
+/** read_network -> reads the network file
+ */
+int Startup::read_network(std::vector<struct journal_record> &records)
+{
+	uint64_t t0 = monotonic_us();
+	int err = journal_load(this->network_path.c_str(), records);
+
+	this->report.network_read_us = monotonic_us() - t0;
+	return err;
+}
+
+/** upload_network -> creates the layers of the network file on the device
+ */
+int Startup::upload_network(const std::vector<struct journal_record> &records)
+{
+	uint64_t t0 = monotonic_us();
+	int err = this->net->upload_network(records);
+
+	this->report.upload_us = monotonic_us() - t0;
+	this->report.network_ready_us = monotonic_us() - this->start_us;
+	return err;
+}
+
+/** start_camera -> configures the camera pipeline and captures the first frame
+ * 					Starting the stream early hides the sensor start-up behind the network upload.
+ */
+int Startup::start_camera()
+{
+	uint64_t t0 = monotonic_us();
+	uint8_t *img;
+	int h, w, c, err;
+
+	this->cam.reset(new Camera(this->camera_dev.c_str(), this->width, this->height, this->fps));
+	this->report.camera_us = monotonic_us() - t0;
+
+	t0 = monotonic_us();
+	err = this->cam->capture(&img, &h, &w, &c);
+	this->report.first_frame_us = monotonic_us() - t0;
+	this->report.camera_ready_us = monotonic_us() - this->start_us;
+	CHECK(0 == err, ERROR_OTHER, "No frame from camera.")
+	return 0;
+}
+
+/** run -> starts device, network and camera
+ * 		  Camera errors terminate the process (see Camera::init).
+ * @mode: STARTUP_PARALLEL or STARTUP_SEQUENTIAL (stages one after the other, for comparison)
+ * @return: 0 or the error of the first failed stage
+ */
+int Startup::run(int mode)
+{
+	std::vector<struct journal_record> records;
+	int net_err = 0, read_err = 0, cam_err = 0;
+	bool has_network = !this->network_path.empty(), has_camera = !this->camera_dev.empty();
+
+	CHECK(!this->started, ERROR_OTHER, "Start-up already done.")
+	CHECK(mode == STARTUP_PARALLEL || mode == STARTUP_SEQUENTIAL, ERROR_OTHER, "Invalid start-up mode.")
+	this->started = true;
+	memset(&this->report, 0, sizeof(this->report));
+	this->start_us = monotonic_us();
+
+	if (mode == STARTUP_SEQUENTIAL)
+	{
+		net_err = start_device();
+		if (0 == net_err && has_network)
+		{
+			net_err = read_network(records);
+			if (0 == net_err)
+			{
+				net_err = upload_network(records);
+			}
+		}
+		if (0 == net_err && has_camera)
+		{
+			cam_err = start_camera();
+		}
+	}
+	else
+	{
+		std::thread camera_thread, read_thread;
+		if (has_camera)
+		{
+			camera_thread = std::thread([&]() { cam_err = start_camera(); });
+		}
+		if (has_network)
+		{
+			read_thread = std::thread([&]() { read_err = read_network(records); });
+		}
+		net_err = start_device();
+		if (read_thread.joinable())
+		{
+			read_thread.join();
+		}
+		if (0 == net_err && has_network)
+		{
+			net_err = (0 != read_err) ? read_err : upload_network(records);
+		}
+		if (camera_thread.joinable())
+		{
+			camera_thread.join();
+		}
+	}
+	if (!has_network)
+	{
+		this->report.network_ready_us = this->report.module_us + this->report.device_us;
+	}
+	this->report.total_us = monotonic_us() - this->start_us;
+	this->report.stage_sum_us = this->report.module_us + this->report.device_us + this->report.network_read_us +
+								this->report.upload_us + this->report.camera_us + this->report.first_frame_us;
+	if (0 != net_err)
+	{
+		return net_err;
+	}
+	return cam_err;
+}
+
+struct startup_report Startup::get_report()
+{
+	return this->report;
+}
+
+/** print_report -> prints the time to first frame breakdown
+ */
+void Startup::print_report()
+{
+	const struct startup_report &r = this->report;
+
+	printf("start-up [ms]: module %.1f%s | device %.1f | network read %.1f | upload %.1f | camera %.1f | first frame %.1f\n",
+		   r.module_us / 1000.0, r.module_inserted ? " (inserted)" : "", r.device_us / 1000.0, r.network_read_us / 1000.0,
+		   r.upload_us / 1000.0, r.camera_us / 1000.0, r.first_frame_us / 1000.0);
+	printf("network ready %.1f ms | camera ready %.1f ms | time to first frame %.1f ms (stages %.1f ms)\n",
+		   r.network_ready_us / 1000.0, r.camera_ready_us / 1000.0, r.total_us / 1000.0, r.stage_sum_us / 1000.0);
+}
+
+/** network -> the started device (owned by Startup, NULL before run)
+ */
+Intuitus_intf *Startup::network()
+{
+	return this->net.get();
+}
+
+/** camera -> the started camera (owned by Startup, NULL before run or without camera)
+ */
+Camera *Startup::camera()
+{
+	return this->cam.get();
+}
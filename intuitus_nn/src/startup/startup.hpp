@@ -0,0 +1,87 @@
+/*
+ * startup.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Start-up orchestration. Brings up the accelerator and the camera concurrently:
+ *   thread 1: kernel module (kmod.hpp) -> device open -> network upload
+ *   thread 2: network file read (joins thread 1 before the upload)
+ *   thread 3: camera pipeline configuration -> video device setup -> first frame
+ * The report breaks the time to the first frame (network uploaded and first camera frame
+ * captured) down into the stages. STARTUP_SEQUENTIAL runs the same stages one after the
+ * other for comparison.
+ */
+#ifndef SRC_STARTUP_H_
+#define SRC_STARTUP_H_
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+#include "intuitus.hpp"
+#include "v4l_camera.hpp"
+
+#define STARTUP_PARALLEL 0
+#define STARTUP_SEQUENTIAL 1
+
+/**
+ * startup_report -> time to first frame breakdown, all times in us
+ * @module_us: kernel module check / finit_module until the device node exists
+ * @device_us: device open and interface mapping
+ * @network_read_us: network file read and checked
+ * @upload_us: layer creation on the device
+ * @camera_us: pipeline configuration, video device and buffer setup
+ * @first_frame_us: stream on until the first frame is captured
+ * @network_ready_us: start -> network uploaded
+ * @camera_ready_us: start -> first frame captured
+ * @total_us: start -> network and first frame ready (time to first frame)
+ * @stage_sum_us: sum of all stages, i.e. the start-up time without overlap
+ * @module_inserted: 1 if the module was inserted by this start-up
+ */
+struct startup_report
+{
+    uint32_t module_us;
+    uint32_t device_us;
+    uint32_t network_read_us;
+    uint32_t upload_us;
+    uint32_t camera_us;
+    uint32_t first_frame_us;
+    uint32_t network_ready_us;
+    uint32_t camera_ready_us;
+    uint32_t total_us;
+    uint32_t stage_sum_us;
+    int module_inserted;
+};
+
+class Startup
+{
+public:
+    Startup(const char *network_path, const char *camera_dev, int width = WIDTH, int height = HEIGHT, int fps = FPS);
+    ~Startup();
+
+    int run(int mode = STARTUP_PARALLEL);
+    struct startup_report get_report();
+    void print_report();
+    Intuitus_intf *network();
+    Camera *camera();
+
+private:
+    std::string network_path; // empty: no network
+    std::string camera_dev;   // empty: no camera
+    int width;
+    int height;
+    int fps;
+    bool started = false;
+    std::unique_ptr<Intuitus_intf> net;
+    std::unique_ptr<Camera> cam;
+    struct startup_report report;
+    uint64_t start_us;
+
+    int start_device();
+    int read_network(std::vector<struct journal_record> &records);
+    int upload_network(const std::vector<struct journal_record> &records);
+    int start_camera();
+};
+
+#endif /* SRC_STARTUP_H_ */
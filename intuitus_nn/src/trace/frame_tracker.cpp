@@ -0,0 +1,222 @@
+#include "frame_tracker.hpp"
+
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+uint64_t monotonic_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline float us_to_ms(uint64_t from, uint64_t to)
+{
+	return (from == 0 || to < from) ? 0.0f : (float)(to - from) / 1000.0f;
+}
+
+/** Frame_tracker -> creates a tracker
+ * @history: number of displayed frames kept for statistics
+ */
+Frame_tracker::Frame_tracker(int history)
+{
+	this->history.resize(history > 0 ? history : 1);
+	reset();
+}
+
+Frame_tracker::~Frame_tracker()
+{
+}
+
+void Frame_tracker::reset()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	this->in_flight.clear();
+	this->history_pos = 0;
+	this->history_len = 0;
+	this->has_sequence = false;
+	this->last_sequence = 0;
+	this->dropped = 0;
+	this->not_displayed = 0;
+	this->displayed = 0;
+}
+
+/** on_capture -> registers a dequeued camera frame. The frame becomes the current frame.
+ * @sequence: V4L2 sequence number
+ * @sensor_us: V4L2 buffer timestamp
+ * @dequeue_us: dequeue time
+ */
+void Frame_tracker::on_capture(uint32_t sequence, uint64_t sensor_us, uint64_t dequeue_us)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	struct frame_meta meta;
+
+	if (this->has_sequence && sequence > this->last_sequence + 1)
+	{
+		this->dropped += sequence - this->last_sequence - 1;
+	}
+	this->has_sequence = true;
+	this->last_sequence = sequence;
+
+	memset(&meta, 0, sizeof(meta));
+	meta.sequence = sequence;
+	meta.sensor_us = sensor_us;
+	meta.dequeue_us = dequeue_us;
+	if (this->in_flight.size() >= TRACKER_IN_FLIGHT)
+	{
+		this->in_flight.erase(this->in_flight.begin());
+		this->not_displayed++;
+	}
+	this->in_flight.push_back(meta);
+}
+
+/** mark -> marks a stage of the current (most recently captured) frame. Only correct if
+ * 			 capture, execution and display run one frame after the other.
+ * @stage: frame_stage
+ */
+void Frame_tracker::mark(int stage)
+{
+	mark_frame(TRACKER_CURRENT_FRAME, stage);
+}
+
+/** mark_frame -> marks a stage of a given frame. Used if several frames are in flight
+ * 				  (capture, inference and display in separate threads).
+ * @sequence: V4L2 sequence number of the frame, TRACKER_CURRENT_FRAME for the most recently captured frame
+ * @stage: frame_stage
+ */
+void Frame_tracker::mark_frame(int64_t sequence, int stage)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	if (this->in_flight.empty())
+	{
+		return;
+	}
+	if (sequence < 0)
+	{
+		mark_meta(&this->in_flight.back(), stage);
+		return;
+	}
+	for (auto &meta : this->in_flight)
+	{
+		if (meta.sequence == (uint32_t)sequence)
+		{
+			mark_meta(&meta, stage);
+			return;
+		}
+	}
+}
+
+/** mark_meta -> stores the stage time. Displayed frames are moved to the history,
+ * 				 frames captured before them are accounted as not displayed. Caller holds lock.
+ */
+void Frame_tracker::mark_meta(struct frame_meta *meta, int stage)
+{
+	uint64_t now = monotonic_us();
+	size_t idx;
+
+	switch (stage)
+	{
+	case STAGE_SUBMIT:
+		meta->submit_us = now;
+		break;
+	case STAGE_COMPLETE:
+		meta->complete_us = now;
+		break;
+	case STAGE_DISPLAY:
+		meta->display_us = now;
+		this->history[this->history_pos] = *meta;
+		this->history_pos = (this->history_pos + 1) % this->history.size();
+		this->history_len = std::min(this->history_len + 1, this->history.size());
+		this->displayed++;
+		idx = meta - this->in_flight.data();
+		this->not_displayed += idx;
+		this->in_flight.erase(this->in_flight.begin(), this->in_flight.begin() + idx + 1);
+		break;
+	}
+}
+
+/** last_frame -> returns the time stamps of the last displayed frame
+ */
+struct frame_meta Frame_tracker::last_frame()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	struct frame_meta meta;
+
+	if (this->history_len == 0)
+	{
+		memset(&meta, 0, sizeof(meta));
+		return meta;
+	}
+	return this->history[(this->history_pos + this->history.size() - 1) % this->history.size()];
+}
+
+struct frame_latency_stats Frame_tracker::get_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	struct frame_latency_stats stats;
+	std::vector<float> lat;
+	float capture = 0, inference = 0, display = 0;
+	size_t i;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.frames = this->displayed;
+	stats.dropped = this->dropped;
+	stats.not_displayed = this->not_displayed;
+	if (this->history_len == 0)
+	{
+		return stats;
+	}
+
+	lat.reserve(this->history_len);
+	for (i = 0; i < this->history_len; i++)
+	{
+		const struct frame_meta &m = this->history[i];
+		lat.push_back(us_to_ms(m.sensor_us, m.display_us));
+		capture += us_to_ms(m.sensor_us, m.dequeue_us);
+		inference += us_to_ms(m.submit_us, m.complete_us);
+		display += us_to_ms(m.complete_us, m.display_us);
+	}
+	const struct frame_meta &last = this->history[(this->history_pos + this->history.size() - 1) % this->history.size()];
+	stats.latency_last_ms = us_to_ms(last.sensor_us, last.display_us);
+	stats.capture_mean_ms = capture / this->history_len;
+	stats.inference_mean_ms = inference / this->history_len;
+	stats.display_mean_ms = display / this->history_len;
+
+	std::sort(lat.begin(), lat.end());
+	for (float l : lat)
+	{
+		stats.latency_mean_ms += l;
+	}
+	stats.latency_mean_ms /= lat.size();
+	stats.latency_p50_ms = lat[lat.size() / 2];
+	stats.latency_p99_ms = lat[std::min(lat.size() - 1, (lat.size() * 99) / 100)];
+	stats.latency_max_ms = lat.back();
+	return stats;
+}
+
+/** get_latencies -> returns the end to end latencies of the frames in the history (oldest first)
+ * @latency: latencies in ms, allocated with malloc (freed by the caller)
+ * @n: number of latencies
+ */
+void Frame_tracker::get_latencies(float **latency, int *n)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	size_t i, start;
+
+	*n = 0;
+	*latency = (float *)malloc((this->history_len > 0 ? this->history_len : 1) * sizeof(float));
+	if (*latency == NULL)
+	{
+		return;
+	}
+	start = (this->history_pos + this->history.size() - this->history_len) % this->history.size();
+	for (i = 0; i < this->history_len; i++)
+	{
+		const struct frame_meta &m = this->history[(start + i) % this->history.size()];
+		(*latency)[i] = us_to_ms(m.sensor_us, m.display_us);
+	}
+	*n = (int)this->history_len;
+}
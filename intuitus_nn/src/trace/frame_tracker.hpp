@@ -0,0 +1,105 @@
+/*
+ * frame_tracker.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Glass to glass latency tracking. Camera, Intuitus_intf and Framebuffer report the
+ * stages of a frame to an attached tracker. All times are CLOCK_MONOTONIC in us, the
+ * same clock as the V4L2 buffer timestamps.
+ */
+#ifndef SRC_FRAME_TRACKER_H_
+#define SRC_FRAME_TRACKER_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+#define TRACKER_DEFAULT_HISTORY 1024
+#define TRACKER_IN_FLIGHT 16
+// Sequence number of the most recently captured frame (mark_frame, execute, show)
+#define TRACKER_CURRENT_FRAME -1
+
+enum frame_stage
+{
+    STAGE_SUBMIT,   // input handed to the accelerator
+    STAGE_COMPLETE, // accelerator output available
+    STAGE_DISPLAY   // frame shown on the framebuffer
+};
+
+/**
+ * frame_meta -> time stamps of a frame
+ * @sequence: V4L2 frame sequence number
+ * @sensor_us: V4L2 buffer timestamp (start of frame)
+ * @dequeue_us: buffer dequeued by the application
+ * @submit_us: input handed to the accelerator
+ * @complete_us: accelerator output available
+ * @display_us: frame shown on the framebuffer
+ */
+struct frame_meta
+{
+    uint32_t sequence;
+    uint64_t sensor_us;
+    uint64_t dequeue_us;
+    uint64_t submit_us;
+    uint64_t complete_us;
+    uint64_t display_us;
+};
+
+/**
+ * frame_latency_stats -> latency statistics of all displayed frames in the history
+ * @frames: displayed frames
+ * @dropped: frames skipped by the capture pipeline (sequence gaps)
+ * @not_displayed: captured frames which were never displayed
+ * @latency_*_ms: end to end latency (sensor timestamp to display)
+ * @capture_mean_ms: mean age of a frame when dequeued
+ * @inference_mean_ms: mean accelerator time (submit to complete)
+ * @display_mean_ms: mean time from accelerator output to display
+ */
+struct frame_latency_stats
+{
+    uint32_t frames;
+    uint32_t dropped;
+    uint32_t not_displayed;
+    float latency_last_ms;
+    float latency_mean_ms;
+    float latency_p50_ms;
+    float latency_p99_ms;
+    float latency_max_ms;
+    float capture_mean_ms;
+    float inference_mean_ms;
+    float display_mean_ms;
+};
+
+uint64_t monotonic_us();
+
+class Frame_tracker
+{
+public:
+    Frame_tracker(int history = TRACKER_DEFAULT_HISTORY);
+    ~Frame_tracker();
+
+    void on_capture(uint32_t sequence, uint64_t sensor_us, uint64_t dequeue_us);
+    void mark(int stage);
+    void mark_frame(int64_t sequence, int stage);
+    struct frame_meta last_frame();
+    struct frame_latency_stats get_stats();
+    void get_latencies(float **latency, int *n);
+    void reset();
+
+private:
+    std::mutex lock;
+    std::vector<struct frame_meta> in_flight; // captured, not yet displayed
+    std::vector<struct frame_meta> history;   // displayed frames (ring)
+    size_t history_pos;
+    size_t history_len;
+    bool has_sequence;
+    uint32_t last_sequence;
+    uint32_t dropped;
+    uint32_t not_displayed;
+    uint32_t displayed;
+
+    void mark_meta(struct frame_meta *meta, int stage);
+};
+
+#endif /* SRC_FRAME_TRACKER_H_ */
@@ -0,0 +1,64 @@
+/*
+ * probes.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * USDT (SystemTap SDT) probes of the hot paths, provider "intuitus". A probe is a single nop
+ * in the code and an ELF note; perf and bpftrace patch it into a trap only while they are
+ * attached. The probes are compiled in when <sys/sdt.h> (systemtap-sdt-dev) is available and
+ * INTUITUS_NO_PROBES is not defined, otherwise they expand to nothing.
+ * Sample scripts for latency breakdowns: tools/bpftrace.
+ *
+ * Probes (arguments):
+ *   exec_start(exec_id, bytes_in)             run_network entry, before the input upload
+ *   exec_submit(exec_id)                      NETWORK_EXECUTE ioctl issued
+ *   exec_complete(exec_id)                    NETWORK_EXECUTE ioctl returned
+ *   exec_done(exec_id, bytes_out)             output copied, run_network exit
+ *   exec_failed(exec_id, err)                 execution failed (timeout, device error)
+ *   layer_create_start(layer_id, request)     layer creation ioctl issued
+ *   layer_create_done(layer_id, err)          layer creation ioctl returned
+ *   conv2d_upload_start(layer_id, bytes)      conv2d layer upload, command bytes
+ *   conv2d_upload_done(layer_id, err)         conv2d layer uploaded
+ *   capture_start()                           Camera::capture entry, waiting for a frame
+ *   capture_dqbuf(sequence, bytes)            V4L2 buffer dequeued
+ *   capture_qbuf(sequence, bytes)             frame copied, buffer queued again
+ *   float8_start(elements)                    float8_to_float32 entry
+ *   float8_done(elements)                     float8_to_float32 exit
+ *   show_start(frame_id, bytes)               Framebuffer::show / show_uyvy entry
+ *   show_done(frame_id, bytes)                frame written to the framebuffer
+ */
+#ifndef SRC_PROBES_H_
+#define SRC_PROBES_H_
+
+#if !defined(INTUITUS_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define INTUITUS_PROBES_ENABLED
+#endif
+#endif
+
+#ifdef INTUITUS_PROBES_ENABLED
+#define INTUITUS_PROBE0(name) DTRACE_PROBE(intuitus, name)
+#define INTUITUS_PROBE1(name, a) DTRACE_PROBE1(intuitus, name, a)
+#define INTUITUS_PROBE2(name, a, b) DTRACE_PROBE2(intuitus, name, a, b)
+#else
+// arguments are evaluated without effect, so variables only passed to probes stay used (-Wall)
+#define INTUITUS_PROBE0(name) \
+    do                        \
+    {                         \
+    } while (0)
+#define INTUITUS_PROBE1(name, a) \
+    do                           \
+    {                            \
+        (void)(a);               \
+    } while (0)
+#define INTUITUS_PROBE2(name, a, b) \
+    do                              \
+    {                               \
+        (void)(a);                  \
+        (void)(b);                  \
+    } while (0)
+#endif
+
+#endif /* SRC_PROBES_H_ */
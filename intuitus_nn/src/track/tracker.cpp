@@ -0,0 +1,401 @@
+#include "tracker.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
+// noise of the coordinate filters relative to the box height (constant velocity model)
+#define TRACK_POS_NOISE (1.0f / 20)  // process and measurement noise of positions and sizes
+#define TRACK_VEL_NOISE (1.0f / 160) // process noise of velocities
+#define TRACK_INIT_POS_STD 2.0f      // initial uncertainty in multiples of the noise
+#define TRACK_INIT_VEL_STD 10.0f
+#define TRACK_MIN_SIZE 1.0f
+
+static inline uint64_t now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline float sq(float v)
+{
+	return v * v;
+}
+
+/** Tracker -> arguments outside the ranges of set_policy and set_iou_threshold are clamped,
+ * 			   an IoU threshold outside (0, 1] falls back to TRACK_DEFAULT_IOU
+ */
+Tracker::Tracker(float iou_threshold, int max_interval, float min_confidence)
+{
+	this->iou_threshold = (iou_threshold > 0 && iou_threshold <= 1) ? iou_threshold : TRACK_DEFAULT_IOU;
+	this->max_interval = max_interval < 1 ? 1 : max_interval;
+	this->min_confidence = !(min_confidence >= 0) ? 0 : (min_confidence > 1 ? 1 : min_confidence);
+	memset(&this->stats, 0, sizeof(this->stats));
+}
+
+/** decide -> decides whether the current frame has to be passed to the network
+ * 			  Call once per frame, then update (inference) or predict (skipped frame).
+ * @return: TRACK_INFER or TRACK_SKIP
+ */
+int Tracker::decide()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	bool interval = !this->inferred || this->frames_since_inference + 1 >= this->max_interval;
+	bool low_confidence = false;
+
+	for (int t = 0; t < this->count; t++)
+	{
+		low_confidence |= (this->hits[t] >= this->min_hits && this->confidence[t] < this->min_confidence);
+	}
+	this->stats.frames++;
+	if (interval || low_confidence)
+	{
+		this->stats.inferences++;
+		if (low_confidence)
+		{
+			this->stats.confidence_triggers++;
+		}
+		else
+		{
+			this->stats.interval_triggers++;
+		}
+		return TRACK_INFER;
+	}
+	this->stats.skipped++;
+	return TRACK_SKIP;
+}
+
+/** predict_tracks -> advances all tracks by one frame. Caller holds lock.
+ */
+void Tracker::predict_tracks()
+{
+	float h[TRACK_MAX];
+	int n = this->count;
+
+	for (int t = 0; t < n; t++)
+	{
+		h[t] = this->pos[3][t];
+	}
+	for (int k = 0; k < 4; k++)
+	{
+		float *__restrict p = this->pos[k];
+		float *__restrict v = this->vel[k];
+		float *__restrict c00 = this->p00[k];
+		float *__restrict c01 = this->p01[k];
+		float *__restrict c11 = this->p11[k];
+		for (int t = 0; t < n; t++)
+		{
+			// x = F x, P = F P F' + Q with F = [[1, 1], [0, 1]]
+			p[t] += v[t];
+			c00[t] += 2 * c01[t] + c11[t] + sq(TRACK_POS_NOISE * h[t]);
+			c01[t] += c11[t];
+			c11[t] += sq(TRACK_VEL_NOISE * h[t]);
+		}
+	}
+	for (int t = 0; t < n; t++)
+	{
+		// prediction is less reliable for boxes moving fast relative to their size
+		float motion = (fabsf(this->vel[0][t]) + fabsf(this->vel[1][t])) / (this->pos[2][t] + this->pos[3][t]);
+		this->pos[2][t] = std::max(this->pos[2][t], TRACK_MIN_SIZE);
+		this->pos[3][t] = std::max(this->pos[3][t], TRACK_MIN_SIZE);
+		this->confidence[t] *= TRACK_CONFIDENCE_DECAY / (1.0f + motion);
+	}
+}
+
+/** correct -> Kalman update of a track with a detection. Caller holds lock.
+ * @det: x1, y1, x2, y2, score, class
+ */
+void Tracker::correct(int t, const float *det)
+{
+	float z[4] = {(det[0] + det[2]) / 2, (det[1] + det[3]) / 2, det[2] - det[0], det[3] - det[1]};
+	float r = sq(TRACK_POS_NOISE * std::max(z[3], TRACK_MIN_SIZE));
+
+	for (int k = 0; k < 4; k++)
+	{
+		float c00 = this->p00[k][t], c01 = this->p01[k][t];
+		float s = c00 + r;
+		float k0 = c00 / s, k1 = c01 / s;
+		float y = z[k] - this->pos[k][t];
+
+		this->pos[k][t] += k0 * y;
+		this->vel[k][t] += k1 * y;
+		this->p00[k][t] = (1 - k0) * c00;
+		this->p01[k][t] = (1 - k0) * c01;
+		this->p11[k][t] -= k1 * c01;
+	}
+	this->pos[2][t] = std::max(this->pos[2][t], TRACK_MIN_SIZE);
+	this->pos[3][t] = std::max(this->pos[3][t], TRACK_MIN_SIZE);
+	this->score[t] = det[4];
+	this->hits[t]++;
+	this->misses[t] = 0;
+	this->confidence[t] = 1.0f;
+}
+
+/** add_track -> starts a track at an unassigned detection. Caller holds lock.
+ */
+void Tracker::add_track(const float *det)
+{
+	int t = this->count;
+	float z[4] = {(det[0] + det[2]) / 2, (det[1] + det[3]) / 2,
+				  std::max(det[2] - det[0], TRACK_MIN_SIZE), std::max(det[3] - det[1], TRACK_MIN_SIZE)};
+
+	for (int k = 0; k < 4; k++)
+	{
+		this->pos[k][t] = z[k];
+		this->vel[k][t] = 0;
+		this->p00[k][t] = sq(TRACK_INIT_POS_STD * TRACK_POS_NOISE * z[3]);
+		this->p01[k][t] = 0;
+		this->p11[k][t] = sq(TRACK_INIT_VEL_STD * TRACK_VEL_NOISE * z[3]);
+	}
+	this->id[t] = this->next_id++;
+	this->cls[t] = (int32_t)det[5];
+	this->score[t] = det[4];
+	this->confidence[t] = 1.0f;
+	this->hits[t] = 1;
+	this->misses[t] = 0;
+	this->count++;
+	this->stats.tracks_created++;
+}
+
+/** remove_track -> replaces a track by the last one. Caller holds lock.
+ */
+void Tracker::remove_track(int t)
+{
+	int last = --this->count;
+
+	for (int k = 0; k < 4; k++)
+	{
+		this->pos[k][t] = this->pos[k][last];
+		this->vel[k][t] = this->vel[k][last];
+		this->p00[k][t] = this->p00[k][last];
+		this->p01[k][t] = this->p01[k][last];
+		this->p11[k][t] = this->p11[k][last];
+	}
+	this->id[t] = this->id[last];
+	this->cls[t] = this->cls[last];
+	this->score[t] = this->score[last];
+	this->confidence[t] = this->confidence[last];
+	this->hits[t] = this->hits[last];
+	this->misses[t] = this->misses[last];
+	this->stats.tracks_dropped++;
+}
+
+/** export_tracks -> copies the reported tracks (at least min_hits detections). Caller holds lock.
+ * @tracks_out: [track_cnt, TRACK_DIM] (allocated using malloc, owned by caller)
+ */
+int Tracker::export_tracks(float **tracks_out, int *track_cnt)
+{
+	int n = 0;
+
+	this->stats.active_tracks = this->count;
+	// at least one row: numpy needs a valid pointer for empty results
+	*tracks_out = (float *)malloc((size_t)std::max(this->count, 1) * TRACK_DIM * sizeof(float));
+	CHECK_NOT_NULL(*tracks_out, ERROR_MEMORY_ALLOC_FAIL)
+	for (int t = 0; t < this->count; t++)
+	{
+		if (this->hits[t] < this->min_hits)
+		{
+			continue;
+		}
+		float *row = *tracks_out + (size_t)n * TRACK_DIM;
+		row[0] = (float)this->id[t];
+		row[1] = this->pos[0][t] - this->pos[2][t] / 2;
+		row[2] = this->pos[1][t] - this->pos[3][t] / 2;
+		row[3] = this->pos[0][t] + this->pos[2][t] / 2;
+		row[4] = this->pos[1][t] + this->pos[3][t] / 2;
+		row[5] = this->score[t];
+		row[6] = (float)this->cls[t];
+		row[7] = this->confidence[t];
+		n++;
+	}
+	*track_cnt = n;
+	return 0;
+}
+
+/** update -> advances the tracks to the current frame and corrects them with the network detections
+ * @dets: detections [det_cnt, 6] = x1, y1, x2, y2, score, class (e.g. roi_merge_detections)
+ * @tracks_out: reported tracks [track_cnt, 8] = id, x1, y1, x2, y2, score, class, confidence
+ */
+int Tracker::update(const float *dets, int det_cnt, int det_dim,
+					float **tracks_out, int *track_cnt, int *track_dim)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	uint64_t start = now_us();
+	float x1[TRACK_MAX], y1[TRACK_MAX], x2[TRACK_MAX], y2[TRACK_MAX], area[TRACK_MAX];
+	std::vector<std::tuple<float, int, int>> pairs;
+	std::vector<bool> det_used(det_cnt, false);
+	bool track_used[TRACK_MAX] = {false};
+	int n, err;
+
+	*tracks_out = NULL;
+	*track_cnt = 0;
+	*track_dim = TRACK_DIM;
+	CHECK(det_dim == TRACK_DETECTION_DIM, ERROR_DIMENSION_MISMATCH, "Detections have to be [n, 6] (x1, y1, x2, y2, score, class).")
+
+	predict_tracks();
+	n = this->count;
+	for (int t = 0; t < n; t++)
+	{
+		x1[t] = this->pos[0][t] - this->pos[2][t] / 2;
+		y1[t] = this->pos[1][t] - this->pos[3][t] / 2;
+		x2[t] = this->pos[0][t] + this->pos[2][t] / 2;
+		y2[t] = this->pos[1][t] + this->pos[3][t] / 2;
+		area[t] = this->pos[2][t] * this->pos[3][t];
+	}
+
+	// IoU of every detection with every track of the same class
+	this->iou.resize((size_t)det_cnt * TRACK_MAX);
+	for (int d = 0; d < det_cnt; d++)
+	{
+		const float *det = dets + (size_t)d * det_dim;
+		float det_area = (det[2] - det[0]) * (det[3] - det[1]);
+		int32_t det_cls = (int32_t)det[5];
+		float *row = this->iou.data() + (size_t)d * TRACK_MAX;
+		for (int t = 0; t < n; t++)
+		{
+			float w = std::max(0.0f, std::min(x2[t], det[2]) - std::max(x1[t], det[0]));
+			float h = std::max(0.0f, std::min(y2[t], det[3]) - std::max(y1[t], det[1]));
+			float inter = w * h;
+			float uni = area[t] + det_area - inter;
+			row[t] = (this->cls[t] == det_cls && uni > 0) ? inter / uni : 0.0f;
+		}
+		for (int t = 0; t < n; t++)
+		{
+			if (row[t] >= this->iou_threshold)
+			{
+				pairs.emplace_back(row[t], d, t);
+			}
+		}
+	}
+
+	// greedy assignment by descending IoU
+	std::sort(pairs.begin(), pairs.end(), [](const std::tuple<float, int, int> &a, const std::tuple<float, int, int> &b) {
+		return std::get<0>(a) > std::get<0>(b);
+	});
+	for (auto &p : pairs)
+	{
+		int d = std::get<1>(p), t = std::get<2>(p);
+		if (det_used[d] || track_used[t])
+		{
+			continue;
+		}
+		det_used[d] = true;
+		track_used[t] = true;
+		correct(t, dets + (size_t)d * det_dim);
+	}
+
+	// tracks without detection, descending: the swapped in last track was already handled
+	for (int t = n - 1; t >= 0; t--)
+	{
+		if (track_used[t])
+		{
+			continue;
+		}
+		this->misses[t]++;
+		this->confidence[t] *= TRACK_MISS_PENALTY;
+		if (this->misses[t] > this->max_misses)
+		{
+			remove_track(t);
+		}
+	}
+	for (int d = 0; d < det_cnt && this->count < TRACK_MAX; d++)
+	{
+		if (!det_used[d])
+		{
+			add_track(dets + (size_t)d * det_dim);
+		}
+	}
+
+	this->inferred = true;
+	this->frames_since_inference = 0;
+	err = export_tracks(tracks_out, track_cnt);
+	this->stats.update_us += now_us() - start;
+	return err;
+}
+
+/** predict -> advances the tracks to the current frame without detections (skipped inference)
+ * @tracks_out: reported tracks [track_cnt, 8] = id, x1, y1, x2, y2, score, class, confidence
+ */
+int Tracker::predict(float **tracks_out, int *track_cnt, int *track_dim)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	uint64_t start = now_us();
+	int err;
+
+	*tracks_out = NULL;
+	*track_cnt = 0;
+	*track_dim = TRACK_DIM;
+	predict_tracks();
+	this->frames_since_inference++;
+	err = export_tracks(tracks_out, track_cnt);
+	this->stats.predict_us += now_us() - start;
+	return err;
+}
+
+/** set_policy -> sets the inference policy
+ * @max_interval: frames between inferences at most (1: every frame)
+ * @min_confidence: inference if a reported track drops below (0: interval only)
+ */
+int Tracker::set_policy(int max_interval, float min_confidence)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(max_interval >= 1, ERROR_OTHER, "Maximum interval has to be at least one frame.")
+	CHECK(min_confidence >= 0 && min_confidence <= 1, ERROR_OTHER, "Confidence has to be in [0, 1].")
+	this->max_interval = max_interval;
+	this->min_confidence = min_confidence;
+	return 0;
+}
+
+/** set_lifetime -> sets when tracks are reported and dropped
+ * @min_hits: detections until a track is reported
+ * @max_misses: inferences without detection until a track is dropped
+ */
+int Tracker::set_lifetime(int min_hits, int max_misses)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(min_hits >= 1 && max_misses >= 0, ERROR_OTHER, "Invalid track lifetime.")
+	this->min_hits = min_hits;
+	this->max_misses = max_misses;
+	return 0;
+}
+
+int Tracker::set_iou_threshold(float iou_threshold)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	CHECK(iou_threshold > 0 && iou_threshold <= 1, ERROR_OTHER, "IoU threshold has to be in (0, 1].")
+	this->iou_threshold = iou_threshold;
+	return 0;
+}
+
+/** reset -> drops all tracks, the next frame is passed to the network
+ */
+void Tracker::reset()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	this->stats.tracks_dropped += this->count;
+	this->count = 0;
+	this->inferred = false;
+	this->frames_since_inference = 0;
+	this->stats.active_tracks = 0;
+}
+
+struct tracker_stats Tracker::get_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	return this->stats;
+}
+
+void Tracker::reset_stats()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	memset(&this->stats, 0, sizeof(this->stats));
+	this->stats.active_tracks = this->count;
+}
@@ -0,0 +1,116 @@
+/*
+ * tracker.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Multi-object tracker for reduced rate inference. Detections of the network update tracks,
+ * on the frames in between the tracks are propagated by a constant velocity Kalman filter, so
+ * display and consumers get results at the camera frame rate.
+ * Every box coordinate (center x, center y, width, height) has an independent position /
+ * velocity filter. The state is kept as structure of arrays, predict and IoU loops run over
+ * contiguous floats and are vectorised by the compiler. Detections are assigned to tracks of
+ * the same class greedily by descending IoU.
+ * decide() runs the network again when the confidence of a track drops below a threshold
+ * (confidence decays faster for fast moving boxes and drops if a track was not detected) or
+ * when the maximum interval of frames without inference is reached.
+ */
+#ifndef SRC_TRACKER_H_
+#define SRC_TRACKER_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+#define TRACK_MAX 256                    // tracks kept at once
+#define TRACK_DETECTION_DIM 6            // detections: [n, 6] = x1, y1, x2, y2, score, class (ROI_MERGED_DIM)
+#define TRACK_DIM 8                      // tracks: [n, 8] = id, x1, y1, x2, y2, score, class, confidence
+#define TRACK_DEFAULT_IOU 0.3f           // minimum IoU of a detection and a predicted track
+#define TRACK_DEFAULT_MAX_INTERVAL 4     // inference at least every 4th frame
+#define TRACK_DEFAULT_MIN_CONFIDENCE 0.5f
+#define TRACK_DEFAULT_MIN_HITS 1         // detections until a track is reported
+#define TRACK_DEFAULT_MAX_MISSES 3       // inferences without detection until a track is dropped
+#define TRACK_CONFIDENCE_DECAY 0.9f      // confidence factor per predicted frame of a static box
+#define TRACK_MISS_PENALTY 0.5f          // confidence factor of an inference without detection
+
+#define TRACK_SKIP 0
+#define TRACK_INFER 1
+
+/**
+ * tracker_stats -> tracker decisions and work
+ * @frames: frames passed to decide
+ * @inferences: frames decided for inference
+ * @skipped: frames served by prediction
+ * @confidence_triggers: inferences triggered by a track below the minimum confidence
+ * @interval_triggers: inferences triggered by the maximum interval (or the first frame)
+ * @tracks_created, @tracks_dropped: track lifecycle
+ * @active_tracks: tracks after the last update or predict
+ * @update_us, @predict_us: accumulated time of update and predict
+ */
+struct tracker_stats
+{
+    uint64_t frames;
+    uint64_t inferences;
+    uint64_t skipped;
+    uint64_t confidence_triggers;
+    uint64_t interval_triggers;
+    uint64_t tracks_created;
+    uint64_t tracks_dropped;
+    uint32_t active_tracks;
+    uint64_t update_us;
+    uint64_t predict_us;
+};
+
+class Tracker
+{
+public:
+    Tracker(float iou_threshold = TRACK_DEFAULT_IOU, int max_interval = TRACK_DEFAULT_MAX_INTERVAL,
+            float min_confidence = TRACK_DEFAULT_MIN_CONFIDENCE);
+
+    int decide();
+    int update(const float *dets, int det_cnt, int det_dim,
+               float **tracks_out, int *track_cnt, int *track_dim);
+    int predict(float **tracks_out, int *track_cnt, int *track_dim);
+    int set_policy(int max_interval, float min_confidence);
+    int set_lifetime(int min_hits, int max_misses);
+    int set_iou_threshold(float iou_threshold);
+    void reset();
+    struct tracker_stats get_stats();
+    void reset_stats();
+
+private:
+    float iou_threshold;
+    int max_interval;
+    float min_confidence;
+    int min_hits = TRACK_DEFAULT_MIN_HITS;
+    int max_misses = TRACK_DEFAULT_MAX_MISSES;
+
+    // track state, index < count (structure of arrays)
+    int count = 0;
+    uint32_t next_id = 1;
+    float pos[4][TRACK_MAX]; // cx, cy, w, h
+    float vel[4][TRACK_MAX]; // per frame
+    float p00[4][TRACK_MAX]; // covariance [[p00, p01], [p01, p11]] of each coordinate filter
+    float p01[4][TRACK_MAX];
+    float p11[4][TRACK_MAX];
+    uint32_t id[TRACK_MAX];
+    int32_t cls[TRACK_MAX];
+    float score[TRACK_MAX];
+    float confidence[TRACK_MAX];
+    int32_t hits[TRACK_MAX];
+    int32_t misses[TRACK_MAX];
+
+    bool inferred = false;       // an update happened since reset
+    int frames_since_inference = 0;
+    std::vector<float> iou;      // [det, track]
+    struct tracker_stats stats;
+    std::mutex lock;
+
+    void predict_tracks();
+    void correct(int t, const float *det);
+    void add_track(const float *det);
+    void remove_track(int t);
+    int export_tracks(float **tracks_out, int *track_cnt);
+};
+
+#endif /* SRC_TRACKER_H_ */
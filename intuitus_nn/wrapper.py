@@ -1,5 +1,15 @@
 import numpy as np
-from intuitus_nn.intuitus_nn import Intuitus_intf
+import pathlib
+from intuitus_nn.intuitus_nn import Intuitus_intf, encode_command_blocks, DMA_OPT_OFF, DMA_OPT_ALL, DMA_OPT_PROFILE, \
+    TENSOR_INT8, TENSOR_FLOAT8, transform_to_hwc_float, transform_to_hwc_uint8, roi_tiles, roi_merge_detections, Motion_gate, MOTION_INFER, \
+    MOTION_DEFAULT_THRESHOLD, MOTION_DEFAULT_MIN_BLOCKS, MOTION_DEFAULT_MAX_INTERVAL_MS, \
+    rt_set_role, rt_enter, rt_leave, rt_lock_memory, rt_unlock_memory, rt_get_thread_state, \
+    RT_ROLE_CAPTURE, RT_ROLE_INFERENCE, RT_ROLE_DISPLAY, RT_ROLE_WORKER, RT_NO_CPU, \
+    Result_publisher, Result_subscriber, RESULT_BUS_DEFAULT_SLOTS, RESULT_BUS_DEFAULT_SLOT_SIZE, \
+    RESULT_BUS_INT8, RESULT_BUS_UINT8, RESULT_BUS_FLOAT32, RESULT_BUS_NO_DATA, ERROR_BUS_CLOSED, \
+    Tracker, TRACK_INFER, TRACK_DEFAULT_IOU, TRACK_DEFAULT_MAX_INTERVAL, TRACK_DEFAULT_MIN_CONFIDENCE, \
+    Detection_log, Detection_log_reader, DETLOG_DEFAULT_PREFIX, DETLOG_DEFAULT_SEGMENT_SIZE, DETLOG_DEFAULT_MAX_SEGMENTS, DETLOG_END, \
+    TRACKER_CURRENT_FRAME
 
 class buffer:
     def __init__(self,id,channel,height,width):
@@ -41,8 +51,33 @@ class buffer:
         self.shape = (self._channel,self._height,self._width)       
 
 
+def compress_command_file(command_file,out_file=None):
+    """ Replaces the uncompressed command blocks (tx_bin) of a conv2d command file by a compressed 
+        command stream (tx_bin_z). The stream is decoded block by block during upload. 
+        Overwrites the command file if no out_file is given. """
+    conv2d_commands = np.load(command_file,allow_pickle=True)
+    if 'tx_bin_z' in conv2d_commands.files:
+        return
+    arrays = {key : conv2d_commands[key] for key in conv2d_commands.files if key != 'tx_bin'}
+    command_block = np.ascontiguousarray(conv2d_commands['tx_bin'].astype(np.int32))
+    conv2d_commands.close()
+    status, stream = encode_command_blocks(command_block,arrays['tx_com_len'].astype(np.uint32))
+    if status != 0:
+        raise Exception("error compressing command file {}. Error code {}".format(command_file,status))
+    arrays['tx_bin_z'] = stream
+    if out_file == None:
+        out_file = command_file
+    with open(out_file,'wb') as f: # np.savez appends .npz to file names 
+        np.savez(f,**arrays)
+
+# names of intuitus_layer_types (intuitus-intf.h)
+intuitus_layer_type_names = ['Input','Output','Conv1x1','InvBottleneck3x3','InvBottleneck5x5','Conv3x3','Conv5x5',
+                             'Residual','Concat','Split','Upsample','Maxpooling2d','Copy','Test_loop']
+
 class Sequential:
-    def __init__(self,command_path,use_float8=False):
+    def __init__(self,command_path,use_float8=False,deadline_ms=0,dma_opt='off'):
+        """ dma_opt: 'off', 'all' or 'profile' (DMA optimisation of the layers selected by tune_dma,
+            loaded from dma_profile.txt next to the command files if present) """
         self.layer_types = {'Input'             : 0,
                             'Output'            : 1,
                             'Conv1x1'           : 2,
@@ -59,17 +94,30 @@ class Sequential:
         self.layer_nbr = 0
         self.has_input = False
         self.has_output = False    
+        self.input_shape = None
         self.outputs = []
         self.use_float8 = use_float8
+        if deadline_ms > 0:
+            self.Net.set_deadline(deadline_ms)
+        self.dma_profile_file = pathlib.Path(command_path) / 'dma_profile.txt'
+        if dma_opt == 'all':
+            self.Net.set_dma_optimization(DMA_OPT_ALL)
+        elif dma_opt == 'profile' and self.dma_profile_file.exists():
+            if self.Net.load_dma_profile(str(self.dma_profile_file)) != 0:
+                raise Exception("error loading dma profile {}".format(self.dma_profile_file))
+        elif dma_opt not in ('off','profile'):
+            raise Exception("unknown dma optimization mode {}".format(dma_opt))
     def __len__(self):
         return self.layer_nbr
 
-    def __call__(self,input):
+    def __call__(self,input,sequence=TRACKER_CURRENT_FRAME):
         if not self.has_input or not self.has_output:
             raise Exception("network requires input and output layer") 
-        status, fmap = self.Net.execute(input)
+        # pooled result: stays valid until all returned arrays are released. The pool grows with the
+        # results kept by the caller, Net.set_result_pool_size caps it (ERROR_MAX_MEMORY_LIMIT when full)
+        status, fmap = self.Net.execute_result(input,sequence)
         if status != 0:
-            raise Exception("error in execution of network")             
+            raise Exception("error in execution of network. Error code {}".format(status))             
     	
         if len(self.outputs) == 1:
             out = fmap.reshape(self.outputs[0].shape)
@@ -81,17 +129,21 @@ class Sequential:
             else:
                 return out
 
+        # convert all outputs in one call, the float outputs are views of one arena buffer
+        if self.use_float8:
+            status, fmap_float = self.Net.float8_to_float32(fmap.reshape(1,1,-1))
+            if status != 0:
+                raise Exception("error converting float8 to float32") 
+            fmap_float = fmap_float.reshape(-1)
+
         outpos = 0
         out_fmaps = []
         out_float = []
         for outs in self.outputs:
             out = fmap[outpos:outpos+outs.size].reshape(outs.shape)
-            outpos += outs.size
             if self.use_float8:
-                status, img_float = self.Net.float8_to_float32(out)
-                if status != 0:
-                    raise Exception("error converting float8 to float32") 
-                out_float.append(img_float) 
+                out_float.append(fmap_float[outpos:outpos+outs.size].reshape(outs.shape)) 
+            outpos += outs.size
 
             out_fmaps.append(out) 
         if self.use_float8:    
@@ -99,6 +151,106 @@ class Sequential:
         else:
             return out_fmaps
 
+    def forward_batch(self,frames):
+        """ Executes the network for a sequence of frames [N,C,H,W] in one call (one device lock and one 
+            output allocation for all frames). Returns one output (or list of outputs) per frame. """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, fmaps = self.Net.execute_batch(np.ascontiguousarray(frames,dtype=np.uint8))
+        if status != 0:
+            raise Exception("error in execution of network. Error code {}".format(status))             
+        return self._split_batch(fmaps)
+
+    def forward_rois(self,frame,rois):
+        """ Executes the network for regions [N,4] (x, y, w, h) of a frame [H,W,C]. Each region is resized to 
+            the network input while the previous one executes. Returns one output (or list of outputs) per region. """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, fmaps = self.Net.execute_rois(np.ascontiguousarray(frame,dtype=np.uint8),np.ascontiguousarray(rois,dtype=np.int32))
+        if status != 0:
+            raise Exception("error in execution of network. Error code {}".format(status))             
+        return self._split_batch(fmaps)
+
+    def forward_tiled(self,frame,overlap=32):
+        """ Executes the network on overlapping tiles of the network input size covering a frame [H,W,C] 
+            (small objects in full resolution frames). Returns the tiles [N,4] and one output per tile. """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, rois = roi_tiles(frame.shape[0],frame.shape[1],self.input_shape[1],self.input_shape[2],overlap)
+        if status != 0:
+            raise Exception("invalid tiling. Error code {}".format(status))
+        return rois, self.forward_rois(frame,rois)
+
+    def merge_detections(self,frame_shape,rois,detections,iou_threshold=0.45):
+        """ Maps detections [N,7] (roi, x1, y1, x2, y2, score, class in network input pixels) of forward_rois or 
+            forward_tiled to frame pixels and removes duplicates of overlapping regions. Returns [M,6] 
+            (x1, y1, x2, y2, score, class). """
+        status, merged = roi_merge_detections(np.ascontiguousarray(detections,dtype=np.float32).reshape(-1,7),
+                                              np.ascontiguousarray(rois,dtype=np.int32),frame_shape[0],frame_shape[1],
+                                              self.input_shape[1],self.input_shape[2],iou_threshold)
+        if status != 0:
+            raise Exception("error merging detections. Error code {}".format(status))
+        return merged
+
+    def _split_batch(self,fmaps):
+        results = []
+        for fmap in fmaps:
+            outpos = 0
+            outs = []
+            for out_buffer in self.outputs:
+                outs.append(fmap[outpos:outpos+out_buffer.size].reshape(out_buffer.shape))
+                outpos += out_buffer.size
+            results.append(outs[0] if len(outs) == 1 else outs)
+        return results
+
+    def forward_dlpack(self,input):
+        """ Executes the network and returns the raw network output as DLPack capsule (zero copy). """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, tensor = self.Net.execute_dlpack(input)
+        if status != 0:
+            raise Exception("error in execution of network")             
+        return tensor
+
+    def forward_tensor(self,input):
+        """ Executes the network and returns one Tensor per output (no copy). Values are decoded to
+            float32 on access (Tensor.array, Tensor.at, Tensor.numpy), float8 if use_float8 is set. """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, tensor = self.Net.execute_tensor(input, TENSOR_FLOAT8 if self.use_float8 else TENSOR_INT8)
+        if status != 0:
+            raise Exception("error in execution of network. Error code {}".format(status))             
+
+        outpos = 0
+        outs = []
+        for out_buffer in self.outputs:
+            outs.append(tensor.view(outpos, *out_buffer.shape))
+            outpos += out_buffer.size
+        return outs[0] if len(outs) == 1 else outs
+
+    def forward_hwc(self,input,scale=1.0,offset=0.0,dtype=np.float32):
+        """ Executes the network and returns the outputs as [H,W,C] arrays of dtype (float32 or uint8, 
+            value * scale + offset). Decoding and transposition are fused in one pass (replaces 
+            float8_to_float32 followed by np.transpose(...).copy()). """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer") 
+        status, fmap = self.Net.execute_result(input)
+        if status != 0:
+            raise Exception("error in execution of network. Error code {}".format(status))             
+        transform = transform_to_hwc_uint8 if np.dtype(dtype) == np.uint8 else transform_to_hwc_float
+        fmt = TENSOR_FLOAT8 if self.use_float8 else TENSOR_INT8
+
+        outpos = 0
+        outs = []
+        for out_buffer in self.outputs:
+            out = fmap[outpos:outpos+out_buffer.size].reshape(out_buffer.shape)
+            status, hwc = transform(out,fmt,scale,offset)
+            if status != 0:
+                raise Exception("error transforming output. Error code {}".format(status))
+            outs.append(hwc)
+            outpos += out_buffer.size
+        return outs[0] if len(outs) == 1 else outs
+
     def forward_layer(self,layer_id,input):
         status, image = self.Net.execute_layer(layer_id,input)
         if status != 0:
@@ -113,6 +265,7 @@ class Sequential:
         if status != 0:
             raise Exception("error configuring input layer")
         self.has_input = True       
+        self.input_shape = (channel,height,width)
         return buffer(0,channel,height,width)
 
     def output(self,in_buffer):
@@ -136,7 +289,11 @@ class Sequential:
 
         conv2d_commands = np.load(command_file,allow_pickle=True)
         command_lengths = conv2d_commands['tx_com_len'].astype(np.uint32)
-        command_block = conv2d_commands['tx_bin'].astype(np.int32)
+        compressed = 'tx_bin_z' in conv2d_commands.files
+        if compressed:
+            command_block = conv2d_commands['tx_bin_z'].astype(np.uint8)
+        else:
+            command_block = conv2d_commands['tx_bin'].astype(np.int32)
         tile_tx_arr = conv2d_commands['tx_tile'].astype(np.uint32)
         tile_rx_arr = conv2d_commands['rx_tile'].astype(np.uint32)
         if kernel_size == (1,1):
@@ -163,7 +320,10 @@ class Sequential:
             out_height = int(out_height/2)
             out_width = int(out_width/2)
 
-        status = self.Net.conv2d(self.layer_nbr,layer_type,in_buffer.id,in_buffer.channel,out_height,out_width,filters,int(tile_rx_arr[0,6]),tile_tx_arr,tile_rx_arr[:,:6],command_block,command_lengths)
+        if compressed:
+            status = self.Net.conv2d_compressed(self.layer_nbr,layer_type,in_buffer.id,in_buffer.channel,out_height,out_width,filters,int(tile_rx_arr[0,6]),tile_tx_arr,tile_rx_arr[:,:6],command_block,command_lengths)
+        else:
+            status = self.Net.conv2d(self.layer_nbr,layer_type,in_buffer.id,in_buffer.channel,out_height,out_width,filters,int(tile_rx_arr[0,6]),tile_tx_arr,tile_rx_arr[:,:6],command_block,command_lengths)
         if status != 0:
             self.layer_nbr -= 1
             raise Exception("error configuring network. Error code {}. Conv2d layer with id: {}".format(status,self.layer_nbr))
@@ -237,7 +397,248 @@ class Sequential:
         self.layer_nbr += groups-1
         return tuple(out_buffers)
 
+    def exec_stats(self):
+        """ Execution metrics: timeouts, missed frames and recovery times. """
+        return self.Net.get_exec_stats()
+
+    def attach_tracker(self, tracker):
+        """ Marks submit and completion of each execution in a Frame_tracker (None to detach). If capture and 
+            inference run in separate threads, pass the sequence number of the frame to the call
+            (camera.last_frame_meta().sequence after capture), otherwise the latest captured frame is marked. """
+        self.tracker = tracker
+        self.Net.attach_tracker(tracker)
+
     def summary(self):
         self.Net.print_network()
     def print_layer_dma_info(self,layer_nbr):
-        self.Net.print_layer(layer_nbr)
\ No newline at end of file
+        self.Net.print_layer(layer_nbr)
+
+    def tune_dma(self,input,runs=10):
+        """ Times the network with and without DMA optimisation of each conv2d layer, keeps the faster
+            choice and stores the profile next to the command files (loaded by dma_opt='profile'). """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer")
+        if self.Net.autotune_dma(input,runs) != 0:
+            raise Exception("dma autotuning failed")
+        if self.Net.save_dma_profile(str(self.dma_profile_file)) != 0:
+            raise Exception("error saving dma profile {}".format(self.dma_profile_file))
+
+    def prefault(self):
+        """ Real-time mode: maps the interface buffer and the output buffer of the calling thread before the 
+            first execution. Call it from the inference thread after rt_enter(RT_ROLE_INFERENCE). """
+        status = self.Net.prefault()
+        if status != 0:
+            raise Exception("error prefaulting buffers. Error code {}".format(status))
+
+    def save_network(self,path):
+        """ Stores the uploaded network (layers and compressed commands) in one file,
+            e.g. for tools/intuitus_bench. """
+        if not self.has_input or not self.has_output:
+            raise Exception("network requires input and output layer")
+        if self.Net.save_network(str(path)) != 0:
+            raise Exception("error saving network {}".format(path))
+
+    def layer_report(self):
+        """ Per layer configuration and memory/DMA footprint as uploaded to the driver. """
+        fields = ['layer_id','layer_type','src_buffer_id','src2_buffer_id','in_channels','out_channels',
+                  'out_height','out_width','output_bytes','tx_tiles','rx_tiles','command_blocks',
+                  'command_bytes','max_command_bytes','tx_scatter_list_size','rx_scatter_list_size','dma_optimized']
+        report = []
+        for i in range(self.Net.layer_count()):
+            info = self.Net.get_layer_info(i)
+            layer = {f: getattr(info, f) for f in fields}
+            layer['layer_type'] = intuitus_layer_type_names[info.layer_type]
+            report.append(layer)
+        return report
+
+    def memory_report(self):
+        """ Prints the layer table and the interface buffer usage. """
+        print("{:>5} {:<14} {:>5} {:>16} {:>9} {:>5} {:>5} {:>10} {:>7} {:>7}".format(
+            'id','type','src','out (c,h,w)','out [B]','tx','rx','cmd [B]','tx sg','rx sg'))
+        for l in self.layer_report():
+            print("{:>5} {:<14} {:>5} {:>16} {:>9} {:>5} {:>5} {:>10} {:>7} {:>7}".format(
+                l['layer_id'], l['layer_type'], l['src_buffer_id'],
+                "({},{},{})".format(l['out_channels'], l['out_height'], l['out_width']),
+                l['output_bytes'], l['tx_tiles'], l['rx_tiles'], l['command_bytes'],
+                l['tx_scatter_list_size'], l['rx_scatter_list_size']))
+        net = self.Net.get_network_info()
+        print("Layers: {} | commands: {} B | feature map buffers: {} B | scatter lists tx/rx: {}/{}".format(
+            net.layers, net.command_bytes, net.buffer_bytes, net.tx_scatter_list_size, net.rx_scatter_list_size))
+        print("Interface buffer: peak {} B of {} B ({:.1f} %) | input {} B | output {} B | largest command block {} B".format(
+            net.intf_buffer_peak, net.intf_buffer_size, 100.0 * net.intf_buffer_peak / net.intf_buffer_size,
+            net.input_bytes, net.output_bytes, net.max_command_bytes))
+        print("Driver status: network {} | execution {}".format(net.network_status, net.execution_status))
+        return net
+
+class MotionGatedNetwork:
+    """ Runs a network only for camera frames (UYVY, as returned by Camera.capture) which changed since the last 
+        inference or when max_interval_ms elapsed, and returns the last results otherwise. 
+        prepare converts a camera frame into the network input. """
+    def __init__(self,net,prepare,threshold=MOTION_DEFAULT_THRESHOLD,min_blocks=MOTION_DEFAULT_MIN_BLOCKS,
+                 max_interval_ms=MOTION_DEFAULT_MAX_INTERVAL_MS):
+        self.net = net
+        self.prepare = prepare
+        self.gate = Motion_gate(threshold,min_blocks,max_interval_ms)
+        self.last = None
+
+    def __call__(self,frame):
+        """ Returns the results and whether the network was executed for this frame """
+        status = self.gate.check(frame)
+        if status < 0:
+            raise Exception("motion gate failed. Error code {}".format(status))
+        if status == MOTION_INFER or self.last is None:
+            self.last = self.net(self.prepare(frame))
+            return self.last, True
+        return self.last, False
+
+    def reset(self):
+        self.gate.reset()
+        self.last = None
+
+    @property
+    def skip_rate(self):
+        stats = self.gate.get_stats()
+        return stats.skipped / stats.frames if stats.frames > 0 else 0.0
+
+    def stats(self):
+        return self.gate.get_stats()
+
+class TrackedNetwork:
+    """ Runs a network only on every Nth frame and tracks its detections in between (Kalman filter and IoU 
+        assignment). The tracker runs the network earlier when a track becomes unreliable (fast motion, 
+        missed detection). prepare converts a frame into the network input, detect converts the network 
+        output into detections [N,6] (x1, y1, x2, y2, score, class). """
+    def __init__(self,net,prepare,detect,iou_threshold=TRACK_DEFAULT_IOU,max_interval=TRACK_DEFAULT_MAX_INTERVAL,
+                 min_confidence=TRACK_DEFAULT_MIN_CONFIDENCE):
+        self.net = net
+        self.prepare = prepare
+        self.detect = detect
+        self.tracker = Tracker(iou_threshold,max_interval,min_confidence)
+
+    def __call__(self,frame):
+        """ Returns the tracks [M,8] (id, x1, y1, x2, y2, score, class, confidence) of this frame and whether 
+            the network was executed """
+        inferred = self.tracker.decide() == TRACK_INFER
+        if inferred:
+            dets = np.ascontiguousarray(self.detect(self.net(self.prepare(frame))),dtype=np.float32).reshape(-1,6)
+            status, tracks = self.tracker.update(dets)
+        else:
+            status, tracks = self.tracker.predict()
+        if status != 0:
+            raise Exception("tracker failed. Error code {}".format(status))
+        return tracks, inferred
+
+    def reset(self):
+        self.tracker.reset()
+
+    @property
+    def skip_rate(self):
+        stats = self.tracker.get_stats()
+        return stats.skipped / stats.frames if stats.frames > 0 else 0.0
+
+    def stats(self):
+        return self.tracker.get_stats()
+
+class ResultBus:
+    """ Publishes results into a lock-free ring in shared memory, readable by other processes (ResultStream, 
+        tools/intuitus_bus). Float results (decoded detections [N,values] or float8 outputs) are published as 
+        float32, int8 and uint8 outputs as bytes. frame and sensor_us are the frame metadata of the camera. 
+        Slow readers never block publish, they lose the overwritten entries. """
+    def __init__(self,name,slots=RESULT_BUS_DEFAULT_SLOTS,slot_size=RESULT_BUS_DEFAULT_SLOT_SIZE):
+        self.bus = Result_publisher(name,slots,slot_size)
+
+    def publish(self,results,frame=0,sensor_us=0):
+        results = np.ascontiguousarray(results)
+        if results.dtype.kind == 'f':
+            values = results.astype(np.float32,copy=False)
+            values = values.reshape(1,-1) if values.ndim < 2 else values.reshape(values.shape[0],-1)
+            status = self.bus.publish_float(values,frame,sensor_us)
+        else:
+            fmt = RESULT_BUS_UINT8 if results.dtype == np.uint8 else RESULT_BUS_INT8
+            status = self.bus.publish_bytes(results.view(np.uint8).reshape(-1),frame,sensor_us,fmt)
+        if status != 0:
+            raise Exception("error publishing results. Error code {}".format(status))
+
+    @property
+    def published(self):
+        return self.bus.published()
+
+class ResultStream:
+    """ Reader of a ResultBus of another process. Entries are returned as (meta, results), meta holds the 
+        sequence number, frame metadata and publish time (result_entry_meta). overruns counts the entries 
+        which were overwritten before they were read. Iterating follows the stream until the bus closes. """
+    def __init__(self,name):
+        self.bus = Result_subscriber(name)
+
+    def _entry(self):
+        meta = self.bus.last_meta()
+        if meta.format == RESULT_BUS_FLOAT32:
+            status, values = self.bus.data_float()
+            if status != 0:
+                raise Exception("malformed result bus entry")
+            return meta, values.copy()
+        data = self.bus.data_bytes()
+        return meta, data.view(np.int8 if meta.format == RESULT_BUS_INT8 else np.uint8).copy()
+
+    def _read(self,status):
+        if status == RESULT_BUS_NO_DATA:
+            return None
+        if status == ERROR_BUS_CLOSED:
+            raise EOFError("result bus closed by the producer")
+        if status != 0:
+            raise Exception("error reading result bus. Error code {}".format(status))
+        return self._entry()
+
+    def latest(self):
+        """ Newest entry or None """
+        return self._read(self.bus.latest())
+
+    def next(self,timeout_ms=-1):
+        """ Entry following the last one read or None on timeout """
+        return self._read(self.bus.next(timeout_ms))
+
+    def __iter__(self):
+        while True:
+            try:
+                entry = self.next()
+            except EOFError:
+                return
+            if entry is not None:
+                yield entry
+
+    @property
+    def overruns(self):
+        return self.bus.overruns()
+
+class DetectionLog:
+    """ Appends detections [N,6] (x1, y1, x2, y2, score, class) or tracks [N,8] (TrackedNetwork) of every frame 
+        to a compact binary log in dir (about 10 bytes per detection). Segments of segment_size bytes are 
+        rotated, the oldest are deleted beyond max_segments. Read with read_detection_log or tools/intuitus_log. """
+    def __init__(self,dir,prefix=DETLOG_DEFAULT_PREFIX,segment_size=DETLOG_DEFAULT_SEGMENT_SIZE,
+                 max_segments=DETLOG_DEFAULT_MAX_SEGMENTS):
+        self.log = Detection_log(str(dir),prefix,segment_size,max_segments)
+
+    def append(self,dets,frame=0,timestamp_us=0):
+        dets = np.ascontiguousarray(dets,dtype=np.float32)
+        dets = dets.reshape(-1,8 if dets.ndim == 2 and dets.shape[1] == 8 else 6)
+        status = self.log.append(dets,frame,timestamp_us)
+        if status != 0:
+            raise Exception("error appending to detection log. Error code {}".format(status))
+
+    def flush(self):
+        self.log.flush()
+
+    def stats(self):
+        return self.log.get_stats()
+
+def read_detection_log(path):
+    """ Yields (frame, timestamp_us, detections [N,7] = x1, y1, x2, y2, score, class, id) of a log segment.
+        id is -1 for logged detections without track. """
+    reader = Detection_log_reader(str(path))
+    while True:
+        status, dets = reader.next()
+        if status == DETLOG_END:
+            return
+        if status != 0:
+            raise Exception("error reading detection log. Error code {}".format(status))
+        yield reader.frame(), reader.timestamp_us(), dets
@@ -6,6 +6,7 @@ from distutils.core import *
 from distutils      import sysconfig
 import glob
 import pathlib 
+import platform
 
 # Third-party modules - we depend on numpy for everything
 import numpy
@@ -61,7 +62,10 @@ if not os.path.exists(str(pkg_dir / 'numpy.i')):
 
 print(str(src_dir))
 # gather up all the source files
-srcFiles = [str(pkg_dir / 'intuitus.i'),str(src_dir / 'intuitus.cpp'),str(src_dir / 'fb' / 'framebuffer.cpp'),str(src_dir / 'cam' / 'v4l_camera.cpp')]
+srcFiles = [str(pkg_dir / 'intuitus.i'),str(src_dir / 'intuitus.cpp'),str(src_dir / 'intuitus_recovery.cpp'),str(src_dir / 'intuitus_info.cpp'),str(src_dir / 'intuitus_tuning.cpp'),str(src_dir / 'journal.cpp'),str(src_dir / 'fb' / 'framebuffer.cpp'),str(src_dir / 'fb' / 'pixel_convert.cpp'),str(src_dir / 'cam' / 'v4l_camera.cpp'),str(src_dir / 'cam' / 'media_ctl.cpp'),str(src_dir / 'cam' / 'frame_record.cpp'),str(src_dir / 'cam' / 'motion_gate.cpp'),
+            str(src_dir / 'codec' / 'command_codec.cpp'),str(src_dir / 'mem' / 'result_pool.cpp'),str(src_dir / 'mem' / 'arena.cpp'),str(src_dir / 'mem' / 'dma_copy.cpp'),str(src_dir / 'mem' / 'transform.cpp'),str(src_dir / 'mem' / 'tensor.cpp'),str(src_dir / 'mem' / 'dlpack_export.cpp'),
+            str(src_dir / 'trace' / 'frame_tracker.cpp'),str(src_dir / 'roi' / 'roi.cpp'),str(src_dir / 'rt' / 'realtime.cpp'),str(src_dir / 'daemon' / 'daemon_protocol.cpp'),str(src_dir / 'daemon' / 'daemon_client.cpp'),str(src_dir / 'bus' / 'result_bus.cpp'),
+            str(src_dir / 'startup' / 'kmod.cpp'),str(src_dir / 'startup' / 'startup.cpp'),str(src_dir / 'track' / 'tracker.cpp'),str(src_dir / 'log' / 'detection_log.cpp')]
 includeDirs = [numpy_include]
 #srcDir = os.path.abspath('driver-intf')
 #for root, dirnames, filenames in os.walk(srcDir):
@@ -76,6 +80,16 @@ includeDirs = [numpy_include]
 includeDirs.append(str(src_dir))
 includeDirs.append(str(src_dir/'fb'))
 includeDirs.append(str(src_dir/'cam'))
+includeDirs.append(str(src_dir/'codec'))
+includeDirs.append(str(src_dir/'mem'))
+includeDirs.append(str(src_dir/'trace'))
+includeDirs.append(str(src_dir/'roi'))
+includeDirs.append(str(src_dir/'rt'))
+includeDirs.append(str(src_dir/'daemon'))
+includeDirs.append(str(src_dir/'bus'))
+includeDirs.append(str(src_dir/'startup'))
+includeDirs.append(str(src_dir/'track'))
+includeDirs.append(str(src_dir/'log'))
 
 print("************************ Include dirs *************************")
 print(includeDirs)
@@ -97,6 +111,8 @@ if sys.platform == 'darwin':
 else: # only tested on travis ci linux servers
     os.environ["CC"] = "g++" # force compiling c as c++
     extra_args = ['-std=c++0x','-fno-rtti']
+    if platform.machine().startswith('armv7'):
+        extra_args += ['-mfpu=neon'] # SIMD pixel conversion (Zynq-7000)
 
 # inplace extension module
 _intuitus_nn = Extension("_intuitus_nn",
@@ -104,7 +120,7 @@ _intuitus_nn = Extension("_intuitus_nn",
                    include_dirs=includeDirs,
                    swig_opts=['-c++'],
                    extra_compile_args=extra_args,
-                   extra_link_args=[],
+                   extra_link_args=['-lrt'],
                    depends=['numpy'],
                    optional=True)
 
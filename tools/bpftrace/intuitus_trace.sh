@@ -0,0 +1,26 @@
+#!/bin/sh
+# Runs one of the bpftrace scripts of this directory against a binary with intuitus USDT probes:
+# the python extension (_intuitus_nn*.so, default), intuitus_bench, intuitusd, ...
+# The probes are compiled in when <sys/sdt.h> was available at build time, check with
+#   readelf -n <binary> | grep -A2 stapsdt
+# Usage: intuitus_trace.sh <script.bt> [binary] [bpftrace options, e.g. -p pid]
+set -e
+if [ $# -lt 1 ]; then
+	echo "usage: $0 <script.bt> [binary] [bpftrace options]" >&2
+	exit 1
+fi
+script=$1
+shift
+case "$script" in
+*/*) ;;
+*) script="$(dirname "$0")/$script" ;;
+esac
+if [ $# -gt 0 ] && [ "${1#-}" = "$1" ]; then
+	binary=$1
+	shift
+else
+	binary=$(python3 -c "import intuitus_nn._intuitus_nn as m; print(m.__file__)" 2>/dev/null ||
+		python3 -c "import _intuitus_nn as m; print(m.__file__)")
+fi
+binary=$(readlink -f "$binary")
+exec bpftrace "$@" -e "$(sed "s#@BINARY@#$binary#g" "$script")"
@@ -0,0 +1,208 @@
+/*
+ * command_codec_check.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Checks the command block codec (command_codec.hpp): random layers are compressed and decoded
+ * again, then malformed streams (huge or overlong runs, truncated payload, forward references)
+ * have to be rejected without writing past the destination block.
+ *
+ * Build (from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -I$S -I$S/codec tools/command_codec_check.cpp $S/codec/command_codec.cpp -o command_codec_check
+ * Usage:
+ *   command_codec_check [-r rounds]
+ */
+#include "command_codec.hpp"
+#include "intuitus-intf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#define GUARD_WORDS 64
+#define GUARD_VALUE 0x5a5a5a5a
+
+static void put_varint(std::vector<uint8_t> &out, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		out.push_back((uint8_t)(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back((uint8_t)v);
+}
+
+static void put_uint32(std::vector<uint8_t> &out, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		out.push_back((uint8_t)(v >> (8 * i)));
+	}
+}
+
+static std::vector<uint8_t> stream_header(uint32_t block_cnt, uint32_t word_cnt)
+{
+	std::vector<uint8_t> out;
+	put_uint32(out, COM_STREAM_MAGIC);
+	put_uint32(out, block_cnt);
+	put_uint32(out, word_cnt);
+	return out;
+}
+
+/** decode_guarded -> decodes a single block stream into a buffer followed by guard words
+ * @return: result of the decoder, -100 if the guard words were overwritten
+ */
+static int decode_guarded(const std::vector<uint8_t> &stream, uint32_t block_cnt, uint32_t word_cnt)
+{
+	std::vector<int32_t> dst((size_t)word_cnt * block_cnt + GUARD_WORDS, GUARD_VALUE);
+	Command_decoder decoder(stream.data(), stream.size());
+	int err = decoder.check_header(block_cnt, word_cnt * block_cnt);
+
+	for (uint32_t b = 0; 0 == err && b < block_cnt; b++)
+	{
+		err = decoder.next_block(dst.data() + (size_t)b * word_cnt, word_cnt);
+	}
+	for (size_t i = (size_t)word_cnt * block_cnt; i < dst.size(); i++)
+	{
+		if (dst[i] != GUARD_VALUE)
+		{
+			return -100;
+		}
+	}
+	return err;
+}
+
+static int round_trip(int rounds)
+{
+	int failed = 0;
+
+	srand(1);
+	for (int r = 0; r < rounds; r++)
+	{
+		int block_cnt = 1 + rand() % 16;
+		std::vector<uint32_t> lengths(block_cnt);
+		std::vector<int32_t> words;
+		for (int b = 0; b < block_cnt; b++)
+		{
+			if (b > 0 && rand() % 2)
+			{
+				// repeated block (reference)
+				size_t start = words.size() - lengths[b - 1];
+				lengths[b] = lengths[b - 1];
+				words.insert(words.end(), words.begin() + start, words.begin() + start + lengths[b]);
+				continue;
+			}
+			lengths[b] = 1 + rand() % 200;
+			int32_t v = rand(), step = rand() % 3 ? rand() % 8 : rand();
+			for (uint32_t i = 0; i < lengths[b]; i++)
+			{
+				v = (rand() % 4) ? v + step : rand();
+				words.push_back(v);
+			}
+		}
+
+		uint8_t *stream;
+		int stream_len;
+		std::vector<int32_t> out(words.size() + GUARD_WORDS, GUARD_VALUE);
+		int err = encode_command_blocks(words.data(), words.size(), lengths.data(), block_cnt, &stream, &stream_len);
+		Command_decoder decoder(stream, stream_len);
+		err = err ? err : decoder.check_header(block_cnt, words.size());
+		for (int b = 0, offs = 0; 0 == err && b < block_cnt; offs += lengths[b], b++)
+		{
+			err = decoder.next_block(out.data() + offs, lengths[b]);
+		}
+		if (0 != err || 0 != memcmp(out.data(), words.data(), words.size() * sizeof(int32_t)) ||
+			out[words.size()] != GUARD_VALUE)
+		{
+			failed++;
+		}
+		free(stream);
+	}
+	printf("round trip: %d layers, %d failed\n", rounds, failed);
+	return failed;
+}
+
+struct malformed_case
+{
+	const char *name;
+	std::vector<uint8_t> stream;
+	uint32_t block_cnt;
+	uint32_t word_cnt;
+};
+
+static int malformed()
+{
+	std::vector<malformed_case> cases;
+	std::vector<uint8_t> s;
+	int failed = 0;
+
+	// run + i wraps around 2^64 and passed the old length check
+	s = stream_header(1, 8);
+	put_varint(s, 0);
+	put_varint(s, (2 << 1)); // two words, then run = 2^64 - 2 (i + run = 0)
+	put_varint(s, (2 << 1));
+	put_varint(s, (2 << 1) | 1);
+	put_varint(s, 0xfffffffffffffffeULL);
+	cases.push_back({"huge run", s, 1, 8});
+
+	s = stream_header(1, 8);
+	put_varint(s, 0);
+	put_varint(s, (2 << 1));     // one word
+	put_varint(s, (2 << 1) | 1); // followed by run of 8 (9 words in total)
+	put_varint(s, 8);
+	cases.push_back({"run past block end", s, 1, 8});
+
+	s = stream_header(1, 8);
+	put_varint(s, 0);
+	put_varint(s, (2 << 1) | 1);
+	put_varint(s, 3); // only 4 of 8 words
+	cases.push_back({"truncated payload", s, 1, 8});
+
+	s = stream_header(2, 8);
+	put_varint(s, 2); // reference to itself
+	cases.push_back({"forward reference", s, 2, 4});
+
+	s = stream_header(1, 8);
+	put_varint(s, 0);
+	for (int i = 0; i < 11; i++)
+	{
+		s.push_back(0xff); // overlong varint
+	}
+	cases.push_back({"overlong varint", s, 1, 8});
+
+	for (const malformed_case &c : cases)
+	{
+		int err = decode_guarded(c.stream, c.block_cnt, c.word_cnt);
+		bool ok = err != 0 && err != -100;
+		printf("%-20s %s (%d)\n", c.name, ok ? "rejected" : (err == -100 ? "OVERFLOW" : "ACCEPTED"), err);
+		failed += ok ? 0 : 1;
+	}
+	return failed;
+}
+
+int main(int argc, char **argv)
+{
+	int rounds = 1000, opt, failed;
+
+	while ((opt = getopt(argc, argv, "r:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'r':
+			rounds = atoi(optarg);
+			break;
+		default:
+			printf("usage: %s [-r rounds]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	failed = round_trip(rounds);
+	failed += malformed();
+	printf("%s\n", failed ? "FAILED" : "passed");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * dma_copy_bench.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Compares the bandwidth of memcpy and the dma_copy routines on a cached host buffer and
+ * on uncached mappings: the interface buffer of the intuitus driver and /dev/mem (O_SYNC).
+ *
+ * Build (on the target, from the repository root):
+ *   g++ -O2 -std=c++0x -mfpu=neon -Iintuitus_nn/src -Iintuitus_nn/src/mem -Iintuitus_nn/src/codec \
+ *       -Iintuitus_nn/src/trace -Iintuitus_nn/src/rt tools/dma_copy_bench.cpp intuitus_nn/src/mem/dma_copy.cpp \
+ *       intuitus_nn/src/mem/arena.cpp intuitus_nn/src/rt/realtime.cpp -lpthread -o dma_copy_bench
+ * Usage:
+ *   dma_copy_bench [-s size] [-r repeats] [-t threads] [-d device] [-m phys_addr]
+ */
+#include "intuitus.hpp"
+#include "intuitus-intf.h"
+#include "dma_copy.hpp"
+#include "arena.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <chrono>
+#include <functional>
+
+struct mapping
+{
+	const char *name;
+	uint8_t *ptr;
+	size_t size;
+};
+
+/** best_mbps -> runs a copy repeats times and returns the bandwidth of the fastest run in MB/s
+ */
+static double best_mbps(const std::function<void()> &copy, size_t bytes, int repeats)
+{
+	double best = 0;
+
+	for (int i = 0; i < repeats; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		copy();
+		double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (s > 0 && bytes / s / 1e6 > best)
+		{
+			best = bytes / s / 1e6;
+		}
+	}
+	return best;
+}
+
+static void bench(const struct mapping &m, uint8_t *host, size_t size, int repeats)
+{
+	size = size < m.size ? size : m.size;
+	printf("%-10s %9zu B | to device: memcpy %8.1f  dma_copy %8.1f | from device: memcpy %8.1f  dma_copy %8.1f  dma_copy_mt %8.1f MB/s\n",
+		   m.name, size,
+		   best_mbps([&]() { memcpy(m.ptr, host, size); }, size, repeats),
+		   best_mbps([&]() { dma_copy_to_device(m.ptr, host, size); }, size, repeats),
+		   best_mbps([&]() { memcpy(host, m.ptr, size); }, size, repeats),
+		   best_mbps([&]() { dma_copy_from_device(host, m.ptr, size); }, size, repeats),
+		   best_mbps([&]() { dma_copy_from_device_mt(host, m.ptr, size); }, size, repeats));
+}
+
+static uint8_t *map_file(const char *path, int flags, off_t offset, size_t size)
+{
+	int fd = open(path, O_RDWR | flags);
+	void *ptr;
+
+	if (fd < 0)
+	{
+		perror(path);
+		return NULL;
+	}
+	ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+	close(fd); // the mapping stays valid
+	if (MAP_FAILED == ptr)
+	{
+		perror("mmap");
+		return NULL;
+	}
+	return (uint8_t *)ptr;
+}
+
+int main(int argc, char **argv)
+{
+	size_t size = 4 * 1024 * 1024;
+	int repeats = 20;
+	const char *device = NULL;
+	unsigned long phys = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:r:t:d:m:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 's':
+			size = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			repeats = atoi(optarg);
+			break;
+		case 't':
+			if (0 != dma_copy_set_threads(atoi(optarg)))
+			{
+				fprintf(stderr, "threads must be 1..%d\n", DMA_COPY_MAX_THREADS);
+				return 1;
+			}
+			break;
+		case 'd':
+			device = optarg;
+			break;
+		case 'm':
+			phys = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			printf("usage: %s [-s size] [-r repeats] [-t threads] [-d device (e.g. %s)] [-m phys_addr]\n", argv[0], LINUX_DEV_PATH);
+			return 1;
+		}
+	}
+
+	uint8_t *host = (uint8_t *)Host_arena::instance().acquire(size, ARENA_LOCKED);
+	uint8_t *cached = (uint8_t *)Host_arena::instance().acquire(size, ARENA_LOCKED);
+	if (host == NULL || cached == NULL)
+	{
+		return 1;
+	}
+	memset(host, 0x5a, size);
+	memset(cached, 0xa5, size);
+	bench({"cached", cached, size}, host, size, repeats);
+
+	if (device != NULL)
+	{
+		// requires the loaded driver, the interface buffer is DMA coherent memory
+		uint8_t *intf = map_file(device, 0, 0, sizeof(struct intuitus_interface));
+		if (intf != NULL)
+		{
+			bench({"interface", intf, INTF_BUFFER_SIZE}, host, size, repeats);
+			munmap(intf, sizeof(struct intuitus_interface));
+		}
+	}
+	if (phys != 0)
+	{
+		// O_SYNC maps /dev/mem uncached. Use a reserved region only.
+		uint8_t *mem = map_file("/dev/mem", O_SYNC, phys, size);
+		if (mem != NULL)
+		{
+			bench({"devmem", mem, size}, host, size, repeats);
+			munmap(mem, size);
+		}
+	}
+	return 0;
+}
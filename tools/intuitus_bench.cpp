@@ -0,0 +1,486 @@
+/*
+ * intuitus_bench.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * End-to-end inference benchmark without python. Loads a network file (Sequential.save_network),
+ * feeds frames from synthetic data, a frame recording or the camera and executes the network
+ * on the device or on a simulated backend. Reports throughput, latency percentiles and the
+ * time spent per stage. Optionally publishes every output on a result bus (result_bus.hpp).
+ * With -N the throughput of batches (Intuitus_intf::execute_batch) is compared with the same
+ * frames executed one by one.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -mfpu=neon -I$S -I$S/fb -I$S/cam -I$S/codec -I$S/mem -I$S/trace -I$S/roi -I$S/rt -I$S/daemon -I$S/bus -I$S/startup \
+ *       $(pkg-config --cflags opencv4) tools/intuitus_bench.cpp $S/intuitus.cpp $S/intuitus_recovery.cpp \
+ *       $S/intuitus_info.cpp $S/intuitus_tuning.cpp $S/journal.cpp $S/cam/v4l_camera.cpp $S/cam/media_ctl.cpp \
+ *       $S/cam/frame_record.cpp $S/codec/command_codec.cpp $S/mem/result_pool.cpp $S/mem/arena.cpp \
+ *       $S/mem/dma_copy.cpp $S/mem/tensor.cpp $S/trace/frame_tracker.cpp $S/roi/roi.cpp $S/rt/realtime.cpp $S/daemon/backend.cpp \
+ *       $S/bus/result_bus.cpp $S/startup/kmod.cpp -lpthread -lrt -o intuitus_bench
+ * Usage:
+ *   intuitus_bench -n network.bin [-b device|sim] [-s synthetic|file:<recording>|camera:<device>]
+ *                  [-i iterations] [-c concurrency] [-w warmup] [-f] [-l sim_latency_us] [-j] [-B bus] [-N batch]
+ */
+#include "intuitus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "v4l_camera.hpp"
+#include "frame_record.hpp"
+#include "backend.hpp"
+#include "result_bus.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BENCH_SYNTHETIC_FRAMES 8 // distinct synthetic frames, cycled
+
+static inline uint64_t now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Bench_source -> provides input frames in network layout (ci, h, w)
+ * 					Recorded and camera frames are copied byte by byte into the input tensor,
+ * 					repeated or truncated to its size: the content is irrelevant for timing.
+ */
+class Bench_source
+{
+public:
+	Bench_source(size_t frame_size) : frame_size(frame_size) {}
+	~Bench_source()
+	{
+		delete this->replay;
+		delete this->camera;
+	}
+
+	int open(const std::string &spec)
+	{
+		try
+		{
+			if (spec == "synthetic")
+			{
+				std::mt19937 rng(1);
+				this->synthetic.resize(BENCH_SYNTHETIC_FRAMES * this->frame_size);
+				for (auto &v : this->synthetic)
+				{
+					v = rng();
+				}
+			}
+			else if (spec.compare(0, 5, "file:") == 0)
+			{
+				this->replay = new Frame_replay(spec.substr(5).c_str(), 0, 1);
+			}
+			else if (spec.compare(0, 7, "camera:") == 0)
+			{
+				this->camera = new Camera(spec.substr(7).c_str());
+			}
+			else
+			{
+				log_err(ERROR_OTHER, "Unknown frame source.");
+				return ERROR_OTHER;
+			}
+		}
+		catch (DMA_Exception &e)
+		{
+			log_err(e.getCode(), e.getMessage());
+			return ERROR_OTHER;
+		}
+		return 0;
+	}
+
+	/** next -> writes the next frame to dst (frame_size bytes)
+	 */
+	int next(uint8_t *dst)
+	{
+		uint8_t *img;
+		int h, w, c, err;
+		std::lock_guard<std::mutex> guard(this->source_lock);
+
+		if (!this->synthetic.empty())
+		{
+			memcpy(dst, &this->synthetic[(this->count++ % BENCH_SYNTHETIC_FRAMES) * this->frame_size], this->frame_size);
+			return 0;
+		}
+		err = (this->replay != NULL) ? this->replay->capture(&img, &h, &w, &c) : this->camera->capture(&img, &h, &w, &c);
+		if (0 != err)
+		{
+			return err;
+		}
+		size_t img_size = (size_t)h * w * c;
+		for (size_t pos = 0; pos < this->frame_size; pos += img_size)
+		{
+			memcpy(dst + pos, img, std::min(img_size, this->frame_size - pos));
+		}
+		return 0;
+	}
+
+private:
+	size_t frame_size;
+	std::vector<uint8_t> synthetic;
+	Frame_replay *replay = NULL;
+	Camera *camera = NULL;
+	uint64_t count = 0;
+	std::mutex source_lock;
+};
+
+/** frame_sample -> time of each stage of one benchmark iteration
+ */
+struct frame_sample
+{
+	bool valid;
+	uint32_t source_us;
+	uint32_t infer_us;
+	uint32_t post_us;
+	uint32_t total_us;
+};
+
+static double percentile(std::vector<uint32_t> &v, double p)
+{
+	if (v.empty())
+	{
+		return 0;
+	}
+	size_t idx = std::min(v.size() - 1, (size_t)(p * v.size()));
+	return v[idx] / 1000.0;
+}
+
+static double mean_ms(uint64_t sum, uint64_t n)
+{
+	return n > 0 ? sum / 1000.0 / n : 0;
+}
+
+static void usage(const char *prog)
+{
+	printf("usage: %s -n network.bin [options]\n"
+		   "  -b device|sim                        backend (default device)\n"
+		   "  -s synthetic|file:<rec>|camera:<dev> frame source (default synthetic)\n"
+		   "  -i iterations                        measured iterations (default 1000)\n"
+		   "  -c concurrency                       benchmark threads (default 1)\n"
+		   "  -w warmup                            iterations before measuring (default 10)\n"
+		   "  -f                                   convert the output to float32 (post stage)\n"
+		   "  -l latency_us                        execution time of the simulated backend (default 20000)\n"
+		   "  -j                                   print a JSON summary line\n"
+		   "  -B bus                               publish the outputs on a result bus (post stage)\n"
+		   "  -N batch                             compare batches of N frames with N single executions\n",
+		   prog);
+}
+
+/** batch_benchmark -> runs iterations batches of n frames, alternating between n single executions 
+ * 					   and one batch execution of the same frames. Returns the number of failures.
+ */
+static int batch_benchmark(Inference_backend *backend, Bench_source &source, size_t frame_size, int n,
+						   int iterations, int warmup, bool json)
+{
+	std::vector<uint8_t> frames((size_t)n * frame_size);
+	std::vector<int8_t> out((size_t)n * backend->output_size());
+	std::vector<uint32_t> single_us, batch_us;
+	int failures = 0;
+
+	for (int it = -warmup; it < iterations; it++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			if (0 != source.next(&frames[(size_t)j * frame_size]))
+			{
+				return failures + 1;
+			}
+		}
+		uint64_t t0 = now_us();
+		for (int j = 0; j < n; j++)
+		{
+			failures += (0 != backend->run(&frames[(size_t)j * frame_size], &out[(size_t)j * backend->output_size()]));
+		}
+		uint64_t t1 = now_us();
+		int8_t *batch_out = NULL;
+		failures += (0 != backend->run_batch(frames.data(), n, &batch_out));
+		uint64_t t2 = now_us();
+		free(batch_out);
+		if (it >= 0)
+		{
+			single_us.push_back(t1 - t0);
+			batch_us.push_back(t2 - t1);
+		}
+	}
+
+	uint64_t single_sum = 0, batch_sum = 0;
+	for (int i = 0; i < iterations; i++)
+	{
+		single_sum += single_us[i];
+		batch_sum += batch_us[i];
+	}
+	std::sort(single_us.begin(), single_us.end());
+	std::sort(batch_us.begin(), batch_us.end());
+	double single_fps = single_sum > 0 ? (double)n * iterations * 1e6 / single_sum : 0;
+	double batch_fps = batch_sum > 0 ? (double)n * iterations * 1e6 / batch_sum : 0;
+	if (json)
+	{
+		printf("{\"backend\": \"%s\", \"batch\": %d, \"iterations\": %d, \"failures\": %d, \"single_fps\": %.2f, "
+			   "\"batch_fps\": %.2f, \"gain\": %.3f, \"single_p50_ms\": %.3f, \"batch_p50_ms\": %.3f}\n",
+			   backend->name(), n, iterations, failures, single_fps, batch_fps, single_fps > 0 ? batch_fps / single_fps : 0,
+			   percentile(single_us, 0.5), percentile(batch_us, 0.5));
+	}
+	else
+	{
+		printf("backend:     %s, batches of %d frames, %d iterations, %d failed\n", backend->name(), n, iterations, failures);
+		printf("%d x single: %.2f frames/s, p50 %.3f ms per batch\n", n, single_fps, percentile(single_us, 0.5));
+		printf("batch:       %.2f frames/s, p50 %.3f ms per batch\n", batch_fps, percentile(batch_us, 0.5));
+		printf("gain:        %.3fx\n", single_fps > 0 ? batch_fps / single_fps : 0);
+	}
+	return failures;
+}
+
+int main(int argc, char **argv)
+{
+	const char *network = NULL;
+	std::string backend_name = "device", source_spec = "synthetic";
+	int iterations = 1000, concurrency = 1, warmup = 10, batch = 0;
+	uint32_t sim_latency_us = SIM_DEFAULT_LATENCY_US;
+	const char *bus_name = NULL;
+	bool decode = false, json = false;
+	int opt, err;
+
+	while ((opt = getopt(argc, argv, "n:b:s:i:c:w:fl:jB:N:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'n':
+			network = optarg;
+			break;
+		case 'b':
+			backend_name = optarg;
+			break;
+		case 's':
+			source_spec = optarg;
+			break;
+		case 'i':
+			iterations = atoi(optarg);
+			break;
+		case 'c':
+			concurrency = atoi(optarg);
+			break;
+		case 'w':
+			warmup = atoi(optarg);
+			break;
+		case 'f':
+			decode = true;
+			break;
+		case 'l':
+			sim_latency_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			json = true;
+			break;
+		case 'B':
+			bus_name = optarg;
+			break;
+		case 'N':
+			batch = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (network == NULL || iterations <= 0 || concurrency <= 0 || warmup < 0 || batch < 0)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	// backend
+	Inference_backend *backend = NULL;
+	try
+	{
+		if (backend_name == "device")
+		{
+			backend = new Device_backend();
+		}
+		else if (backend_name == "sim")
+		{
+			backend = new Sim_backend(sim_latency_us);
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		err = backend->load(network);
+	}
+	catch (DMA_Exception &e)
+	{
+		log_err(e.getCode(), e.getMessage());
+		return 1;
+	}
+	if (0 != err)
+	{
+		delete backend;
+		return 1;
+	}
+	int ci, h, w;
+	backend->input_dims(&ci, &h, &w);
+	size_t frame_size = (size_t)ci * h * w;
+	int out_size = backend->output_size();
+
+	Bench_source source(frame_size);
+	if (0 != source.open(source_spec))
+	{
+		delete backend;
+		return 1;
+	}
+	if (batch > 0)
+	{
+		err = batch_benchmark(backend, source, frame_size, batch, iterations, warmup, json);
+		delete backend;
+		return (err > 0) ? 2 : 0;
+	}
+	Result_publisher *bus = NULL;
+	if (bus_name != NULL)
+	{
+		try
+		{
+			bus = new Result_publisher(bus_name, RESULT_BUS_DEFAULT_SLOTS, out_size * (decode ? sizeof(float) : 1));
+		}
+		catch (DMA_Exception &e)
+		{
+			log_err(e.getCode(), e.getMessage());
+			delete backend;
+			return 1;
+		}
+	}
+
+	// benchmark threads take iterations from a shared counter
+	std::vector<struct frame_sample> samples(iterations);
+	std::atomic<int> next(-warmup);
+	std::atomic<int> failures(0);
+	std::atomic<uint64_t> measure_start(0);
+	struct stage_totals before = {0, 0, 0};
+	std::mutex before_lock;
+	auto worker = [&]() {
+		std::vector<uint8_t> frame(frame_size);
+		std::vector<int8_t> out(out_size);
+		std::vector<float> decoded(decode ? out_size : 0);
+		int i;
+
+		while ((i = next++) < iterations)
+		{
+			if (0 == i)
+			{
+				// first measured iteration, stage totals of the warmup are subtracted
+				std::lock_guard<std::mutex> guard(before_lock);
+				before = backend->totals();
+				measure_start = now_us();
+			}
+			uint64_t t0 = now_us();
+			if (0 != source.next(frame.data()))
+			{
+				failures++;
+				continue;
+			}
+			uint64_t t1 = now_us();
+			if (0 != backend->run(frame.data(), out.data()))
+			{
+				failures++;
+				continue;
+			}
+			uint64_t t2 = now_us();
+			if (decode)
+			{
+				float8_decode((const uint8_t *)out.data(), decoded.data(), out_size);
+			}
+			if (bus != NULL)
+			{
+				int bus_err = decode ? bus->publish_float(decoded.data(), 1, out_size, i + warmup, t0)
+									 : bus->publish_bytes((const uint8_t *)out.data(), out_size, i + warmup, t0);
+				if (0 != bus_err)
+				{
+					failures++;
+				}
+			}
+			uint64_t t3 = now_us();
+			if (i >= 0)
+			{
+				samples[i] = {true, (uint32_t)(t1 - t0), (uint32_t)(t2 - t1), (uint32_t)(t3 - t2), (uint32_t)(t3 - t0)};
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < concurrency; t++)
+	{
+		threads.emplace_back(worker);
+	}
+	for (auto &t : threads)
+	{
+		t.join();
+	}
+	uint64_t wall_us = now_us() - measure_start;
+	struct stage_totals after = backend->totals();
+
+	// statistics
+	std::vector<uint32_t> total, infer;
+	uint64_t source_sum = 0, infer_sum = 0, post_sum = 0;
+	for (auto &s : samples)
+	{
+		if (!s.valid)
+		{
+			continue; // failed iteration
+		}
+		total.push_back(s.total_us);
+		infer.push_back(s.infer_us);
+		source_sum += s.source_us;
+		infer_sum += s.infer_us;
+		post_sum += s.post_us;
+	}
+	std::sort(total.begin(), total.end());
+	std::sort(infer.begin(), infer.end());
+	uint64_t n = total.size();
+	// device stages of all executions after the warmup (including failed iterations)
+	double upload_ms = mean_ms(after.upload_us - before.upload_us, n);
+	double execute_ms = mean_ms(after.execute_us - before.execute_us, n);
+	double readout_ms = mean_ms(after.readout_us - before.readout_us, n);
+	double queue_ms = std::max(0.0, mean_ms(infer_sum, n) - upload_ms - execute_ms - readout_ms);
+	double fps = wall_us > 0 ? n * 1e6 / wall_us : 0;
+
+	struct utsname host;
+	uname(&host);
+	if (json)
+	{
+		printf("{\"machine\": \"%s\", \"kernel\": \"%s\", \"compiler\": \"%s\", \"backend\": \"%s\", \"source\": \"%s\", "
+			   "\"input\": [%d, %d, %d], \"output_bytes\": %d, \"iterations\": %d, \"concurrency\": %d, \"failures\": %d, "
+			   "\"fps\": %.2f, \"p50_ms\": %.3f, \"p99_ms\": %.3f, \"p999_ms\": %.3f, \"max_ms\": %.3f, "
+			   "\"source_ms\": %.3f, \"queue_ms\": %.3f, \"upload_ms\": %.3f, \"execute_ms\": %.3f, \"readout_ms\": %.3f, \"post_ms\": %.3f}\n",
+			   host.machine, host.release, __VERSION__, backend->name(), source_spec.c_str(),
+			   ci, h, w, out_size, iterations, concurrency, failures.load(),
+			   fps, percentile(total, 0.5), percentile(total, 0.99), percentile(total, 0.999), percentile(total, 1.0),
+			   mean_ms(source_sum, n), queue_ms, upload_ms, execute_ms, readout_ms, mean_ms(post_sum, n));
+	}
+	else
+	{
+		printf("host:        %s %s, built with gcc %s\n", host.machine, host.release, __VERSION__);
+		printf("network:     %s, input (%d,%d,%d), output %d B\n", network, ci, h, w, out_size);
+		printf("backend:     %s, source %s, %d threads\n", backend->name(), source_spec.c_str(), concurrency);
+		printf("iterations:  %llu measured, %d failed, %d warmup\n", (unsigned long long)n, failures.load(), warmup);
+		printf("throughput:  %.2f frames/s\n", fps);
+		printf("latency:     p50 %.3f ms | p99 %.3f ms | p999 %.3f ms | max %.3f ms\n",
+			   percentile(total, 0.5), percentile(total, 0.99), percentile(total, 0.999), percentile(total, 1.0));
+		printf("inference:   p50 %.3f ms | p99 %.3f ms | p999 %.3f ms\n",
+			   percentile(infer, 0.5), percentile(infer, 0.99), percentile(infer, 0.999));
+		printf("stages [ms]: source %.3f | queue %.3f | upload %.3f | execute %.3f | readout %.3f | post %.3f\n",
+			   mean_ms(source_sum, n), queue_ms, upload_ms, execute_ms, readout_ms, mean_ms(post_sum, n));
+	}
+	delete bus;
+	delete backend;
+	return (failures > 0) ? 2 : 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * intuitus_bus.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Consumer of a result bus (result_bus.hpp). Prints the latest entry or follows the stream and
+ * reports the entries, the delivery latency (publication -> read) and the overruns, i.e. the
+ * entries the producer overwrote before they were read.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -I$S -I$S/bus tools/intuitus_bus.cpp $S/bus/result_bus.cpp -lrt -o intuitus_bus
+ * Usage:
+ *   intuitus_bus -n bus [-l] [-c count] [-t timeout_ms] [-d delay_us] [-q]
+ */
+#include "result_bus.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_signal(int)
+{
+	stop = 1;
+}
+
+static inline uint64_t mono_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static const char *format_name(int format)
+{
+	switch (format)
+	{
+	case RESULT_BUS_INT8:
+		return "int8";
+	case RESULT_BUS_UINT8:
+		return "uint8";
+	case RESULT_BUS_FLOAT32:
+		return "float32";
+	default:
+		return "unknown";
+	}
+}
+
+static void print_entry(const struct result_entry_meta &m, uint64_t read_us)
+{
+	printf("entry %llu: frame %llu, %s [%d, %d] %u B, sensor -> publish %.3f ms, publish -> read %.3f ms\n",
+		   (unsigned long long)m.sequence, (unsigned long long)m.frame, format_name(m.format), m.rows, m.cols, m.size,
+		   m.sensor_us > 0 && m.publish_us >= m.sensor_us ? (m.publish_us - m.sensor_us) / 1000.0 : 0.0,
+		   (read_us - m.publish_us) / 1000.0);
+}
+
+static void usage(const char *prog)
+{
+	printf("usage: %s -n bus [options]\n"
+		   "  -l             print the latest entry and exit\n"
+		   "  -c count       entries to read (default: until the bus closes)\n"
+		   "  -t timeout_ms  give up after this time without an entry (default: wait)\n"
+		   "  -d delay_us    processing time per entry, simulates a slow consumer (default 0)\n"
+		   "  -q             print the summary only\n",
+		   prog);
+}
+
+int main(int argc, char **argv)
+{
+	const char *name = NULL;
+	bool latest = false, quiet = false;
+	long count = -1;
+	int timeout_ms = -1, opt, err = 0;
+	uint32_t delay_us = 0;
+
+	while ((opt = getopt(argc, argv, "n:lc:t:d:qh")) != -1)
+	{
+		switch (opt)
+		{
+		case 'n':
+			name = optarg;
+			break;
+		case 'l':
+			latest = true;
+			break;
+		case 'c':
+			count = atol(optarg);
+			break;
+		case 't':
+			timeout_ms = atoi(optarg);
+			break;
+		case 'd':
+			delay_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'q':
+			quiet = true;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (name == NULL)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	Result_subscriber *bus;
+	try
+	{
+		bus = new Result_subscriber(name);
+	}
+	catch (DMA_Exception &e)
+	{
+		log_err(e.getCode(), e.getMessage());
+		return 1;
+	}
+
+	if (latest)
+	{
+		err = bus->latest();
+		if (0 == err)
+		{
+			print_entry(bus->last_meta(), mono_us());
+		}
+		else if (RESULT_BUS_NO_DATA == err)
+		{
+			printf("no entry published yet\n");
+		}
+		delete bus;
+		return (err < 0) ? 1 : 0;
+	}
+
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = on_signal; // no SA_RESTART: interrupts the futex wait
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	std::vector<uint32_t> latency;
+	printf("bus %s: %d slots of %d B\n", name, bus->slots(), bus->slot_size());
+	while (!stop && (count < 0 || (long)latency.size() < count))
+	{
+		err = bus->next(timeout_ms);
+		if (0 != err)
+		{
+			break;
+		}
+		uint64_t now = mono_us();
+		struct result_entry_meta m = bus->last_meta();
+		latency.push_back((uint32_t)(now - m.publish_us));
+		if (!quiet)
+		{
+			print_entry(m, now);
+		}
+		if (delay_us > 0)
+		{
+			usleep(delay_us);
+		}
+	}
+	if (ERROR_BUS_CLOSED == err)
+	{
+		printf("bus closed by the producer\n");
+	}
+	else if (RESULT_BUS_NO_DATA == err && !stop)
+	{
+		printf("no entry within %d ms\n", timeout_ms);
+	}
+
+	std::sort(latency.begin(), latency.end());
+	uint64_t sum = 0;
+	for (auto l : latency)
+	{
+		sum += l;
+	}
+	printf("entries %zu, overruns %llu, publish -> read [ms] mean %.3f | p99 %.3f | max %.3f\n", latency.size(),
+		   (unsigned long long)bus->overruns(), latency.empty() ? 0.0 : sum / 1000.0 / latency.size(),
+		   latency.empty() ? 0.0 : latency[std::min(latency.size() - 1, (size_t)(0.99 * latency.size()))] / 1000.0,
+		   latency.empty() ? 0.0 : latency.back() / 1000.0);
+	delete bus;
+	return 0;
+}
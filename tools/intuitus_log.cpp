@@ -0,0 +1,260 @@
+/*
+ * intuitus_log.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Exports detection log segments (detection_log.hpp) as CSV or JSON lines, prints a summary
+ * of segments or measures the append latency of the logger (-W) with synthetic detections.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -I$S -I$S/log tools/intuitus_log.cpp $S/log/detection_log.cpp -lpthread -o intuitus_log
+ * Usage:
+ *   intuitus_log [-f csv|json] segment.idl...
+ *   intuitus_log -s segment.idl...
+ *   intuitus_log -W dir [-n frames] [-d detections] [-t] [-S segment_size] [-m max_segments]
+ */
+#include "detection_log.hpp"
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <vector>
+
+#define FORMAT_CSV 0
+#define FORMAT_JSON 1
+
+static void usage(const char *prog)
+{
+	printf("usage: %s [options] segment.idl...\n"
+		   "  -f format      export format: csv (default) or json (one object per frame)\n"
+		   "  -s             summary of each segment instead of the detections\n"
+		   "  -W dir         write benchmark: append synthetic frames to a log in dir\n"
+		   "  -n frames      frames of the write benchmark (default 10000)\n"
+		   "  -d detections  detections per frame of the write benchmark (default 10)\n"
+		   "  -t             write tracks (with ids) instead of detections\n"
+		   "  -S bytes       segment size of the write benchmark (default %d)\n"
+		   "  -m segments    segments kept by the write benchmark (default %d)\n",
+		   prog, DETLOG_DEFAULT_SEGMENT_SIZE, DETLOG_DEFAULT_MAX_SEGMENTS);
+}
+
+static uint64_t mono_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static int export_segment(const char *path, int format, bool summary)
+{
+	float *dets;
+	int cnt, dim, err;
+	uint64_t frames = 0, detections = 0, first_us = 0, last_us = 0;
+	struct stat st;
+
+	try
+	{
+		Detection_log_reader reader(path);
+		while (0 == (err = reader.next(&dets, &cnt, &dim)))
+		{
+			if (0 == frames)
+			{
+				first_us = reader.timestamp_us();
+			}
+			last_us = reader.timestamp_us();
+			frames++;
+			detections += cnt;
+			if (summary)
+			{
+				free(dets);
+				continue;
+			}
+			if (format == FORMAT_JSON)
+			{
+				printf("{\"frame\":%llu,\"timestamp_us\":%llu,\"detections\":[", (unsigned long long)reader.frame(),
+					   (unsigned long long)reader.timestamp_us());
+				for (int i = 0; i < cnt; i++)
+				{
+					const float *d = dets + i * dim;
+					printf("%s{\"box\":[%.3f,%.3f,%.3f,%.3f],\"score\":%.3f,\"class\":%d", i > 0 ? "," : "", d[0], d[1],
+						   d[2], d[3], d[4], (int)d[5]);
+					if (d[6] >= 0)
+					{
+						printf(",\"id\":%d", (int)d[6]);
+					}
+					printf("}");
+				}
+				printf("]}\n");
+			}
+			else
+			{
+				for (int i = 0; i < cnt; i++)
+				{
+					const float *d = dets + i * dim;
+					printf("%llu,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d\n", (unsigned long long)reader.frame(),
+						   (unsigned long long)reader.timestamp_us(), d[0], d[1], d[2], d[3], d[4], (int)d[5], (int)d[6]);
+				}
+			}
+			free(dets);
+		}
+		free(dets);
+		if (summary)
+		{
+			stat(path, &st);
+			printf("%s: segment %u, %llu frames, %llu detections, %lld bytes (%.1f bytes per detection), %.1f s\n", path,
+				   reader.segment(), (unsigned long long)frames, (unsigned long long)detections, (long long)st.st_size,
+				   detections > 0 ? (double)st.st_size / detections : 0.0, (last_us - first_us) / 1e6);
+		}
+	}
+	catch (DMA_Exception &e)
+	{
+		fprintf(stderr, "%s: %s\n", path, e.getMessage());
+		return 1;
+	}
+	if (err != DETLOG_END)
+	{
+		fprintf(stderr, "%s: corrupt block after %llu frames (%d)\n", path, (unsigned long long)frames, err);
+		return 1;
+	}
+	return 0;
+}
+
+static int write_benchmark(const char *dir, int frames, int det_cnt, bool tracks, int segment_size, int max_segments)
+{
+	int dim = tracks ? DETLOG_TRACK_DIM : DETLOG_DETECTION_DIM, o = tracks ? 1 : 0;
+	std::vector<float> dets((size_t)det_cnt * dim);
+	std::vector<uint32_t> latency(frames);
+	uint64_t start, now;
+
+	try
+	{
+		Detection_log log(dir, DETLOG_DEFAULT_PREFIX, segment_size, max_segments);
+		srand(1);
+		for (int i = 0; i < det_cnt; i++)
+		{
+			float *d = &dets[(size_t)i * dim];
+			d[0] = i + 1;
+			d[o + 0] = rand() % 400;
+			d[o + 1] = rand() % 400;
+			d[o + 2] = d[o + 0] + 10 + rand() % 100;
+			d[o + 3] = d[o + 1] + 10 + rand() % 100;
+			d[o + 4] = (rand() % 1000) / 1000.0f;
+			d[o + 5] = rand() % 80;
+		}
+		start = mono_us();
+		for (int f = 0; f < frames; f++)
+		{
+			float step = (f % 256 == 255) ? -127.5f : 0.5f; // moving boxes
+			for (int i = 0; i < det_cnt; i++)
+			{
+				dets[(size_t)i * dim + o] += step;
+				dets[(size_t)i * dim + o + 2] += step;
+			}
+			now = mono_us();
+			if (0 != log.append(dets.data(), det_cnt, dim, f))
+			{
+				fprintf(stderr, "append failed\n");
+				return 1;
+			}
+			latency[f] = mono_us() - now;
+		}
+		log.flush();
+		now = mono_us() - start;
+
+		struct detection_log_stats stats = log.get_stats();
+		std::sort(latency.begin(), latency.end());
+		printf("%d frames, %d %s per frame: %.1f ms\n", frames, det_cnt, tracks ? "tracks" : "detections", now / 1e3);
+		printf("append latency [us]: mean %.2f, p50 %u, p99 %u, max %u\n", (double)stats.append_us / std::max(frames, 1),
+			   latency[frames / 2], latency[(size_t)frames * 99 / 100], latency[frames - 1]);
+		printf("%llu bytes (%.1f bytes per detection), %u segments, %llu syncs, open segment %s\n",
+			   (unsigned long long)stats.bytes, stats.detections > 0 ? (double)stats.bytes / stats.detections : 0.0,
+			   stats.segments, (unsigned long long)stats.syncs, log.segment_path());
+	}
+	catch (DMA_Exception &e)
+	{
+		fprintf(stderr, "%s: %s\n", dir, e.getMessage());
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	const char *write_dir = NULL;
+	int format = FORMAT_CSV, frames = 10000, det_cnt = 10, segment_size = DETLOG_DEFAULT_SEGMENT_SIZE;
+	int max_segments = DETLOG_DEFAULT_MAX_SEGMENTS, opt, err = 0;
+	bool summary = false, tracks = false;
+
+	while ((opt = getopt(argc, argv, "f:sW:n:d:tS:m:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'f':
+			if (0 == strcmp(optarg, "json"))
+			{
+				format = FORMAT_JSON;
+			}
+			else if (0 != strcmp(optarg, "csv"))
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 's':
+			summary = true;
+			break;
+		case 'W':
+			write_dir = optarg;
+			break;
+		case 'n':
+			frames = atoi(optarg);
+			break;
+		case 'd':
+			det_cnt = atoi(optarg);
+			break;
+		case 't':
+			tracks = true;
+			break;
+		case 'S':
+			segment_size = atoi(optarg);
+			break;
+		case 'm':
+			max_segments = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (write_dir != NULL)
+	{
+		if (frames <= 0 || det_cnt < 0 || det_cnt > DETLOG_MAX_DETECTIONS)
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		return write_benchmark(write_dir, frames, det_cnt, tracks, segment_size, max_segments);
+	}
+	if (optind >= argc)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	if (format == FORMAT_CSV && !summary)
+	{
+		printf("frame,timestamp_us,x1,y1,x2,y2,score,class,id\n");
+	}
+	for (int i = optind; i < argc; i++)
+	{
+		err |= export_segment(argv[i], format, summary);
+	}
+	return err;
+}
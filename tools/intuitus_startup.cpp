@@ -0,0 +1,79 @@
+/*
+ * intuitus_startup.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Measures the time to the first frame: kernel module, device, network file and camera are
+ * brought up by the start-up orchestrator (startup.hpp) and the breakdown is printed.
+ * Run once with -s (stages one after the other) to see the gain of the overlapped start-up.
+ * Unload the module before the run (rmmod intuitus) to include the module insertion.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -mfpu=neon -I$S -I$S/fb -I$S/cam -I$S/codec -I$S/mem -I$S/trace -I$S/roi -I$S/rt -I$S/daemon -I$S/startup \
+ *       tools/intuitus_startup.cpp $S/intuitus.cpp $S/intuitus_recovery.cpp $S/intuitus_info.cpp $S/intuitus_tuning.cpp \
+ *       $S/journal.cpp $S/cam/v4l_camera.cpp $S/cam/media_ctl.cpp $S/codec/command_codec.cpp $S/mem/result_pool.cpp \
+ *       $S/mem/arena.cpp $S/mem/dma_copy.cpp $S/mem/tensor.cpp $S/trace/frame_tracker.cpp $S/roi/roi.cpp \
+ *       $S/rt/realtime.cpp $S/startup/kmod.cpp $S/startup/startup.cpp -lpthread -o intuitus_startup
+ * Usage:
+ *   intuitus_startup [-n network.bin] [-d camera_device] [-x width] [-y height] [-f fps] [-s]
+ */
+#include "startup.hpp"
+#include "intuitus-intf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static void usage(const char *prog)
+{
+	printf("usage: %s [options]\n"
+		   "  -n network     network file (Sequential.save_network)\n"
+		   "  -d device      camera video device (e.g. /dev/video0)\n"
+		   "  -x width       capture width (default %d)\n"
+		   "  -y height      capture height (default %d)\n"
+		   "  -f fps         sensor frame rate (default %d)\n"
+		   "  -s             sequential start-up (for comparison)\n",
+		   prog, WIDTH, HEIGHT, FPS);
+}
+
+int main(int argc, char **argv)
+{
+	const char *network = NULL, *camera = NULL;
+	int width = WIDTH, height = HEIGHT, fps = FPS, mode = STARTUP_PARALLEL, opt, err;
+
+	while ((opt = getopt(argc, argv, "n:d:x:y:f:sh")) != -1)
+	{
+		switch (opt)
+		{
+		case 'n':
+			network = optarg;
+			break;
+		case 'd':
+			camera = optarg;
+			break;
+		case 'x':
+			width = atoi(optarg);
+			break;
+		case 'y':
+			height = atoi(optarg);
+			break;
+		case 'f':
+			fps = atoi(optarg);
+			break;
+		case 's':
+			mode = STARTUP_SEQUENTIAL;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	Startup startup(network, camera, width, height, fps);
+	err = startup.run(mode);
+	printf("%s start-up%s\n", mode == STARTUP_PARALLEL ? "parallel" : "sequential", 0 == err ? "" : " failed");
+	startup.print_report();
+	return 0 == err ? 0 : 1;
+}
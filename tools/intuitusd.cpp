@@ -0,0 +1,167 @@
+/*
+ * intuitusd.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Inference daemon. Owns the accelerator and the loaded networks and executes frames of several
+ * client processes (Daemon_client, python: intuitus_nn.Daemon_client) which submit them through
+ * shared memory. Clients are served round robin per network.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -mfpu=neon -I$S -I$S/fb -I$S/cam -I$S/codec -I$S/mem -I$S/trace -I$S/roi -I$S/rt -I$S/daemon -I$S/startup \
+ *       tools/intuitusd.cpp $S/intuitus.cpp $S/intuitus_recovery.cpp $S/intuitus_info.cpp $S/intuitus_tuning.cpp \
+ *       $S/journal.cpp $S/codec/command_codec.cpp $S/mem/result_pool.cpp $S/mem/arena.cpp $S/mem/dma_copy.cpp \
+ *       $S/mem/tensor.cpp $S/trace/frame_tracker.cpp $S/roi/roi.cpp $S/rt/realtime.cpp $S/daemon/backend.cpp $S/daemon/daemon_protocol.cpp \
+ *       $S/daemon/daemon_server.cpp $S/startup/kmod.cpp -lpthread -o intuitusd
+ * Usage:
+ *   intuitusd -n name=network.bin [-n name=network.bin ...] [-b device|sim] [-l sim_latency_us]
+ *             [-S socket] [-p socket_mode]
+ */
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "backend.hpp"
+#include "daemon_server.hpp"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+static Daemon_server *server = NULL;
+
+static void on_signal(int sig)
+{
+	(void)sig;
+	if (server != NULL)
+	{
+		server->stop();
+	}
+}
+
+static void usage(const char *prog)
+{
+	printf("usage: %s -n name=network.bin [options]\n"
+		   "  -n name=network.bin  serve a network file (Sequential.save_network) under a name, repeatable\n"
+		   "  -b device|sim        execution backend (default device, one network only)\n"
+		   "  -l latency_us        execution time of the simulated backend (default 20000)\n"
+		   "  -S socket            socket path (default " DAEMON_SOCKET_PATH ")\n"
+		   "  -p mode              socket permissions, octal (default 0660)\n",
+		   prog);
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<std::pair<std::string, std::string>> networks;
+	std::string backend_name = "device";
+	const char *socket_path = DAEMON_SOCKET_PATH;
+	uint32_t sim_latency_us = SIM_DEFAULT_LATENCY_US;
+	int socket_mode = 0660;
+	int opt, err = 0;
+
+	while ((opt = getopt(argc, argv, "n:b:l:S:p:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'n':
+		{
+			const char *sep = strchr(optarg, '=');
+			if (sep == NULL || sep == optarg || sep[1] == '\0')
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			networks.push_back(std::make_pair(std::string(optarg, sep - optarg), std::string(sep + 1)));
+			break;
+		}
+		case 'b':
+			backend_name = optarg;
+			break;
+		case 'l':
+			sim_latency_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'S':
+			socket_path = optarg;
+			break;
+		case 'p':
+			socket_mode = strtol(optarg, NULL, 8);
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (networks.empty() || (backend_name != "device" && backend_name != "sim"))
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	if (backend_name == "device" && networks.size() > 1)
+	{
+		// the device holds one network at a time
+		log_err(ERROR_OTHER, "The device backend serves a single network.");
+		return 1;
+	}
+
+	try
+	{
+		Daemon_server daemon(socket_path, socket_mode);
+
+		for (auto &entry : networks)
+		{
+			Inference_backend *backend;
+			if (backend_name == "device")
+			{
+				backend = new Device_backend();
+			}
+			else
+			{
+				backend = new Sim_backend(sim_latency_us);
+			}
+			err = backend->load(entry.second.c_str());
+			if (0 == err)
+			{
+				err = daemon.add_network(entry.first.c_str(), backend);
+			}
+			else
+			{
+				delete backend;
+			}
+			if (0 != err)
+			{
+				return 1;
+			}
+			printf("%s: %s (%s)\n", entry.first.c_str(), entry.second.c_str(), backend_name.c_str());
+		}
+
+		struct sigaction sa;
+		memset(&sa, 0, sizeof(sa));
+		sa.sa_handler = on_signal;
+		sigaction(SIGINT, &sa, NULL);
+		sigaction(SIGTERM, &sa, NULL);
+		signal(SIGPIPE, SIG_IGN);
+		server = &daemon;
+		printf("listening on %s\n", socket_path);
+		fflush(stdout);
+		err = daemon.run();
+		server = NULL;
+
+		for (auto &entry : networks)
+		{
+			struct daemon_network_stats stats = daemon.get_stats(entry.first.c_str());
+			printf("%s: %llu executions, %llu failures\n", entry.first.c_str(),
+				   (unsigned long long)stats.executions, (unsigned long long)stats.failures);
+		}
+	}
+	catch (DMA_Exception &e)
+	{
+		log_err(e.getCode(), e.getMessage());
+		return 1;
+	}
+	return 0 == err ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+/*
+ * rt_jitter.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Jitter benchmark of the real-time mode (realtime.hpp). Executes the network periodically, like
+ * the inference thread of a camera pipeline, once with the default scheduler and once in
+ * real-time mode (pinned, SCHED_FIFO, mlockall, prefaulted buffers) and compares the wakeup
+ * latency, the execution time and the missed periods. Optional load threads compete for the
+ * cores and the memory meanwhile.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -fno-rtti -mfpu=neon -I$S -I$S/fb -I$S/cam -I$S/codec -I$S/mem -I$S/trace -I$S/roi -I$S/rt -I$S/daemon -I$S/startup \
+ *       tools/rt_jitter.cpp $S/intuitus.cpp $S/intuitus_recovery.cpp $S/intuitus_info.cpp $S/intuitus_tuning.cpp \
+ *       $S/journal.cpp $S/codec/command_codec.cpp $S/mem/result_pool.cpp $S/mem/arena.cpp $S/mem/dma_copy.cpp \
+ *       $S/mem/tensor.cpp $S/trace/frame_tracker.cpp $S/roi/roi.cpp $S/rt/realtime.cpp $S/daemon/backend.cpp \
+ *       $S/startup/kmod.cpp -lpthread -o rt_jitter
+ * Usage:
+ *   rt_jitter -n network.bin [-b device|sim] [-l sim_latency_us] [-p period_us] [-i cycles]
+ *             [-m both|default|rt] [-c cpu] [-P priority] [-x load_threads]
+ */
+#include "intuitus-intf.h"
+#include "driver_exceptions.hpp"
+#include "backend.hpp"
+#include "realtime.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define JITTER_LOAD_BYTES (4 * 1024 * 1024) // memory churned per load iteration
+
+static inline uint64_t mono_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static double percentile(std::vector<uint32_t> &v, double p)
+{
+	if (v.empty())
+	{
+		return 0;
+	}
+	size_t idx = std::min(v.size() - 1, (size_t)(p * v.size()));
+	return v[idx] / 1000.0;
+}
+
+/**
+ * jitter_result -> one run of the periodic loop
+ * @wakeup: delay of the wakeups after the period start [us]
+ * @exec: execution times [us]
+ * @overruns: periods missed because the previous cycle was too late
+ */
+struct jitter_result
+{
+	std::vector<uint32_t> wakeup;
+	std::vector<uint32_t> exec;
+	int overruns;
+	int failures;
+	int applied;
+};
+
+static void usage(const char *prog)
+{
+	printf("usage: %s -n network.bin [options]\n"
+		   "  -b device|sim        backend (default device)\n"
+		   "  -l latency_us        execution time of the simulated backend (default 20000)\n"
+		   "  -p period_us         cycle period (default 33333)\n"
+		   "  -i cycles            cycles per mode (default 1000)\n"
+		   "  -m both|default|rt   modes to measure (default both)\n"
+		   "  -c cpu               core of the real-time thread (default %d)\n"
+		   "  -P priority          SCHED_FIFO priority (default %d)\n"
+		   "  -x threads           load threads during the measurement (default 2)\n",
+		   prog, RT_DEFAULT_INFERENCE_CPU, RT_DEFAULT_INFERENCE_PRIORITY);
+}
+
+static void run_periodic(Inference_backend *backend, bool rt, uint32_t period_us, int cycles, struct jitter_result *res)
+{
+	int ci, h, w;
+	backend->input_dims(&ci, &h, &w);
+	std::vector<uint8_t> frame((size_t)ci * h * w, 0x55);
+	std::vector<int8_t> out(backend->output_size());
+
+	res->overruns = 0;
+	res->failures = 0;
+	res->applied = 0;
+	if (rt)
+	{
+		res->applied = rt_lock_memory() | rt_enter(RT_ROLE_INFERENCE);
+		backend->prefault();
+		rt_prefault(frame.data(), frame.size(), 1);
+		rt_prefault(out.data(), out.size(), 1);
+	}
+	res->wakeup.reserve(cycles);
+	res->exec.reserve(cycles);
+
+	struct timespec next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	for (int i = 0; i < cycles; i++)
+	{
+		next.tv_nsec += (long)period_us * 1000;
+		while (next.tv_nsec >= 1000000000L)
+		{
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+		uint64_t target = (uint64_t)next.tv_sec * 1000000ULL + next.tv_nsec / 1000;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR)
+		{
+		}
+		uint64_t woken = mono_us();
+		if (0 != backend->run(frame.data(), out.data()))
+		{
+			res->failures++;
+		}
+		uint64_t done = mono_us();
+		res->wakeup.push_back((uint32_t)(woken - target));
+		res->exec.push_back((uint32_t)(done - woken));
+		// skip the periods which already passed
+		while (done > target + period_us)
+		{
+			res->overruns++;
+			target += period_us;
+			next.tv_nsec += (long)period_us * 1000;
+			while (next.tv_nsec >= 1000000000L)
+			{
+				next.tv_nsec -= 1000000000L;
+				next.tv_sec++;
+			}
+		}
+	}
+	if (rt)
+	{
+		rt_leave();
+		rt_unlock_memory();
+	}
+	std::sort(res->wakeup.begin(), res->wakeup.end());
+	std::sort(res->exec.begin(), res->exec.end());
+}
+
+static void print_result(const char *mode, struct jitter_result &r)
+{
+	printf("%-8s wakeup [ms] p50 %.3f | p99 %.3f | max %.3f   exec [ms] p50 %.3f | p99 %.3f | max %.3f | jitter %.3f   overruns %d\n",
+		   mode, percentile(r.wakeup, 0.5), percentile(r.wakeup, 0.99), percentile(r.wakeup, 1.0),
+		   percentile(r.exec, 0.5), percentile(r.exec, 0.99), percentile(r.exec, 1.0),
+		   percentile(r.exec, 1.0) - percentile(r.exec, 0.5), r.overruns);
+}
+
+int main(int argc, char **argv)
+{
+	const char *network = NULL;
+	std::string backend_name = "device", mode = "both";
+	uint32_t sim_latency_us = SIM_DEFAULT_LATENCY_US, period_us = 33333;
+	int cycles = 1000, cpu = RT_DEFAULT_INFERENCE_CPU, priority = RT_DEFAULT_INFERENCE_PRIORITY, load_threads = 2;
+	int opt, err;
+
+	while ((opt = getopt(argc, argv, "n:b:l:p:i:m:c:P:x:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'n':
+			network = optarg;
+			break;
+		case 'b':
+			backend_name = optarg;
+			break;
+		case 'l':
+			sim_latency_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			period_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'i':
+			cycles = atoi(optarg);
+			break;
+		case 'm':
+			mode = optarg;
+			break;
+		case 'c':
+			cpu = atoi(optarg);
+			break;
+		case 'P':
+			priority = atoi(optarg);
+			break;
+		case 'x':
+			load_threads = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (network == NULL || cycles <= 0 || period_us == 0 || load_threads < 0 ||
+		(mode != "both" && mode != "default" && mode != "rt"))
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	if (0 != rt_set_role(RT_ROLE_INFERENCE, cpu, priority))
+	{
+		return 1;
+	}
+
+	Inference_backend *backend = NULL;
+	try
+	{
+		if (backend_name == "device")
+		{
+			backend = new Device_backend();
+		}
+		else if (backend_name == "sim")
+		{
+			backend = new Sim_backend(sim_latency_us);
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		err = backend->load(network);
+	}
+	catch (DMA_Exception &e)
+	{
+		log_err(e.getCode(), e.getMessage());
+		return 1;
+	}
+	if (0 != err)
+	{
+		delete backend;
+		return 1;
+	}
+
+	// load: threads touching fresh memory on all cores with the default scheduler
+	std::atomic<bool> stop(false);
+	std::vector<std::thread> load;
+	for (int t = 0; t < load_threads; t++)
+	{
+		load.emplace_back([&]() {
+			while (!stop)
+			{
+				uint8_t *p = (uint8_t *)malloc(JITTER_LOAD_BYTES);
+				if (p != NULL)
+				{
+					memset(p, 1, JITTER_LOAD_BYTES);
+					free(p);
+				}
+			}
+		});
+	}
+
+	printf("backend %s, period %.3f ms, %d cycles per mode, %d load threads, real-time core %d priority %d\n",
+		   backend->name(), period_us / 1000.0, cycles, load_threads, cpu, priority);
+	struct jitter_result def, rt;
+	if (mode != "rt")
+	{
+		run_periodic(backend, false, period_us, cycles, &def);
+		print_result("default", def);
+	}
+	if (mode != "default")
+	{
+		run_periodic(backend, true, period_us, cycles, &rt);
+		print_result("rt", rt);
+		printf("rt mode applied: %s%s%s\n", (rt.applied & RT_APPLIED_AFFINITY) ? "affinity " : "",
+			   (rt.applied & RT_APPLIED_FIFO) ? "SCHED_FIFO " : "", (rt.applied & RT_APPLIED_MLOCK) ? "mlockall" : "");
+	}
+
+	stop = true;
+	for (auto &t : load)
+	{
+		t.join();
+	}
+	delete backend;
+	return 0;
+}
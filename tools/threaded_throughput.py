@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# threaded_throughput.py
+#
+#  Created on: 19 Oct 2026
+#      Author: Lukas Baischer
+#
+# Measures the gain of overlapping capture and inference from python threads. Intuitus_intf.execute,
+# Camera.capture and Frame_replay.capture release the GIL, so a capture thread can wait for the next
+# frame while inference threads execute the network. The same frames are run once in a single
+# thread (capture -> prepare -> execute) and once with one capture thread and N inference threads.
+#
+# Usage (on the target, from the repository root):
+#   python3 tools/threaded_throughput.py -n network.bin -c 3 -y 416 -x 416 [-s camera:/dev/video0 | file:<recording>]
+#                                        [-i frames] [-t threads]
+#   python3 tools/threaded_throughput.py --sim 20 [-s synthetic] ...   (no device: execute is replaced by a
+#                                        GIL free wait of 20 ms, checks the harness itself)
+
+import argparse
+import queue
+import sys
+import threading
+import time
+
+import numpy as np
+
+
+class Source:
+    """ Frames from a camera, a frame recording (real-time replay) or synthetic data """
+    def __init__(self, spec, shape, fps):
+        self.spec = spec
+        self.shape = shape
+        if spec == 'synthetic':
+            rng = np.random.default_rng(1)
+            self.frames = [rng.integers(0, 256, (shape[1], shape[2], shape[0]), dtype=np.uint8) for _ in range(8)]
+            self.pos = 0
+        elif spec.startswith('camera:'):
+            from intuitus_nn.intuitus_nn import Camera
+            self.cam = Camera(spec[7:], shape[2], shape[1], fps)
+        elif spec.startswith('file:'):
+            from intuitus_nn.intuitus_nn import Frame_replay
+            self.cam = Frame_replay(spec[5:], 1, 1)
+        else:
+            raise ValueError("unknown source {}".format(spec))
+
+    def capture(self):
+        if self.spec == 'synthetic':
+            self.pos = (self.pos + 1) % len(self.frames)
+            return self.frames[self.pos]
+        status, img = self.cam.capture()
+        if status != 0:
+            raise Exception("capture failed. Error code {}".format(status))
+        return img
+
+
+def prepare(img, shape):
+    """ [H,W,C] frame -> [C,h,w] network input (nearest neighbour) """
+    c, h, w = shape
+    ys = np.arange(h) * img.shape[0] // h
+    xs = np.arange(w) * img.shape[1] // w
+    return np.ascontiguousarray(img[ys][:, xs, :c].transpose(2, 0, 1))
+
+
+class Executor:
+    def __init__(self, network, sim_ms):
+        self.sim_ms = sim_ms
+        if sim_ms <= 0:
+            from intuitus_nn.intuitus_nn import Intuitus_intf
+            self.net = Intuitus_intf()
+            if self.net.load_network(network) != 0:
+                raise Exception("error loading network {}".format(network))
+
+    def __call__(self, fmap):
+        if self.sim_ms > 0:
+            time.sleep(self.sim_ms / 1000)  # releases the GIL like execute
+            return
+        status, _ = self.net.execute(fmap)
+        if status != 0:
+            raise Exception("execution failed. Error code {}".format(status))
+
+
+def run_single(source, execute, shape, frames):
+    start = time.perf_counter()
+    for _ in range(frames):
+        execute(prepare(source.capture(), shape))
+    return time.perf_counter() - start
+
+
+def run_threaded(source, execute, shape, frames, threads):
+    inputs = queue.Queue(maxsize=2 * threads)
+    errors = []
+
+    def capture():
+        try:
+            for _ in range(frames):
+                inputs.put(prepare(source.capture(), shape))
+        except Exception as e:
+            errors.append(e)
+        for _ in range(threads):
+            inputs.put(None)
+
+    def infer():
+        try:
+            while True:
+                fmap = inputs.get()
+                if fmap is None:
+                    return
+                execute(fmap)
+        except Exception as e:
+            errors.append(e)
+
+    workers = [threading.Thread(target=capture)] + [threading.Thread(target=infer) for _ in range(threads)]
+    start = time.perf_counter()
+    for t in workers:
+        t.start()
+    for t in workers:
+        t.join()
+    if errors:
+        raise errors[0]
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Throughput of capture and inference from python threads')
+    parser.add_argument('-n', '--network', help='network file (Sequential.save_network)')
+    parser.add_argument('-s', '--source', default='synthetic', help='synthetic, camera:<device> or file:<recording>')
+    parser.add_argument('-c', '--channels', type=int, default=3)
+    parser.add_argument('-y', '--height', type=int, default=416)
+    parser.add_argument('-x', '--width', type=int, default=416)
+    parser.add_argument('-f', '--fps', type=int, default=30, help='camera frame rate')
+    parser.add_argument('-i', '--frames', type=int, default=200)
+    parser.add_argument('-t', '--threads', type=int, default=2, help='inference threads')
+    parser.add_argument('--sim', type=float, default=0, metavar='MS', help='simulate execute with a wait of MS ms')
+    args = parser.parse_args()
+    if args.sim <= 0 and args.network is None:
+        parser.error('a network file is required without --sim')
+
+    shape = (args.channels, args.height, args.width)
+    source = Source(args.source, shape, args.fps)
+    execute = Executor(args.network, args.sim)
+    execute(prepare(source.capture(), shape))  # warm up: buffers, page faults
+
+    single = run_single(source, execute, shape, args.frames)
+    threaded = run_threaded(source, execute, shape, args.frames, args.threads)
+    print("{} frames, source {}, input {}".format(args.frames, args.source, list(shape)))
+    print("single thread:              {:8.1f} fps".format(args.frames / single))
+    print("capture + {} infer threads:  {:8.1f} fps".format(args.threads, args.frames / threaded))
+    print("gain: {:.2f}x".format(single / threaded))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,145 @@
+/*
+ * transform_bench.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Lukas Baischer
+ *
+ * Compares the fused layout transform (transform.hpp) with the separate passes it replaces:
+ * float8 decode, transpose CHW -> HWC and a contiguous copy (float8_to_float32 followed by
+ * np.transpose(...).copy() in Python). Checks that both produce the same result.
+ * tools/transform_bench.py measures the same against numpy through the python extension.
+ *
+ * Build (on the target, from the repository root):
+ *   S=intuitus_nn/src
+ *   g++ -O2 -std=c++0x -mfpu=neon -I$S -I$S/mem -I$S/codec -I$S/trace -I$S/rt tools/transform_bench.cpp \
+ *       $S/mem/transform.cpp $S/mem/tensor.cpp $S/mem/arena.cpp $S/rt/realtime.cpp -lpthread -o transform_bench
+ * Usage:
+ *   transform_bench [-c channels] [-y height] [-x width] [-r repeats] [-t threads]
+ */
+#include "transform.hpp"
+#include "tensor.hpp"
+#include "intuitus-intf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+/** best_ms -> runs a transform repeats times and returns the time of the fastest run in ms
+ */
+static double best_ms(const std::function<void()> &run, int repeats)
+{
+	double best = -1;
+
+	for (int i = 0; i < repeats; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		run();
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (best < 0 || ms < best)
+		{
+			best = ms;
+		}
+	}
+	return best;
+}
+
+/** separate_passes -> decode, naive transpose and copy, one pass over the tensor each
+ */
+static void separate_passes(const uint8_t *src, int c, int h, int w, float *decoded, float *transposed, float *out)
+{
+	size_t pixels = (size_t)h * w;
+
+	float8_decode(src, decoded, (size_t)c * pixels);
+	for (size_t p = 0; p < pixels; p++)
+	{
+		for (int ch = 0; ch < c; ch++)
+		{
+			transposed[p * c + ch] = decoded[ch * pixels + p];
+		}
+	}
+	memcpy(out, transposed, (size_t)c * pixels * sizeof(float));
+}
+
+int main(int argc, char **argv)
+{
+	int c = 255, h = 52, w = 52, repeats = 20, threads = 0, opt;
+
+	while ((opt = getopt(argc, argv, "c:y:x:r:t:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'c':
+			c = atoi(optarg);
+			break;
+		case 'y':
+			h = atoi(optarg);
+			break;
+		case 'x':
+			w = atoi(optarg);
+			break;
+		case 'r':
+			repeats = atoi(optarg);
+			break;
+		case 't':
+			threads = atoi(optarg);
+			break;
+		default:
+			printf("usage: %s [-c channels] [-y height] [-x width] [-r repeats] [-t threads]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (c < 1 || h < 1 || w < 1 || repeats < 1)
+	{
+		fprintf(stderr, "invalid shape or repeats\n");
+		return 1;
+	}
+
+	size_t n = (size_t)c * h * w;
+	std::vector<uint8_t> src(n), out8(n);
+	std::vector<float> decoded(n), transposed(n), ref(n), out(n);
+	struct transform_desc desc = {TENSOR_FLOAT8, TENSOR_CHW, TRANSFORM_FLOAT32, TENSOR_HWC, 1.0f, 0.0f};
+	struct transform_desc desc8 = {TENSOR_FLOAT8, TENSOR_CHW, TRANSFORM_UINT8, TENSOR_HWC, 255.0f, 0.0f};
+
+	srand(1);
+	for (auto &v : src)
+	{
+		v = rand() & 0xff;
+	}
+
+	double separate = best_ms([&]() { separate_passes(src.data(), c, h, w, decoded.data(), transposed.data(), ref.data()); }, repeats);
+	transform_set_threads(1);
+	double fused = best_ms([&]() { transform_tensor(src.data(), c, h, w, desc, out.data()); }, repeats);
+	if (0 != memcmp(ref.data(), out.data(), n * sizeof(float)))
+	{
+		fprintf(stderr, "fused transform differs from the reference\n");
+		return 1;
+	}
+	if (threads == 0)
+	{
+		threads = TRANSFORM_MAX_THREADS;
+	}
+	if (0 != transform_set_threads(threads))
+	{
+		fprintf(stderr, "threads must be 1..%d\n", TRANSFORM_MAX_THREADS);
+		return 1;
+	}
+	double fused_mt = best_ms([&]() { transform_tensor(src.data(), c, h, w, desc, out.data()); }, repeats);
+	if (0 != memcmp(ref.data(), out.data(), n * sizeof(float)))
+	{
+		fprintf(stderr, "parallel transform differs from the reference\n");
+		return 1;
+	}
+	double fused_u8 = best_ms([&]() { transform_tensor(src.data(), c, h, w, desc8, out8.data()); }, repeats);
+
+	printf("[%d, %d, %d] float8 CHW -> HWC: separate passes %.3f ms | fused %.3f ms (%.1fx) | fused %d threads %.3f ms (%.1fx) | fused uint8 %.3f ms\n",
+		   c, h, w, separate, fused, separate / fused, threads, fused_mt, separate / fused_mt, fused_u8);
+	if (n < TRANSFORM_MT_THRESHOLD)
+	{
+		printf("(below %d elements the transform runs on the caller only)\n", TRANSFORM_MT_THRESHOLD);
+	}
+	return 0;
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#
+# transform_bench.py
+#
+#  Created on: 19 Oct 2026
+#      Author: Lukas Baischer
+#
+# Python counterpart of transform_bench.cpp: compares the numpy path for network outputs
+# (Intuitus_intf.float8_to_float32 followed by np.transpose(...).copy()) with the fused
+# transform_to_hwc_float of the extension, as Sequential.__call__ and Sequential.forward_hwc
+# use them. Checks that both produce the same result.
+#
+# Usage (on the target, from the repository root, intuitus device loaded):
+#   python3 tools/transform_bench.py [-s 255x52x52 -s 3x416x416 ...] [-r repeats] [-t threads]
+
+import argparse
+import sys
+import time
+
+import numpy as np
+
+
+def best_ms(run, repeats):
+    """ runs repeats times and returns the time of the fastest run in ms """
+    best = None
+    for _ in range(repeats):
+        start = time.perf_counter()
+        run()
+        ms = (time.perf_counter() - start) * 1000
+        best = ms if best is None else min(best, ms)
+    return best
+
+
+def parse_shape(text):
+    shape = tuple(int(v) for v in text.split('x'))
+    if len(shape) != 3 or min(shape) < 1:
+        raise argparse.ArgumentTypeError("shape has to be CxHxW, e.g. 255x52x52")
+    return shape
+
+
+def bench(net, shape, repeats):
+    from intuitus_nn.intuitus_nn import transform_to_hwc_float, TENSOR_FLOAT8
+
+    fmap = np.random.default_rng(1).integers(0, 256, shape, dtype=np.uint8)
+
+    def decode():
+        status, out = net.float8_to_float32(fmap)
+        if status != 0:
+            raise Exception("float8_to_float32 failed. Error code {}".format(status))
+        return out
+
+    def fused():
+        status, out = transform_to_hwc_float(fmap, TENSOR_FLOAT8, 1.0, 0.0)
+        if status != 0:
+            raise Exception("transform_to_hwc_float failed. Error code {}".format(status))
+        return out
+
+    decoded = decode()
+    ref = np.transpose(decoded, (1, 2, 0)).copy()
+    if not np.array_equal(ref, fused(), equal_nan=True):
+        raise Exception("fused transform differs from numpy for {}".format(list(shape)))
+
+    t_decode = best_ms(decode, repeats)
+    t_transpose = best_ms(lambda: np.transpose(decoded, (1, 2, 0)).copy(), repeats)
+    t_numpy = best_ms(lambda: np.transpose(decode(), (1, 2, 0)).copy(), repeats)
+    t_fused = best_ms(fused, repeats)
+    print("{} float8 CHW -> HWC: numpy path {:.3f} ms (decode {:.3f} + transpose/copy {:.3f}) | "
+          "fused {:.3f} ms ({:.1f}x)".format(list(shape), t_numpy, t_decode, t_transpose, t_fused, t_numpy / t_fused))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='float8_to_float32 + numpy transpose/copy against the fused transform')
+    parser.add_argument('-s', '--shape', type=parse_shape, action='append', help='CxHxW (repeatable)')
+    parser.add_argument('-r', '--repeats', type=int, default=20)
+    parser.add_argument('-t', '--threads', type=int, default=1, help='threads of the fused transform')
+    args = parser.parse_args()
+
+    from intuitus_nn.intuitus_nn import Intuitus_intf, transform_set_threads
+    if transform_set_threads(args.threads) != 0:
+        parser.error('invalid thread count')
+    net = Intuitus_intf()
+    print("numpy {}, fused transform with {} thread(s)".format(np.__version__, args.threads))
+    for shape in args.shape or [(255, 52, 52), (255, 26, 26), (3, 416, 416)]:
+        bench(net, shape, args.repeats)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())